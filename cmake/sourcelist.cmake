@@ -13,6 +13,7 @@ set(SOURCES
 	src/UI/Panels/ReticlePanel.cpp
 	src/UI/Panels/ZoomDataPanel.cpp
 	src/UI/Localization/LocalizationManager.cpp
+	src/UI/GlyphSet.cpp
 	src/EventHandler.cpp
 	src/DataPersistence.cpp
 	src/DDSTextureLoader11.cpp
@@ -30,4 +31,25 @@ set(SOURCES
 	src/ENBIntegration.cpp
 	src/FGCompatibility.cpp
 	src/rendering/ScopeCulling.cpp
+	src/rendering/TTSMarkerRegistry.cpp
+	src/rendering/ScopeQuadVerdictCache.cpp
+	src/rendering/ScopeProjection.cpp
+	src/rendering/TexturePool.cpp
+	src/rendering/D3DStateCache.cpp
+	src/rendering/ScopeRegion.cpp
+	src/rendering/RTWriteTracker.cpp
+	src/rendering/TransientAliasPlanner.cpp
+	src/rendering/ScopeResolutionScaler.cpp
+	src/rendering/ScopeAmortizationPolicy.cpp
+	src/rendering/FrameBudgetGovernor.cpp
+	src/rendering/GpuTimestampRing.cpp
+	src/rendering/TimingStatsStore.cpp
+	src/rendering/ClearPolicyTable.cpp
+	src/rendering/LightSelector.cpp
+	src/rendering/LightStateSnapshot.cpp
+	src/rendering/ScopeShaderVariants.cpp
+	src/rendering/ShaderBlobCache.cpp
+	src/rendering/DistortionLUT.cpp
+	src/rendering/AnalyticScopeMask.cpp
+	src/rendering/AsyncTextureLoader.cpp
 )
@@ -0,0 +1,157 @@
+import argparse
+import hashlib
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+# Must match ScopeShaderVariants (src/rendering/ScopeShaderVariants.cpp): bit order, defines, suffixes
+FEATURES = (
+	(1 << 0, "TTS_NIGHT_VISION", "NV"),
+	(1 << 1, "TTS_PARALLAX", "PX"),
+	(1 << 2, "TTS_SPHERICAL_DISTORTION", "SD"),
+	(1 << 3, "TTS_CHROMATIC_ABERRATION", "CA"),
+)
+SPHERICAL_DISTORTION = 1 << 2
+CHROMATIC_ABERRATION = 1 << 3
+
+def canonicalize(a_features):
+	if not a_features & SPHERICAL_DISTORTION:
+		a_features &= ~CHROMATIC_ABERRATION
+	return a_features
+
+def variant_name(a_features):
+	suffixes = [suffix for bit, _, suffix in FEATURES if a_features & bit]
+	return "TrueScopeShader_" + ("_".join(suffixes) if suffixes else "Base")
+
+def variant_defines(a_features):
+	defines = [("TTS_SHADER_VARIANT", "1")]
+	for bit, define, _ in FEATURES:
+		defines.append((define, "1" if a_features & bit else "0"))
+	return defines
+
+def variants():
+	count = 1 << len(FEATURES)
+	return [features for features in range(count) if canonicalize(features) == features]
+
+def shader_hash(a_shader):
+	# Line endings normalized so CRLF and LF checkouts share the baseline
+	with open(a_shader, "rb") as file:
+		return hashlib.sha256(file.read().replace(b"\r\n", b"\n")).hexdigest()
+
+def compile_fxc(a_args, a_features, a_cso, a_listing):
+	command = [a_args.fxc, "/nologo", "/T", "ps_5_0", "/E", "main", "/O3", "/Fo", a_cso, "/Fc", a_listing]
+	for name, value in variant_defines(a_features):
+		command += ["/D", "{}={}".format(name, value)]
+	command.append(a_args.shader)
+	subprocess.run(command, check=True)
+
+	# fxc listings end with "// approximately N instruction slots used"
+	with open(a_listing, "r", errors="replace") as listing:
+		match = re.search(r"approximately (\d+) instruction slots used", listing.read())
+	return int(match.group(1)) if match else -1
+
+def compile_dxc(a_args, a_features, a_cso, a_listing):
+	command = [a_args.dxc, "-nologo", "-T", "ps_6_0", "-E", "main", "-O3", "-Fo", a_cso, "-Fc", a_listing]
+	for name, value in variant_defines(a_features):
+		command += ["-D", "{}={}".format(name, value)]
+	command.append(a_args.shader)
+	subprocess.run(command, check=True)
+
+	# Count the DXIL instructions of main (indented lines inside "define void @main()")
+	count = 0
+	inside = False
+	with open(a_listing, "r", errors="replace") as listing:
+		for line in listing:
+			if line.startswith("define void @main()"):
+				inside = True
+			elif inside and line.startswith("}"):
+				break
+			elif inside and line.startswith("  ") and not line.strip().startswith(";"):
+				count += 1
+	return count
+
+def parse_arguments():
+	parser = argparse.ArgumentParser(description="compile every TrueScopeShader variant and report instruction counts")
+	parser.add_argument("--shader", type=str, help="path to TrueScopeShader.hlsl", required=True)
+	parser.add_argument("--output", type=str, help="output directory for the variant .cso files (deployed with the plugin)", required=True)
+	parser.add_argument("--listings", type=str, help="output directory for the disassembly listings (default: <output>/../ShaderVariantListings)")
+	parser.add_argument("--compiler", choices=("fxc", "dxc"), help="fxc builds the shipped ps_5_0 blobs; dxc (ps_6_0, Linux) only reports counts", default="fxc" if os.name == "nt" else "dxc")
+	parser.add_argument("--fxc", type=str, help="fxc executable", default="fxc")
+	parser.add_argument("--dxc", type=str, help="dxc executable", default="dxc")
+	parser.add_argument("--baseline", type=str, help="JSON file with previous instruction counts to compare against")
+	parser.add_argument("--update-baseline", action="store_true", help="write the current counts to --baseline")
+	parser.add_argument("--tolerance", type=int, help="allowed instruction count growth per variant", default=0)
+	return parser.parse_args()
+
+def main():
+	args = parse_arguments()
+	compiler = args.fxc if args.compiler == "fxc" else args.dxc
+	if shutil.which(compiler) is None:
+		print("{} not found".format(compiler))
+		return 1
+
+	listings = args.listings or os.path.join(os.path.dirname(os.path.abspath(args.output)), "ShaderVariantListings")
+	os.makedirs(args.output, exist_ok=True)
+	os.makedirs(listings, exist_ok=True)
+	compile_variant = compile_fxc if args.compiler == "fxc" else compile_dxc
+
+	counts = {}
+	for features in variants():
+		name = variant_name(features)
+		cso = os.path.join(args.output, name + ".cso")
+		listing = os.path.join(listings, name + ".asm")
+		counts[name] = compile_variant(args, features, cso, listing)
+
+	unreadable = [name for name, count in counts.items() if count < 0]
+	if unreadable:
+		print("no instruction count in the listings of: {}".format(", ".join(unreadable)))
+		return 1
+
+	# The baseline records the shader it was measured on; counts from an older shader are not comparable.
+	# A missing or null count fails the check instead of passing it unchecked
+	source = shader_hash(args.shader)
+	compare = args.baseline and not args.update_baseline
+	baseline = {}
+	if compare:
+		entry = {}
+		if os.path.exists(args.baseline):
+			with open(args.baseline, "r") as file:
+				entry = json.load(file).get(args.compiler, {})
+		if not entry:
+			print("no {} baseline in {}; rerun with --update-baseline".format(args.compiler, args.baseline))
+			return 1
+		if entry.get("shader") != source:
+			print("{} baseline in {} is for a different TrueScopeShader.hlsl; rerun with --update-baseline".format(args.compiler, args.baseline))
+			return 1
+		baseline = entry.get("counts") or {}
+
+	failures = 0
+	print("{:<32} {:>12} {:>10}".format("variant", "instructions", "baseline"))
+	for name, count in counts.items():
+		previous = baseline.get(name)
+		flag = ""
+		if compare and not isinstance(previous, int):
+			flag = "  NO BASELINE"
+			failures += 1
+		elif compare and count > previous + args.tolerance:
+			flag = "  REGRESSION"
+			failures += 1
+		print("{:<32} {:>12} {:>10}{}".format(name, count, "-" if previous is None else previous, flag))
+
+	if args.baseline and args.update_baseline:
+		data = {}
+		if os.path.exists(args.baseline):
+			with open(args.baseline, "r") as file:
+				data = json.load(file)
+		data[args.compiler] = {"shader": source, "counts": counts}
+		with open(args.baseline, "w") as file:
+			json.dump(data, file, indent=4, sort_keys=True)
+			file.write("\n")
+
+	return 1 if failures else 0
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -10,6 +10,13 @@
 #include <d3dcompiler.h>
 #include "RenderUtilities.h"
 #include "ScopeRenderingManager.h"
+#include "TTSMarkerRegistry.h"
+#include "ScopeQuadVerdictCache.h"
+#include "ScopeProjection.h"
+#include "D3DStateCache.h"
+#include "RenderTargetMerger.h"
+#include "ScopeRegion.h"
+#include "ScopeResolutionScaler.h"
 
 #include <DDSTextureLoader11.h>
 #include "ImGuiManager.h"
@@ -132,24 +139,72 @@ namespace ThroughScope {
 	float D3DHooks::s_SphericalDistortionCenterY = 0.0f;
 	int D3DHooks::s_EnableSphericalDistortion = 0;
 	int D3DHooks::s_EnableChromaticAberration = 0;
+	uint32_t D3DHooks::s_ScopeShaderFeatures = 0;
+	DistortionLUT D3DHooks::s_DistortionLUT;
+	int D3DHooks::s_ScopeUpsampleFilter = 2;
 
 	static constexpr UINT TARGET_STRIDE = 28;
 	static constexpr UINT TARGET_INDEX_COUNT = 96;
 	static constexpr UINT TARGET_BUFFER_SIZE = 0x0000000008000000;
-	
-	// TTS Marker UV - 用于可靠检测 TTSEffectShape 的唯一标识
-	// 在 NIF 编辑时，将第一个顶点的 UV 设置为这个特殊值
-	// UV 使用 half-float (16-bit) 格式存储在顶点缓冲区中
-	static constexpr float TTS_MARKER_UV_U = 0.415411f;
-	static constexpr float TTS_MARKER_UV_V = 0.189191f;
-	static constexpr float TTS_MARKER_UV_TOLERANCE = 0.001f;
+
+	// 判定缓存的缓冲区销毁通知：指针可能被新缓冲区复用，销毁时丢弃引用它的缓存项
+	static void WINAPI OnVerdictBufferDestroyed(void* token)
+	{
+		ScopeQuadVerdictCache::OnBufferDestroyed(token);
+	}
+
+	static bool WatchVerdictBuffer(const void* buffer, void* token)
+	{
+		auto* d3dBuffer = static_cast<ID3D11Buffer*>(const_cast<void*>(buffer));
+		Microsoft::WRL::ComPtr<ID3DDestructionNotifier> notifier;
+		if (FAILED(d3dBuffer->QueryInterface(IID_PPV_ARGS(notifier.GetAddressOf())))) {
+			logger::warn("ID3DDestructionNotifier is not available, scope quad verdict cache disabled");
+			return false;
+		}
+
+		UINT callbackID = 0;
+		return SUCCEEDED(notifier->RegisterDestructionCallback(&OnVerdictBufferDestroyed, token, &callbackID));
+	}
+
 	typedef void(__stdcall* D3D11DrawIndexedHook)(ID3D11DeviceContext* pContext, UINT IndexCount, UINT StartIndexLocation, INT BaseVertexLocation);
 	typedef void(__stdcall* D3D11RSSetViewportsHook)(ID3D11DeviceContext* pContext, UINT NumViewports, const D3D11_VIEWPORT* pViewports);
+	typedef void(__stdcall* D3D11RSSetStateHook)(ID3D11DeviceContext* pContext, ID3D11RasterizerState* pRasterizerState);
+	typedef void(__stdcall* D3D11RSSetScissorRectsHook)(ID3D11DeviceContext* pContext, UINT NumRects, const D3D11_RECT* pRects);
+	typedef void(__stdcall* D3D11ClearRenderTargetViewHook)(ID3D11DeviceContext* pContext, ID3D11RenderTargetView* pRenderTargetView, const FLOAT ColorRGBA[4]);
+	typedef void(__stdcall* D3D11OMSetRenderTargetsHook)(ID3D11DeviceContext* pContext, UINT NumViews, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView);
+	typedef void(__stdcall* D3D11OMSetRenderTargetsAndUnorderedAccessViewsHook)(ID3D11DeviceContext* pContext, UINT NumRTVs, ID3D11RenderTargetView* const* ppRenderTargetViews,
+		ID3D11DepthStencilView* pDepthStencilView, UINT UAVStartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts);
+	typedef void(__stdcall* D3D11CopySubresourceRegionHook)(ID3D11DeviceContext* pContext, ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT DstZ,
+		ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox);
+	typedef void(__stdcall* D3D11CopyResourceHook)(ID3D11DeviceContext* pContext, ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource);
+	typedef void(__stdcall* D3D11ClearUnorderedAccessViewUintHook)(ID3D11DeviceContext* pContext, ID3D11UnorderedAccessView* pUnorderedAccessView, const UINT Values[4]);
+	typedef void(__stdcall* D3D11ClearUnorderedAccessViewFloatHook)(ID3D11DeviceContext* pContext, ID3D11UnorderedAccessView* pUnorderedAccessView, const FLOAT Values[4]);
+	typedef void(__stdcall* D3D11CSSetUnorderedAccessViewsHook)(ID3D11DeviceContext* pContext, UINT StartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts);
 	using ClipCur = decltype(&ClipCursor);
 
 	D3D11DrawIndexedHook phookD3D11DrawIndexed = nullptr;
 	ClipCur phookClipCursor = nullptr;
 	D3D11RSSetViewportsHook phookD3D11RSSetViewports = nullptr;
+	D3D11RSSetStateHook phookD3D11RSSetState = nullptr;
+	D3D11RSSetScissorRectsHook phookD3D11RSSetScissorRects = nullptr;
+	D3D11ClearRenderTargetViewHook phookD3D11ClearRenderTargetView = nullptr;
+	D3D11OMSetRenderTargetsHook phookD3D11OMSetRenderTargets = nullptr;
+	D3D11OMSetRenderTargetsAndUnorderedAccessViewsHook phookD3D11OMSetRenderTargetsAndUnorderedAccessViews = nullptr;
+	D3D11CopySubresourceRegionHook phookD3D11CopySubresourceRegion = nullptr;
+	D3D11CopyResourceHook phookD3D11CopyResource = nullptr;
+	D3D11ClearUnorderedAccessViewUintHook phookD3D11ClearUnorderedAccessViewUint = nullptr;
+	D3D11ClearUnorderedAccessViewFloatHook phookD3D11ClearUnorderedAccessViewFloat = nullptr;
+	D3D11CSSetUnorderedAccessViewsHook phookD3D11CSSetUnorderedAccessViews = nullptr;
+
+	// 区域限定第二次渲染的 scissor 状态（仅渲染线程访问）
+	static bool s_ScopeRegionScissorActive = false;
+	static D3D11_VIEWPORT s_ScopeRegionViewport = {};
+	static Microsoft::WRL::ComPtr<ID3D11RasterizerState> s_ScopeGameRasterizerState;  // 游戏最后请求的 RS 状态
+	static bool s_ScopeGameScissorEnabled = false;
+	static D3D11_RECT s_ScopeGameScissorRect = {};
+	static void ApplyScopeRegionScissor(ID3D11DeviceContext* pContext);
+
+	static void SetScopeViewport(ID3D11DeviceContext* pContext, const D3D11_VIEWPORT& viewport);
 
 	D3DHooks* D3DInstance = D3DHooks::GetSingleton();
 	ImGuiManager* imguiMgr;
@@ -204,6 +259,7 @@ namespace ThroughScope {
 		s_SphericalDistortionRadius = std::clamp(radius, 0.0f, 1.0f);
 		s_SphericalDistortionCenterX = std::clamp(centerX, -0.5f, 0.5f);
 		s_SphericalDistortionCenterY = std::clamp(centerY, -0.5f, 0.5f);
+		s_DistortionLUT.Update({ s_SphericalDistortionStrength, s_SphericalDistortionRadius });
 		
 		// 立即标记缓存为无效，强制下次更新
 		s_CachedConstantBufferData.sphericalDistortionStrength = -999.0f; // 设置一个不可能的值
@@ -394,6 +450,7 @@ namespace ThroughScope {
 	{
 		
 		logger::info("Initializing D3D11 hooks...");
+		ScopeQuadVerdictCache::GetSingleton()->SetWatchFunction(&WatchVerdictBuffer);
 		if (!m_SwapChain) {
 			logger::error("Failed to get SwapChain");
 			auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
@@ -414,7 +471,17 @@ namespace ThroughScope {
 
 		void* drawIndexedFunc = contextVTable[12];
 		void* presentFunc = swapChainVTable[8];  // 注意：Present是SwapChain的方法，不是Context的
+		void* omSetRenderTargetsFunc = contextVTable[33];  // OMSetRenderTargets - 索引33
+		void* omSetRenderTargetsAndUAVsFunc = contextVTable[34];  // OMSetRenderTargetsAndUnorderedAccessViews - 索引34
+		void* rsSetStateFunc = contextVTable[43];  // RSSetState - 索引43
 		void* rsSetViewportsFunc = contextVTable[44];  // RSSetViewports - 索引44
+		void* rsSetScissorRectsFunc = contextVTable[45];  // RSSetScissorRects - 索引45
+		void* copySubresourceRegionFunc = contextVTable[46];  // CopySubresourceRegion - 索引46
+		void* copyResourceFunc = contextVTable[47];  // CopyResource - 索引47
+		void* clearRenderTargetViewFunc = contextVTable[50];  // ClearRenderTargetView - 索引50
+		void* clearUAVUintFunc = contextVTable[51];  // ClearUnorderedAccessViewUint - 索引51
+		void* clearUAVFloatFunc = contextVTable[52];  // ClearUnorderedAccessViewFloat - 索引52
+		void* csSetUAVsFunc = contextVTable[68];  // CSSetUnorderedAccessViews - 索引68
 
 		// 初始化ImGui管理器
 		imguiMgr = ImGuiManager::GetSingleton();
@@ -438,6 +505,16 @@ namespace ThroughScope {
 		Utilities::CreateAndEnableHook(presentFunc, reinterpret_cast<void*>(hkPresent), reinterpret_cast<void**>(&s_OriginalPresent), "Present");
 		Utilities::CreateAndEnableHook(&ClipCursor, ClipCursorHook, reinterpret_cast<LPVOID*>(&phookClipCursor), "ClipCursorHook");
 		Utilities::CreateAndEnableHook(rsSetViewportsFunc, reinterpret_cast<void*>(hkRSSetViewports), reinterpret_cast<void**>(&phookD3D11RSSetViewports), "RSSetViewportsHook");
+		Utilities::CreateAndEnableHook(rsSetStateFunc, reinterpret_cast<void*>(hkRSSetState), reinterpret_cast<void**>(&phookD3D11RSSetState), "RSSetStateHook");
+		Utilities::CreateAndEnableHook(rsSetScissorRectsFunc, reinterpret_cast<void*>(hkRSSetScissorRects), reinterpret_cast<void**>(&phookD3D11RSSetScissorRects), "RSSetScissorRectsHook");
+		Utilities::CreateAndEnableHook(clearRenderTargetViewFunc, reinterpret_cast<void*>(hkClearRenderTargetView), reinterpret_cast<void**>(&phookD3D11ClearRenderTargetView), "ClearRenderTargetViewHook");
+		Utilities::CreateAndEnableHook(omSetRenderTargetsFunc, reinterpret_cast<void*>(hkOMSetRenderTargets), reinterpret_cast<void**>(&phookD3D11OMSetRenderTargets), "OMSetRenderTargetsHook");
+		Utilities::CreateAndEnableHook(omSetRenderTargetsAndUAVsFunc, reinterpret_cast<void*>(hkOMSetRenderTargetsAndUnorderedAccessViews), reinterpret_cast<void**>(&phookD3D11OMSetRenderTargetsAndUnorderedAccessViews), "OMSetRenderTargetsAndUAVsHook");
+		Utilities::CreateAndEnableHook(copySubresourceRegionFunc, reinterpret_cast<void*>(hkCopySubresourceRegion), reinterpret_cast<void**>(&phookD3D11CopySubresourceRegion), "CopySubresourceRegionHook");
+		Utilities::CreateAndEnableHook(copyResourceFunc, reinterpret_cast<void*>(hkCopyResource), reinterpret_cast<void**>(&phookD3D11CopyResource), "CopyResourceHook");
+		Utilities::CreateAndEnableHook(clearUAVUintFunc, reinterpret_cast<void*>(hkClearUnorderedAccessViewUint), reinterpret_cast<void**>(&phookD3D11ClearUnorderedAccessViewUint), "ClearUAVUintHook");
+		Utilities::CreateAndEnableHook(clearUAVFloatFunc, reinterpret_cast<void*>(hkClearUnorderedAccessViewFloat), reinterpret_cast<void**>(&phookD3D11ClearUnorderedAccessViewFloat), "ClearUAVFloatHook");
+		Utilities::CreateAndEnableHook(csSetUAVsFunc, reinterpret_cast<void*>(hkCSSetUnorderedAccessViews), reinterpret_cast<void**>(&phookD3D11CSSetUnorderedAccessViews), "CSSetUAVsHook");
 
 		// Name all render targets for RenderDoc debugging
 		NameAllRenderTargets();
@@ -451,7 +528,7 @@ namespace ThroughScope {
 		if (isSelfDrawCall)
 			return phookD3D11DrawIndexed(pContext, IndexCount, StartIndexLocation, BaseVertexLocation);
 
-		bool isScopeQuad = IsScopeQuadBeingDrawn(pContext, IndexCount);
+		bool isScopeQuad = IsScopeQuadBeingDrawn(pContext, IndexCount, StartIndexLocation, BaseVertexLocation);
 
 		if (isScopeQuad) {
 			D3DPERF_BeginEvent(0xFFFF00FF, L"TTS_ScopeQuad_Detected");
@@ -484,15 +561,8 @@ namespace ThroughScope {
 
 	bool D3DHooks::LoadAimTexture(const std::string& path)
 	{
-		return D3DResourceManager::GetSingleton()->LoadReticleTexture(m_Device, path);
-	}
-
-	ID3D11ShaderResourceView* D3DHooks::LoadAimSRV(const std::string& path)
-	{
-		if (D3DResourceManager::GetSingleton()->LoadReticleTexture(m_Device, path)) {
-			return D3DResourceManager::GetSingleton()->GetReticleSRV();
-		}
-		return nullptr;
+		// 异步加载：就绪前继续使用旧准星，替换在 hkPresent 中完成
+		return D3DResourceManager::GetSingleton()->RequestReticleTexture(path);
 	}
 
 	void D3DHooks::CacheAllStates()
@@ -549,12 +619,13 @@ namespace ThroughScope {
 	{
 		outInfos.clear();
 
-		// 1. 直接尝试获取所有可能的槽位
-		std::vector<ID3D11Buffer*> buffers(maxSlotsToCheck);
-		std::vector<UINT> strides(maxSlotsToCheck);
-		std::vector<UINT> offsets(maxSlotsToCheck);
+		// 1. 直接尝试获取所有可能的槽位（固定大小的栈上数组，避免堆分配）
+		maxSlotsToCheck = (std::min)(maxSlotsToCheck, static_cast<UINT>(D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT));
+		ID3D11Buffer* buffers[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+		UINT strides[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
+		UINT offsets[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
 
-		pContext->IAGetVertexBuffers(0, maxSlotsToCheck, buffers.data(), strides.data(), offsets.data());
+		pContext->IAGetVertexBuffers(0, maxSlotsToCheck, buffers, strides, offsets);
 
 		// 2. 计算实际绑定的缓冲区数量
 		UINT actualCount = 0;
@@ -572,6 +643,7 @@ namespace ThroughScope {
 		UINT validIndex = 0;
 		for (UINT i = 0; i < maxSlotsToCheck && validIndex < actualCount; ++i) {
 			if (buffers[i] != nullptr) {
+				outInfos[validIndex].buffer = buffers[i];  // 仅作标识使用，不持有引用
 				outInfos[validIndex].stride = strides[i];
 				outInfos[validIndex].offset = offsets[i];
 				buffers[i]->GetDesc(&outInfos[validIndex].desc);
@@ -603,161 +675,102 @@ namespace ThroughScope {
 		return true;
 	}
 
-	// Half-float 转换辅助函数 (FO4 使用 half-float 存储 UV)
-	static float HalfToFloat(uint16_t half)
+	// 检查该次绘制是否为已登记的 TTSEffectShape，纯 CPU 查表，不访问 GPU
+	// 登记在 NIF 加载时完成（见 NIFLoader::ProcessBSTriShape）。池化顶点缓冲区里同样大小的网格
+	// 也会命中 (VB, IndexCount)，所以只接受引擎 DrawTriShape 绘制登记形状时发出的绘制窗口
+	// (VB 偏移, StartIndex, BaseVertex)，之后同一窗口直接查表
+	bool D3DHooks::HasTTSMarkerUV(const BufferInfo& vertexInfo, UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
 	{
-		uint32_t sign = (half & 0x8000) << 16;
-		uint32_t exponent = (half >> 10) & 0x1F;
-		uint32_t mantissa = half & 0x3FF;
+		// 只有 stride=28 的格式是 TTSEffectShape 的顶点格式
+		if (vertexInfo.stride != TARGET_STRIDE)
+			return false;
 
-		if (exponent == 0) {
-			// Subnormal or zero
-			if (mantissa == 0) {
-				uint32_t result = sign;
-				return *reinterpret_cast<float*>(&result);
-			}
-			// Subnormal - normalize
-			while ((mantissa & 0x400) == 0) {
-				mantissa <<= 1;
-				exponent--;
-			}
-			exponent++;
-			mantissa &= 0x3FF;
-		} else if (exponent == 31) {
-			// Inf or NaN
-			uint32_t result = sign | 0x7F800000 | (mantissa << 13);
-			return *reinterpret_cast<float*>(&result);
-		}
+		TTSMarkerRegistry::DrawWindow window;
+		window.vertexBuffer = vertexInfo.buffer;
+		window.vertexOffset = vertexInfo.offset;
+		window.startIndex = startIndexLocation;
+		window.baseVertex = baseVertexLocation;
+		window.indexCount = indexCount;
 
-		exponent = exponent + (127 - 15);
-		uint32_t result = sign | (exponent << 23) | (mantissa << 13);
-		return *reinterpret_cast<float*>(&result);
+		return TTSMarkerRegistry::GetSingleton()->IsMarked(window);
 	}
-
-	// 检查顶点缓冲区是否包含 TTS Marker UV
-	// FO4 顶点格式 (stride=28, Full Prec): Position(12) + BitangentX(4) + UV(4) + Normal(4) + Tangent(4)
-	// UV 位于偏移 16 字节处，使用 half-float 格式
-	static constexpr UINT TTS_UV_OFFSET = 16;  // Position(12) + BitangentX(4)
-	Microsoft::WRL::ComPtr<ID3D11Buffer> D3DHooks::s_StagingBuffer = nullptr;
-
-	bool D3DHooks::HasTTSMarkerUV(ID3D11DeviceContext* pContext, UINT stride, UINT offset)
+    
+	bool D3DHooks::ClassifyScopeQuadDraw(ID3D11DeviceContext* pContext, BufferInfo& vertexInfo, BufferInfo& indexInfo, UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
 	{
-		// 只有 stride=28 的格式我们知道 UV 的位置
-		if (stride != 28)
-			return false;
-
-		// 获取顶点缓冲区
-		ID3D11Buffer* vertexBuffer = nullptr;
-		UINT vbStride = 0, vbOffset = 0;
-		pContext->IAGetVertexBuffers(0, 1, &vertexBuffer, &vbStride, &vbOffset);
-		
-		if (!vertexBuffer)
-			return false;
+		// 慢路径：只在判定缓存未命中时执行
+		vertexInfo.buffer->GetDesc(&vertexInfo.desc);
+		indexInfo.buffer->GetDesc(&indexInfo.desc);
 
-		// 获取缓冲区描述
-		D3D11_BUFFER_DESC bufferDesc;
-		vertexBuffer->GetDesc(&bufferDesc);
-
-		// 安全检查：防止读取越界
-		// 我们需要读取 stride 字节，从 vbOffset 开始
-		if (vbOffset + stride > bufferDesc.ByteWidth) {
-			vertexBuffer->Release();
-			return false;
-		}
-
-		// 如果缓存的 staging buffer 还没创建，或者丢失了，就创建一个
-		if (!s_StagingBuffer) {
-			ID3D11Device* device = nullptr;
-			pContext->GetDevice(&device);
-			if (!device) {
-				vertexBuffer->Release();
-				return false;
-			}
-
-			D3D11_BUFFER_DESC stagingDesc = {};
-			stagingDesc.ByteWidth = 28; // 我们只关心 stride=28 的情况
-			stagingDesc.Usage = D3D11_USAGE_STAGING;
-			stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-			stagingDesc.BindFlags = 0;
-
-			HRESULT hr = device->CreateBuffer(&stagingDesc, nullptr, s_StagingBuffer.GetAddressOf());
-			device->Release();
-
-			if (FAILED(hr)) {
-				vertexBuffer->Release();
-				return false;
-			}
-		}
-
-		// 从顶点缓冲区复制第一个顶点到 staging buffer
-		D3D11_BOX srcBox = {};
-		srcBox.left = vbOffset;
-		srcBox.right = vbOffset + stride;
-		srcBox.top = 0;
-		srcBox.bottom = 1;
-		srcBox.front = 0;
-		srcBox.back = 1;
-
-		pContext->CopySubresourceRegion(s_StagingBuffer.Get(), 0, 0, 0, 0, vertexBuffer, 0, &srcBox);
-
-		// 映射 staging buffer 读取数据
-		D3D11_MAPPED_SUBRESOURCE mapped;
-		HRESULT hr = pContext->Map(s_StagingBuffer.Get(), 0, D3D11_MAP_READ, 0, &mapped);
-		
-		bool hasMarker = false;
-		if (SUCCEEDED(hr)) {
-			// UV 在偏移 TTS_UV_OFFSET 字节处，使用 half-float 格式
-			const uint8_t* data = static_cast<const uint8_t*>(mapped.pData);
-			const uint16_t* uvData = reinterpret_cast<const uint16_t*>(data + TTS_UV_OFFSET);
-			
-			float u = HalfToFloat(uvData[0]);
-			float v = HalfToFloat(uvData[1]);
-			
-			// 检查是否匹配 TTS Marker UV
-			hasMarker = (std::abs(u - TTS_MARKER_UV_U) < TTS_MARKER_UV_TOLERANCE &&
-			             std::abs(v - TTS_MARKER_UV_V) < TTS_MARKER_UV_TOLERANCE);
-			
-			pContext->Unmap(s_StagingBuffer.Get(), 0);
+		// ===== 主检测方法: TTS Marker 登记表 =====
+		// NIF 加载时登记了 TTSEffectShape 的顶点缓冲区，命中即为 scope quad
+		if (HasTTSMarkerUV(vertexInfo, indexCount, startIndexLocation, baseVertexLocation))
+		{
+			return true;
 		}
 
-		vertexBuffer->Release();
-
-		return hasMarker;
+		// ===== 回退检测方法: 几何特征匹配 =====
+		// 如果 NIF 还没有设置标记 UV，使用传统的几何匹配方法
+		// 检查 buffer size, stride 和 index count
+		return IsTargetDrawCall(vertexInfo, indexInfo, indexCount);
 	}
-    
-	bool D3DHooks::IsScopeQuadBeingDrawn(ID3D11DeviceContext* pContext, UINT IndexCount)
+
+	bool D3DHooks::IsScopeQuadBeingDrawn(ID3D11DeviceContext* pContext, UINT IndexCount, UINT StartIndexLocation, INT BaseVertexLocation)
 	{
+		// 快速拒绝：scope quad 只在 forward 阶段绘制，其余阶段不读取任何 D3D 状态
 		if (!s_isForwardStage)
 			return false;
 
-		auto playerCharacter = RE::PlayerCharacter::GetSingleton();
-		if (!playerCharacter || !playerCharacter->Get3D())
+		// 没有加载瞄具模型时不可能有 scope quad（登记表和几何匹配都依赖它）
+		auto* scopeNode = ScopeCamera::s_CurrentScopeNode;
+		if (!scopeNode)
 			return false;
 
-		std::vector<BufferInfo> vertexInfo;
-		BufferInfo indexInfo;
-		if (!GetVertexBuffersInfo(pContext, vertexInfo) || !GetIndexBufferInfo(pContext, indexInfo))
-			return false;
-		
-		if (vertexInfo.empty())
-			return false;
-
-		// ===== 主检测方法: TTS Marker UV =====
-		// 检查第一个顶点的 UV 是否为 TTS 标记值 (0.415411, 0.189191)
-		if (HasTTSMarkerUV(pContext, vertexInfo[0].stride, vertexInfo[0].offset))
-		{
-			return true;
+		// 只读取 slot 0 和索引缓冲区，全部使用栈上变量
+		BufferInfo vertexInfo{};
+		BufferInfo indexInfo{};
+		DXGI_FORMAT indexFormat = DXGI_FORMAT_UNKNOWN;
+		pContext->IAGetVertexBuffers(0, 1, &vertexInfo.buffer, &vertexInfo.stride, &vertexInfo.offset);
+		pContext->IAGetIndexBuffer(&indexInfo.buffer, &indexFormat, &indexInfo.offset);
+		indexInfo.stride = (indexFormat == DXGI_FORMAT_R32_UINT) ? 4 : 2;
+
+		bool isScopeQuad = false;
+		if (vertexInfo.buffer && indexInfo.buffer) {
+			// 判定只取决于绘制窗口（缓冲区、偏移、StartIndex、BaseVertex、IndexCount、stride）和当前加载的瞄具模型，
+			// 命中缓存即可跳过 GetDesc。池化缓冲区里同样大小的网格只靠偏移区分，所以偏移必须在键里
+			auto verdictCache = ScopeQuadVerdictCache::GetSingleton();
+			ScopeQuadVerdictCache::Key key;
+			key.vertexBuffer = vertexInfo.buffer;
+			key.indexBuffer = indexInfo.buffer;
+			key.vertexOffset = vertexInfo.offset;
+			key.indexOffset = indexInfo.offset;
+			key.startIndex = StartIndexLocation;
+			key.baseVertex = BaseVertexLocation;
+			key.indexCount = IndexCount;
+			key.stride = vertexInfo.stride;
+			const ScopeQuadVerdictCache::Context context{ TTSMarkerRegistry::GetSingleton()->GetGeneration(), scopeNode };
+
+			// 引擎正在绘制登记的 TTSEffectShape 时必须走完整检测，登记表据此记录绘制窗口
+			auto verdict = TTSMarkerRegistry::GetSingleton()->IsRegisteredShapeDrawActive() ?
+				ScopeQuadVerdictCache::Verdict::Unknown : verdictCache->Lookup(key, context);
+			if (verdict == ScopeQuadVerdictCache::Verdict::Unknown) {
+				isScopeQuad = ClassifyScopeQuadDraw(pContext, vertexInfo, indexInfo, IndexCount, StartIndexLocation, BaseVertexLocation);
+				verdictCache->Store(key, context, isScopeQuad);
+			} else {
+				isScopeQuad = (verdict == ScopeQuadVerdictCache::Verdict::ScopeQuad);
+			}
 		}
 
-		// ===== 回退检测方法: 几何特征匹配 =====
-		// 如果 NIF 还没有设置标记 UV，使用传统的几何匹配方法
-		// 检查 buffer size, stride 和 index count
-		if (IsTargetDrawCall(vertexInfo[0], indexInfo, IndexCount))
-		{
-			return true;
-		}
+		// 释放 IAGet* 获取的引用
+		if (vertexInfo.buffer)
+			vertexInfo.buffer->Release();
+		if (indexInfo.buffer)
+			indexInfo.buffer->Release();
+
+		if (!isScopeQuad)
+			return false;
 
-		return false;
+		auto playerCharacter = RE::PlayerCharacter::GetSingleton();
+		return playerCharacter && playerCharacter->Get3D();
 	}
 	
 	bool D3DHooks::IsScopeQuadBeingDrawnShape(ID3D11DeviceContext* pContext, UINT IndexCount)
@@ -976,6 +989,18 @@ namespace ThroughScope {
 		newCBData.screenHeight = viewportHeight;
 		newCBData.viewportWidth = viewportWidth;
 		newCBData.viewportHeight = viewportHeight;
+		// 动态分辨率：第二次渲染只占上面 viewport 的左上角部分，与 DLSS/FSR 的缩放叠加
+		newCBData.scopeResolutionScale[0] = RenderUtilities::GetScopeResolutionScaleX();
+		newCBData.scopeResolutionScale[1] = RenderUtilities::GetScopeResolutionScaleY();
+		newCBData.scopeUpsampleFilter = RenderUtilities::IsScopeResolutionScaled() ? s_ScopeUpsampleFilter : 0;
+		// 时域分摊：本帧未渲染瞄具，按相机变化重投影上一次的图像
+		if (RenderUtilities::IsScopeReprojectionActive()) {
+			const auto& homography = RenderUtilities::GetScopeReprojection();
+			for (int row = 0; row < 3; ++row) {
+				memcpy(newCBData.reprojection[row], homography[row], sizeof(homography[row]));
+			}
+			newCBData.enableReprojection = 1;
+		}
 		newCBData.cameraPosition[0] = cameraPos.x;
 		newCBData.cameraPosition[1] = cameraPos.y;
 		newCBData.cameraPosition[2] = cameraPos.z;
@@ -1004,6 +1029,16 @@ namespace ThroughScope {
 		newCBData.reticleZoomScale = zoomScale;
 		newCBData.enableNightVision = s_EnableNightVision;
 
+		// 夜视蓝噪声：平铺偏移按 R2 低差异序列逐帧跳动（32 位定点 Weyl 序列，取高 6 位即 0-63 纹素），
+		// 相邻帧的噪点互不相关且长期均匀覆盖整个纹理
+		ID3D11ShaderResourceView* blueNoiseSRV = s_EnableNightVision ? resManager->GetBlueNoiseSRV() : nullptr;
+		newCBData.useBlueNoise = blueNoiseSRV ? 1 : 0;
+		if (blueNoiseSRV) {
+			const uint32_t frame = static_cast<uint32_t>(s_FrameNumber);
+			newCBData.nightVisionNoiseOffset[0] = static_cast<float>((frame * 0xC13FA9A9u + 0x80000000u) >> 26);
+			newCBData.nightVisionNoiseOffset[1] = static_cast<float>((frame * 0x91E10DA6u + 0x80000000u) >> 26);
+		}
+
 		
 		// 添加球形畸变参数到变化检测中
 		newCBData.sphericalDistortionStrength = s_SphericalDistortionStrength;
@@ -1012,6 +1047,13 @@ namespace ThroughScope {
 		newCBData.sphericalDistortionCenter[1] = s_SphericalDistortionCenterY;
 		newCBData.enableSphericalDistortion = s_EnableSphericalDistortion;
 		newCBData.enableChromaticAberration = s_EnableChromaticAberration;
+		// 畸变系数表：参数变化时才在 CPU 上重建并上传
+		ID3D11ShaderResourceView* distortionLUTSRV = nullptr;
+		if (s_EnableSphericalDistortion) {
+			s_DistortionLUT.Update({ s_SphericalDistortionStrength, s_SphericalDistortionRadius });
+			distortionLUTSRV = resManager->UpdateDistortionLUT(device, pContext, s_DistortionLUT);
+		}
+		newCBData.useDistortionLUT = distortionLUTSRV ? 1 : 0;
 		newCBData.brightnessBoost = 1.0f;   // No additional brightness boost (gamma correction only)
 		newCBData.ambientOffset = 0.0f;     // Unused
 
@@ -1081,15 +1123,18 @@ namespace ThroughScope {
 		ID3D11Buffer* cb = resManager->GetConstantBuffer();
 		pContext->PSSetConstantBuffers(0, 1, &cb);
 		
-		pContext->PSSetShader(resManager->GetScopePixelShader(), nullptr, 0);
+		// 按当前 ScopeConfig 的功能开关选择编译期变体，关闭的效果不再占用着色器指令
+		s_ScopeShaderFeatures = ScopeShaderVariants::FromSwitches(s_EnableNightVision != 0, s_EnableParallax != 0,
+			s_EnableSphericalDistortion != 0, s_EnableChromaticAberration != 0);
+		pContext->PSSetShader(resManager->GetScopePixelShader(s_ScopeShaderFeatures), nullptr, 0);
 
 		// 设置纹理资源和采样器
-        ID3D11ShaderResourceView* views[2] = { stagingSRV, resManager->GetReticleSRV() };
-		pContext->PSSetShaderResources(0, 2, views);
+        ID3D11ShaderResourceView* views[4] = { stagingSRV, resManager->GetReticleSRV(), distortionLUTSRV, blueNoiseSRV };
+		pContext->PSSetShaderResources(0, 4, views);
 		
-		// 设置采样器（s0用于主纹理）
-		ID3D11SamplerState* samplers[1] = { resManager->GetSamplerState() };
-        pContext->PSSetSamplers(0, 1, samplers);
+		// 设置采样器（s0用于主纹理，s1用于畸变系数表）
+		ID3D11SamplerState* samplers[2] = { resManager->GetSamplerState(), resManager->GetLUTSamplerState() };
+        pContext->PSSetSamplers(0, 2, samplers);
 
 		// === 绘制 ScopeQuad 并写入 Stencil ===
 		// ScopeQuad 在 hkDrawIndexed 中被跳过了，需要在这里用自定义 shader 绘制
@@ -1150,8 +1195,8 @@ namespace ThroughScope {
 			dssDesc.FrontFace.StencilFunc = D3D11_COMPARISON_ALWAYS;    // 总是写入
 			dssDesc.BackFace = dssDesc.FrontFace;
 
-			Microsoft::WRL::ComPtr<ID3D11DepthStencilState> stencilWriteDSS;
-			if (SUCCEEDED(device->CreateDepthStencilState(&dssDesc, stencilWriteDSS.GetAddressOf()))) {
+			ID3D11DepthStencilState* stencilWriteDSS = D3DStateCache::GetSingleton()->GetDepthStencilState(device, dssDesc);
+			if (stencilWriteDSS) {
 				// 设置 viewport (关键：使用 scope quad 检测时捕获的原始 viewport)
 				// 这样顶点坐标变换与游戏原始渲染一致，即使 RT4 尺寸不同
 				// D3D11 的 viewport 变换会自动处理坐标映射
@@ -1163,7 +1208,7 @@ namespace ThroughScope {
 				pContext->OMSetRenderTargets(1, &rt4RTV, stencilDSV);
 
 				// 设置 stencil ref = 127
-				pContext->OMSetDepthStencilState(stencilWriteDSS.Get(), 127);
+				pContext->OMSetDepthStencilState(stencilWriteDSS, 127);
 
 				// 绘制 ScopeQuad（同时写入 stencil 和渲染颜色）
 				// 使用 StartIndexLocation=0, BaseVertexLocation=0（与原 RestoreFirstPass 一致）
@@ -1210,6 +1255,12 @@ namespace ThroughScope {
 		s_InPresent = true;
 		HRESULT result = S_OK;
 
+		// 瞄具 RT 备份纹理按帧老化，退出 ADS 一段时间后释放
+		RenderTargetMerger::GetInstance().EndFrame();
+
+		// 后台创建完成的准星纹理在帧之间替换
+		D3DResourceManager::GetSingleton()->UpdateReticleTexture();
+
 		if (imguiMgr && imguiMgr->IsInitialized()) {
 			ImGuiContext* ctx = ImGui::GetCurrentContext();
 			if (ctx != nullptr) {
@@ -1286,13 +1337,17 @@ namespace ThroughScope {
 					D3D11_TEXTURE2D_DESC desc;
 					backBuffer->GetDesc(&desc);
 
+					// 动态分辨率的瞄具渲染：引擎的动态分辨率 viewport 只占左上角的缩放部分，这才是预期的全屏 viewport
+					const float expectedWidth = static_cast<float>(ScopeResolutionScaler::ScaleExtent(desc.Width, RenderUtilities::GetScopeResolutionScaleX()));
+					const float expectedHeight = static_cast<float>(ScopeResolutionScaler::ScaleExtent(desc.Height, RenderUtilities::GetScopeResolutionScaleY()));
+
 					// 检查传入的viewport是否与预期的全屏viewport匹配
 					// 如果不匹配（可能被其他MOD修改了），则强制使用正确的全屏viewport
 					const D3D11_VIEWPORT& vp = pViewports[0];
 					bool needsCorrection = false;
 
 					// 检查viewport是否明显偏离全屏设置
-					if (vp.Width < desc.Width * 0.9f || vp.Height < desc.Height * 0.9f ||
+					if (vp.Width < expectedWidth * 0.9f || vp.Height < expectedHeight * 0.9f ||
 						vp.TopLeftX > desc.Width * 0.1f || vp.TopLeftY > desc.Height * 0.1f) {
 						needsCorrection = true;
 					}
@@ -1302,20 +1357,267 @@ namespace ThroughScope {
 						D3D11_VIEWPORT fullViewport;
 						fullViewport.TopLeftX = 0.0f;
 						fullViewport.TopLeftY = 0.0f;
-						fullViewport.Width = static_cast<float>(desc.Width);
-						fullViewport.Height = static_cast<float>(desc.Height);
+						fullViewport.Width = expectedWidth;
+						fullViewport.Height = expectedHeight;
 						fullViewport.MinDepth = 0.0f;
 						fullViewport.MaxDepth = 1.0f;
 
 						// 使用正确的全屏viewport
-						return phookD3D11RSSetViewports(pContext, 1, &fullViewport);
+						SetScopeViewport(pContext, fullViewport);
+						return;
 					}
 				}
 			}
 		}
 
 		// 正常情况下透传调用
-		return phookD3D11RSSetViewports(pContext, NumViewports, pViewports);
+		phookD3D11RSSetViewports(pContext, NumViewports, pViewports);
+
+		// 区域限定渲染：scissor 跟随新的 viewport（半分辨率 RT 按比例缩放区域）
+		if (s_ScopeRegionScissorActive && ScopeCamera::IsRenderingForScope() && NumViewports > 0 && pViewports != nullptr) {
+			s_ScopeRegionViewport = pViewports[0];
+			ApplyScopeRegionScissor(pContext);
+		}
+	}
+
+	// 瞄具渲染期间提交 viewport（绕过 hook），区域 scissor 跟随
+	static void SetScopeViewport(ID3D11DeviceContext* pContext, const D3D11_VIEWPORT& viewport)
+	{
+		phookD3D11RSSetViewports(pContext, 1, &viewport);
+
+		if (s_ScopeRegionScissorActive) {
+			s_ScopeRegionViewport = viewport;
+			ApplyScopeRegionScissor(pContext);
+		}
+	}
+
+	// 区域 scissor 与游戏自己的 scissor 求交后提交（绕过 hook）
+	static void ApplyScopeRegionScissor(ID3D11DeviceContext* pContext)
+	{
+		const D3D11_VIEWPORT& vp = s_ScopeRegionViewport;
+		const LONG vpLeft = (LONG)vp.TopLeftX;
+		const LONG vpTop = (LONG)vp.TopLeftY;
+		const UINT vpWidth = (UINT)vp.Width;
+		const UINT vpHeight = (UINT)vp.Height;
+
+		// 与屏幕比例不同的 viewport（阴影贴图等）使用整个 viewport
+		D3D11_RECT regionRect;
+		RenderUtilities::GetScopeRegionRect(vpWidth, vpHeight, regionRect);
+		const ScopeRegion::PixelRect region{ (uint32_t)regionRect.left, (uint32_t)regionRect.top, (uint32_t)regionRect.right, (uint32_t)regionRect.bottom };
+		const ScopeRegion::ScissorRect gameScissor{ s_ScopeGameScissorRect.left, s_ScopeGameScissorRect.top,
+			s_ScopeGameScissorRect.right, s_ScopeGameScissorRect.bottom };
+		const ScopeRegion::ScissorRect scissor = ScopeRegion::ViewportScissor(region, vpLeft, vpTop,
+			s_ScopeGameScissorEnabled ? &gameScissor : nullptr);
+
+		const D3D11_RECT rect = { scissor.left, scissor.top, scissor.right, scissor.bottom };
+		phookD3D11RSSetScissorRects(pContext, 1, &rect);
+	}
+
+	// 返回 scissor 已开启的等价 RS 状态（D3DStateCache 持有）
+	static ID3D11RasterizerState* GetScissorEnabledState(ID3D11DeviceContext* pContext, ID3D11RasterizerState* pState, bool& gameScissorEnabled)
+	{
+		D3D11_RASTERIZER_DESC desc;
+		if (pState) {
+			pState->GetDesc(&desc);
+		} else {
+			// nullptr 表示 D3D11 默认光栅化状态
+			desc.FillMode = D3D11_FILL_SOLID;
+			desc.CullMode = D3D11_CULL_BACK;
+			desc.FrontCounterClockwise = FALSE;
+			desc.DepthBias = 0;
+			desc.DepthBiasClamp = 0.0f;
+			desc.SlopeScaledDepthBias = 0.0f;
+			desc.DepthClipEnable = TRUE;
+			desc.ScissorEnable = FALSE;
+			desc.MultisampleEnable = FALSE;
+			desc.AntialiasedLineEnable = FALSE;
+		}
+
+		gameScissorEnabled = desc.ScissorEnable != FALSE;
+		if (gameScissorEnabled) {
+			return pState;
+		}
+
+		Microsoft::WRL::ComPtr<ID3D11Device> device;
+		pContext->GetDevice(&device);
+		desc.ScissorEnable = TRUE;
+		return D3DStateCache::GetSingleton()->GetRasterizerState(device.Get(), desc);
+	}
+
+	void WINAPI D3DHooks::hkRSSetState(ID3D11DeviceContext* pContext, ID3D11RasterizerState* pRasterizerState)
+	{
+		if (s_ScopeRegionScissorActive && ScopeCamera::IsRenderingForScope()) {
+			s_ScopeGameRasterizerState = pRasterizerState;
+			ID3D11RasterizerState* scissorState = GetScissorEnabledState(pContext, pRasterizerState, s_ScopeGameScissorEnabled);
+			if (scissorState) {
+				phookD3D11RSSetState(pContext, scissorState);
+				ApplyScopeRegionScissor(pContext);
+				return;
+			}
+		}
+
+		phookD3D11RSSetState(pContext, pRasterizerState);
+	}
+
+	void WINAPI D3DHooks::hkRSSetScissorRects(ID3D11DeviceContext* pContext, UINT NumRects, const D3D11_RECT* pRects)
+	{
+		if (s_ScopeRegionScissorActive && ScopeCamera::IsRenderingForScope()) {
+			// 记录游戏的 scissor，实际提交的是与区域的交集
+			if (NumRects > 0 && pRects != nullptr) {
+				s_ScopeGameScissorRect = pRects[0];
+			}
+			ApplyScopeRegionScissor(pContext);
+			return;
+		}
+
+		phookD3D11RSSetScissorRects(pContext, NumRects, pRects);
+	}
+
+	// 写入跟踪只在第二次渲染期间（RenderTargetMerger 备份到合并之间）、且仅限立即上下文
+	static bool IsRecordingScopeWrites(ID3D11DeviceContext* pContext)
+	{
+		return RenderTargetMerger::GetInstance().IsRecordingWrites() &&
+		       pContext->GetType() == D3D11_DEVICE_CONTEXT_IMMEDIATE;
+	}
+
+	static void NotifyViewWrite(ID3D11DeviceContext* pContext, ID3D11View* pView)
+	{
+		if (!pView) return;
+		Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+		pView->GetResource(&resource);
+		RenderTargetMerger::GetInstance().NotifyScopeWrite(pContext, resource.Get());
+	}
+
+	void WINAPI D3DHooks::hkOMSetRenderTargets(ID3D11DeviceContext* pContext, UINT NumViews, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView)
+	{
+		if (ppRenderTargetViews && IsRecordingScopeWrites(pContext)) {
+			for (UINT i = 0; i < NumViews; ++i) {
+				NotifyViewWrite(pContext, ppRenderTargetViews[i]);
+			}
+		}
+		phookD3D11OMSetRenderTargets(pContext, NumViews, ppRenderTargetViews, pDepthStencilView);
+	}
+
+	void WINAPI D3DHooks::hkOMSetRenderTargetsAndUnorderedAccessViews(ID3D11DeviceContext* pContext, UINT NumRTVs, ID3D11RenderTargetView* const* ppRenderTargetViews,
+		ID3D11DepthStencilView* pDepthStencilView, UINT UAVStartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts)
+	{
+		if (IsRecordingScopeWrites(pContext)) {
+			if (ppRenderTargetViews && NumRTVs != D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL) {
+				for (UINT i = 0; i < NumRTVs; ++i) {
+					NotifyViewWrite(pContext, ppRenderTargetViews[i]);
+				}
+			}
+			if (ppUnorderedAccessViews && NumUAVs != D3D11_KEEP_UNORDERED_ACCESS_VIEWS) {
+				for (UINT i = 0; i < NumUAVs; ++i) {
+					NotifyViewWrite(pContext, ppUnorderedAccessViews[i]);
+				}
+			}
+		}
+		phookD3D11OMSetRenderTargetsAndUnorderedAccessViews(pContext, NumRTVs, ppRenderTargetViews, pDepthStencilView,
+			UAVStartSlot, NumUAVs, ppUnorderedAccessViews, pUAVInitialCounts);
+	}
+
+	void WINAPI D3DHooks::hkCopySubresourceRegion(ID3D11DeviceContext* pContext, ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT DstZ,
+		ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox)
+	{
+		if (IsRecordingScopeWrites(pContext)) {
+			RenderTargetMerger::GetInstance().NotifyScopeWrite(pContext, pDstResource);
+		}
+		phookD3D11CopySubresourceRegion(pContext, pDstResource, DstSubresource, DstX, DstY, DstZ, pSrcResource, SrcSubresource, pSrcBox);
+	}
+
+	void WINAPI D3DHooks::hkCopyResource(ID3D11DeviceContext* pContext, ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource)
+	{
+		if (IsRecordingScopeWrites(pContext)) {
+			RenderTargetMerger::GetInstance().NotifyScopeWrite(pContext, pDstResource);
+		}
+		phookD3D11CopyResource(pContext, pDstResource, pSrcResource);
+	}
+
+	void WINAPI D3DHooks::hkClearUnorderedAccessViewUint(ID3D11DeviceContext* pContext, ID3D11UnorderedAccessView* pUnorderedAccessView, const UINT Values[4])
+	{
+		if (IsRecordingScopeWrites(pContext)) {
+			NotifyViewWrite(pContext, pUnorderedAccessView);
+		}
+		phookD3D11ClearUnorderedAccessViewUint(pContext, pUnorderedAccessView, Values);
+	}
+
+	void WINAPI D3DHooks::hkClearUnorderedAccessViewFloat(ID3D11DeviceContext* pContext, ID3D11UnorderedAccessView* pUnorderedAccessView, const FLOAT Values[4])
+	{
+		if (IsRecordingScopeWrites(pContext)) {
+			NotifyViewWrite(pContext, pUnorderedAccessView);
+		}
+		phookD3D11ClearUnorderedAccessViewFloat(pContext, pUnorderedAccessView, Values);
+	}
+
+	void WINAPI D3DHooks::hkCSSetUnorderedAccessViews(ID3D11DeviceContext* pContext, UINT StartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts)
+	{
+		if (ppUnorderedAccessViews && IsRecordingScopeWrites(pContext)) {
+			for (UINT i = 0; i < NumUAVs; ++i) {
+				NotifyViewWrite(pContext, ppUnorderedAccessViews[i]);
+			}
+		}
+		phookD3D11CSSetUnorderedAccessViews(pContext, StartSlot, NumUAVs, ppUnorderedAccessViews, pUAVInitialCounts);
+	}
+
+	void WINAPI D3DHooks::hkClearRenderTargetView(ID3D11DeviceContext* pContext, ID3D11RenderTargetView* pRenderTargetView, const FLOAT ColorRGBA[4])
+	{
+		if (IsRecordingScopeWrites(pContext)) {
+			NotifyViewWrite(pContext, pRenderTargetView);
+		}
+
+		// 清除不受 scissor 影响，区域限定渲染时改用 ClearView 只清除区域
+		if (s_ScopeRegionScissorActive && ScopeCamera::IsRenderingForScope()) {
+			if (RenderUtilities::ClearRenderTargetScopeRegion(pContext, pRenderTargetView, ColorRGBA)) {
+				return;
+			}
+		}
+
+		phookD3D11ClearRenderTargetView(pContext, pRenderTargetView, ColorRGBA);
+	}
+
+	void D3DHooks::BeginScopeRegionScissor(ID3D11DeviceContext* pContext)
+	{
+		if (!pContext || !RenderUtilities::IsScopeRegionActive() || !phookD3D11RSSetState || !phookD3D11RSSetScissorRects) {
+			return;
+		}
+
+		// 当前绑定的状态即游戏状态，替换为开启 scissor 的版本
+		s_ScopeGameRasterizerState.Reset();
+		pContext->RSGetState(s_ScopeGameRasterizerState.GetAddressOf());
+
+		UINT numRects = 1;
+		pContext->RSGetScissorRects(&numRects, &s_ScopeGameScissorRect);
+
+		UINT numViewports = 1;
+		pContext->RSGetViewports(&numViewports, &s_ScopeRegionViewport);
+		if (numViewports == 0) {
+			return;
+		}
+
+		ID3D11RasterizerState* scissorState = GetScissorEnabledState(pContext, s_ScopeGameRasterizerState.Get(), s_ScopeGameScissorEnabled);
+		if (!scissorState) {
+			return;
+		}
+
+		s_ScopeRegionScissorActive = true;
+		phookD3D11RSSetState(pContext, scissorState);
+		ApplyScopeRegionScissor(pContext);
+	}
+
+	void D3DHooks::EndScopeRegionScissor(ID3D11DeviceContext* pContext)
+	{
+		if (!s_ScopeRegionScissorActive) {
+			return;
+		}
+		s_ScopeRegionScissorActive = false;
+
+		// 恢复游戏最后请求的 RS 状态和 scissor
+		if (pContext) {
+			phookD3D11RSSetState(pContext, s_ScopeGameRasterizerState.Get());
+			phookD3D11RSSetScissorRects(pContext, 1, &s_ScopeGameScissorRect);
+		}
+		s_ScopeGameRasterizerState.Reset();
 	}
 
 	void D3DHooks::ProcessGamepadFOVInput()
@@ -1425,22 +1727,33 @@ namespace ThroughScope {
 		pContext->VSGetConstantBuffers(0, VSStateCache::MAX_CONSTANT_BUFFERS,
 			reinterpret_cast<ID3D11Buffer**>(s_CachedVSState.constantBuffers));
 
-		// 为每个绑定的常量缓冲区创建副本并复制数据
+		// 为每个绑定的常量缓冲区准备副本并复制数据
+		// 副本缓冲区跨帧复用，只有尺寸变化时才重新创建（避免每帧 CreateBuffer）
+		static Microsoft::WRL::ComPtr<ID3D11Buffer> s_ConstantBufferCopies[VSStateCache::MAX_CONSTANT_BUFFERS];
 		for (UINT i = 0; i < VSStateCache::MAX_CONSTANT_BUFFERS; ++i) {
 			if (s_CachedVSState.constantBuffers[i].Get()) {
 				// 获取原始缓冲区描述
 				D3D11_BUFFER_DESC originalDesc;
 				s_CachedVSState.constantBuffers[i]->GetDesc(&originalDesc);
 
-				// 创建可读的副本缓冲区
-				D3D11_BUFFER_DESC copyDesc = originalDesc;
-				copyDesc.Usage = D3D11_USAGE_DEFAULT;
-				copyDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-				copyDesc.CPUAccessFlags = 0;
-				copyDesc.MiscFlags = 0;
+				HRESULT hr = S_OK;
+				D3D11_BUFFER_DESC existingDesc = {};
+				if (s_ConstantBufferCopies[i]) {
+					s_ConstantBufferCopies[i]->GetDesc(&existingDesc);
+				}
 
-				HRESULT hr = device->CreateBuffer(&copyDesc, nullptr,
-					s_CachedVSState.copiedConstantBuffers[i].GetAddressOf());
+				if (!s_ConstantBufferCopies[i] || existingDesc.ByteWidth != originalDesc.ByteWidth) {
+					// 创建可读的副本缓冲区
+					D3D11_BUFFER_DESC copyDesc = originalDesc;
+					copyDesc.Usage = D3D11_USAGE_DEFAULT;
+					copyDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+					copyDesc.CPUAccessFlags = 0;
+					copyDesc.MiscFlags = 0;
+
+					s_ConstantBufferCopies[i].Reset();
+					hr = device->CreateBuffer(&copyDesc, nullptr, s_ConstantBufferCopies[i].GetAddressOf());
+				}
+				s_CachedVSState.copiedConstantBuffers[i] = s_ConstantBufferCopies[i];
 
 				if (SUCCEEDED(hr)) {
 					// 复制缓冲区内容
@@ -1461,74 +1774,46 @@ namespace ThroughScope {
 		pContext->VSGetSamplers(0, VSStateCache::MAX_SAMPLERS,
 			reinterpret_cast<ID3D11SamplerState**>(s_CachedVSState.samplers));
 
-		// [Plan A] 从 cb2 提取 WVP 矩阵，计算 scope quad 屏幕中心位置
-		// cb2 包含完整的 World-View-Projection 矩阵，用于将模型顶点变换到 clip space
-		if (s_CachedVSState.copiedConstantBuffers[2].Get()) {
-			// 创建 staging buffer 用于读取 cb2 数据
-			D3D11_BUFFER_DESC stagingDesc;
-			s_CachedVSState.copiedConstantBuffers[2]->GetDesc(&stagingDesc);
-			stagingDesc.Usage = D3D11_USAGE_STAGING;
-			stagingDesc.BindFlags = 0;
-			stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-			
-			Microsoft::WRL::ComPtr<ID3D11Buffer> stagingBuffer;
-			HRESULT hr = device->CreateBuffer(&stagingDesc, nullptr, stagingBuffer.GetAddressOf());
-			if (SUCCEEDED(hr)) {
-				pContext->CopyResource(stagingBuffer.Get(), s_CachedVSState.copiedConstantBuffers[2].Get());
-				
-				D3D11_MAPPED_SUBRESOURCE mapped;
-				hr = pContext->Map(stagingBuffer.Get(), 0, D3D11_MAP_READ, 0, &mapped);
-				if (SUCCEEDED(hr)) {
-					// cb2 structure (WVP matrix): 4 float4 rows
-					float* cb2Data = (float*)mapped.pData;
-					// Row-major WVP matrix: cb2[0-3]
-					float wvp00 = cb2Data[0], wvp01 = cb2Data[1], wvp02 = cb2Data[2], wvp03 = cb2Data[3];
-					float wvp10 = cb2Data[4], wvp11 = cb2Data[5], wvp12 = cb2Data[6], wvp13 = cb2Data[7];
-					float wvp20 = cb2Data[8], wvp21 = cb2Data[9], wvp22 = cb2Data[10], wvp23 = cb2Data[11];
-					float wvp30 = cb2Data[12], wvp31 = cb2Data[13], wvp32 = cb2Data[14], wvp33 = cb2Data[15];
-					
-					pContext->Unmap(stagingBuffer.Get(), 0);
-					
-					// 计算模型原点 (0,0,0,1) 在 clip space 的位置
-					// Shader: dp4 r1.x, cb2[0].xyzw, r0.xyzw  (r0 = vertex position, w=1)
-					// 对于原点 (0,0,0,1): clipPos = cb2[row] * (0,0,0,1) = cb2[row].w
-					float clipX = wvp03;  // cb2[0].w
-					float clipY = wvp13;  // cb2[1].w
-					float clipZ = wvp23;  // cb2[2].w
-					float clipW = wvp33;  // cb2[3].w
-					
-					if (fabsf(clipW) > 0.0001f) {
-						// 透视除法得到 NDC
-						float ndcX = clipX / clipW;
-						float ndcY = clipY / clipW;
-						
-						// 转换到 UV 空间 (0-1)
-						// D3D NDC: X [-1,1] left-to-right, Y [-1,1] bottom-to-top
-						float u = ndcX * 0.5f + 0.5f;
-						float v = -ndcY * 0.5f + 0.5f;  // Y flip for D3D
-						
-						// 估算 scope quad 半径：使用模型空间 (+1,0,0,1) 点计算
-						// 这假设 scope quad 模型在 X 方向有 1.0 单位的半径
-						float edgeClipX = wvp00 + wvp03;  // (1,0,0,1) dot cb2[0]
-						float edgeClipY = wvp10 + wvp13;  // (1,0,0,1) dot cb2[1]
-						float edgeClipW = wvp30 + wvp33;  // (1,0,0,1) dot cb2[3]
-						
-						if (fabsf(edgeClipW) > 0.0001f) {
-							float edgeNdcX = edgeClipX / edgeClipW;
-							float edgeU = edgeNdcX * 0.5f + 0.5f;
-							float radius = fabsf(edgeU - u);
-							
-							// 设置 scope quad 屏幕位置供 MV merge shader 使用
-							RenderUtilities::SetScopeQuadScreenPosition(u, v, radius);
-						}
-					}
-				}
-			}
-		}
+		// [Plan A] 计算 scope quad 屏幕位置（CPU 解析投影，不再回读 cb2）
+		UpdateScopeQuadScreenPosition();
 
 		device->Release();
 	}
 
+	void D3DHooks::UpdateScopeQuadScreenPosition()
+	{
+		// 使用 TTSEffectShape 的世界包围球和第一人称相机的 ViewProj 矩阵在 CPU 上求投影椭圆
+		// 与 shader 中 cb2 (WVP) 的变换等价，但不需要 GPU→CPU 回读
+		auto* scopeNode = ScopeCamera::s_CurrentScopeNode;
+		if (!scopeNode)
+			return;
+
+		auto* effectShape = scopeNode->GetObjectByName("TTSEffectShape");
+		if (!effectShape)
+			return;
+
+		// scope quad 属于第一人称模型，由第一人称相机绘制
+		RE::NiCamera* camera = *ptr_DrawWorld1stCamera;
+		if (!camera)
+			camera = *ptr_DrawWorldCamera;
+		if (!camera)
+			return;
+
+		ScopeProjection::Matrix4 viewProj;
+		memcpy(viewProj.m, camera->worldToCam, sizeof(viewProj.m));
+
+		// worldBound 是正方形面片的外接球（半径 = 半对角线），孔径是内切圆（半径 = 半边长）
+		const RE::NiBound& bound = effectShape->worldBound;
+		auto ellipse = ScopeProjection::ProjectScopeQuad(viewProj,
+			{ bound.center.x, bound.center.y, bound.center.z }, bound.fRadius);
+		if (!ellipse.valid)
+			return;  // 越过近平面等异常情况，保留上一帧的值
+
+		RenderUtilities::SetScopeQuadScreenEllipse(ellipse.centerU, ellipse.centerV,
+			ellipse.radiusU, ellipse.radiusV,
+			ellipse.minU, ellipse.minV, ellipse.maxU, ellipse.maxV);
+	}
+
 	void D3DHooks::RestoreIAState(ID3D11DeviceContext* pContext)
 	{
 		if (!s_HasCachedState)
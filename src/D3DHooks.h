@@ -59,6 +59,13 @@ namespace ThroughScope {
 			float vignetteSoftness = 0;
 			float eyeReliefDistance = 0;
 			int enableParallax = 0;
+			float scopeResolutionScale[2] = {1, 1};
+			int scopeUpsampleFilter = 0;
+			float reprojection[3][4] = {};
+			int enableReprojection = 0;
+			int useDistortionLUT = 0;
+			int useBlueNoise = 0;
+			float nightVisionNoiseOffset[2] = {0, 0};
 			
 			bool NeedsUpdate(const ScopeConstantBuffer& newData) const {
 				return screenWidth != newData.screenWidth ||
@@ -85,7 +92,14 @@ namespace ThroughScope {
 					   vignetteRadius != newData.vignetteRadius ||
 					   vignetteSoftness != newData.vignetteSoftness ||
 					   eyeReliefDistance != newData.eyeReliefDistance ||
-					   enableParallax != newData.enableParallax;
+					   enableParallax != newData.enableParallax ||
+					   memcmp(scopeResolutionScale, newData.scopeResolutionScale, sizeof(scopeResolutionScale)) != 0 ||
+					   scopeUpsampleFilter != newData.scopeUpsampleFilter ||
+					   enableReprojection != newData.enableReprojection ||
+					   useDistortionLUT != newData.useDistortionLUT ||
+					   useBlueNoise != newData.useBlueNoise ||
+					   memcmp(nightVisionNoiseOffset, newData.nightVisionNoiseOffset, sizeof(nightVisionNoiseOffset)) != 0 ||
+					   memcmp(reprojection, newData.reprojection, sizeof(reprojection)) != 0;
 			}
 			
 			void UpdateFrom(const ScopeConstantBuffer& newData) {
@@ -115,6 +129,13 @@ namespace ThroughScope {
 				vignetteSoftness = newData.vignetteSoftness;
 				eyeReliefDistance = newData.eyeReliefDistance;
 				enableParallax = newData.enableParallax;
+				memcpy(scopeResolutionScale, newData.scopeResolutionScale, sizeof(scopeResolutionScale));
+				scopeUpsampleFilter = newData.scopeUpsampleFilter;
+				enableReprojection = newData.enableReprojection;
+				useDistortionLUT = newData.useDistortionLUT;
+				useBlueNoise = newData.useBlueNoise;
+				memcpy(nightVisionNoiseOffset, newData.nightVisionNoiseOffset, sizeof(nightVisionNoiseOffset));
+				memcpy(reprojection, newData.reprojection, sizeof(reprojection));
 			}
 		};
 
@@ -130,11 +151,30 @@ namespace ThroughScope {
 		static HRESULT WINAPI hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags);
 		static LRESULT CALLBACK hkWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 		static void WINAPI hkRSSetViewports(ID3D11DeviceContext* pContext, UINT NumViewports, const D3D11_VIEWPORT* pViewports);
+		static void WINAPI hkRSSetState(ID3D11DeviceContext* pContext, ID3D11RasterizerState* pRasterizerState);
+		static void WINAPI hkRSSetScissorRects(ID3D11DeviceContext* pContext, UINT NumRects, const D3D11_RECT* pRects);
+		static void WINAPI hkClearRenderTargetView(ID3D11DeviceContext* pContext, ID3D11RenderTargetView* pRenderTargetView, const FLOAT ColorRGBA[4]);
+
+		// 写入跟踪：第二次渲染期间写入的 RT 报告给 RenderTargetMerger（决定哪些 RT 需要备份/合并）
+		static void WINAPI hkOMSetRenderTargets(ID3D11DeviceContext* pContext, UINT NumViews, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView);
+		static void WINAPI hkOMSetRenderTargetsAndUnorderedAccessViews(ID3D11DeviceContext* pContext, UINT NumRTVs, ID3D11RenderTargetView* const* ppRenderTargetViews,
+			ID3D11DepthStencilView* pDepthStencilView, UINT UAVStartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts);
+		static void WINAPI hkCopySubresourceRegion(ID3D11DeviceContext* pContext, ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT DstZ,
+			ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox);
+		static void WINAPI hkCopyResource(ID3D11DeviceContext* pContext, ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource);
+		static void WINAPI hkClearUnorderedAccessViewUint(ID3D11DeviceContext* pContext, ID3D11UnorderedAccessView* pUnorderedAccessView, const UINT Values[4]);
+		static void WINAPI hkClearUnorderedAccessViewFloat(ID3D11DeviceContext* pContext, ID3D11UnorderedAccessView* pUnorderedAccessView, const FLOAT Values[4]);
+		static void WINAPI hkCSSetUnorderedAccessViews(ID3D11DeviceContext* pContext, UINT StartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews, const UINT* pUAVInitialCounts);
+
+		// 区域限定的第二次渲染：强制开启 scissor，把游戏的绘制/清除限制在瞄具区域内
+		// 在 ScopeCamera::SetRenderingForScope(true/false) 之间调用，仅当 RenderUtilities 的 scope region 激活时生效
+		static void BeginScopeRegionScissor(ID3D11DeviceContext* pContext);
+		static void EndScopeRegionScissor(ID3D11DeviceContext* pContext);
 
 		ID3D11DeviceContext* GetContext();
 		ID3D11Device* GetDevice();
 
-        static bool IsScopeQuadBeingDrawn(ID3D11DeviceContext* pContext, UINT IndexCount);
+        static bool IsScopeQuadBeingDrawn(ID3D11DeviceContext* pContext, UINT IndexCount, UINT StartIndexLocation, INT BaseVertexLocation);
         static bool IsScopeQuadBeingDrawnShape(ID3D11DeviceContext* pContext, UINT IndexCount);
 		static BOOL __stdcall ClipCursorHook(RECT* lpRect);
 
@@ -192,6 +232,14 @@ namespace ThroughScope {
 		static float GetSphericalDistortionCenterY() { return s_SphericalDistortionCenterY; }
 		static bool GetEnableSphericalDistortion() { return s_EnableSphericalDistortion != 0; }
 		static bool GetEnableChromaticAberration() { return s_EnableChromaticAberration != 0; }
+		// 上次绘制使用的着色器变体功能位（ScopeShaderVariants::Feature）
+		static uint32_t GetScopeShaderFeatures() { return s_ScopeShaderFeatures; }
+
+		// 动态分辨率放大滤波：1 = 双线性, 2 = Catmull-Rom（未缩放时 shader 不使用）
+		static void SetScopeUpsampleFilter(int filter) {
+			s_ScopeUpsampleFilter = std::clamp(filter, 1, 2);
+		}
+		static int GetScopeUpsampleFilter() { return s_ScopeUpsampleFilter; }
 
 		// 视差参数的Getter和Setter函数
 		static float GetParallaxStrength() { return s_ParallaxStrength; }
@@ -239,6 +287,7 @@ namespace ThroughScope {
 	private:
 		struct BufferInfo
 		{
+			ID3D11Buffer* buffer = nullptr;  // 非持有指针，仅用于标识
 			UINT stride;
 			UINT offset;
 			D3D11_BUFFER_DESC desc;
@@ -259,7 +308,6 @@ namespace ThroughScope {
 		static OMStateCache s_CachedOMState;
 		static bool s_HasCachedState;
 		static CachedScopeConstantBuffer s_CachedConstantBufferData; // 缓存的常量缓冲区数据
-		static Microsoft::WRL::ComPtr<ID3D11Buffer> s_StagingBuffer;
 	private:
 		// 新的视差参数
 		static float s_ParallaxStrength;
@@ -297,6 +345,9 @@ namespace ThroughScope {
 		static float s_SphericalDistortionCenterY;
 		static int s_EnableSphericalDistortion;
 		static int s_EnableChromaticAberration;
+		static uint32_t s_ScopeShaderFeatures;
+		static DistortionLUT s_DistortionLUT;  // 球形畸变/色散系数表（CPU 端）
+		static int s_ScopeUpsampleFilter;
 		
 	public:
 
@@ -334,6 +385,7 @@ namespace ThroughScope {
 		// 添加缓存和恢复方法
 		static void CacheIAState(ID3D11DeviceContext* pContext);
 		static void CacheVSState(ID3D11DeviceContext* pContext);
+		static void UpdateScopeQuadScreenPosition();  // CPU 解析投影 scope quad 屏幕椭圆
 		static void CacheRSState(ID3D11DeviceContext* pContext);
 		static void CacheOMState(ID3D11DeviceContext* pContext);
 		static void RestoreIAState(ID3D11DeviceContext* pContext);
@@ -343,14 +395,14 @@ namespace ThroughScope {
 		static void CacheAllStates();
 		static void RestoreAllCachedStates();
 		static bool LoadAimTexture(const std::string& path);
-		static ID3D11ShaderResourceView* LoadAimSRV(const std::string& path);
 		static void SetSecondRenderTargetAsActive();
     private:
 		static bool IsTargetDrawCall(const BufferInfo& vertexInfo, const BufferInfo& indexInfo, UINT indexCount);
 		static bool IsTargetDrawCall(std::vector<BufferInfo> vertexInfos, const BufferInfo& indexInfo, UINT indexCount);
 		static UINT GetVertexBuffersInfo(ID3D11DeviceContext* pContext, std::vector<BufferInfo>& outInfos, UINT maxSlotsToCheck = D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT);
 		static bool GetIndexBufferInfo(ID3D11DeviceContext* pContext, BufferInfo& outInfo);
-		static bool HasTTSMarkerUV(ID3D11DeviceContext* pContext, UINT stride, UINT offset);  // 检查顶点缓冲区是否有 TTS 标记 UV
+		static bool ClassifyScopeQuadDraw(ID3D11DeviceContext* pContext, BufferInfo& vertexInfo, BufferInfo& indexInfo, UINT indexCount, UINT startIndexLocation, INT baseVertexLocation);  // 判定缓存未命中时的完整检测
+		static bool HasTTSMarkerUV(const BufferInfo& vertexInfo, UINT indexCount, UINT startIndexLocation, INT baseVertexLocation);  // 检查该次绘制是否为已登记的 TTS 标记几何体
 
 		static void ProcessGamepadFOVInput();
 		static void ProcessMouseWheelFOVInput(short wheelDelta);
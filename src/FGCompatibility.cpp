@@ -138,6 +138,31 @@ namespace FGCompatibility
             }
         }
 
+        D3D11_BUFFER_DESC cbDesc = {};
+        cbDesc.ByteWidth = sizeof(AnalyticScopeMask::Constants);
+        cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+        cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        HRESULT hr = device->CreateBuffer(&cbDesc, nullptr, g_ScopeMaskConstantBuffer.ReleaseAndGetAddressOf());
+        if (FAILED(hr)) {
+            logger::error("[FGCompat] Failed to create mask constant buffer: {:X}", hr);
+            return false;
+        }
+
+        // DispatchIndirect 参数（tile 数由 CPU 每帧写入），失败时只使用全屏 dispatch
+        D3D11_BUFFER_DESC argsDesc = {};
+        argsDesc.ByteWidth = 3 * sizeof(UINT);
+        argsDesc.Usage = D3D11_USAGE_DEFAULT;
+        argsDesc.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+
+        const UINT initialArgs[3] = { 0, 1, 1 };
+        D3D11_SUBRESOURCE_DATA argsData = { initialArgs, 0, 0 };
+        hr = device->CreateBuffer(&argsDesc, &argsData, g_MaskTileDispatchArgs.ReleaseAndGetAddressOf());
+        if (FAILED(hr)) {
+            logger::warn("[FGCompat] Failed to create mask dispatch args buffer: {:X}, tile dispatch disabled", hr);
+        }
+
         // 编译 compute shader
         if (!CompileApplyMaskShader(device)) {
             logger::warn("[FGCompat] Failed to compile mask shader, will use simple copy fallback");
@@ -267,6 +292,13 @@ namespace FGCompatibility
             g_InterpolationMaskSRV[i].Reset();
             g_InterpolationMaskRTV[i].Reset();
         }
+        g_ScopeMaskConstantBuffer.Reset();
+        g_ScopeMask = {};
+        g_MaskTileList.clear();
+        g_MaskTileSRV.Reset();
+        g_MaskTileBuffer.Reset();
+        g_MaskTileCapacity = 0;
+        g_MaskTileDispatchArgs.Reset();
         g_ApplyMaskToMVCS.Reset();
         g_MaskResourcesCreated = false;
 
@@ -298,23 +330,120 @@ namespace FGCompatibility
         return frameIndex;
     }
 
-    ID3D11RenderTargetView* GetMaskRTV()
+    ID3D11RenderTargetView* GetFallbackMaskRTV(ID3D11DeviceContext* context)
     {
+        if (!context) return nullptr;
         if (!g_MaskResourcesCreated.load()) return nullptr;
 
+        // 只有投影无效的帧才清除并绘制遮罩纹理
         int frameIndex = GetFrameIndex();
+
+        FLOAT clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        context->ClearRenderTargetView(g_InterpolationMaskRTV[frameIndex].Get(), clearColor);
+        g_ScopeMask.MarkCurrentTextureDrawn();
         return g_InterpolationMaskRTV[frameIndex].Get();
     }
 
-    void ClearMask(ID3D11DeviceContext* context)
+    void BeginMaskFrame()
     {
-        if (!context) return;
-        if (!g_MaskResourcesCreated.load()) return;
+        g_ScopeMask.BeginFrame();
+    }
 
-        int frameIndex = GetFrameIndex();
-        
-        FLOAT clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-        context->ClearRenderTargetView(g_InterpolationMaskRTV[frameIndex].Get(), clearColor);
+    void SetScopeEllipse(const AnalyticScopeMask::Ellipse& ellipse)
+    {
+        g_ScopeMask.SetCurrentAperture(ellipse);
+    }
+
+    // tile 列表缓冲区按 2 的幂增长，最多 65535 项（单维 dispatch 的 group 上限）
+    static bool EnsureMaskTileCapacity(ID3D11DeviceContext* context, uint32_t tileCount)
+    {
+        if (tileCount <= g_MaskTileCapacity) return true;
+
+        ID3D11Device* device = nullptr;
+        context->GetDevice(&device);
+        if (!device) return false;
+
+        uint32_t capacity = 1024;
+        while (capacity < tileCount) capacity *= 2;
+        capacity = (std::min)(capacity, uint32_t(D3D11_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION));
+
+        D3D11_BUFFER_DESC bufferDesc = {};
+        bufferDesc.ByteWidth = capacity * sizeof(uint32_t);
+        bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+        bufferDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+        bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        bufferDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        bufferDesc.StructureByteStride = sizeof(uint32_t);
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        srvDesc.Buffer.FirstElement = 0;
+        srvDesc.Buffer.NumElements = capacity;
+
+        HRESULT hr = device->CreateBuffer(&bufferDesc, nullptr, g_MaskTileBuffer.ReleaseAndGetAddressOf());
+        if (SUCCEEDED(hr)) {
+            hr = device->CreateShaderResourceView(g_MaskTileBuffer.Get(), &srvDesc, g_MaskTileSRV.ReleaseAndGetAddressOf());
+        }
+        device->Release();
+
+        if (FAILED(hr)) {
+            logger::error("[FGCompat] Failed to create mask tile buffer ({} tiles): {:X}", capacity, hr);
+            g_MaskTileSRV.Reset();
+            g_MaskTileBuffer.Reset();
+            g_MaskTileCapacity = 0;
+            return false;
+        }
+
+        g_MaskTileCapacity = capacity;
+        return true;
+    }
+
+    // 准备 tile 模式：分类 tile、上传 tile 列表和 DispatchIndirect 参数，并设置 constants.useTileList
+    // 返回 false 时使用全屏 dispatch：RT_29 无法直接复制到共享缓冲区（尺寸/格式不同），
+    // 某一帧使用遮罩纹理（CPU 投影无效），或瞄具覆盖超过一半的 tile（此时逐 tile 处理不比全屏便宜）
+    static bool PrepareMaskTiles(ID3D11DeviceContext* context, ID3D11Texture2D* sharedBuffer, ID3D11Texture2D* mvTexture,
+        AnalyticScopeMask::Constants& constants, uint32_t width, uint32_t height)
+    {
+        if (!g_MaskTileDispatchArgs || width == 0 || height == 0) return false;
+
+        D3D11_TEXTURE2D_DESC sharedDesc, mvDesc;
+        sharedBuffer->GetDesc(&sharedDesc);
+        mvTexture->GetDesc(&mvDesc);
+        if (sharedDesc.Width != width || sharedDesc.Height != height ||
+            mvDesc.Width != width || mvDesc.Height != height ||
+            sharedDesc.Format != mvDesc.Format ||
+            sharedDesc.MipLevels != mvDesc.MipLevels ||
+            sharedDesc.ArraySize != mvDesc.ArraySize ||
+            sharedDesc.SampleDesc.Count != mvDesc.SampleDesc.Count) {
+            return false;
+        }
+
+        constexpr uint32_t tileSize = AnalyticScopeMask::kTileSize;
+        const uint32_t totalTiles = ((width + tileSize - 1) / tileSize) * ((height + tileSize - 1) / tileSize);
+        if (!AnalyticScopeMask::ClassifyTiles(constants, width, height, g_MaskTileList)) return false;
+        const uint32_t tileCount = static_cast<uint32_t>(g_MaskTileList.size());
+
+        g_LastMaskTileCount = tileCount;
+        g_LastMaskTotalTiles = totalTiles;
+        if (tileCount > (std::min)(totalTiles / 2, uint32_t(D3D11_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION))) {
+            return false;
+        }
+
+        if (tileCount > 0) {
+            if (!EnsureMaskTileCapacity(context, tileCount)) return false;
+
+            D3D11_MAPPED_SUBRESOURCE mapped;
+            if (FAILED(context->Map(g_MaskTileBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) return false;
+            memcpy(mapped.pData, g_MaskTileList.data(), tileCount * sizeof(uint32_t));
+            context->Unmap(g_MaskTileBuffer.Get(), 0);
+
+            const UINT args[3] = { tileCount, 1, 1 };
+            context->UpdateSubresource(g_MaskTileDispatchArgs.Get(), 0, nullptr, args, 0, 0);
+        }
+
+        constants.useTileList = 1;
+        return true;
     }
 
     void ExecuteMVCopyWithMask(ID3D11DeviceContext* context)
@@ -393,6 +522,9 @@ namespace FGCompatibility
             // ========== 使用遮罩处理 MV ==========
             bool useMaskProcessing = g_MaskResourcesCreated.load() && 
                                      g_ApplyMaskToMVCS && 
+                                     g_ScopeMaskConstantBuffer &&
+                                     g_InterpolationMaskSRV[frameIndex] &&
+                                     g_InterpolationMaskSRV[prevFrameIndex] &&
                                      sharedUAV;
 
             if (useMaskProcessing) {
@@ -406,13 +538,28 @@ namespace FGCompatibility
                 uint32_t dispatchX = (uint32_t)std::ceil(float(width) / 8.0f);
                 uint32_t dispatchY = (uint32_t)std::ceil(float(height) / 8.0f);
 
-                // 设置 SRV: MV input, current mask, previous mask
-                ID3D11ShaderResourceView* views[3] = {
+                // 更新遮罩常量：当前帧和上一帧的瞄具椭圆（投影无效的帧改用遮罩纹理）
+                AnalyticScopeMask::Constants maskConstants = g_ScopeMask.BuildConstants(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+                const bool useTiles = PrepareMaskTiles(context, sharedBuffer, mvTexture, maskConstants,
+                    static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+                g_LastMaskTiled = useTiles;
+
+                D3D11_MAPPED_SUBRESOURCE mapped;
+                if (SUCCEEDED(context->Map(g_ScopeMaskConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+                    memcpy(mapped.pData, &maskConstants, sizeof(maskConstants));
+                    context->Unmap(g_ScopeMaskConstantBuffer.Get(), 0);
+                }
+                ID3D11Buffer* constantBuffers[1] = { g_ScopeMaskConstantBuffer.Get() };
+                context->CSSetConstantBuffers(0, 1, constantBuffers);
+
+                // 设置 SRV: MV input, current mask, previous mask, tile list
+                ID3D11ShaderResourceView* views[4] = {
                     mvSRV,
-                    g_InterpolationMaskSRV[frameIndex].Get(),      // 当前帧遮罩
-                    g_InterpolationMaskSRV[prevFrameIndex].Get()   // 上一帧遮罩
+                    g_InterpolationMaskSRV[frameIndex].Get(),      // 当前帧回退遮罩（只在该帧投影无效时读取）
+                    g_InterpolationMaskSRV[prevFrameIndex].Get(),  // 上一帧回退遮罩
+                    useTiles ? g_MaskTileSRV.Get() : nullptr
                 };
-                context->CSSetShaderResources(0, 3, views);
+                context->CSSetShaderResources(0, 4, views);
 
                 // 设置 UAV: 共享 MV buffer
                 ID3D11UnorderedAccessView* uavs[1] = { sharedUAV };
@@ -420,11 +567,21 @@ namespace FGCompatibility
 
                 // 执行 compute shader
                 context->CSSetShader(g_ApplyMaskToMVCS.Get(), nullptr, 0);
-                context->Dispatch(dispatchX, dispatchY, 1);
+                if (useTiles) {
+                    // tile 之外的像素在瞄具椭圆外，不会被遮罩，整体复制即可；CS 只覆盖写入瞄具所在的 tile
+                    context->CopyResource(sharedBuffer, mvTexture);
+                    if (g_LastMaskTileCount.load() > 0) {
+                        context->DispatchIndirect(g_MaskTileDispatchArgs.Get(), 0);
+                    }
+                } else {
+                    context->Dispatch(dispatchX, dispatchY, 1);
+                }
 
                 // 清理
-                ID3D11ShaderResourceView* nullViews[3] = { nullptr, nullptr, nullptr };
-                context->CSSetShaderResources(0, 3, nullViews);
+                ID3D11ShaderResourceView* nullViews[4] = { nullptr, nullptr, nullptr, nullptr };
+                context->CSSetShaderResources(0, 4, nullViews);
+                ID3D11Buffer* nullBuffers[1] = { nullptr };
+                context->CSSetConstantBuffers(0, 1, nullBuffers);
                 ID3D11UnorderedAccessView* nullUavs[1] = { nullptr };
                 context->CSSetUnorderedAccessViews(0, 1, nullUavs, nullptr);
                 context->CSSetShader(nullptr, nullptr, 0);
@@ -3,7 +3,9 @@
 #include <Windows.h>
 #include <d3d11.h>
 #include <atomic>
+#include <vector>
 #include <wrl/client.h>
+#include "rendering/AnalyticScopeMask.h"
 
 namespace ThroughScope
 {
@@ -18,8 +20,8 @@ namespace FGCompatibility
     //
     // 解决方案（侵入式 Hook + 自定义遮罩处理）：
     // 1. 修改 DrawWorld_Forward::thunk 中的 jz 指令为 jmp，跳过整个 MV/Depth 复制块
-    // 2. 创建我们自己的 interpolation mask 纹理（R8_UNORM）
-    // 3. 使用我们自己的 ApplyMaskToMVCS 计算着色器处理遮罩
+    // 2. CPU 投影有效时遮罩就是瞄具椭圆（常量缓冲区），ApplyMaskToMVCS 解析计算，只处理椭圆所在的 tile
+    // 3. 投影无效时回退到我们自己的 interpolation mask 纹理（R8_UNORM），由模板测试绘制写入瞄具区域
     // 4. 在遮罩区域内将 MV 设为 (0,0)，让 FG 从源帧复制而非插值
     //
     // 关键地址（fo4test 1.3.3 版本）：
@@ -77,10 +79,27 @@ namespace FGCompatibility
     inline bool g_WarnedException = false;
 
     // ========== 遮罩纹理资源 (我们自己创建，不依赖 fo4test) ==========
-    // 双缓冲遮罩纹理，用于双遮罩方法减少边缘伪影
+    // 双缓冲回退遮罩纹理，只在该帧 CPU 投影无效时清除、绘制和读取
     inline Microsoft::WRL::ComPtr<ID3D11Texture2D> g_InterpolationMask[2];
     inline Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> g_InterpolationMaskSRV[2];
     inline Microsoft::WRL::ComPtr<ID3D11RenderTargetView> g_InterpolationMaskRTV[2];
+
+    // 当前帧和上一帧的瞄具椭圆或回退遮罩纹理状态（AnalyticScopeMask），dispatch 前写入常量缓冲区
+    inline AnalyticScopeMask g_ScopeMask;
+    inline Microsoft::WRL::ComPtr<ID3D11Buffer> g_ScopeMaskConstantBuffer;
+
+    // 与瞄具椭圆相交的 8x8 tile 列表（AnalyticScopeMask::ClassifyTiles）
+    // RT_29 先整体 CopyResource 到共享缓冲区，CS 只通过 DispatchIndirect 处理这些 tile
+    inline std::vector<uint32_t> g_MaskTileList;
+    inline Microsoft::WRL::ComPtr<ID3D11Buffer> g_MaskTileBuffer;              // StructuredBuffer<uint> TileList (t3)
+    inline Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> g_MaskTileSRV;
+    inline uint32_t g_MaskTileCapacity = 0;
+    inline Microsoft::WRL::ComPtr<ID3D11Buffer> g_MaskTileDispatchArgs;        // DispatchIndirect 参数 { tileCount, 1, 1 }
+
+    // 调试统计：上一次 dispatch 的 tile 数 / 全屏 tile 数（g_LastMaskTiled = false 时为全屏 dispatch）
+    inline std::atomic<bool> g_LastMaskTiled = false;
+    inline std::atomic<uint32_t> g_LastMaskTileCount = 0;
+    inline std::atomic<uint32_t> g_LastMaskTotalTiles = 0;
     
     // ApplyMaskToMVCS 计算着色器（我们自己编译）
     inline Microsoft::WRL::ComPtr<ID3D11ComputeShader> g_ApplyMaskToMVCS;
@@ -104,7 +123,7 @@ namespace FGCompatibility
     void Shutdown();
 
     /**
-     * @brief 创建遮罩纹理资源
+     * @brief 创建遮罩资源（遮罩纹理、常量缓冲区、DispatchIndirect 参数缓冲区和计算着色器）
      * @param device D3D11 设备
      * @param width 纹理宽度
      * @param height 纹理高度
@@ -113,30 +132,40 @@ namespace FGCompatibility
     bool CreateMaskResources(ID3D11Device* device, uint32_t width, uint32_t height);
 
     /**
-     * @brief 获取当前帧的遮罩 RTV
-     * @return 遮罩 RTV，外部渲染白色 (1.0) 标记 scope 区域
+     * @brief 获取当前帧的回退遮罩 RTV（仅在本帧 CPU 投影无效时调用）
+     * @param context D3D11 设备上下文
+     * @return 已清除的遮罩 RTV，外部渲染白色 (1.0) 标记 scope 区域
      *
-     * 返回基于当前帧索引的遮罩 RTV。
+     * 清除基于当前帧索引的遮罩纹理并把它记为本帧遮罩。
      * 调用者应在 scope 区域渲染白色，然后调用 ExecuteMVCopyWithMask。
      */
-    ID3D11RenderTargetView* GetMaskRTV();
+    ID3D11RenderTargetView* GetFallbackMaskRTV(ID3D11DeviceContext* context);
 
     /**
-     * @brief 清除当前帧遮罩
-     * @param context D3D11 设备上下文
+     * @brief 开始新的遮罩帧
+     *
+     * 每帧开始时调用；上一帧的瞄具椭圆或回退遮罩成为"上一帧遮罩"，不清除任何纹理
+     */
+    void BeginMaskFrame();
+
+    /**
+     * @brief 设置本帧瞄具的屏幕椭圆（视口 UV），本帧遮罩即为该椭圆
      *
-     * 每帧开始时调用以清除遮罩
+     * 在 ExecuteMVCopyWithMask 之前调用；本帧 CPU 投影无效时不调用，改为绘制回退遮罩纹理（全屏 dispatch）
      */
-    void ClearMask(ID3D11DeviceContext* context);
+    void SetScopeEllipse(const AnalyticScopeMask::Ellipse& ellipse);
 
     /**
      * @brief 使用遮罩执行 MV 复制 (增强版)
      * @param context D3D11 设备上下文
      *
      * 使用双遮罩方法：
-     * 1. 结合当前帧和上一帧遮罩减少边缘伪影
+     * 1. 结合当前帧和上一帧遮罩减少边缘伪影（每帧为瞄具椭圆，投影无效的帧为回退遮罩纹理）
      * 2. 遮罩区域内的 MV 设为 (0,0)，让 FG 从源帧复制
      * 3. 复制处理后的 MV 到 fo4test 的共享缓冲区
+     *
+     * RT_29 与共享缓冲区尺寸/格式一致且两帧都没有使用遮罩纹理时整体复制，再只对瞄具所在的 tile 运行 CS；
+     * 否则（或瞄具覆盖超过一半的 tile）对全屏 dispatch
      */
     void ExecuteMVCopyWithMask(ID3D11DeviceContext* context);
 
@@ -2,39 +2,73 @@
 // Compute shader to apply interpolation mask to motion vectors
 // Pixels with mask > 0 will have their MV zeroed, causing Frame Generation
 // to copy from source frame rather than interpolate (eliminating ghosting)
+//
+// Each frame's mask is its scope aperture ellipse when the quad was projected on the CPU, evaluated
+// here without reading a texture; only a frame whose projection failed falls back to the mask
+// texture written by the stencil-tested draw (CPU reference: src/rendering/AnalyticScopeMask.cpp)
+//
+// Tile mode (useTileList = 1): the caller copies the whole MV buffer first and dispatches
+// one group per 8x8 tile in TileList (tiles touching the ellipses, AnalyticScopeMask::ClassifyTiles)
 
 // Input textures
 Texture2D<float2> MotionVectorInput : register(t0);  // RT_29 Motion Vectors (RG16F)
-Texture2D<float> CurrentMask : register(t1);         // Current frame mask (R8_UNORM)
-Texture2D<float> PreviousMask : register(t2);        // Previous frame mask (R8_UNORM)
+Texture2D<float> CurrentMask : register(t1);         // Current frame fallback mask (R8_UNORM)
+Texture2D<float> PreviousMask : register(t2);        // Previous frame fallback mask (R8_UNORM)
+StructuredBuffer<uint> TileList : register(t3);      // Tile column | (tile row << 16)
 
 // Output buffer
 RWTexture2D<float2> MotionVectorOutput : register(u0);  // Shared MV buffer
 
+cbuffer ScopeMaskConstants : register(b0)
+{
+    float4 currentEllipse;   // centerU, centerV, 1/radiusU, 1/radiusV (viewport UV)
+    float4 previousEllipse;
+    float2 invOutputSize;    // 1/width, 1/height
+    uint maskFlags;          // bit 0/1 = current/previous ellipse, bit 2/3 = current/previous fallback texture
+    uint useTileList;        // 1 = SV_GroupID.x indexes TileList, 0 = full-screen grid
+};
+
+bool insideEllipse(float4 ellipse, float2 uv)
+{
+    float2 d = (uv - ellipse.xy) * ellipse.zw;
+    return d.x * d.x + d.y * d.y <= 1.0f;
+}
+
 [numthreads(8, 8, 1)]
-void main(uint3 dispatchThreadId : SV_DispatchThreadID)
+void main(uint3 dispatchThreadId : SV_DispatchThreadID, uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
 {
     uint2 pixelCoord = dispatchThreadId.xy;
-    
+    if (useTileList != 0)
+    {
+        uint tile = TileList[groupId.x];
+        pixelCoord = uint2(tile & 0xFFFF, tile >> 16) * 8 + groupThreadId.xy;
+    }
+
     // Read motion vector from source
     float2 mv = MotionVectorInput[pixelCoord];
-    
-    // Read masks from both frames
+
     // Dual-mask approach: use OR of current and previous frame masks
     // This reduces edge artifacts at mask boundaries
-    float currentMaskValue = CurrentMask[pixelCoord];
-    float previousMaskValue = PreviousMask[pixelCoord];
-    
-    // If either mask has a value > 0, zero the motion vector
-    // This tells Frame Generation to copy this pixel directly instead of interpolating
-    float combinedMask = max(currentMaskValue, previousMaskValue);
-    
-    if (combinedMask > 0.0f)
+    // The flags are uniform, so the branches skip the texture fetches for analytic frames
+    float2 uv = (float2(pixelCoord) + 0.5f) * invOutputSize;
+    bool currentMasked = false;
+    [branch] if ((maskFlags & 1) != 0)
+        currentMasked = insideEllipse(currentEllipse, uv);
+    else if ((maskFlags & 4) != 0)
+        currentMasked = CurrentMask[pixelCoord] > 0.0f;
+    bool previousMasked = false;
+    [branch] if ((maskFlags & 2) != 0)
+        previousMasked = insideEllipse(previousEllipse, uv);
+    else if ((maskFlags & 8) != 0)
+        previousMasked = PreviousMask[pixelCoord] > 0.0f;
+
+    if (currentMasked || previousMasked)
     {
         // Zero motion vector for masked (scope) pixels
+        // This tells Frame Generation to copy this pixel directly instead of interpolating
         mv = float2(0.0f, 0.0f);
     }
-    
+
     // Write to shared output buffer
     MotionVectorOutput[pixelCoord] = mv;
 }
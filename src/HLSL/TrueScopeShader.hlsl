@@ -1,8 +1,13 @@
 Texture2D scopeTexture : register(t0);
 Texture2D reticleTexture : register(t1);
+// 径向畸变系数表（DistortionLUT）：u 对应 距离 / 畸变半径；rgb = 色散三通道系数 - 1，a = 单通道系数 - 1
+Texture2D distortionLUT : register(t2);
+// 夜视噪点：64x64 可平铺蓝噪声（tools/BlueNoiseGenerator 离线生成，R8_UNORM）
+Texture2D blueNoiseTexture : register(t3);
 
 
 SamplerState scopeSampler : register(s0);
+SamplerState lutSampler : register(s1);
 
             
 // Constants buffer containing screen resolution, camera position and scope position
@@ -16,7 +21,10 @@ cbuffer ScopeConstants : register(b0)
     // Viewport dimensions for DLSS/FSR3 upscaling
     float viewportWidth;
     float viewportHeight;
-    float3 padding_viewport;
+
+    // Dynamic-resolution scope pass: content occupies scopeResolutionScale of the viewport (top-left)
+    float2 scopeResolutionScale;
+    int scopeUpsampleFilter;        // 0 = 全分辨率, 1 = 双线性, 2 = Catmull-Rom
 
     float3 cameraPosition;
     float padding2; // 16-byte alignment
@@ -61,7 +69,7 @@ cbuffer ScopeConstants : register(b0)
     float parallaxFogRadius;           // 边缘渐变半径
     float parallaxMaxTravel;           // 最大移动距离
     float reticleParallaxStrength;     // 准星偏移强度
-    float _padding1;                   // 对齐填充
+    int useBlueNoise;                  // 1 = 噪点从 blueNoiseTexture 读取，0 = 正弦哈希
 
     // 球形畸变参数
     float sphericalDistortionStrength;  // 球形畸变强度 (0.0 = 无畸变, 正值 = 桶形畸变, 负值 = 枕形畸变)
@@ -72,8 +80,46 @@ cbuffer ScopeConstants : register(b0)
     int enableChromaticAberration;      // 是否启用色散效果 (0 = 禁用, 1 = 启用)
     float brightnessBoost;              // 亮度增强系数
     float ambientOffset;                // 环境光补偿
+
+    // 时域分摊：复用上一帧瞄具图像时，当前 NDC (x, y, 1) -> 上一帧齐次 NDC 的单应矩阵（行）
+    float4 reprojectionRow0;
+    float4 reprojectionRow1;
+    float4 reprojectionRow2;
+    int enableReprojection;
+    int useDistortionLUT;               // 1 = 畸变系数从 distortionLUT 采样，0 = 逐像素计算
+    float2 nightVisionNoiseOffset;      // 蓝噪声每帧的平铺偏移（纹素），让噪点随时间变化
 }
 
+// ============================================================================
+// 编译期变体（ScopeShaderVariants / scripts/compile_shader_variants.py）
+// 定义 TTS_SHADER_VARIANT 时各功能由 0/1 宏决定，关闭的代码路径不会编译进着色器；
+// 未定义时是通用版本，按常量缓冲区中的开关在运行时分支
+// ============================================================================
+#ifdef TTS_SHADER_VARIANT
+    #ifndef TTS_NIGHT_VISION
+        #define TTS_NIGHT_VISION 0
+    #endif
+    #ifndef TTS_PARALLAX
+        #define TTS_PARALLAX 0
+    #endif
+    #ifndef TTS_SPHERICAL_DISTORTION
+        #define TTS_SPHERICAL_DISTORTION 0
+    #endif
+    #ifndef TTS_CHROMATIC_ABERRATION
+        #define TTS_CHROMATIC_ABERRATION 0
+    #endif
+    #define USE_NIGHT_VISION (TTS_NIGHT_VISION != 0)
+    #define USE_PARALLAX (TTS_PARALLAX != 0)
+    #define USE_SPHERICAL_DISTORTION (TTS_SPHERICAL_DISTORTION != 0)
+    // 色散只在球形畸变之上生效
+    #define USE_CHROMATIC_ABERRATION (TTS_SPHERICAL_DISTORTION != 0 && TTS_CHROMATIC_ABERRATION != 0)
+#else
+    #define USE_NIGHT_VISION (enableNightVision != 0)
+    #define USE_PARALLAX (enableParallax != 0)
+    #define USE_SPHERICAL_DISTORTION (enableSphericalDistortion != 0)
+    #define USE_CHROMATIC_ABERRATION (enableSphericalDistortion != 0 && enableChromaticAberration != 0)
+#endif
+
             
 struct PS_INPUT
 {
@@ -262,8 +308,17 @@ float random(float2 st) {
 
 
 
+// 蓝噪声噪点（0-1）：每 cellSize 个像素共用一个纹素，整数偏移逐帧平移图案
+float sampleBlueNoise(float2 pixelPos, float cellSize)
+{
+    uint width, height;
+    blueNoiseTexture.GetDimensions(width, height);
+    uint2 texel = (uint2(pixelPos / cellSize) + uint2(nightVisionNoiseOffset)) % uint2(width, height);
+    return blueNoiseTexture.Load(int3(texel, 0)).r;
+}
+
 // 夜视效果处理
-float4 applyNightVision(float4 color, float2 texcoord)
+float4 applyNightVision(float4 color, float2 texcoord, float2 pixelPos)
 {
     // 转换为灰度
     float luminance = dot(color.rgb, float3(0.299, 0.587, 0.114));
@@ -271,9 +326,15 @@ float4 applyNightVision(float4 color, float2 texcoord)
     // 归一化亮度值
     luminance = saturate(luminance);
     
-    // 添加噪点
-    float2 noiseCoord = texcoord * nightVisionNoiseScale * 100.0;
-    float noise = (random(noiseCoord) - 0.5) * nightVisionNoiseAmount;
+    // 添加噪点（蓝噪声的颗粒大小 = 噪点缩放 * 20 像素，默认 0.05 即逐像素）
+    float noiseValue;
+    [branch] if (useBlueNoise != 0) {
+        noiseValue = sampleBlueNoise(pixelPos, max(nightVisionNoiseScale * 20.0, 1.0));
+    } else {
+        float2 noiseCoord = texcoord * nightVisionNoiseScale * 100.0;
+        noiseValue = random(noiseCoord);
+    }
+    float noise = (noiseValue - 0.5) * nightVisionNoiseAmount;
     
     // 应用绿色色调
     float3 nightVisionColor = float3(0.0, luminance * nightVisionGreenTint, luminance * 0.3);
@@ -291,6 +352,17 @@ float4 applyNightVision(float4 color, float2 texcoord)
 // 热成像效果处理
 
 
+// 距中心 distance 处的畸变系数（rgb = 色散三通道，a = 单通道）
+float4 sampleDistortionLUT(float distance)
+{
+    float lutWidth, lutHeight;
+    distortionLUT.GetDimensions(lutWidth, lutHeight);
+    float t = saturate(distance / max(sphericalDistortionRadius, 1e-5));
+    // 纹素 i 对应 t = i / (width - 1)
+    float u = (t * (lutWidth - 1.0) + 0.5) / lutWidth;
+    return distortionLUT.SampleLevel(lutSampler, float2(u, 0.5), 0) + 1.0;
+}
+
 // 球形畸变函数
 float2 applySphericalDistortion(float2 texcoord)
 {
@@ -304,14 +376,19 @@ float2 applySphericalDistortion(float2 texcoord)
     // 计算到中心的距离
     float distance = length(uv);
     
-    // 应用球形畸变
-    // 使用二次函数来模拟球形透镜的畸变效果
-    float distortionFactor = 1.0 + sphericalDistortionStrength * distance * distance;
-    
-    // 限制畸变作用的半径范围
-    // radiusMask: 0 在中心区域（应用完整畸变），1 在边缘外（无畸变）
-    float radiusMask = smoothstep(sphericalDistortionRadius * 0.8, sphericalDistortionRadius, distance);
-    distortionFactor = lerp(distortionFactor, 1.0, radiusMask);
+    float distortionFactor;
+    [branch] if (useDistortionLUT != 0) {
+        distortionFactor = sampleDistortionLUT(distance).a;
+    } else {
+        // 应用球形畸变
+        // 使用二次函数来模拟球形透镜的畸变效果
+        distortionFactor = 1.0 + sphericalDistortionStrength * distance * distance;
+
+        // 限制畸变作用的半径范围
+        // radiusMask: 0 在中心区域（应用完整畸变），1 在边缘外（无畸变）
+        float radiusMask = smoothstep(sphericalDistortionRadius * 0.8, sphericalDistortionRadius, distance);
+        distortionFactor = lerp(distortionFactor, 1.0, radiusMask);
+    }
     
     // 应用畸变
     uv *= distortionFactor;
@@ -323,6 +400,78 @@ float2 applySphericalDistortion(float2 texcoord)
     return uv + center;
 }
 
+// 动态分辨率：第二次渲染只写入纹理左上角 scopeResolutionScale 部分（0 视为未缩放）
+float2 getContentScale()
+{
+    return scopeResolutionScale.x > 0.0 ? scopeResolutionScale : float2(1.0, 1.0);
+}
+
+// 时域分摊：把当前帧的纹理坐标映射到上一次完整渲染的图像中（旋转/缩放补偿）
+float2 reprojectScopeUV(float2 uv)
+{
+    if (enableReprojection == 0) {
+        return uv;
+    }
+
+    float3 ndc = float3(uv.x * 2.0 - 1.0, 1.0 - uv.y * 2.0, 1.0);
+    float3 prev = float3(dot(reprojectionRow0.xyz, ndc), dot(reprojectionRow1.xyz, ndc), dot(reprojectionRow2.xyz, ndc));
+
+    // 位于上一帧相机后方时保持原坐标
+    if (prev.z <= 1e-5) {
+        return uv;
+    }
+
+    float2 prevNdc = prev.xy / prev.z;
+    return saturate(float2(prevNdc.x * 0.5 + 0.5, 0.5 - prevNdc.y * 0.5));
+}
+
+// Catmull-Rom 双三次采样，利用双线性过滤合并为 5 次采样（省略四角权重）
+float4 sampleCatmullRom(Texture2D tex, SamplerState samp, float2 uv, float2 texSize)
+{
+    float2 samplePos = uv * texSize;
+    float2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    float2 f = samplePos - texPos1;
+
+    float2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    float2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    float2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    float2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    float2 w12 = w1 + w2;
+    float2 texPos0 = (texPos1 - 1.0) / texSize;
+    float2 texPos3 = (texPos1 + 2.0) / texSize;
+    float2 texPos12 = (texPos1 + w2 / w12) / texSize;
+
+    float4 result = tex.SampleLevel(samp, float2(texPos12.x, texPos0.y), 0) * (w12.x * w0.y);
+    result += tex.SampleLevel(samp, float2(texPos0.x, texPos12.y), 0) * (w0.x * w12.y);
+    result += tex.SampleLevel(samp, texPos12, 0) * (w12.x * w12.y);
+    result += tex.SampleLevel(samp, float2(texPos3.x, texPos12.y), 0) * (w3.x * w12.y);
+    result += tex.SampleLevel(samp, float2(texPos12.x, texPos3.y), 0) * (w12.x * w3.y);
+
+    float weightSum = w12.x * w0.y + w0.x * w12.y + w12.x * w12.y + w3.x * w12.y + w12.x * w3.y;
+    return max(result / weightSum, 0.0);
+}
+
+// 采样瞄具纹理：缩放渲染时限制在有效内容区域内并按 scopeUpsampleFilter 放大
+// uv 已乘以 textureScale，textureScale 即有效区域右下角
+float4 sampleScopeTexture(Texture2D tex, SamplerState samp, float2 uv, float2 textureScale)
+{
+    if (scopeUpsampleFilter == 0) {
+        return tex.Sample(samp, uv);
+    }
+
+    float2 texSize;
+    tex.GetDimensions(texSize.x, texSize.y);
+
+    // 有效区域之外是第一次渲染的残留内容
+    uv = min(uv, textureScale - 0.5 / texSize);
+
+    if (scopeUpsampleFilter == 2) {
+        return sampleCatmullRom(tex, samp, uv, texSize);
+    }
+    return tex.SampleLevel(samp, uv, 0);
+}
+
 // Spherical distortion with chromatic aberration (branchless)
 float4 sampleWithSphericalDistortionAndChromatic(Texture2D tex, SamplerState samp, float2 texcoord, float2 textureScale)
 {
@@ -332,19 +481,28 @@ float4 sampleWithSphericalDistortionAndChromatic(Texture2D tex, SamplerState sam
     uv.x *= screenWidth / screenHeight;
     
     float distance = length(uv);
-    // edgeFade: 1 在中心区域（应用完整畸变），0 在边缘外（无畸变）
-    float edgeFade = 1.0 - smoothstep(sphericalDistortionRadius * 0.9, sphericalDistortionRadius, distance);
-    
-    // Chromatic aberration: different distortion per channel
-    // 增强色散差异系数，使效果更明显
-    float distortionR = 1.0 + sphericalDistortionStrength * 1.05 * distance * distance;
-    float distortionG = 1.0 + sphericalDistortionStrength * distance * distance;
-    float distortionB = 1.0 + sphericalDistortionStrength * 0.95 * distance * distance;
-    
-    // edgeFade=1 时应用完整畸变，edgeFade=0 时无畸变
-    distortionR = lerp(1.0, distortionR, edgeFade);
-    distortionG = lerp(1.0, distortionG, edgeFade);
-    distortionB = lerp(1.0, distortionB, edgeFade);
+
+    float distortionR, distortionG, distortionB;
+    [branch] if (useDistortionLUT != 0) {
+        float3 distortion = sampleDistortionLUT(distance).rgb;
+        distortionR = distortion.r;
+        distortionG = distortion.g;
+        distortionB = distortion.b;
+    } else {
+        // edgeFade: 1 在中心区域（应用完整畸变），0 在边缘外（无畸变）
+        float edgeFade = 1.0 - smoothstep(sphericalDistortionRadius * 0.9, sphericalDistortionRadius, distance);
+
+        // Chromatic aberration: different distortion per channel
+        // 增强色散差异系数，使效果更明显
+        distortionR = 1.0 + sphericalDistortionStrength * 1.05 * distance * distance;
+        distortionG = 1.0 + sphericalDistortionStrength * distance * distance;
+        distortionB = 1.0 + sphericalDistortionStrength * 0.95 * distance * distance;
+
+        // edgeFade=1 时应用完整畸变，edgeFade=0 时无畸变
+        distortionR = lerp(1.0, distortionR, edgeFade);
+        distortionG = lerp(1.0, distortionG, edgeFade);
+        distortionB = lerp(1.0, distortionB, edgeFade);
+    }
     
     float2 uvR = uv * distortionR;
     float2 uvG = uv * distortionG;
@@ -363,23 +521,24 @@ float4 sampleWithSphericalDistortionAndChromatic(Texture2D tex, SamplerState sam
     float2 validB = step(0.0, uvB) * step(uvB, 1.0);
     float borderMask = validR.x * validR.y * validG.x * validG.y * validB.x * validB.y;
     
-    uvR = saturate(uvR);
-    uvG = saturate(uvG);
-    uvB = saturate(uvB);
+    uvR = reprojectScopeUV(saturate(uvR));
+    uvG = reprojectScopeUV(saturate(uvG));
+    uvB = reprojectScopeUV(saturate(uvB));
     
     // Apply texture scale for DLSS/FSR3
     uvR *= textureScale;
     uvG *= textureScale;
     uvB *= textureScale;
-    float2 scaledTexcoord = texcoord * textureScale;
+    float2 scaledTexcoord = reprojectScopeUV(texcoord) * textureScale;
     
+    float4 sampleG = sampleScopeTexture(tex, samp, uvG, textureScale);
     float4 distortedSample;
-    distortedSample.r = tex.Sample(samp, uvR).r;
-    distortedSample.g = tex.Sample(samp, uvG).g;
-    distortedSample.b = tex.Sample(samp, uvB).b;
-    distortedSample.a = tex.Sample(samp, uvG).a;
+    distortedSample.r = sampleScopeTexture(tex, samp, uvR, textureScale).r;
+    distortedSample.g = sampleG.g;
+    distortedSample.b = sampleScopeTexture(tex, samp, uvB, textureScale).b;
+    distortedSample.a = sampleG.a;
     
-    float4 originalSample = tex.Sample(samp, scaledTexcoord);
+    float4 originalSample = sampleScopeTexture(tex, samp, scaledTexcoord, textureScale);
     
     return lerp(originalSample, distortedSample, borderMask);
 }
@@ -407,7 +566,7 @@ PS_OUTPUT main(PS_INPUT input)
         vignetteStrength,
         vignetteRadius,
         vignetteSoftness,
-        enableParallax
+        USE_PARALLAX ? 1 : 0
     );
 
     // 应用视差偏移到纹理坐标
@@ -420,22 +579,23 @@ PS_OUTPUT main(PS_INPUT input)
     // 球形畸变效果
     // ========================================================================
 
-    float useDistortion = step(0.5, float(enableSphericalDistortion));
-    float useChromatic = step(0.5, float(enableChromaticAberration));
-
     // 在视差偏移后的坐标上应用畸变
-    float2 distortedTexCoord = lerp(parallaxedTexCoord, applySphericalDistortion(parallaxedTexCoord), useDistortion);
-
-    float useChromaticSampling = useDistortion * useChromatic;
+    float2 distortedTexCoord = parallaxedTexCoord;
+    if (USE_SPHERICAL_DISTORTION) {
+        distortedTexCoord = applySphericalDistortion(parallaxedTexCoord);
+    }
 
     // DLSS/FSR3 upscaling: scale UV to valid texture region
-    float2 textureScale = float2(viewportWidth / screenWidth, viewportHeight / screenHeight);
-    float2 scaledTexCoord = distortedTexCoord * textureScale;
-
-    float4 basicColor = scopeTexture.Sample(scopeSampler, scaledTexCoord);
-    float4 chromaticColor = lerp(basicColor,
-                                sampleWithSphericalDistortionAndChromatic(scopeTexture, scopeSampler, parallaxedTexCoord, textureScale),
-                                useChromaticSampling);
+    // Dynamic-resolution scope pass shrinks that region further by the content scale
+    float2 textureScale = float2(viewportWidth / screenWidth, viewportHeight / screenHeight) * getContentScale();
+    float2 scaledTexCoord = reprojectScopeUV(distortedTexCoord) * textureScale;
+
+    float4 basicColor = sampleScopeTexture(scopeTexture, scopeSampler, scaledTexCoord, textureScale);
+    // 色散路径要多次采样（放大滤波时每次都是双三次），仅在启用时执行
+    float4 chromaticColor = basicColor;
+    [branch] if (USE_CHROMATIC_ABERRATION) {
+        chromaticColor = sampleWithSphericalDistortionAndChromatic(scopeTexture, scopeSampler, parallaxedTexCoord, textureScale);
+    }
 
     float4 color = chromaticColor;
 
@@ -455,11 +615,10 @@ PS_OUTPUT main(PS_INPUT input)
     // 特殊视觉效果
     // ========================================================================
 
-    // 计算夜视和热成像效果
-    float4 nightVisionColor = applyNightVision(color, texCoord);
-
-
-    color = lerp(color, nightVisionColor, float(enableNightVision));
+    // 夜视效果
+    if (USE_NIGHT_VISION) {
+        color = applyNightVision(color, texCoord, input.position.xy);
+    }
 
 
     // ========================================================================
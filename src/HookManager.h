@@ -90,7 +90,7 @@ namespace ThroughScope
 	void __fastcall hkImageSpaceManager_RenderEffectRange(void* thisPtr, int aiFirst, int aiLast, int aiSourceTarget, int aiDestTarget);
 	void __fastcall hkDrawWorld_Render_UI(uint64_t thisPtr);  // Debug hook
 	void __fastcall hkUI_BeginRender();  // Upscaling mode: render scope after Upscaling, before UI
-	void __fastcall hkSetUseDynamicResolutionViewport(void* thisPtr, bool a_useDynamicResolution);  // Debug: fo4test PostDisplay timing
+	void __fastcall hkSetUseDynamicResolutionViewport(void* thisPtr, bool a_useDynamicResolution);  // fo4test PostDisplay timing, scope pass dynamic resolution
 	void __fastcall hkDrawWorld_Render_PostUI();  // Debug: After Upscaling, before UI - potential scope render point
 	void __fastcall hkUI_ScreenSpace_RenderMenus(void* thisPtr);  // Debug: Actual UI overlay rendering
 	bool __fastcall hkBSShaderAccumulator_RegisterObject(BSShaderAccumulator* thisPtr, BSGeometry* apGeometry);  // Validate geometry before registration
@@ -152,7 +152,7 @@ namespace ThroughScope
 		typedef void (__fastcall *FnImageSpaceManager_RenderEffectRange)(void*, int, int, int, int);
 		typedef void (*FnDrawWorld_Render_UI)(uint64_t);  // Debug
 		typedef void (*FnUI_BeginRender)();  // Upscaling mode
-		typedef void (__fastcall *FnSetUseDynamicResolutionViewport)(void*, bool);  // Debug: fo4test timing
+		typedef void (__fastcall *FnSetUseDynamicResolutionViewport)(void*, bool);  // fo4test timing, scope pass dynamic resolution
 		typedef void (*FnDrawWorld_Imagespace)();  // Debug
 		typedef void (*FnDrawWorld_Render_PostUI)();  // Debug
 		typedef void (__fastcall *FnUI_ScreenSpace_RenderMenus)(void*);  // Debug
@@ -209,7 +209,7 @@ namespace ThroughScope
 		FnImageSpaceManager_RenderEffectRange g_ImageSpaceManager_RenderEffectRange = nullptr;
 		FnDrawWorld_Render_UI g_DrawWorld_Render_UI = nullptr;  // Debug
 		FnUI_BeginRender g_UI_BeginRender = nullptr;  // Upscaling mode
-		FnSetUseDynamicResolutionViewport g_SetUseDynamicResolutionViewport = nullptr;  // Debug
+		FnSetUseDynamicResolutionViewport g_SetUseDynamicResolutionViewport = nullptr;  // Also called by SecondPassRenderer
 		FnDrawWorld_Imagespace g_DrawWorld_Imagespace = nullptr;  // Debug
 		FnDrawWorld_Render_PostUI g_DrawWorld_Render_PostUI = nullptr;  // Debug
 		FnUI_ScreenSpace_RenderMenus g_UI_ScreenSpace_RenderMenus = nullptr;  // Debug
@@ -291,7 +291,7 @@ namespace ThroughScope
 		// UI::BeginRender - Upscaling 模式: 在 Upscaling 完成后但 UI 开始前渲染瞄具
 		REL::Relocation<uintptr_t> UI_BeginRender_Ori{ REL::ID(1056045) };
 
-		// SetUseDynamicResolutionViewportAsDefaultViewport - Debug: fo4test PostDisplay 时机
+		// SetUseDynamicResolutionViewportAsDefaultViewport - fo4test PostDisplay 时机，瞄具动态分辨率渲染
 		// fo4test 在此函数参数为 false 时调用 PostDisplay()，复制 kFrameBuffer 到共享缓冲区
 		REL::Relocation<uintptr_t> SetUseDynamicResolutionViewport_Ori{ REL::ID(587723) };
 
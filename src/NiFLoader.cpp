@@ -1,4 +1,5 @@
 #include "NiFLoader.h"
+#include "rendering/TTSMarkerRegistry.h"
 
 using namespace RE;
 
@@ -32,6 +33,10 @@ NiNode* NIFLoader::LoadNIF(const char* filePath)
 		return nullptr;
 	}
 
+	// 新模型替换旧模型：重新登记 TTSEffectShape 的顶点缓冲区，供 DrawIndexed 在 CPU 侧识别
+	ThroughScope::TTSMarkerRegistry::GetSingleton()->Clear();
+	ProcessNiNode(rootNode);
+
 	return rootNode;
 }
 
@@ -104,6 +109,16 @@ void NIFLoader::ProcessNiNode(NiNode* node)
 		return;
 	}
 
+	// TTSEffectShape 即瞄具面片，记录其渲染数据和 GPU 顶点缓冲区，绘制窗口由 DrawTriShape hook 确定
+	const char* shapeName = triShape->name.c_str();
+	if (shapeName && std::strcmp(shapeName, "TTSEffectShape") == 0) {
+		auto* shapeData = triShape->rendererData;
+		if (shapeData && shapeData->vertexBuffer && shapeData->vertexBuffer->buffer) {
+			ThroughScope::TTSMarkerRegistry::GetSingleton()->Register(shapeData, shapeData->vertexBuffer->buffer, triShape->numTriangles * 3);
+		} else {
+			logger::warn("TTSEffectShape has no renderer data yet, falling back to geometry matching");
+		}
+	}
 
 
 	// Get the vertex and index data
@@ -124,7 +139,8 @@ void NIFLoader::ProcessNiNode(NiNode* node)
 	}
 
 	// Get the alpha property
-	NiAlphaProperty* alphaProperty = (NiAlphaProperty*)triShape->properties[1].get();
+	// BSGeometry::properties: [0] = alpha, [1] = shader (QShaderProperty)，用 RTTI 检查类型而不是直接强转
+	NiAlphaProperty* alphaProperty = netimmerse_cast<NiAlphaProperty*>(triShape->properties[0].get());
 	if (alphaProperty) {
 		ProcessNiAlphaProperty(alphaProperty);
 	} else {
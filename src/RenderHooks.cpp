@@ -14,6 +14,7 @@
 #include "ENBIntegration.h"
 #include "FGCompatibility.h"
 #include "rendering/ScopeCulling.h"
+#include "rendering/TTSMarkerRegistry.h"
 #include <d3d9.h>  // for D3DPERF_BeginEvent / D3DPERF_EndEvent
 #include <DirectXMath.h>
 #include <chrono>
@@ -145,9 +146,15 @@ namespace ThroughScope
 				NotifyComplete();
 			} else if (g_Mode == Mode::VanillaHook) {
 				// For VanillaHook mode, execute the MV copy with mask
+				// The mask is the scope quad ellipse when it was projected this frame
+				// (D3DHooks::UpdateScopeQuadScreenPosition); otherwise GetMaskRTV drew the fallback texture
 				auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
 				if (rendererData && rendererData->context) {
 					auto context = (ID3D11DeviceContext*)rendererData->context;
+					if (RenderUtilities::HasScopeQuadScreenEllipse()) {
+						FGCompatibility::SetScopeEllipse({ RenderUtilities::GetScopeQuadCenterU(), RenderUtilities::GetScopeQuadCenterV(),
+							RenderUtilities::GetScopeQuadRadius(), RenderUtilities::GetScopeQuadRadiusV() });
+					}
 					FGCompatibility::ExecuteMVCopyWithMask(context);
 				}
 			}
@@ -161,22 +168,23 @@ namespace ThroughScope
 			if (g_Mode == Mode::XifeiliAPI && GetMVOverrideMaskRTV) {
 				return GetMVOverrideMaskRTV();
 			} else if (g_Mode == Mode::VanillaHook) {
-				return FGCompatibility::GetMaskRTV();
+				// With a valid projection the CS evaluates the ellipse: no clear and no mask draw
+				if (RenderUtilities::HasScopeQuadScreenEllipse()) return nullptr;
+				auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
+				if (rendererData && rendererData->context) {
+					return FGCompatibility::GetFallbackMaskRTV((ID3D11DeviceContext*)rendererData->context);
+				}
 			}
 			return nullptr;
 		}
 		
-		// Clear the mask at the start of each frame (VanillaHook mode only)
-		void ClearMask()
+		// Start a new mask frame (VanillaHook mode only): this frame's mask becomes the previous one
+		void BeginMaskFrame()
 		{
 			if (!g_Initialized) return;
 			
 			if (g_Mode == Mode::VanillaHook) {
-				auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
-				if (rendererData && rendererData->context) {
-					auto context = (ID3D11DeviceContext*)rendererData->context;
-					FGCompatibility::ClearMask(context);
-				}
+				FGCompatibility::BeginMaskFrame();
 			}
 			// XifeiliAPI mode: mask is cleared by fo4test automatically
 		}
@@ -406,6 +414,11 @@ namespace ThroughScope
 						IncrementCullingFiltered();
 						return;
 					}
+					// 在瞄具画面中投影过小的物体（贡献裁剪，默认关闭）
+					if (!TestBoundContribution(&apObj->worldBound)) {
+						IncrementCullingFiltered();
+						return;
+					}
 					IncrementCullingPassed();
 				}
 			}
@@ -508,7 +521,11 @@ namespace ThroughScope
 			return;
 		}
 
+		// 登记的 TTSEffectShape 在此期间发出的 DrawIndexed 即为瞄具面片的绘制窗口（apTriShape 为 rendererData）
+		auto markerRegistry = TTSMarkerRegistry::GetSingleton();
+		markerRegistry->BeginShapeDraw(apTriShape);
 		g_hookMgr->g_DrawTriShape(thisPtr, apTriShape, auiStartIndex, auiNumTriangles);
+		markerRegistry->EndShapeDraw();
 		D3DPERF_EndEvent();
 	}
 
@@ -532,8 +549,9 @@ namespace ThroughScope
 
 			D3DPERF_BeginEvent(0xFF00FF00, L"TrueThroughScope_FirstPass");
 			
-			// Clear the FG interpolation mask at the start of each frame (VanillaHook mode only)
-			FGInterop::ClearMask();
+			// Rotate the FG interpolation mask at the start of each frame (VanillaHook mode only)
+			FGInterop::BeginMaskFrame();
+			RenderUtilities::InvalidateScopeQuadScreenEllipse();
 			
 			g_hookMgr->g_RenderPreUIOriginal(ptr_drawWorld);
 			D3DPERF_EndEvent();
@@ -573,24 +591,31 @@ namespace ThroughScope
 						ScopedFullRenderState stateGuard(context);
 
 						D3DPERF_BeginEvent(0xFF00FFFF, L"TrueThroughScope_SecondPass");
-						SecondPassRenderer renderer(context, device, d3dHooks);
+						auto& renderer = SecondPassRenderer::GetInstance(context, device, d3dHooks);
 						if (!renderer.ExecuteSecondPass()) {
 							logger::warn("[Render_PreUI Hook] SecondPassRenderer failed");
 						}
 
 						// Merge Render Targets
-						RenderTargetMerger::GetInstance().MergeRenderTargets(context, device);
+						{
+							SecondPassRenderer::ScopedPhase mergeTimer(renderer, SecondPassRenderer::Phase::MergeRenderTargets);
+							RenderTargetMerger::GetInstance().MergeRenderTargets(context, device);
+						}
 
 						if (!FGInterop::IsActive()) FGInterop::Initialize();
 
-						if (FGInterop::IsMaskAPIAvailable()) {
-							ID3D11RenderTargetView* maskRTV = FGInterop::GetMaskRTV();
-							if (maskRTV) {
-								renderer.WriteToMVRegionOverrideMask(maskRTV);
+						if (FGInterop::IsActive()) {
+							SecondPassRenderer::ScopedPhase maskTimer(renderer, SecondPassRenderer::Phase::MotionVectorMask);
+							if (FGInterop::IsMaskAPIAvailable()) {
+								ID3D11RenderTargetView* maskRTV = FGInterop::GetMaskRTV();
+								if (maskRTV) {
+									renderer.WriteToMVRegionOverrideMask(maskRTV);
+								}
 							}
+
+							FGInterop::NotifyMVComplete();
 						}
-						
-						FGInterop::NotifyMVComplete();
+						renderer.EndFrame();
 						
 						D3DPERF_EndEvent();
 						g_scopeRenderMgr->OnFrameEnd();
@@ -933,11 +958,19 @@ namespace ThroughScope
 		g_hookMgr->g_UI_BeginRender();
 	}
 
-	// ========== SetUseDynamicResolutionViewport Debug Hook ==========
+	// ========== SetUseDynamicResolutionViewport Hook ==========
 	// fo4test 在此函数参数为 false 时调用 PostDisplay()
 	// PostDisplay 将 kFrameBuffer 复制到 HUDLessBufferShared 供 FSR3 处理
+	// 动态分辨率的瞄具渲染期间保持动态分辨率 viewport：瞄具图像留在左上角（TrueScopeShader 按比例采样），
+	// 也不会在瞄具渲染中途触发 PostDisplay。游戏自己的设置记录下来，瞄具渲染结束后恢复
 	void __fastcall hkSetUseDynamicResolutionViewport(void* thisPtr, bool a_useDynamicResolution)
 	{
+		if (ScopeCamera::IsRenderingForScope() && RenderUtilities::IsScopeResolutionScaled()) {
+			a_useDynamicResolution = true;
+		} else {
+			RenderUtilities::SetGameDynamicResolutionViewport(thisPtr, a_useDynamicResolution);
+		}
+
 		if (a_useDynamicResolution) {
 			D3DPERF_BeginEvent(0xFF0088FF, L"SetUseDynamicResolutionViewport(TRUE)");
 		} else {
@@ -1,8 +1,11 @@
 #include "RenderUtilities.h"
 
 #include "ScopeCamera.h"
+#include "rendering/ScopeRegion.h"
+#include "rendering/D3DResourceManager.h"
 
 #include "Utilities.h"
+#include <d3d11_1.h>
 #include <wrl/client.h>
 namespace ThroughScope
 {
@@ -37,6 +40,8 @@ namespace ThroughScope
 	ID3D11PixelShader* RenderUtilities::s_GBufferCopyPS = nullptr;
 	ID3D11PixelShader* RenderUtilities::s_EmissiveDebugPS = nullptr;
 	ID3D11PixelShader* RenderUtilities::s_HalfResMergePS = nullptr;
+	ID3D11PixelShader* RenderUtilities::s_MRTMergePS = nullptr;
+	ID3D11PixelShader* RenderUtilities::s_HalfResMRTMergePS = nullptr;
 
     RE::BSGraphics::Texture* RenderUtilities::s_ScopeBSTexture = nullptr;
     RE::NiTexture* RenderUtilities::s_ScopeNiTexture = nullptr;
@@ -54,6 +59,17 @@ namespace ThroughScope
 	float RenderUtilities::s_ScopeQuadCenterU = 0.5f;  // Default: screen center
 	float RenderUtilities::s_ScopeQuadCenterV = 0.5f;
 	float RenderUtilities::s_ScopeQuadRadius = 0.15f;  // Default radius
+	float RenderUtilities::s_ScopeQuadRadiusV = 0.15f;
+	float RenderUtilities::s_ScopeQuadBounds[4] = { 0.35f, 0.35f, 0.65f, 0.65f };  // minU, minV, maxU, maxV
+	bool RenderUtilities::s_ScopeQuadEllipseValid = false;
+	bool RenderUtilities::s_ScopeRegionActive = false;
+	float RenderUtilities::s_ScopeRegionUV[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+	UINT RenderUtilities::s_ScopeRegionRefSize[2] = { 0, 0 };
+	float RenderUtilities::s_ScopeResolutionScale[2] = { 1.0f, 1.0f };
+	void* RenderUtilities::s_DynamicResolutionViewportOwner = nullptr;
+	bool RenderUtilities::s_GameUsesDynamicResolutionViewport = false;
+	bool RenderUtilities::s_ScopeReprojectionActive = false;
+	float RenderUtilities::s_ScopeReprojection[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
 
 
 	// Simple Pixel Shader to copy MV from texture (samples t0, outputs directly)
@@ -114,6 +130,78 @@ namespace ThroughScope
 		}
 	)";
 
+	// MRT Merge Pixel Shader - restores up to 8 full-res RTs in one stencil-tested draw
+	// tN = backup of the RT bound to SV_TargetN; unbound slots read 0 and write nowhere
+	const char* g_MRTMergePSCode = R"(
+		Texture2D<float4> FirstPassTex0 : register(t0);
+		Texture2D<float4> FirstPassTex1 : register(t1);
+		Texture2D<float4> FirstPassTex2 : register(t2);
+		Texture2D<float4> FirstPassTex3 : register(t3);
+		Texture2D<float4> FirstPassTex4 : register(t4);
+		Texture2D<float4> FirstPassTex5 : register(t5);
+		Texture2D<float4> FirstPassTex6 : register(t6);
+		Texture2D<float4> FirstPassTex7 : register(t7);
+		SamplerState PointSamp : register(s0);
+
+		struct PS_IN { float4 Pos : SV_POSITION; float2 UV : TEXCOORD0; };
+		struct PS_OUT {
+			float4 Target0 : SV_Target0;
+			float4 Target1 : SV_Target1;
+			float4 Target2 : SV_Target2;
+			float4 Target3 : SV_Target3;
+			float4 Target4 : SV_Target4;
+			float4 Target5 : SV_Target5;
+			float4 Target6 : SV_Target6;
+			float4 Target7 : SV_Target7;
+		};
+
+		PS_OUT main(PS_IN input) {
+			PS_OUT output;
+			output.Target0 = FirstPassTex0.Sample(PointSamp, input.UV);
+			output.Target1 = FirstPassTex1.Sample(PointSamp, input.UV);
+			output.Target2 = FirstPassTex2.Sample(PointSamp, input.UV);
+			output.Target3 = FirstPassTex3.Sample(PointSamp, input.UV);
+			output.Target4 = FirstPassTex4.Sample(PointSamp, input.UV);
+			output.Target5 = FirstPassTex5.Sample(PointSamp, input.UV);
+			output.Target6 = FirstPassTex6.Sample(PointSamp, input.UV);
+			output.Target7 = FirstPassTex7.Sample(PointSamp, input.UV);
+			return output;
+		}
+	)";
+
+	// Half-Resolution MRT Merge Pixel Shader - same stencil lookup as HalfResMergePS, two targets per draw
+	// t0/t1 = backups for SV_Target0/1, t2 = stencil texture (full-res)
+	const char* g_HalfResMRTMergePSCode = R"(
+		Texture2D<float4> FirstPassTex0 : register(t0);
+		Texture2D<float4> FirstPassTex1 : register(t1);
+		Texture2D<uint2> StencilTex : register(t2);  // R24G8 format, stencil in .y
+		SamplerState PointSamp : register(s0);
+
+		cbuffer HalfResParams : register(b0) {
+			float2 FullResSize;
+			float2 Padding;
+		};
+
+		struct PS_IN { float4 Pos : SV_POSITION; float2 UV : TEXCOORD0; };
+		struct PS_OUT {
+			float4 Target0 : SV_Target0;
+			float4 Target1 : SV_Target1;
+		};
+
+		PS_OUT main(PS_IN input) {
+			int2 stencilCoord = int2(saturate(input.UV) * FullResSize);
+			uint stencilVal = StencilTex.Load(int3(stencilCoord, 0)).y;
+			if (stencilVal == 127) {
+				discard;
+			}
+
+			PS_OUT output;
+			output.Target0 = FirstPassTex0.Sample(PointSamp, input.UV);
+			output.Target1 = FirstPassTex1.Sample(PointSamp, input.UV);
+			return output;
+		}
+	)";
+
 	// Simple Pixel Shader that outputs white (1.0) - for writing to interpolation skip mask
 	const char* g_WhiteOutputPSCode = R"(
 		struct PS_IN { float4 Pos : SV_POSITION; float2 UV : TEXCOORD0; };
@@ -231,18 +319,20 @@ namespace ThroughScope
 	{
 		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
 		ID3D11Device* device = (ID3D11Device*)rendererData->device;
+		// 编译结果缓存在 ShaderCache 目录，源码不变时启动不再调用编译器
+		auto shaderCompiler = D3DResourceManager::GetSingleton();
 
 		ID3DBlob* blob = nullptr;
 		ID3DBlob* errorBlob = nullptr;
 		HRESULT hr;
 
 		// --- Compile ScopeMV VS (fullscreen triangle with UV) ---
-		hr = D3DCompile(
+		hr = shaderCompiler->CompileShaderCached(
 			g_FullscreenVSCode,
 			strlen(g_FullscreenVSCode),
-			nullptr, nullptr, nullptr,
+			"FullscreenVS", nullptr, nullptr,
 			"main", "vs_5_0",
-			0, 0, &blob, &errorBlob
+			0, &blob, &errorBlob
 		);
 
 		if (FAILED(hr)) {
@@ -262,12 +352,12 @@ namespace ThroughScope
 		}
 
 		// --- Compile MV Debug PS ---
-		hr = D3DCompile(
+		hr = shaderCompiler->CompileShaderCached(
 			g_MVDebugPSCode,
 			strlen(g_MVDebugPSCode),
-			nullptr, nullptr, nullptr,
+			"MVDebugPS", nullptr, nullptr,
 			"main", "ps_5_0",
-			0, 0, &blob, &errorBlob
+			0, &blob, &errorBlob
 		);
 
 		if (FAILED(hr)) {
@@ -286,12 +376,12 @@ namespace ThroughScope
 		}
 
 		// --- Compile MV Copy PS (stencil-masked copy from FirstPassMV) ---
-		hr = D3DCompile(
+		hr = shaderCompiler->CompileShaderCached(
 			g_MVCopyPSCode,
 			strlen(g_MVCopyPSCode),
-			nullptr, nullptr, nullptr,
+			"MVCopyPS", nullptr, nullptr,
 			"main", "ps_5_0",
-			0, 0, &blob, &errorBlob
+			0, &blob, &errorBlob
 		);
 
 		if (FAILED(hr)) {
@@ -311,12 +401,12 @@ namespace ThroughScope
 		}
 
 		// --- Compile MV Blend PS (edge feathering for Frame Generation) ---
-		hr = D3DCompile(
+		hr = shaderCompiler->CompileShaderCached(
 			g_MVBlendPSCode,
 			strlen(g_MVBlendPSCode),
-			nullptr, nullptr, nullptr,
+			"MVBlendPS", nullptr, nullptr,
 			"main", "ps_5_0",
-			0, 0, &blob, &errorBlob
+			0, &blob, &errorBlob
 		);
 
 		if (FAILED(hr)) {
@@ -337,8 +427,8 @@ namespace ThroughScope
 		}
 
 		// Compile WhiteOutputPS (for writing to FG interpolation skip mask)
-		hr = D3DCompile(g_WhiteOutputPSCode, strlen(g_WhiteOutputPSCode), "WhiteOutputPS", nullptr, nullptr,
-			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &blob, &errorBlob);
+		hr = shaderCompiler->CompileShaderCached(g_WhiteOutputPSCode, strlen(g_WhiteOutputPSCode), "WhiteOutputPS", nullptr, nullptr,
+			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, &blob, &errorBlob);
 		if (FAILED(hr)) {
 			if (errorBlob) {
 				logger::error("Failed to compile WhiteOutputPS: {}", (char*)errorBlob->GetBufferPointer());
@@ -357,8 +447,8 @@ namespace ThroughScope
 		}
 
 		// Compile GBufferCopyPS (for GBuffer debug display - float4 output)
-		hr = D3DCompile(g_GBufferCopyPSCode, strlen(g_GBufferCopyPSCode), "GBufferCopyPS", nullptr, nullptr,
-			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &blob, &errorBlob);
+		hr = shaderCompiler->CompileShaderCached(g_GBufferCopyPSCode, strlen(g_GBufferCopyPSCode), "GBufferCopyPS", nullptr, nullptr,
+			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, &blob, &errorBlob);
 		if (FAILED(hr)) {
 			if (errorBlob) {
 				logger::error("Failed to compile GBufferCopyPS: {}", (char*)errorBlob->GetBufferPointer());
@@ -377,8 +467,8 @@ namespace ThroughScope
 		}
 
 		// Compile EmissiveDebugPS (for Emissive visualization with amplification)
-		hr = D3DCompile(g_EmissiveDebugPSCode, strlen(g_EmissiveDebugPSCode), "EmissiveDebugPS", nullptr, nullptr,
-			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &blob, &errorBlob);
+		hr = shaderCompiler->CompileShaderCached(g_EmissiveDebugPSCode, strlen(g_EmissiveDebugPSCode), "EmissiveDebugPS", nullptr, nullptr,
+			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, &blob, &errorBlob);
 		if (FAILED(hr)) {
 			if (errorBlob) {
 				logger::error("Failed to compile EmissiveDebugPS: {}", (char*)errorBlob->GetBufferPointer());
@@ -397,8 +487,8 @@ namespace ThroughScope
 		}
 
 		// Compile HalfResMergePS (for half-resolution RT merge with UV*2 stencil sampling)
-		hr = D3DCompile(g_HalfResMergePSCode, strlen(g_HalfResMergePSCode), "HalfResMergePS", nullptr, nullptr,
-			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &blob, &errorBlob);
+		hr = shaderCompiler->CompileShaderCached(g_HalfResMergePSCode, strlen(g_HalfResMergePSCode), "HalfResMergePS", nullptr, nullptr,
+			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, &blob, &errorBlob);
 		if (FAILED(hr)) {
 			if (errorBlob) {
 				logger::error("Failed to compile HalfResMergePS: {}", (char*)errorBlob->GetBufferPointer());
@@ -416,7 +506,43 @@ namespace ThroughScope
 			}
 		}
 
-		logger::info("Successfully created all shaders (FullscreenVS, MVDebugPS, MVCopyPS, MVBlendPS, WhiteOutputPS, GBufferCopyPS, EmissiveDebugPS, HalfResMergePS)");
+		// Compile MRTMergePS (restores up to 8 full-res RTs per draw)
+		hr = shaderCompiler->CompileShaderCached(g_MRTMergePSCode, strlen(g_MRTMergePSCode), "MRTMergePS", nullptr, nullptr,
+			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, &blob, &errorBlob);
+		if (FAILED(hr)) {
+			if (errorBlob) {
+				logger::error("Failed to compile MRTMergePS: {}", (char*)errorBlob->GetBufferPointer());
+				errorBlob->Release();
+			}
+			// Non-fatal - RenderTargetMerger falls back to one draw per RT
+		} else {
+			if (errorBlob) errorBlob->Release();
+			hr = device->CreatePixelShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &RenderUtilities::s_MRTMergePS);
+			blob->Release();
+			if (FAILED(hr)) {
+				logger::error("Failed to create MRTMerge pixel shader");
+			}
+		}
+
+		// Compile HalfResMRTMergePS (restores both half-res RTs per draw)
+		hr = shaderCompiler->CompileShaderCached(g_HalfResMRTMergePSCode, strlen(g_HalfResMRTMergePSCode), "HalfResMRTMergePS", nullptr, nullptr,
+			"main", "ps_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, &blob, &errorBlob);
+		if (FAILED(hr)) {
+			if (errorBlob) {
+				logger::error("Failed to compile HalfResMRTMergePS: {}", (char*)errorBlob->GetBufferPointer());
+				errorBlob->Release();
+			}
+			// Non-fatal
+		} else {
+			if (errorBlob) errorBlob->Release();
+			hr = device->CreatePixelShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &RenderUtilities::s_HalfResMRTMergePS);
+			blob->Release();
+			if (FAILED(hr)) {
+				logger::error("Failed to create HalfResMRTMerge pixel shader");
+			}
+		}
+
+		logger::info("Successfully created all shaders (FullscreenVS, MVDebugPS, MVCopyPS, MVBlendPS, WhiteOutputPS, GBufferCopyPS, EmissiveDebugPS, HalfResMergePS, MRTMergePS, HalfResMRTMergePS)");
 		return true;
 	}
 
@@ -808,6 +934,14 @@ namespace ThroughScope
 			s_HalfResMergePS->Release();
 			s_HalfResMergePS = nullptr;
 		}
+		if (s_MRTMergePS) {
+			s_MRTMergePS->Release();
+			s_MRTMergePS = nullptr;
+		}
+		if (s_HalfResMRTMergePS) {
+			s_HalfResMRTMergePS->Release();
+			s_HalfResMRTMergePS = nullptr;
+		}
 		if (s_TempMVTexture) {
 			s_TempMVTexture->Release();
 			s_TempMVTexture = nullptr;
@@ -847,6 +981,87 @@ namespace ThroughScope
 		}
     }
 
+	bool RenderUtilities::GetScopeRegionRect(UINT width, UINT height, D3D11_RECT& rect)
+	{
+		rect = { 0, 0, (LONG)width, (LONG)height };
+		if (!s_ScopeRegionActive) {
+			return false;
+		}
+
+		// 只有屏幕空间的纹理（全分辨率/半分辨率/超分输入）才按区域处理，阴影贴图等保持整张
+		ScopeRegion::UVRect uv{ s_ScopeRegionUV[0], s_ScopeRegionUV[1], s_ScopeRegionUV[2], s_ScopeRegionUV[3] };
+		ScopeRegion::PixelRect pixels;
+		const bool limited = ScopeRegion::SurfaceRect(uv, s_ScopeRegionRefSize[0], s_ScopeRegionRefSize[1], width, height, pixels);
+		rect.left = (LONG)pixels.left;
+		rect.top = (LONG)pixels.top;
+		rect.right = (LONG)pixels.right;
+		rect.bottom = (LONG)pixels.bottom;
+		return limited;
+	}
+
+	bool RenderUtilities::ClearRenderTargetScopeRegion(ID3D11DeviceContext* context, ID3D11RenderTargetView* rtv, const FLOAT color[4])
+	{
+		if (!s_ScopeRegionActive || !context || !rtv) {
+			return false;
+		}
+
+		Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+		rtv->GetResource(&resource);
+		Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+		if (!resource || FAILED(resource.As(&texture))) {
+			return false;
+		}
+
+		D3D11_TEXTURE2D_DESC desc;
+		texture->GetDesc(&desc);
+		D3D11_RECT rect;
+		if (!GetScopeRegionRect(desc.Width, desc.Height, rect)) {
+			return false;
+		}
+
+		// ClearView 需要 D3D11.1 运行时
+		Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context1;
+		if (FAILED(context->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)context1.GetAddressOf()))) {
+			return false;
+		}
+
+		if (rect.right > rect.left && rect.bottom > rect.top) {
+			context1->ClearView(rtv, color, &rect, 1);
+		}
+		return true;
+	}
+
+	bool RenderUtilities::CopyTextureScopeRegion(ID3D11DeviceContext* context, ID3D11Device* device, ID3D11Texture2D* dest, ID3D11Texture2D* src)
+	{
+		if (!s_ScopeRegionActive) {
+			return SafeCopyTexture(context, device, dest, src);
+		}
+		if (!context || !device || !dest || !src) return false;
+
+		D3D11_TEXTURE2D_DESC srcDesc, destDesc;
+		src->GetDesc(&srcDesc);
+		dest->GetDesc(&destDesc);
+
+		// 区域复制要求尺寸/格式一致，且不支持 MSAA 和深度格式的子区域复制
+		if (srcDesc.Width != destDesc.Width || srcDesc.Height != destDesc.Height ||
+			srcDesc.Format != destDesc.Format || srcDesc.SampleDesc.Count > 1 ||
+			(srcDesc.BindFlags & D3D11_BIND_DEPTH_STENCIL) || (destDesc.BindFlags & D3D11_BIND_DEPTH_STENCIL)) {
+			return SafeCopyTexture(context, device, dest, src);
+		}
+
+		D3D11_RECT rect;
+		if (!GetScopeRegionRect(srcDesc.Width, srcDesc.Height, rect)) {
+			return SafeCopyTexture(context, device, dest, src);
+		}
+		if (rect.right <= rect.left || rect.bottom <= rect.top) {
+			return true;  // 区域为空，无需复制
+		}
+
+		D3D11_BOX box = { (UINT)rect.left, (UINT)rect.top, 0, (UINT)rect.right, (UINT)rect.bottom, 1 };
+		context->CopySubresourceRegion(dest, 0, box.left, box.top, 0, src, 0, &box);
+		return true;
+	}
+
 	bool RenderUtilities::SafeCopyTexture(ID3D11DeviceContext* context, ID3D11Device* device, ID3D11Texture2D* dest, ID3D11Texture2D* src)
 	{
 		if (!context || !device || !dest || !src) return false;
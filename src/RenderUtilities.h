@@ -34,6 +34,10 @@ namespace ThroughScope
 		// Robust texture copy that handles dimension mismatches
 		// Uses CopyResource if dimensions match, otherwise falls back to shader copy
 		static bool SafeCopyTexture(ID3D11DeviceContext* context, ID3D11Device* device, ID3D11Texture2D* dest, ID3D11Texture2D* src);
+
+		// Region-limited variant: copies only the active scope region (CopySubresourceRegion)
+		// Falls back to SafeCopyTexture when no region is active or the textures differ
+		static bool CopyTextureScopeRegion(ID3D11DeviceContext* context, ID3D11Device* device, ID3D11Texture2D* dest, ID3D11Texture2D* src);
     
         // Texture getters
         static ID3D11Texture2D* GetFirstPassColorTexture() { return s_FirstPassColorTexture; }
@@ -106,6 +110,10 @@ namespace ThroughScope
 		// Half-resolution RT merge shader with UV*2 stencil sampling
 		static ID3D11PixelShader* GetHalfResMergePS() { return s_HalfResMergePS; }
 
+		// MRT merge shaders: full-res (8 targets per draw) and half-res (2 targets per draw)
+		static ID3D11PixelShader* GetMRTMergePS() { return s_MRTMergePS; }
+		static ID3D11PixelShader* GetHalfResMRTMergePS() { return s_HalfResMRTMergePS; }
+
     private:
         static ID3D11Texture2D* s_FirstPassColorTexture;
         static ID3D11Texture2D* s_FirstPassDepthTexture;
@@ -146,6 +154,8 @@ namespace ThroughScope
 		static ID3D11PixelShader* s_GBufferCopyPS;   // GBuffer 复制 shader (float4 output)
 		static ID3D11PixelShader* s_EmissiveDebugPS; // Emissive 调试 shader (50x amplification)
 		static ID3D11PixelShader* s_HalfResMergePS;  // 半分辨率 RT 合并 shader (UV*2 stencil sampling)
+		static ID3D11PixelShader* s_MRTMergePS;      // 全分辨率 MRT 合并 shader (每次 draw 8 个 RT)
+		static ID3D11PixelShader* s_HalfResMRTMergePS;  // 半分辨率 MRT 合并 shader (每次 draw 2 个 RT)
 
 	private:
         // Scope textures
@@ -167,6 +177,25 @@ namespace ThroughScope
 		static float s_ScopeQuadCenterU;  // Scope center X in UV space (0-1)
 		static float s_ScopeQuadCenterV;  // Scope center Y in UV space (0-1)
 		static float s_ScopeQuadRadius;   // Scope radius in UV space
+		static float s_ScopeQuadRadiusV;  // Scope vertical radius in UV space (differs from U by aspect)
+		static float s_ScopeQuadBounds[4];  // Scope bounding rect in UV space: minU, minV, maxU, maxV
+		static bool s_ScopeQuadEllipseValid;  // Ellipse projected this frame (otherwise the values above are stale)
+
+		// Region-limited second pass (aperture rect in UV space, see ScopeRegion)
+		static bool s_ScopeRegionActive;
+		static float s_ScopeRegionUV[4];  // minU, minV, maxU, maxV
+		static UINT s_ScopeRegionRefSize[2];  // screen width, height
+
+		// Dynamic-resolution second pass (per-axis fraction of full resolution, see ScopeResolutionScaler)
+		static float s_ScopeResolutionScale[2];
+
+		// Engine dynamic-resolution viewport switch, as last requested by the game (hkSetUseDynamicResolutionViewport)
+		static void* s_DynamicResolutionViewportOwner;
+		static bool s_GameUsesDynamicResolutionViewport;
+
+		// Temporal amortization (reprojected frame, see ScopeAmortizationPolicy)
+		static bool s_ScopeReprojectionActive;
+		static float s_ScopeReprojection[3][3];  // current NDC (x, y, 1) -> previous homogeneous NDC
 		
 	public:
 		// Scope screen position for MV merge (Plan A)
@@ -175,9 +204,88 @@ namespace ThroughScope
 			s_ScopeQuadCenterV = centerV;
 			s_ScopeQuadRadius = radius;
 		}
+		// Full projected ellipse (CPU analytic projection, see ScopeProjection)
+		static void SetScopeQuadScreenEllipse(float centerU, float centerV, float radiusU, float radiusV,
+			float minU, float minV, float maxU, float maxV) {
+			SetScopeQuadScreenPosition(centerU, centerV, radiusU);
+			s_ScopeQuadRadiusV = radiusV;
+			s_ScopeQuadBounds[0] = minU;
+			s_ScopeQuadBounds[1] = minV;
+			s_ScopeQuadBounds[2] = maxU;
+			s_ScopeQuadBounds[3] = maxV;
+			s_ScopeQuadEllipseValid = true;
+		}
+		// Called at the start of each frame, before the scope quad is drawn and projected
+		static void InvalidateScopeQuadScreenEllipse() { s_ScopeQuadEllipseValid = false; }
+		static bool HasScopeQuadScreenEllipse() { return s_ScopeQuadEllipseValid; }
 		static float GetScopeQuadCenterU() { return s_ScopeQuadCenterU; }
 		static float GetScopeQuadCenterV() { return s_ScopeQuadCenterV; }
 		static float GetScopeQuadRadius() { return s_ScopeQuadRadius; }
+		static float GetScopeQuadRadiusV() { return s_ScopeQuadRadiusV; }
+		static void GetScopeQuadScreenBounds(float& minU, float& minV, float& maxU, float& maxV) {
+			minU = s_ScopeQuadBounds[0];
+			minV = s_ScopeQuadBounds[1];
+			maxU = s_ScopeQuadBounds[2];
+			maxV = s_ScopeQuadBounds[3];
+		}
+
+		// Region-limited second pass: active between SecondPassRenderer::ExecuteSecondPass and EndFrame
+		// refWidth/refHeight is the screen size, used to tell screen-space surfaces from shadow maps etc.
+		static void SetScopeRegion(float minU, float minV, float maxU, float maxV, UINT refWidth, UINT refHeight) {
+			s_ScopeRegionUV[0] = minU;
+			s_ScopeRegionUV[1] = minV;
+			s_ScopeRegionUV[2] = maxU;
+			s_ScopeRegionUV[3] = maxV;
+			s_ScopeRegionRefSize[0] = refWidth;
+			s_ScopeRegionRefSize[1] = refHeight;
+			s_ScopeRegionActive = true;
+		}
+		static void ClearScopeRegion() { s_ScopeRegionActive = false; }
+		static bool IsScopeRegionActive() { return s_ScopeRegionActive; }
+		// Fraction of the screen covered by the region (1.0 when inactive)
+		static float GetScopeRegionCoverage() {
+			if (!s_ScopeRegionActive) return 1.0f;
+			return (s_ScopeRegionUV[2] - s_ScopeRegionUV[0]) * (s_ScopeRegionUV[3] - s_ScopeRegionUV[1]);
+		}
+		// Scope region in pixels of a width x height surface
+		// Returns false when no region is active or the surface is not screen-shaped (use the whole surface)
+		static bool GetScopeRegionRect(UINT width, UINT height, D3D11_RECT& rect);
+		// Clear only the scope region of rtv via ID3D11DeviceContext1::ClearView
+		// Returns false when the caller has to do a regular full clear
+		static bool ClearRenderTargetScopeRegion(ID3D11DeviceContext* context, ID3D11RenderTargetView* rtv, const FLOAT color[4]);
+
+		// Dynamic-resolution second pass: SecondPassRenderer scales the engine's dynamic-resolution ratio
+		// by this while rendering for the scope, so the scope image fills the top-left scale x size of
+		// the target and the scope shader samples that sub-rect. Cleared in EndFrame (1.0 = full resolution)
+		static void SetScopeResolutionScale(float scaleX, float scaleY) {
+			s_ScopeResolutionScale[0] = scaleX;
+			s_ScopeResolutionScale[1] = scaleY;
+		}
+		static void ClearScopeResolutionScale() {
+			s_ScopeResolutionScale[0] = 1.0f;
+			s_ScopeResolutionScale[1] = 1.0f;
+		}
+		static bool IsScopeResolutionScaled() { return s_ScopeResolutionScale[0] < 1.0f || s_ScopeResolutionScale[1] < 1.0f; }
+		static float GetScopeResolutionScaleX() { return s_ScopeResolutionScale[0]; }
+		static float GetScopeResolutionScaleY() { return s_ScopeResolutionScale[1]; }
+
+		// The game's own SetUseDynamicResolutionViewport calls (outside the scope pass)
+		static void SetGameDynamicResolutionViewport(void* owner, bool enabled) {
+			s_DynamicResolutionViewportOwner = owner;
+			s_GameUsesDynamicResolutionViewport = enabled;
+		}
+		static void* GetDynamicResolutionViewportOwner() { return s_DynamicResolutionViewportOwner; }
+		static bool GameUsesDynamicResolutionViewport() { return s_GameUsesDynamicResolutionViewport; }
+
+		// Temporal amortization: the scope shader reuses the last rendered scope image, remapped
+		// through this homography. Set by SecondPassRenderer on reprojected frames, cleared in EndFrame
+		static void SetScopeReprojection(const float homography[3][3]) {
+			memcpy(s_ScopeReprojection, homography, sizeof(s_ScopeReprojection));
+			s_ScopeReprojectionActive = true;
+		}
+		static void ClearScopeReprojection() { s_ScopeReprojectionActive = false; }
+		static bool IsScopeReprojectionActive() { return s_ScopeReprojectionActive; }
+		static const float (&GetScopeReprojection())[3][3] { return s_ScopeReprojection; }
 		
 	public:
 		static void SetFirstPassViewport(const D3D11_VIEWPORT& viewport) {
@@ -6,6 +6,7 @@
 #include "NiFLoader.h"
 
 #include "D3DHooks.h"
+#include "rendering/TTSMarkerRegistry.h"
 
 #include <cmath>
 #include <map>
@@ -18,6 +19,7 @@ namespace ThroughScope
 	NiCamera* ScopeCamera::s_OriginalCamera = nullptr;
 	TESFormID ScopeCamera::s_EquippedWeaponFormID = 0;
 	NiNode* ScopeCamera::s_CurrentScopeNode = nullptr;
+	DirtyNodeSet<NiAVObject> ScopeCamera::s_DirtyNodes;
 
 	BGSKeyword* ScopeCamera::an_45 = nullptr;
 	BGSKeyword* ScopeCamera::AnimsXM2010_scopeKH45 = nullptr;
@@ -120,6 +122,9 @@ namespace ThroughScope
 			s_CurrentScopeNode = nullptr;  // 重要：设置为nullptr避免悬空指针
 		}
 
+		// 模型已卸载，登记的顶点缓冲区不再代表瞄具面片
+		TTSMarkerRegistry::GetSingleton()->Clear();
+
 		// 清理D3D相关资源
 		// ThroughScope::D3DHooks::CleanupStaticResources();
 
@@ -221,8 +226,6 @@ namespace ThroughScope
 		updateData.flags = 0;
 
 		scopeNode->Update(updateData);
-
-
 	}
 
 	void ScopeCamera::SetupScopeForWeapon(const DataPersistence::WeaponInfo& weaponInfo)
@@ -4,6 +4,7 @@
 #include <RE/NetImmerse/NiCamera.hpp>
 
 #include "DataPersistence.h"
+#include "rendering/DirtyNodeSet.h"
 
 namespace ThroughScope
 {
@@ -20,6 +21,7 @@ namespace ThroughScope
         static bool s_OriginalRenderDecals;
         static bool s_IsRenderingForScope;
 		static bool s_IsUserAdjustingZoomData;
+		static DirtyNodeSet<RE::NiAVObject> s_DirtyNodes;
 
     public:
         // Initialize scope camera system
@@ -34,6 +36,12 @@ namespace ThroughScope
         static void SetScopeCamera(RE::NiCamera* camera) { s_ScopeCamera = camera; }
         
 		static void ApplyScopeTransform(RE::NiNode* scopeNode, const DataPersistence::CameraAdjustments& adjustments);
+
+		// 第一次渲染之后局部变换被修改的节点；第二次渲染前的增量场景图更新只更新这些子树
+		// 只在渲染线程使用（UpdateScopeCamera 标记，DrawScopeContent/EndFrame 清空）；
+		// 装配瞄具的 EquipWatcher 线程不能访问。瞄具节点在玩家 3D 之下，每帧都会随玩家根节点更新
+		static void MarkTransformDirty(RE::NiAVObject* node) { s_DirtyNodes.Mark(node); }
+		static DirtyNodeSet<RE::NiAVObject>& GetDirtyNodes() { return s_DirtyNodes; }
 		static void ApplyScopeSettings(const DataPersistence::ScopeConfig* config);
 		static void SetupScopeForWeapon(const DataPersistence::WeaponInfo& weaponInfo);
 		static int GetScopeNodeIndexCount();
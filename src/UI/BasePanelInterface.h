@@ -85,5 +85,8 @@ namespace ThroughScope
         // 标记有未保存的更改
         virtual void MarkUnsavedChanges() = 0;
         virtual void MarkSaved() = 0;
+
+        // 确保文本（文件名等用户可见名称）中的 CJK 字符在字体图集中
+        virtual void RequestGlyphs(std::string_view text) = 0;
     };
 }
@@ -0,0 +1,149 @@
+#include "GlyphSet.h"
+
+namespace ThroughScope
+{
+    namespace
+    {
+        constexpr uint32_t kBmpSize = 0x10000;
+
+        // CJK Extension A, CJK Unified Ideographs, Hangul Syllables, CJK Compatibility Ideographs
+        constexpr uint32_t kDynamicBlocks[][2] = {
+            { 0x3400, 0x4DBF },
+            { 0x4E00, 0x9FFF },
+            { 0xAC00, 0xD7AF },
+            { 0xF900, 0xFAFF },
+        };
+
+        /**
+         * Decode one code point starting at text[i] and advance i; returns false for an invalid
+         * sequence (i then moves past the lead byte only)
+         */
+        bool DecodeUtf8(std::string_view text, size_t& i, uint32_t& codePoint)
+        {
+            const uint8_t lead = static_cast<uint8_t>(text[i++]);
+            size_t length = 0;
+            uint32_t minimum = 0;
+            if (lead < 0x80) {
+                codePoint = lead;
+                return true;
+            } else if ((lead & 0xE0) == 0xC0) {
+                length = 1;
+                minimum = 0x80;
+                codePoint = lead & 0x1F;
+            } else if ((lead & 0xF0) == 0xE0) {
+                length = 2;
+                minimum = 0x800;
+                codePoint = lead & 0x0F;
+            } else if ((lead & 0xF8) == 0xF0) {
+                length = 3;
+                minimum = 0x10000;
+                codePoint = lead & 0x07;
+            } else {
+                return false;
+            }
+
+            if (text.size() - i < length) {
+                return false;
+            }
+            for (size_t k = 0; k < length; ++k) {
+                const uint8_t next = static_cast<uint8_t>(text[i + k]);
+                if ((next & 0xC0) != 0x80) {
+                    return false;
+                }
+                codePoint = (codePoint << 6) | (next & 0x3F);
+            }
+            i += length;
+            // Overlong encodings and surrogates are not valid UTF-8
+            return codePoint >= minimum && codePoint <= 0x10FFFF && (codePoint < 0xD800 || codePoint > 0xDFFF);
+        }
+    }
+
+    bool GlyphSet::IsDynamic(uint32_t codePoint)
+    {
+        for (const auto& block : kDynamicBlocks) {
+            if (codePoint >= block[0] && codePoint <= block[1]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t GlyphSet::AddUtf8(std::string_view text)
+    {
+        const size_t before = m_Count;
+        size_t i = 0;
+        while (i < text.size()) {
+            // ASCII never holds a dynamic code point
+            if (static_cast<uint8_t>(text[i]) < 0x80) {
+                ++i;
+                continue;
+            }
+            uint32_t codePoint = 0;
+            if (DecodeUtf8(text, i, codePoint)) {
+                Add(codePoint);
+            }
+        }
+        return m_Count - before;
+    }
+
+    bool GlyphSet::Add(uint32_t codePoint)
+    {
+        if (!IsDynamic(codePoint)) {
+            return false;
+        }
+        if (m_Bits.empty()) {
+            m_Bits.assign(kBmpSize / 64, 0);
+        }
+        uint64_t& word = m_Bits[codePoint / 64];
+        const uint64_t bit = uint64_t(1) << (codePoint % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++m_Count;
+        return true;
+    }
+
+    bool GlyphSet::Contains(uint32_t codePoint) const
+    {
+        if (m_Bits.empty() || codePoint >= kBmpSize) {
+            return false;
+        }
+        return (m_Bits[codePoint / 64] >> (codePoint % 64)) & 1;
+    }
+
+    void GlyphSet::Clear()
+    {
+        m_Bits.clear();
+        m_Count = 0;
+    }
+
+    void GlyphSet::AppendRanges(std::vector<uint32_t>& ranges) const
+    {
+        if (m_Count == 0) {
+            return;
+        }
+        for (const auto& block : kDynamicBlocks) {
+            uint32_t codePoint = block[0];
+            while (codePoint <= block[1]) {
+                const uint64_t word = m_Bits[codePoint / 64];
+                // Skip empty words in one step
+                if (word == 0 && codePoint % 64 == 0) {
+                    codePoint += 64;
+                    continue;
+                }
+                if (!((word >> (codePoint % 64)) & 1)) {
+                    ++codePoint;
+                    continue;
+                }
+                const uint32_t first = codePoint;
+                while (codePoint + 1 <= block[1] && Contains(codePoint + 1)) {
+                    ++codePoint;
+                }
+                ranges.push_back(first);
+                ranges.push_back(codePoint);
+                ++codePoint;
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// Portable set of the CJK code points the UI actually shows, turned into font atlas glyph ranges.
+// No ImGui / CommonLib dependencies; ImGuiManager feeds it UI text and rebuilds the atlas when it grows.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Code points of the large CJK blocks used by the UI
+     *
+     * The CJK ideograph and Hangul syllable blocks hold ~40k characters; rasterizing them all
+     * (GetGlyphRangesChineseFull / Korean) makes the atlas huge and every rebuild slow. Only the
+     * characters that occur in the language table and user-visible names are collected here;
+     * the small blocks (Latin, Cyrillic, kana, punctuation, symbols) stay as static ranges.
+     */
+    class GlyphSet
+    {
+    public:
+        /// True for code points of the blocks collected on demand (everything else is static)
+        static bool IsDynamic(uint32_t codePoint);
+
+        /**
+         * @brief Add the dynamic code points of a UTF-8 string
+         * @return Number of code points that were not in the set yet
+         *
+         * Invalid UTF-8 bytes are skipped.
+         */
+        size_t AddUtf8(std::string_view text);
+
+        /// @return true when the code point is dynamic and was not in the set yet
+        bool Add(uint32_t codePoint);
+        bool Contains(uint32_t codePoint) const;
+        size_t Size() const { return m_Count; }
+        void Clear();
+
+        /**
+         * @brief Append the set as sorted, merged [first, last] pairs (ImFontAtlas range format,
+         *        without the terminating 0)
+         */
+        void AppendRanges(std::vector<uint32_t>& ranges) const;
+
+    private:
+        // One bit per BMP code point, allocated on the first insertion
+        std::vector<uint64_t> m_Bits;
+        size_t m_Count = 0;
+    };
+}
@@ -234,6 +234,9 @@ namespace ThroughScope
 		ImGui_ImplWin32_NewFrame();
 		ImGui::NewFrame();
 
+		// 键盘和 IME 输入的字符会显示在 InputText 中，同样加入图集（下一帧重建后显示）
+		RequestInputGlyphs();
+
 		// 渲染主菜单
 		RenderMainMenu();
 
@@ -252,8 +255,15 @@ namespace ThroughScope
 
 	void ImGuiManager::Update()
 	{
+		// 语言切换后把新语言表中的字符加入图集
+		auto localization = LocalizationManager::GetSingleton();
+		if (localization->IsInitialized() && localization->GetCurrentLanguage() != m_GlyphLanguage) {
+			CollectLanguageGlyphs();
+		}
+
 		// 处理字体重建请求（在渲染循环外）
 		if (m_FontRebuildRequested) {
+			m_GlyphRebuildRequested = false;
 			m_FontRebuildRequested = false;
 			RebuildFonts();
 			
@@ -264,6 +274,10 @@ namespace ThroughScope
 			} else {
 				SetDebugText("Font rebuilt for language support");
 			}
+		} else if (m_GlyphRebuildRequested) {
+			// 新字符的增量重建，不覆盖状态栏文本
+			m_GlyphRebuildRequested = false;
+			RebuildFonts();
 		}
 		
 
@@ -463,16 +477,22 @@ namespace ThroughScope
 	{
 		if (text && strlen(text) < sizeof(m_DebugText)) {
 			strcpy_s(m_DebugText, sizeof(m_DebugText), text);
+			RequestGlyphs(m_DebugText);
 		}
 	}
 
 	DataPersistence::WeaponInfo ImGuiManager::GetCurrentWeaponInfo()
 	{
-		return DataPersistence::GetCurrentWeaponInfo();
+		DataPersistence::WeaponInfo weaponInfo = DataPersistence::GetCurrentWeaponInfo();
+		RequestGlyphs(weaponInfo.weaponModName);
+		RequestGlyphs(weaponInfo.configSource);
+		return weaponInfo;
 	}
 
 	void ImGuiManager::ShowErrorDialog(const std::string& title, const std::string& message)
 	{
+		RequestGlyphs(title);
+		RequestGlyphs(message);
 		m_ErrorDialog.title = title;
 		m_ErrorDialog.message = message;
 		m_ErrorDialog.show = true;
@@ -493,7 +513,19 @@ namespace ThroughScope
 		fontConfig.MergeMode = false;  // 第一个字体不使用合并模式
 		fontConfig.PixelSnapH = true;
 		
-		// 创建扩展的字符范围组合（包含所有需要的字符）
+		// 确保当前语言表中的字符已收集（首次加载时 Update 尚未运行）
+		auto localization = LocalizationManager::GetSingleton();
+		if (localization->IsInitialized() && localization->GetCurrentLanguage() != m_GlyphLanguage) {
+			CollectLanguageGlyphs();
+			m_GlyphRebuildRequested = false;  // 这次构建已经包含
+		}
+
+		// 借用其他 MOD 的 ImGui 上下文时无法按需重建图集，也无法保证所有文本来源都经过 RequestGlyphs，
+		// 此时 CJK 统一汉字和韩文音节整块加载
+		const bool fullCJKRanges = !m_CreatedImGuiContext;
+
+		// 静态字符范围：体积小的字符块全部加载
+		// CJK 统一汉字和韩文音节（共约 4 万字）不再整块加载，只加载 m_GlyphSet 中实际出现的字符
 		static const ImWchar ranges[] =
 		{
 			0x0020, 0x00FF, // 基本拉丁文 + 拉丁文补充
@@ -511,11 +543,53 @@ namespace ThroughScope
 			0x2700, 0x27BF, // 装饰符号（包含✓等符号）
 			0x3000, 0x30FF, // CJK符号和标点、平假名、片假名
 			0x31F0, 0x31FF, // 片假名语音扩展
+			0xFF00, 0xFFEF, // 半角及全角形式
+			0,
+		};
+
+		// CJK 字体只需要假名、CJK 标点和全角形式，其余为动态字符
+		static const ImWchar cjkRanges[] =
+		{
+			0x3000, 0x30FF, // CJK符号和标点、平假名、片假名
+			0x31F0, 0x31FF, // 片假名语音扩展
+			0xFF00, 0xFFEF, // 半角及全角形式
+			0,
+		};
+
+		// 整块加载时的 CJK 统一汉字和韩文音节
+		static const ImWchar fullCJKBlocks[] =
+		{
 			0x4E00, 0x9FAF, // CJK统一汉字
 			0xAC00, 0xD7AF, // 韩文音节
-			0xFF00, 0xFFEF, // 半角及全角形式
 			0,
 		};
+
+		// 静态范围 + 动态收集的 CJK 字符（成对的 [first, last]，以 0 结尾）
+		std::vector<uint32_t> dynamicRanges;
+		if (fullCJKRanges) {
+			for (const ImWchar* range = fullCJKBlocks; *range; ++range) {
+				dynamicRanges.push_back(*range);
+			}
+		} else {
+			m_GlyphSet.AppendRanges(dynamicRanges);
+		}
+		auto buildRanges = [&dynamicRanges](const ImWchar* staticRanges, std::vector<ImWchar>& out) {
+			out.clear();
+			for (const ImWchar* range = staticRanges; *range; ++range) {
+				out.push_back(*range);
+			}
+			for (uint32_t codePoint : dynamicRanges) {
+				out.push_back(static_cast<ImWchar>(codePoint));
+			}
+			out.push_back(0);
+		};
+		buildRanges(ranges, m_BaseGlyphRanges);
+		buildRanges(cjkRanges, m_CJKGlyphRanges);
+
+		// 合并的 CJK 字体：整块加载时使用 ImGui 内置的完整范围
+		auto cjkFontRanges = [&](const ImWchar* fullRanges) {
+			return fullCJKRanges ? fullRanges : m_CJKGlyphRanges.data();
+		};
 		
 		// 首先尝试加载一个支持多种语言的字体作为基础
 		ImFont* baseFont = nullptr;
@@ -530,7 +604,7 @@ namespace ThroughScope
 		
 		for (const auto& systemFont : systemFonts) {
 			if (std::filesystem::exists(systemFont)) {
-				baseFont = io.Fonts->AddFontFromFileTTF(systemFont.c_str(), 16.0f, &fontConfig, ranges);
+				baseFont = io.Fonts->AddFontFromFileTTF(systemFont.c_str(), 16.0f, &fontConfig, m_BaseGlyphRanges.data());
 				if (baseFont) {
 
 					break;
@@ -550,28 +624,28 @@ namespace ThroughScope
 		std::string chineseFontPath = fontBasePath + "sc.ttc";
 		if (std::filesystem::exists(chineseFontPath)) {
 			io.Fonts->AddFontFromFileTTF(chineseFontPath.c_str(), 16.0f, &fontConfig, 
-				io.Fonts->GetGlyphRangesChineseFull());
+				cjkFontRanges(io.Fonts->GetGlyphRangesChineseFull()));
 		}
 
 		// 合并繁体中文字体
 		std::string chineseTraditionFontPath = fontBasePath + "tc.ttc";
 		if (std::filesystem::exists(chineseTraditionFontPath)) {
 			io.Fonts->AddFontFromFileTTF(chineseTraditionFontPath.c_str(), 16.0f, &fontConfig,
-				io.Fonts->GetGlyphRangesChineseFull());
+				cjkFontRanges(io.Fonts->GetGlyphRangesChineseFull()));
 		}
 		
 		// 合并日语字体
 		std::string japaneseFontPath = fontBasePath + "jp.ttc";
 		if (std::filesystem::exists(japaneseFontPath)) {
 			io.Fonts->AddFontFromFileTTF(japaneseFontPath.c_str(), 16.0f, &fontConfig, 
-				io.Fonts->GetGlyphRangesJapanese());
+				cjkFontRanges(io.Fonts->GetGlyphRangesJapanese()));
 		}
 		
 		// 合并韩语字体
 		std::string koreanFontPath = fontBasePath + "ko.ttf";
 		if (std::filesystem::exists(koreanFontPath)) {
 			io.Fonts->AddFontFromFileTTF(koreanFontPath.c_str(), 16.0f, &fontConfig, 
-				io.Fonts->GetGlyphRangesKorean());
+				cjkFontRanges(io.Fonts->GetGlyphRangesKorean()));
 		}
 		
 		// 合并俄语字体（西里尔字符）
@@ -604,6 +678,13 @@ namespace ThroughScope
 		
 		// 构建字体图集
 		io.Fonts->Build();
+		if (fullCJKRanges) {
+			logger::info("Font atlas built with full CJK ranges (shared ImGui context), {}x{} texture",
+				io.Fonts->TexWidth, io.Fonts->TexHeight);
+		} else {
+			logger::info("Font atlas built: {} CJK glyphs collected, {}x{} texture",
+				m_GlyphSet.Size(), io.Fonts->TexWidth, io.Fonts->TexHeight);
+		}
 		
 		// 设置默认字体为合并后的字体
 		io.FontDefault = baseFont;
@@ -650,6 +731,49 @@ namespace ThroughScope
 
 	}
 
+	void ImGuiManager::RequestGlyphs(std::string_view text)
+	{
+		// 借用其他 MOD 的 ImGui 上下文时不自动重建（LoadLanguageFonts 会清除对方的字体，图集已整块加载 CJK）
+		if (m_GlyphSet.AddUtf8(text) > 0 && m_CreatedImGuiContext) {
+			m_GlyphRebuildRequested = true;
+		}
+	}
+
+	void ImGuiManager::RequestInputGlyphs()
+	{
+		if (!m_CreatedImGuiContext) {
+			return;
+		}
+
+		// 本帧输入队列中的字符（WM_CHAR，包括 IME 提交的文字），在 NewFrame 之后、EndFrame 清空之前读取
+		const ImGuiIO& io = ImGui::GetIO();
+		for (int i = 0; i < io.InputQueueCharacters.Size; ++i) {
+			if (m_GlyphSet.Add(io.InputQueueCharacters[i])) {
+				m_GlyphRebuildRequested = true;
+			}
+		}
+	}
+
+	void ImGuiManager::CollectLanguageGlyphs()
+	{
+		auto localization = LocalizationManager::GetSingleton();
+		m_GlyphLanguage = localization->GetCurrentLanguage();
+
+		// 语言选择框显示所有语言名称
+		for (int i = 0; i < static_cast<int>(Language::COUNT); ++i) {
+			RequestGlyphs(localization->GetLanguageName(static_cast<Language>(i)));
+		}
+
+		// 当前语言表，以及缺失键回退的英语表
+		for (Language language : { m_GlyphLanguage, Language::English }) {
+			if (auto translations = localization->GetTranslations(language)) {
+				for (const auto& [key, text] : *translations) {
+					RequestGlyphs(text);
+				}
+			}
+		}
+	}
+
 	void ImGuiManager::ForceHideCursor()
 	{
 		int count = REX::W32::ShowCursor(FALSE);
@@ -20,6 +20,7 @@
 #include "RenderUtilities.h"
 #include "ScopeCamera.h"
 #include "LocalizationManager.h"
+#include "GlyphSet.h"
 
 namespace ThroughScope
 {
@@ -50,6 +51,8 @@ namespace ThroughScope
 		void UpdateFontsForLanguage(Language language);
 		void RebuildFonts();
 		void RequestFontRebuild();
+		void RequestGlyphs(std::string_view text) override;
+		size_t GetDynamicGlyphCount() const { return m_GlyphSet.Size(); }
 
 	private:
 		ImGuiManager() = default;
@@ -60,8 +63,16 @@ namespace ThroughScope
 		void ShutdownPanels();
 
 		// 字体管理
-		
+		// 收集当前语言表和语言名称中的 CJK 字符（语言切换时在 Update 中调用）
+		void CollectLanguageGlyphs();
+		// 收集本帧键盘/IME 输入的 CJK 字符（粘贴的文本由各 InputText 调用 RequestGlyphs）
+		void RequestInputGlyphs();
 
+		// 图集只包含实际出现过的 CJK 字符，出现新字符时增量重建（借用其他 MOD 的上下文时整块加载）
+		GlyphSet m_GlyphSet;
+		std::vector<ImWchar> m_BaseGlyphRanges;  // ImFontAtlas 保存的是指针，必须与图集同生命周期
+		std::vector<ImWchar> m_CJKGlyphRanges;
+		Language m_GlyphLanguage = Language::COUNT;
 
 		// UI渲染
 		void RenderMainMenu();
@@ -90,6 +101,7 @@ namespace ThroughScope
 		bool m_MenuOpen = false;
 		bool m_HasUnsavedChanges = false;
 		bool m_FontRebuildRequested = false;  // 添加字体重建请求标志
+		bool m_GlyphRebuildRequested = false; // 出现新 CJK 字符，静默重建字体图集
 		bool m_CreatedImGuiContext = false;   // 跟踪是否由我们创建了ImGui上下文
 		bool m_BorrowedCursor = false;        // Track if we are sharing visibility with another tool (e.g. ENB)
 
@@ -136,6 +136,12 @@ namespace ThroughScope
         return m_FormatBuffer;
     }
 
+    const std::unordered_map<std::string, std::string>* LocalizationManager::GetTranslations(Language language) const
+    {
+        auto langIt = m_Translations.find(language);
+        return langIt != m_Translations.end() ? &langIt->second : nullptr;
+    }
+
     const char* LocalizationManager::GetLanguageName(Language language) const 
     {
         int index = static_cast<int>(language);
@@ -457,6 +463,8 @@ namespace ThroughScope
             {"reticle.aspect_ratio", "Aspect Ratio: %.3f"},
             {"reticle.no_preview", "No Preview Available"},
             {"reticle.load_preview", "Load Preview"},
+            {"reticle.loading", "Loading texture..."},
+            {"reticle.load_failed", "Status: ✗ Texture Failed to Load"},
             {"reticle.quick_actions", "Quick Actions"},
             {"reticle.reload_texture", "Reload Texture"},
             {"reticle.reload_success", "Reticle texture reload successful"},
@@ -38,6 +38,9 @@ namespace ThroughScope
         const char* GetText(const char* key) const;
         const char* GetTextFormat(const char* key, ...) const;
         
+        // 某种语言已加载的全部翻译（未加载时返回 nullptr），用于收集字体图集所需字符
+        const std::unordered_map<std::string, std::string>* GetTranslations(Language language) const;
+
         // 语言信息
         const char* GetLanguageName(Language language) const;
         const char* GetLanguageCode(Language language) const;
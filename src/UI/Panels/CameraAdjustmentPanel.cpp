@@ -942,6 +942,7 @@ namespace ThroughScope
 			for (const auto& entry : std::filesystem::directory_iterator(dataPath)) {
 				if (entry.is_regular_file() && entry.path().extension() == ".nif") {
 					std::string fileName = entry.path().filename().string();
+					m_Manager->RequestGlyphs(fileName);
 					m_AvailableNIFFiles.push_back(fileName);
 				}
 			}
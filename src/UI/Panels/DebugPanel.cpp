@@ -1,7 +1,11 @@
 #include "DebugPanel.h"
 #include "rendering/ScopeCulling.h"
+#include "rendering/TexturePool.h"
+#include "rendering/D3DStateCache.h"
+#include "rendering/RenderTargetMerger.h"
 #include "ScopeCamera.h"
 #include "D3DHooks.h"
+#include "FGCompatibility.h"
 #include "Utilities.h"
 #include "fmt/format.h"
 
@@ -222,6 +226,336 @@ namespace ThroughScope
 		ImGui::Separator();
 		ImGui::Spacing();
 
+		// ========== Texture Pool ==========
+		auto texturePool = TexturePool::GetSingleton();
+		uint64_t poolHits = texturePool->GetHitCount();
+		uint64_t poolMisses = texturePool->GetMissCount();
+		uint64_t poolTotal = poolHits + poolMisses;
+		ImGui::Text("Texture Pool");
+		ImGui::BulletText("Entries: %zu", texturePool->GetEntryCount());
+		ImGui::BulletText("Hits: %llu  Misses: %llu  (%.1f%% hit)",
+			poolHits, poolMisses, poolTotal ? 100.0 * poolHits / poolTotal : 0.0);
+		RenderHelpTooltip("Transient scope-pass textures reused across frames.\nMisses only grow on first use or after a resolution change.");
+
+		// ========== D3D State Cache ==========
+		auto stateCache = D3DStateCache::GetSingleton();
+		ImGui::Text("D3D State Cache");
+		ImGui::BulletText("Live objects: %zu", stateCache->GetLiveCount());
+		ImGui::BulletText("Hits: %llu  Misses: %llu", stateCache->GetHitCount(), stateCache->GetMissCount());
+		RenderHelpTooltip("Depth-stencil, rasterizer, sampler, blend states and scratch constant buffers.\nLive objects should stay constant during play.");
+
+		auto& rtMerger = RenderTargetMerger::GetInstance();
+		ImGui::Text("RT Merge");
+		ImGui::BulletText("Enabled RTs: %d  Draws last frame: %d", rtMerger.GetEnabledCount(), rtMerger.GetLastMergeDrawCount());
+
+		constexpr double kMB = 1024.0 * 1024.0;
+		ImGui::BulletText("Backup memory: %.1f MB reserved / %.1f MB used (%.1f MB requested)",
+			rtMerger.GetReservedBytes() / kMB, rtMerger.GetUsedBytes() / kMB, rtMerger.GetRequestedBytes() / kMB);
+		RenderHelpTooltip("Reserved = backup textures currently allocated.\n"
+			"Used = textures backing a backup in the last scope frame.\n"
+			"Requested = backups taken, before same-size/format sharing.\n"
+			"Everything is released a few seconds after leaving ADS.");
+		int budgetMB = static_cast<int>(rtMerger.GetMemoryBudget() / (1024 * 1024));
+		ImGui::SetNextItemWidth(180);
+		if (ImGui::SliderInt("Backup Budget (MB)", &budgetMB, 64, 2048)) {
+			rtMerger.SetMemoryBudget(static_cast<uint64_t>(budgetMB) * 1024 * 1024);
+		}
+		RenderHelpTooltip("Idle backup textures beyond this budget are released.\nBackups needed in the current frame are always kept.");
+
+		bool writeTracking = rtMerger.IsWriteTrackingEnabled();
+		if (ImGui::Checkbox("Write Tracking", &writeTracking)) {
+			rtMerger.SetWriteTrackingEnabled(writeTracking);
+		}
+		RenderHelpTooltip("Only back up and merge render targets the scope pass actually writes.\n"
+			"Skip = frames with neither backup nor merge. Late = writes backed up on first use.");
+		if (writeTracking && ImGui::TreeNode("Per-RT Skip Rate")) {
+			for (const auto& config : rtMerger.GetConfiguredRTs()) {
+				auto stats = rtMerger.GetWriteStats(config.rtIndex);
+				ImGui::BulletText("RT_%02d %-18s skip %5.1f%%  late %llu", config.rtIndex, config.name,
+					stats.frames ? 100.0 * stats.skipped / stats.frames : 0.0, stats.lateBackups);
+			}
+			ImGui::TreePop();
+		}
+
+		// ========== Region-Limited Scope Pass ==========
+		ImGui::Checkbox("Region-Limited Scope Pass", &SecondPassRenderer::s_RegionLimited);
+		RenderHelpTooltip("Scissor the second pass, its clears, backups and RT merge to the scope aperture.\n"
+			"Pixels outside the aperture keep their first-pass content.");
+		if (SecondPassRenderer::s_RegionLimited) {
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Region Margin", &SecondPassRenderer::s_RegionMargin, 0.0f, 0.25f, "%.3f");
+			RenderHelpTooltip("Extra UV margin around the aperture bounds (covers parallax and distortion).");
+			ImGui::BulletText("Region coverage: %.1f%% of screen", SecondPassRenderer::s_LastRegionCoverage * 100.0f);
+		}
+
+		// ========== Selective Render Target Clears ==========
+		if (ImGui::TreeNode("Render Target Clear Policy")) {
+			auto& clearPolicy = SecondPassRenderer::s_ClearPolicy;
+			bool validating = clearPolicy.IsValidating();
+			if (ImGui::Checkbox("Validate Clear Policy", &validating)) {
+				clearPolicy.SetValidating(validating);
+			}
+			RenderHelpTooltip("Each probe copies one target's scope region after the policy clear and again after the scope pass,\n"
+				"then reads both back a few frames later. Unchanged texels would show stale content without a clear.\n"
+				"A Must Clear target is reported as skippable only if the pass replaced every texel.");
+
+			const char* policyNames[] = { "Must Clear", "Overwritten", "Skip" };
+			const auto& entries = clearPolicy.GetEntries();
+			for (size_t i = 0; i < entries.size(); ++i) {
+				ImGui::PushID((int)i);
+				int policy = (int)entries[i].policy;
+				ImGui::SetNextItemWidth(120);
+				if (ImGui::Combo("##Policy", &policy, policyNames, IM_ARRAYSIZE(policyNames))) {
+					clearPolicy.SetPolicy(i, (ClearPolicyTable::Policy)policy);
+				}
+				ImGui::SameLine();
+				const auto& stats = clearPolicy.GetStats(i);
+				ImGui::Text("RT_%02u  probes %u, leaked %u, max %.2f%%  %s", entries[i].renderTarget, stats.probes,
+					stats.leakedProbes, stats.maxLeakFraction * 100.0f,
+					ClearPolicyTable::GetVerdictName(clearPolicy.GetVerdict(i)));
+				ImGui::PopID();
+			}
+
+			if (ImGui::Button("Reset Policies")) {
+				clearPolicy.ResetPolicies();
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Reset Validation")) {
+				clearPolicy.ResetValidation();
+			}
+			ImGui::TreePop();
+		}
+
+		// ========== Incremental Scene Update ==========
+		ImGui::Checkbox("Incremental Scene Update", &SecondPassRenderer::s_IncrementalSceneUpdate);
+		RenderHelpTooltip("Before the second pass, update only the player, weapon, scope and camera subtrees\n"
+			"instead of the whole parent of the player's 3D (usually the entire cell).");
+
+		// ========== Scope Light Culling ==========
+		ImGui::Checkbox("Scope Light Culling", &SecondPassRenderer::s_LightCulling);
+		RenderHelpTooltip("Cull lights whose radius doesn't reach the scope frustum, then keep the\n"
+			"highest intensity x solid angle lights up to the budget. Ambient lights are always kept.");
+		if (SecondPassRenderer::s_LightCulling) {
+			int lightBudget = (int)SecondPassRenderer::s_LightBudget;
+			ImGui::SetNextItemWidth(180);
+			if (ImGui::SliderInt("Light Budget", &lightBudget, 0, 128)) {
+				SecondPassRenderer::s_LightBudget = (uint32_t)lightBudget;
+			}
+			RenderHelpTooltip("Maximum number of culled-in lights shaded in the scope pass (0 = no limit).");
+			const auto& lightStats = LightBackupSystem::GetSingleton()->GetSelectionStats();
+			ImGui::BulletText("Lights: %u, outside frustum %u, over budget %u, shaded %u", lightStats.candidates,
+				lightStats.culled, lightStats.overBudget, lightStats.selected);
+		}
+		const auto& writeStats = LightBackupSystem::GetSingleton()->GetWriteStats();
+		ImGui::BulletText("Light fields written: apply %u (%u lights), restore %u (%u lights) of %u lights",
+			writeStats.appliedFields, writeStats.appliedLights, writeStats.restoredFields, writeStats.restoredLights,
+			writeStats.lights);
+		RenderHelpTooltip("Apply/restore only write the light fields that differ from the snapshot.");
+
+		// ========== Scope Shader Variants ==========
+		{
+			auto resManager = D3DResourceManager::GetSingleton();
+			const uint32_t shaderFeatures = D3DHooks::GetScopeShaderFeatures();
+			ImGui::BulletText("Scope shader variants: %zu/%zu loaded, active %s%s",
+				resManager->GetLoadedScopeVariantCount(), ScopeShaderVariants::CountCanonical(),
+				ScopeShaderVariants::GetVariantName(shaderFeatures).c_str(),
+				resManager->GetScopePixelShader(shaderFeatures) == resManager->GetScopePixelShader() ? " (uber fallback)" : "");
+			RenderHelpTooltip("Pre-compiled TrueScopeShader permutations (Data\\Shaders\\XiFeiLi\\TrueScopeShader_*.cso).\n"
+				"Missing variants fall back to the runtime-branching shader.");
+
+			const auto& shaderCache = resManager->GetShaderCache();
+			const auto& cacheStats = shaderCache.GetStats();
+			ImGui::BulletText("Shader cache (%s): %u loaded, %u compiled, %u invalid, %u write failures",
+				shaderCache.IsEnabled() ? shaderCache.GetCompilerVersion().c_str() : "disabled",
+				cacheStats.hits, cacheStats.misses, cacheStats.invalid, cacheStats.writeFailures);
+			RenderHelpTooltip("Runtime-compiled shaders are cached in Data\\F4SE\\Plugins\\TrueThroughScope\\ShaderCache.\n"
+				"Entries are keyed by source, entry point, target, defines, flags and the loaded d3dcompiler DLL version.");
+
+			ImGui::BulletText("Night vision grain: %s", resManager->GetBlueNoiseSRV() ? "blue noise" : "procedural hash");
+			RenderHelpTooltip("Blue-noise grain reads Data\\Textures\\TTS\\BlueNoise64.dds (tools/BlueNoiseGenerator),\n"
+				"offset every frame; without it the shader falls back to the sine hash.");
+
+			if (FGCompatibility::IsActive()) {
+				const uint32_t maskTiles = FGCompatibility::g_LastMaskTileCount.load();
+				const uint32_t maskTotalTiles = FGCompatibility::g_LastMaskTotalTiles.load();
+				if (FGCompatibility::g_LastMaskTiled.load()) {
+					ImGui::BulletText("FG motion-vector mask: %u/%u tiles (%.1f%%)", maskTiles, maskTotalTiles,
+						maskTotalTiles ? 100.0f * float(maskTiles) / float(maskTotalTiles) : 0.0f);
+				} else {
+					ImGui::BulletText("FG motion-vector mask: full-screen dispatch");
+				}
+				RenderHelpTooltip("Only the 8x8 tiles touching the current or previous aperture run the mask shader;\n"
+					"the rest of the motion vectors are copied as a whole. Full-screen when the aperture\n"
+					"covers more than half the tiles or RT_29 cannot be copied directly.");
+			}
+		}
+
+		// ========== Dynamic-Resolution Scope Pass ==========
+		ImGui::Checkbox("Dynamic Resolution Scope Pass", &SecondPassRenderer::s_DynamicResolution);
+		RenderHelpTooltip("Render the second pass at a lower resolution derived from the aperture size\n"
+			"and magnification through the engine's dynamic-resolution viewport,\n"
+			"then upsample in the scope shader.");
+		if (SecondPassRenderer::s_DynamicResolution) {
+			auto& scalerSettings = SecondPassRenderer::s_ResolutionScaler.GetSettings();
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Min Scale", &scalerSettings.minScale, 0.25f, 1.0f, "%.2f");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Max Scale", &scalerSettings.maxScale, scalerSettings.minScale, 1.0f, "%.2f");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Full Detail Magnification", &scalerSettings.fullDetailMagnification, 1.0f, 8.0f, "%.1fx");
+			RenderHelpTooltip("Up to this magnification the aperture keeps native pixel density.");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Magnification Falloff", &scalerSettings.magnificationFalloff, 0.0f, 1.0f, "%.2f");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Max Aperture Pixels", &scalerSettings.maxAperturePixels, 480.0f, 2160.0f, "%.0f");
+			RenderHelpTooltip("Rendered aperture diameter cap, in pixels.");
+
+			int upsampleFilter = D3DHooks::GetScopeUpsampleFilter() - 1;
+			const char* filterNames[] = { "Bilinear", "Catmull-Rom" };
+			ImGui::SetNextItemWidth(180);
+			if (ImGui::Combo("Upsample Filter", &upsampleFilter, filterNames, IM_ARRAYSIZE(filterNames))) {
+				D3DHooks::SetScopeUpsampleFilter(upsampleFilter + 1);
+			}
+
+			ImGui::BulletText("Render scale: %.2f (target %.2f), %.1f%% of the pixels",
+				SecondPassRenderer::s_LastResolutionScale, SecondPassRenderer::s_ResolutionScaler.GetTargetScale(),
+				SecondPassRenderer::s_LastResolutionScale * SecondPassRenderer::s_LastResolutionScale * 100.0f);
+		}
+
+		// ========== Temporal Amortization ==========
+		auto& amortization = SecondPassRenderer::s_Amortization;
+		auto& amortizationSettings = amortization.GetSettings();
+		ImGui::Checkbox("Temporal Amortization", &amortizationSettings.enabled);
+		RenderHelpTooltip("While the camera is nearly still, skip the second pass on some frames and\n"
+			"reproject the last scope image instead. Motion, zoom changes and flashes force a full render.");
+		if (amortizationSettings.enabled) {
+			int renderInterval = (int)amortizationSettings.renderInterval;
+			ImGui::SetNextItemWidth(180);
+			if (ImGui::SliderInt("Render Interval", &renderInterval, 1, 4)) {
+				amortizationSettings.renderInterval = (uint32_t)renderInterval;
+			}
+			RenderHelpTooltip("Render at least every N frames (2 = alternate frames).");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Max Angular Delta", &amortizationSettings.maxAngularDeltaDeg, 0.0f, 0.5f, "%.3f deg");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Max Accumulated Angle", &amortizationSettings.maxAccumulatedAngleDeg, 0.0f, 2.0f, "%.2f deg");
+			RenderHelpTooltip("Rotation allowed since the last full render.");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Max Positional Delta", &amortizationSettings.maxPositionalDelta, 0.0f, 5.0f, "%.2f");
+			int cooldownFrames = (int)amortizationSettings.cooldownFrames;
+			ImGui::SetNextItemWidth(180);
+			if (ImGui::SliderInt("Cooldown Frames", &cooldownFrames, 0, 10)) {
+				amortizationSettings.cooldownFrames = (uint32_t)cooldownFrames;
+			}
+
+			const auto& amortizationStats = amortization.GetStats();
+			ImGui::BulletText("Reprojected: %.1f%% of %llu frames",
+				amortizationStats.frames ? 100.0 * amortizationStats.reprojected / amortizationStats.frames : 0.0,
+				amortizationStats.frames);
+			if (ImGui::TreeNode("Render Reasons")) {
+				using Reason = ScopeAmortizationPolicy::Reason;
+				const char* reasonNames[] = { "Disabled", "No History", "Forced", "Schedule", "Motion", "Zoom", "Flash", "Cooldown", "Reprojected" };
+				static_assert(IM_ARRAYSIZE(reasonNames) == static_cast<size_t>(Reason::Count));
+				for (size_t i = 0; i < static_cast<size_t>(Reason::Count); ++i) {
+					ImGui::BulletText("%-12s %llu", reasonNames[i], amortizationStats.byReason[i]);
+				}
+				ImGui::TreePop();
+			}
+			if (ImGui::Button("Reset Stats")) {
+				amortization.Reset();
+			}
+		}
+
+		// ========== Frame Budget Governor ==========
+		auto& governor = SecondPassRenderer::s_BudgetGovernor;
+		auto& governorSettings = governor.GetSettings();
+		ImGui::Checkbox("Frame Budget Governor", &governorSettings.enabled);
+		RenderHelpTooltip("Measure the scope pass on the GPU and lower its quality step by step\n"
+			"(culling, shadow range, optional RT merges) to hold the budget.");
+		ImGui::BulletText("Scope pass GPU: %.3f ms", SecondPassRenderer::s_LastSecondPassGpuMs);
+		if (governorSettings.enabled) {
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Target", &governorSettings.targetMs, 0.25f, 8.0f, "%.2f ms");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Upper Band", &governorSettings.upperBand, 0.0f, 0.5f, "%.2f");
+			RenderHelpTooltip("Lower quality when the smoothed cost exceeds target * (1 + band).");
+			ImGui::SetNextItemWidth(180);
+			ImGui::SliderFloat("Lower Band", &governorSettings.lowerBand, 0.05f, 0.5f, "%.2f");
+			RenderHelpTooltip("Raise quality when the smoothed cost stays below target * (1 - band).");
+			int degradeFrames = (int)governorSettings.degradeFrames;
+			ImGui::SetNextItemWidth(180);
+			if (ImGui::SliderInt("Degrade Frames", &degradeFrames, 1, 30)) {
+				governorSettings.degradeFrames = (uint32_t)degradeFrames;
+			}
+			int improveFrames = (int)governorSettings.improveFrames;
+			ImGui::SetNextItemWidth(180);
+			if (ImGui::SliderInt("Improve Frames", &improveFrames, 10, 300)) {
+				governorSettings.improveFrames = (uint32_t)improveFrames;
+			}
+
+			const char* actionNames[] = { "Disabled", "Hold", "Settling", "Degrade", "Improve" };
+			const auto& knobs = governor.GetKnobs();
+			ImGui::BulletText("Level %u / %u (%s), smoothed %.3f ms", governor.GetLevel(), governor.GetLevelCount() - 1,
+				actionNames[static_cast<int>(governor.GetLastAction())], governor.GetSmoothedMs());
+			ImGui::BulletText("Margin x%.2f, shadows x%.2f, contribution %.1f px, optional merges %s",
+				knobs.cullingMarginScale, knobs.shadowCasterRangeScale,
+				knobs.contributionCullPixels, knobs.skipOptionalMerges ? "skipped" : "on");
+			if (ImGui::TreeNode("Level Changes")) {
+				for (const auto& event : governor.GetHistory()) {
+					ImGui::BulletText("#%llu  %u -> %u at %.3f ms", event.sample, event.fromLevel, event.toLevel, event.smoothedMs);
+				}
+				ImGui::TreePop();
+			}
+			if (ImGui::Button("Reset Governor")) {
+				governor.Reset();
+			}
+		}
+
+		// ========== Scope Pass Timings ==========
+		if (ImGui::TreeNode("Scope Pass Timings")) {
+			auto& timings = SecondPassRenderer::s_PhaseTimings;
+			ImGui::Text("Rolling window: %zu frames (GPU results lag %u frames)", timings.GetWindow(), GpuTimestampRing::FRAME_LATENCY);
+			ImGui::Columns(7, "ScopePhaseTimings", true);
+			for (const char* header : { "Phase", "CPU avg", "CPU p99", "GPU min", "GPU avg", "GPU p99", "GPU max" }) {
+				ImGui::Text("%s", header);
+				ImGui::NextColumn();
+			}
+			ImGui::Separator();
+			for (size_t phase = 0; phase < timings.GetPhaseCount(); ++phase) {
+				auto cpu = timings.GetSummary(phase, TimingStatsStore::Clock::Cpu);
+				auto gpu = timings.GetSummary(phase, TimingStatsStore::Clock::Gpu);
+				if (cpu.samples == 0 && gpu.samples == 0) {
+					continue;
+				}
+				ImGui::Text("%s", timings.GetPhaseName(phase).c_str());
+				ImGui::NextColumn();
+				for (float value : { cpu.avgMs, cpu.p99Ms, gpu.minMs, gpu.avgMs, gpu.p99Ms, gpu.maxMs }) {
+					ImGui::Text("%.3f", value);
+					ImGui::NextColumn();
+				}
+			}
+			ImGui::Columns(1);
+
+			static std::string s_lastTimingsCsv;
+			if (ImGui::Button("Dump CSV")) {
+				if (!SecondPassRenderer::DumpPhaseTimingsCsv(s_lastTimingsCsv)) {
+					s_lastTimingsCsv = "(failed, see log)";
+				}
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Clear Timings")) {
+				timings.Clear();
+			}
+			if (!s_lastTimingsCsv.empty()) {
+				ImGui::TextWrapped("Last dump: %s", s_lastTimingsCsv.c_str());
+			}
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+		ImGui::Separator();
+		ImGui::Spacing();
+
 		auto weaponInfo = m_Manager->GetCurrentWeaponInfo();
 
 		ImGui::Text(LOC("debug.weapon_information"));
@@ -101,7 +101,9 @@ namespace ThroughScope
 
 		// 搜索过滤器
 		ImGui::SetNextItemWidth(-100);
-		ImGui::InputTextWithHint("##Search", LOC("models.search_placeholder"), &m_SearchFilter);
+		if (ImGui::InputTextWithHint("##Search", LOC("models.search_placeholder"), &m_SearchFilter)) {
+			m_Manager->RequestGlyphs(m_SearchFilter);  // 包括粘贴的文本
+		}
 		ImGui::SameLine();
 		if (ImGui::Button(LOC("button.clear"))) {
 			m_SearchFilter.clear();
@@ -358,6 +360,7 @@ namespace ThroughScope
 			for (const auto& entry : std::filesystem::directory_iterator(dataPath)) {
 				if (IsValidNIFFile(entry.path())) {
 					std::string fileName = entry.path().filename().string();
+					m_Manager->RequestGlyphs(fileName);
 					m_AvailableNIFFiles.push_back(fileName);
 				}
 			}
@@ -32,6 +32,7 @@ namespace ThroughScope
 	void ReticlePanel::Render()
 	{
 		OptimizedScan();
+		UpdatePendingPreview();
 
 		RenderCurrentReticleInfo();
 		ImGui::Spacing();
@@ -97,6 +98,16 @@ namespace ThroughScope
 			} else {
 				ImGui::TextColored(m_ErrorColor, LOC("reticle.status_not_found"));
 			}
+
+			// 后台加载状态（加载期间仍显示旧准星）
+			const auto loadStatus = D3DResourceManager::GetSingleton()->GetReticleLoadStatus();
+			if (loadStatus.path == fullPath) {
+				if (loadStatus.state == AsyncTextureLoader::State::Pending) {
+					ImGui::TextColored(m_WarningColor, LOC("reticle.loading"));
+				} else if (loadStatus.state == AsyncTextureLoader::State::Failed) {
+					ImGui::TextColored(m_ErrorColor, LOC("reticle.load_failed"));
+				}
+			}
 		} else {
 			ImGui::TextColored(m_WarningColor, LOC("reticle.no_texture_selected"));
 		}
@@ -125,7 +136,9 @@ namespace ThroughScope
 
 		// 搜索过滤器
 		ImGui::SetNextItemWidth(-100);
-		ImGui::InputTextWithHint("##Search", LOC("reticle.search_placeholder"), &m_SearchFilter);
+		if (ImGui::InputTextWithHint("##Search", LOC("reticle.search_placeholder"), &m_SearchFilter)) {
+			m_Manager->RequestGlyphs(m_SearchFilter);  // 包括粘贴的文本
+		}
 		ImGui::SameLine();
 		if (ImGui::Button(LOC("button.clear"))) {
 			m_SearchFilter.clear();
@@ -275,6 +288,8 @@ namespace ThroughScope
 			// 显示纹理信息
 			ImGui::Text(LOC("reticle.dimensions"), m_PreviewWidth, m_PreviewHeight);
 			ImGui::Text(LOC("reticle.aspect_ratio"), aspectRatio);
+		} else if (!m_PreviewPendingPath.empty()) {
+			ImGui::TextColored(m_WarningColor, LOC("reticle.loading"));
 		} else {
 			ImGui::TextColored(m_WarningColor, LOC("reticle.no_preview"));
 			if (ImGui::Button(LOC("reticle.load_preview"))) {
@@ -290,8 +305,9 @@ namespace ThroughScope
 		// 由于实时更新，Apply按钮主要用于加载纹理（如果路径改变了）
 		if (ImGui::Button(LOC("reticle.reload_texture"), ImVec2(-1, 0))) {
 			if (LoadTexture(m_CurrentSettings.texturePath)) {
+				// 加载完成后在 UpdatePendingPreview 中报告结果
 				CreateTexturePreview(m_CurrentSettings.texturePath);
-				m_Manager->SetDebugText(LOC("reticle.reload_success"));
+				m_ReportReloadResult = true;
 			} else {
 				m_Manager->ShowErrorDialog(LOC("reticle.reload_error_title"), LOC("reticle.reload_error_desc"));
 			}
@@ -332,13 +348,15 @@ namespace ThroughScope
 	bool ReticlePanel::LoadTexture(const std::string& texturePath)
 	{
 		std::string fullPath = GetFullTexturePath(texturePath);
-		auto srv = D3DHooks::LoadAimSRV(fullPath);
-		bool success = (srv != nullptr);
+		if (texturePath.empty() || !std::filesystem::exists(fullPath)) {
+			logger::error("Failed to load reticle texture: {}", texturePath);
+			return false;
+		}
 
+		// 后台加载，结果通过 D3DResourceManager::GetReticleLoadStatus 查询
+		bool success = D3DHooks::LoadAimTexture(fullPath);
 		if (success) {
-			logger::info("Successfully loaded reticle texture: {}", texturePath);
-		} else {
-			logger::error("Failed to load reticle texture: {}", texturePath);
+			logger::info("Requested reticle texture: {}", texturePath);
 		}
 
 		return success;
@@ -435,61 +453,103 @@ namespace ThroughScope
 	{
 		// 释放之前的预览
 		ReleaseTexturePreview();
+		m_PreviewPendingPath.clear();
 
 		if (texturePath.empty()) {
 			return false;
 		}
 
-		try {
-			std::string fullPath = GetFullTexturePath(texturePath);
-			if (!std::filesystem::exists(fullPath)) {
-				logger::warn("Texture file not found: {}", fullPath);
-				return false;
-			}
+		std::string fullPath = GetFullTexturePath(texturePath);
+		if (!std::filesystem::exists(fullPath)) {
+			logger::warn("Texture file not found: {}", fullPath);
+			return false;
+		}
 
-			// 使用现有的LoadAimSRV函数加载纹理
-			auto srv = D3DHooks::LoadAimSRV(fullPath);
-			if (!srv) {
-				logger::error("Failed to load texture SRV: {}", texturePath);
-				return false;
+		// 预览使用当前准星 SRV；尚未加载时请求加载，就绪后在 UpdatePendingPreview 中显示
+		auto resManager = D3DResourceManager::GetSingleton();
+		const auto status = resManager->GetReticleLoadStatus();
+		const bool loading = status.path == fullPath && status.state == AsyncTextureLoader::State::Pending;
+		if (loading || resManager->GetReticlePath() != fullPath || !resManager->GetReticleSRV()) {
+			if (!loading) {
+				D3DHooks::LoadAimTexture(fullPath);
 			}
+			m_PreviewPendingPath = fullPath;
+			return true;
+		}
 
-			// 获取纹理尺寸信息
-			ID3D11Resource* resource = nullptr;
-			srv->GetResource(&resource);
+		return AdoptTexturePreview(resManager->GetReticleSRV(), texturePath);
+	}
 
-			if (resource) {
-				ID3D11Texture2D* texture = nullptr;
-				HRESULT hr = resource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&texture);
+	bool ReticlePanel::AdoptTexturePreview(ID3D11ShaderResourceView* srv, const std::string& texturePath)
+	{
+		if (!srv) {
+			return false;
+		}
 
-				if (SUCCEEDED(hr) && texture) {
-					D3D11_TEXTURE2D_DESC desc;
-					texture->GetDesc(&desc);
+		// 获取纹理尺寸信息
+		ID3D11Resource* resource = nullptr;
+		srv->GetResource(&resource);
 
-					m_PreviewWidth = static_cast<int>(desc.Width);
-					m_PreviewHeight = static_cast<int>(desc.Height);
+		if (resource) {
+			ID3D11Texture2D* texture = nullptr;
+			HRESULT hr = resource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&texture);
 
-					texture->Release();
-				} else {
-					// 如果无法获取尺寸，使用默认值
-					m_PreviewWidth = 256;
-					m_PreviewHeight = 256;
-				}
+			if (SUCCEEDED(hr) && texture) {
+				D3D11_TEXTURE2D_DESC desc;
+				texture->GetDesc(&desc);
+
+				m_PreviewWidth = static_cast<int>(desc.Width);
+				m_PreviewHeight = static_cast<int>(desc.Height);
 
-				resource->Release();
+				texture->Release();
+			} else {
+				// 如果无法获取尺寸，使用默认值
+				m_PreviewWidth = 256;
+				m_PreviewHeight = 256;
 			}
 
-			// 将SRV设置为ImGui纹理ID
-			m_PreviewTextureID = static_cast<void*>(srv);
+			resource->Release();
+		}
 
-			// 增加引用计数，防止被自动释放
-			srv->AddRef();
+		// 将SRV设置为ImGui纹理ID
+		m_PreviewTextureID = static_cast<void*>(srv);
 
-			logger::info("Texture preview created for: {} ({}x{})", texturePath, m_PreviewWidth, m_PreviewHeight);
-			return true;
-		} catch (const std::exception& e) {
-			logger::error("Error creating texture preview: {}", e.what());
-			return false;
+		// 增加引用计数，准星替换后预览仍然有效
+		srv->AddRef();
+
+		logger::info("Texture preview created for: {} ({}x{})", texturePath, m_PreviewWidth, m_PreviewHeight);
+		return true;
+	}
+
+	void ReticlePanel::UpdatePendingPreview()
+	{
+		if (m_PreviewPendingPath.empty()) {
+			return;
+		}
+
+		auto resManager = D3DResourceManager::GetSingleton();
+		const auto status = resManager->GetReticleLoadStatus();
+		if (status.path == m_PreviewPendingPath && status.state == AsyncTextureLoader::State::Pending) {
+			return;  // 仍在加载，预览区显示加载中
+		}
+
+		const bool failed = status.path == m_PreviewPendingPath && status.state == AsyncTextureLoader::State::Failed;
+		if (!failed && resManager->GetReticlePath() == m_PreviewPendingPath && resManager->GetReticleSRV()) {
+			ReleaseTexturePreview();
+			AdoptTexturePreview(resManager->GetReticleSRV(), m_PreviewPendingPath);
+			m_PreviewPendingPath.clear();
+			if (m_ReportReloadResult) {
+				m_ReportReloadResult = false;
+				m_Manager->SetDebugText(LOC("reticle.reload_success"));
+			}
+			return;
+		}
+
+		// 加载失败，或已被另一个准星请求取代
+		m_PreviewPendingPath.clear();
+		if (m_ReportReloadResult) {
+			m_ReportReloadResult = false;
+			m_Manager->ShowErrorDialog(LOC("reticle.reload_error_title"), LOC("reticle.reload_error_desc"));
 		}
 	}
 
@@ -526,6 +586,7 @@ namespace ThroughScope
 			for (const auto& entry : std::filesystem::directory_iterator(texturePath)) {
 				if (IsValidTextureFile(entry.path())) {
 					std::string fileName = entry.path().filename().string();
+					m_Manager->RequestGlyphs(fileName);
 					m_AvailableTextures.push_back(fileName);
 				}
 			}
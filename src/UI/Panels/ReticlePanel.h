@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BasePanelInterface.h"
+#include <d3d11.h>
 #include <filesystem>
 #include <vector>
 #include <string>
@@ -68,6 +69,8 @@ namespace ThroughScope
         void* m_PreviewTextureID = nullptr;  // ImGui纹理ID
         int m_PreviewWidth = 0;
         int m_PreviewHeight = 0;
+        std::string m_PreviewPendingPath;    // 等待后台加载的纹理完整路径
+        bool m_ReportReloadResult = false;   // "重新加载"按钮：加载完成后报告结果
         
         // 渲染函数
         void RenderCurrentReticleInfo();
@@ -85,6 +88,8 @@ namespace ThroughScope
         
         // 预览相关
         bool CreateTexturePreview(const std::string& texturePath);
+        bool AdoptTexturePreview(ID3D11ShaderResourceView* srv, const std::string& texturePath);
+        void UpdatePendingPreview();  // 异步加载完成后显示预览
         void ReleaseTexturePreview();
         
         // 纹理文件扫描
@@ -0,0 +1,203 @@
+#include "AnalyticScopeMask.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope
+{
+    namespace
+    {
+        void PackEllipse(const AnalyticScopeMask::Ellipse& aperture, float out[4])
+        {
+            out[0] = aperture.centerU;
+            out[1] = aperture.centerV;
+            out[2] = aperture.IsValid() ? 1.0f / aperture.radiusU : 0.0f;
+            out[3] = aperture.IsValid() ? 1.0f / aperture.radiusV : 0.0f;
+        }
+
+        // Same operations and order as insideEllipse() in the shader
+        bool InsideEllipse(const float ellipse[4], float u, float v)
+        {
+            const float dx = (u - ellipse[0]) * ellipse[2];
+            const float dy = (v - ellipse[1]) * ellipse[3];
+            return dx * dx + dy * dy <= 1.0f;
+        }
+
+        struct Span
+        {
+            int32_t first = 0;
+            int32_t last = -1;  // Inclusive; empty when last < first
+
+            bool IsEmpty() const { return last < first; }
+        };
+
+        /**
+         * Pixel columns whose centers fall inside the ellipse for some pixel row in [rowFirst, rowLast],
+         * widened by one pixel on each side (and the rows by one pixel too)
+         */
+        Span EllipseColumnSpan(const float ellipse[4], int32_t rowFirst, int32_t rowLast, uint32_t width, uint32_t height)
+        {
+            Span span;
+            if (!(ellipse[2] > 0.0f) || !(ellipse[3] > 0.0f)) {
+                return span;
+            }
+
+            // Closest pixel-center V of the (widened) rows to the ellipse center
+            const double vMin = (double(rowFirst) - 0.5) / double(height);
+            const double vMax = (double(rowLast) + 1.5) / double(height);
+            const double dv = (std::clamp(double(ellipse[1]), vMin, vMax) - double(ellipse[1])) * double(ellipse[3]);
+            if (dv * dv > 1.0) {
+                return span;
+            }
+
+            // Half width in U at that row, then the pixel columns whose centers lie within it
+            const double halfWidth = std::sqrt(1.0 - dv * dv) / double(ellipse[2]);
+            const double xMin = (double(ellipse[0]) - halfWidth) * double(width) - 0.5;
+            const double xMax = (double(ellipse[0]) + halfWidth) * double(width) - 0.5;
+            span.first = std::max(int32_t(std::ceil(std::max(xMin, -2.0))) - 1, 0);
+            span.last = std::min(int32_t(std::floor(std::min(xMax, double(width) + 1.0))) + 1, int32_t(width) - 1);
+            return span;
+        }
+    }
+
+    void AnalyticScopeMask::BeginFrame()
+    {
+        m_previous = m_current;
+        m_current = {};
+    }
+
+    void AnalyticScopeMask::SetCurrentAperture(const Ellipse& aperture)
+    {
+        m_current.aperture = aperture.IsValid() ? aperture : Ellipse{};
+    }
+
+    void AnalyticScopeMask::MarkCurrentTextureDrawn()
+    {
+        m_current.textureDrawn = true;
+    }
+
+    AnalyticScopeMask::Constants AnalyticScopeMask::BuildConstants(uint32_t width, uint32_t height) const
+    {
+        Constants constants = {};
+        PackEllipse(m_current.aperture, constants.currentEllipse);
+        PackEllipse(m_previous.aperture, constants.previousEllipse);
+        constants.invOutputSize[0] = width ? 1.0f / float(width) : 0.0f;
+        constants.invOutputSize[1] = height ? 1.0f / float(height) : 0.0f;
+        if (m_current.IsAnalytic()) {
+            constants.flags |= kCurrentAnalytic;
+        } else if (m_current.textureDrawn) {
+            constants.flags |= kCurrentTexture;
+        }
+        if (m_previous.IsAnalytic()) {
+            constants.flags |= kPreviousAnalytic;
+        } else if (m_previous.textureDrawn) {
+            constants.flags |= kPreviousTexture;
+        }
+        return constants;
+    }
+
+    bool AnalyticScopeMask::IsAnalytic(const Constants& constants)
+    {
+        return (constants.flags & (kCurrentTexture | kPreviousTexture)) == 0;
+    }
+
+    bool AnalyticScopeMask::IsMasked(const Constants& constants, uint8_t currentMask, uint8_t previousMask, uint32_t x, uint32_t y)
+    {
+        // Pixel center, where the fallback draw rasterizes the mask texture
+        const float u = (float(x) + 0.5f) * constants.invOutputSize[0];
+        const float v = (float(y) + 0.5f) * constants.invOutputSize[1];
+        bool current = false;
+        if (constants.flags & kCurrentAnalytic) {
+            current = InsideEllipse(constants.currentEllipse, u, v);
+        } else if (constants.flags & kCurrentTexture) {
+            current = currentMask != 0;
+        }
+        bool previous = false;
+        if (constants.flags & kPreviousAnalytic) {
+            previous = InsideEllipse(constants.previousEllipse, u, v);
+        } else if (constants.flags & kPreviousTexture) {
+            previous = previousMask != 0;
+        }
+        return current || previous;
+    }
+
+    size_t AnalyticScopeMask::ApplyReference(const Constants& constants, const uint8_t* currentMask,
+        const uint8_t* previousMask, const float* motionVectorsIn, float* motionVectorsOut, uint32_t width, uint32_t height)
+    {
+        size_t masked = 0;
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                const size_t pixel = size_t(y) * width + x;
+                const size_t index = pixel * 2;
+                const uint8_t current = currentMask ? currentMask[pixel] : 0;
+                const uint8_t previous = previousMask ? previousMask[pixel] : 0;
+                if (IsMasked(constants, current, previous, x, y)) {
+                    motionVectorsOut[index + 0] = 0.0f;
+                    motionVectorsOut[index + 1] = 0.0f;
+                    ++masked;
+                } else {
+                    motionVectorsOut[index + 0] = motionVectorsIn[index + 0];
+                    motionVectorsOut[index + 1] = motionVectorsIn[index + 1];
+                }
+            }
+        }
+        return masked;
+    }
+
+    bool AnalyticScopeMask::ClassifyTiles(const Constants& constants, uint32_t width, uint32_t height,
+        std::vector<uint32_t>& tiles)
+    {
+        tiles.clear();
+        if (!IsAnalytic(constants)) {
+            return false;
+        }
+        if (width == 0 || height == 0) {
+            return true;
+        }
+
+        const uint32_t tilesY = (height + kTileSize - 1) / kTileSize;
+        const float* ellipses[2] = {
+            (constants.flags & kCurrentAnalytic) ? constants.currentEllipse : nullptr,
+            (constants.flags & kPreviousAnalytic) ? constants.previousEllipse : nullptr
+        };
+
+        for (uint32_t tileY = 0; tileY < tilesY; ++tileY) {
+            const int32_t rowFirst = int32_t(tileY * kTileSize);
+            const int32_t rowLast = int32_t(std::min((tileY + 1) * kTileSize, height)) - 1;
+
+            Span spans[2];
+            for (int i = 0; i < 2; ++i) {
+                if (ellipses[i]) {
+                    spans[i] = EllipseColumnSpan(ellipses[i], rowFirst, rowLast, width, height);
+                }
+            }
+
+            // Pixel spans -> tile column ranges, merged when they overlap or touch
+            uint32_t ranges[2][2];
+            int rangeCount = 0;
+            for (const Span& span : spans) {
+                if (!span.IsEmpty()) {
+                    ranges[rangeCount][0] = uint32_t(span.first) / kTileSize;
+                    ranges[rangeCount][1] = uint32_t(span.last) / kTileSize;
+                    ++rangeCount;
+                }
+            }
+            if (rangeCount == 2) {
+                if (ranges[1][0] < ranges[0][0]) {
+                    std::swap(ranges[0], ranges[1]);
+                }
+                if (ranges[1][0] <= ranges[0][1] + 1) {
+                    ranges[0][1] = std::max(ranges[0][1], ranges[1][1]);
+                    rangeCount = 1;
+                }
+            }
+
+            for (int r = 0; r < rangeCount; ++r) {
+                for (uint32_t tileX = ranges[r][0]; tileX <= ranges[r][1]; ++tileX) {
+                    tiles.push_back(PackTile(tileX, tileY));
+                }
+            }
+        }
+        return true;
+    }
+}
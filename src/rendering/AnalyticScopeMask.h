@@ -0,0 +1,123 @@
+#pragma once
+
+// Portable CPU side of ApplyMaskToMVCS.hlsl: the current and previous frame's scope aperture
+// ellipses that form the motion-vector mask, packed into the CS constant buffer.
+// No D3D / CommonLib dependencies; FGCompatibility uploads the constants and dispatches the CS.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Motion-vector mask for frame generation, evaluated analytically from the scope aperture
+     *
+     * A pixel is masked (its motion vector zeroed so FG copies it instead of interpolating) when it
+     * lies in the current or the previous frame's mask; the dual mask reduces edge artifacts. A frame
+     * whose scope quad was projected on the CPU is masked by its aperture ellipse, with no texture
+     * read, clear or draw. Only a frame whose projection failed (behind the camera, no bound) falls
+     * back to the R8 texture written by SecondPassRenderer::WriteToMVRegionOverrideMask.
+     */
+    class AnalyticScopeMask
+    {
+    public:
+        /// Thread group size of ApplyMaskToMVCS ([numthreads(8, 8, 1)])
+        static constexpr uint32_t kTileSize = 8;
+
+        /// Aperture in viewport UV (0-1, V down), see ScopeProjection::ScreenEllipse
+        struct Ellipse
+        {
+            float centerU = 0.0f;
+            float centerV = 0.0f;
+            float radiusU = 0.0f;
+            float radiusV = 0.0f;
+
+            bool IsValid() const { return radiusU > 0.0f && radiusV > 0.0f; }
+        };
+
+        /// One frame of the dual mask
+        struct Frame
+        {
+            Ellipse aperture;            // Valid: the mask is this ellipse
+            bool textureDrawn = false;   // Fallback mask texture written (projection failed)
+
+            bool IsAnalytic() const { return aperture.IsValid(); }
+            bool HasMask() const { return IsAnalytic() || textureDrawn; }
+        };
+
+        enum Flags : uint32_t
+        {
+            kCurrentAnalytic = 1 << 0,
+            kPreviousAnalytic = 1 << 1,
+            kCurrentTexture = 1 << 2,
+            kPreviousTexture = 1 << 3,
+        };
+
+        /// Matches cbuffer ScopeMaskConstants in ApplyMaskToMVCS.hlsl
+        struct Constants
+        {
+            float currentEllipse[4];   // centerU, centerV, 1 / radiusU, 1 / radiusV
+            float previousEllipse[4];
+            float invOutputSize[2];    // 1 / width, 1 / height of the dispatched surface
+            uint32_t flags;
+            uint32_t useTileList;      // 1 = one group per entry of the tile list, 0 = full-screen grid
+        };
+        static_assert(sizeof(Constants) == 48, "Constant buffer size must be a multiple of 16 bytes");
+
+        /// Start a frame: the last frame becomes the previous one, the current has no mask
+        void BeginFrame();
+
+        /// Aperture of the scope drawn this frame; an invalid ellipse leaves the frame without one
+        void SetCurrentAperture(const Ellipse& aperture);
+
+        /// The scope was drawn into this frame's mask texture (only used without a valid aperture)
+        void MarkCurrentTextureDrawn();
+
+        const Frame& GetCurrent() const { return m_current; }
+        const Frame& GetPrevious() const { return m_previous; }
+        bool HasAny() const { return m_current.HasMask() || m_previous.HasMask(); }
+
+        Constants BuildConstants(uint32_t width, uint32_t height) const;
+
+        /// No frame reads a mask texture, so masked pixels can only lie in ClassifyTiles' tiles
+        static bool IsAnalytic(const Constants& constants);
+
+        /**
+         * @brief The CS test for pixel (x, y)
+         * @param currentMask, previousMask The mask textures at (x, y), nonzero = stencil passed;
+         *        only read for frames flagged kCurrentTexture / kPreviousTexture
+         */
+        static bool IsMasked(const Constants& constants, uint8_t currentMask, uint8_t previousMask, uint32_t x, uint32_t y);
+
+        /**
+         * @brief CPU reference of ApplyMaskToMVCS: copy width x height RG motion vectors,
+         *        zeroing masked pixels
+         * @param currentMask, previousMask width x height mask textures (R8, nonzero = scope);
+         *        may be null when the matching frame is analytic
+         * @return Number of masked pixels
+         */
+        static size_t ApplyReference(const Constants& constants, const uint8_t* currentMask, const uint8_t* previousMask,
+            const float* motionVectorsIn, float* motionVectorsOut, uint32_t width, uint32_t height);
+
+        /// Tile list entry: tile column in the low 16 bits, tile row in the high 16 bits
+        static uint32_t PackTile(uint32_t tileX, uint32_t tileY) { return tileX | (tileY << 16); }
+
+        /**
+         * @brief Collect the kTileSize x kTileSize tiles of a width x height surface that intersect
+         *        the aperture ellipses, row by row, left to right
+         *
+         * Conservative: the ellipse spans are widened by one pixel on every side so CPU/GPU float
+         * differences at the boundary never drop a tile; tiles outside the list hold no masked
+         * pixel and only need a plain copy. Works per tile row (one span per ellipse), so the cost
+         * is the number of rows plus the number of emitted tiles.
+         *
+         * @return false (and no tiles) when a frame uses the mask texture: the whole surface needs the CS
+         */
+        static bool ClassifyTiles(const Constants& constants, uint32_t width, uint32_t height, std::vector<uint32_t>& tiles);
+
+    private:
+        Frame m_current;
+        Frame m_previous;
+    };
+}
@@ -0,0 +1,208 @@
+#include "AsyncTextureLoader.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace ThroughScope
+{
+    namespace
+    {
+        constexpr uint32_t kDDSMagic = 0x20534444;  // "DDS "
+        constexpr uint32_t kDDSHeaderSize = 124;
+        constexpr uint32_t kDDSPixelFormatSize = 32;
+        constexpr uint32_t kDX10HeaderSize = 20;
+        constexpr uint32_t kDDPFFourCC = 0x4;
+        constexpr uint32_t kFourCCDX10 = 0x30315844;  // "DX10"
+        constexpr uint32_t kMaxDimension = 16384;     // D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION
+
+        uint32_t ReadU32(const uint8_t* data, size_t offset)
+        {
+            uint32_t value;
+            std::memcpy(&value, data + offset, sizeof(value));
+            return value;
+        }
+    }
+
+    AsyncTextureLoader::AsyncTextureLoader() :
+        AsyncTextureLoader(&AsyncTextureLoader::ReadDDSFile)
+    {
+    }
+
+    AsyncTextureLoader::AsyncTextureLoader(FileReader reader) :
+        m_reader(std::move(reader))
+    {
+    }
+
+    AsyncTextureLoader::~AsyncTextureLoader()
+    {
+        Shutdown();
+    }
+
+    void AsyncTextureLoader::SetResourceCreator(ResourceCreator creator)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_creator = std::move(creator);
+    }
+
+    uint64_t AsyncTextureLoader::Request(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_worker.joinable()) {
+            m_stop = false;
+            m_worker = std::thread(&AsyncTextureLoader::WorkerLoop, this);
+        }
+
+        ++m_latestTicket;
+        m_hasRequest = true;
+        m_requestPath = path;
+        m_hasResult = false;
+        m_result = {};
+        m_status = { State::Pending, path, {} };
+        m_wake.notify_one();
+        return m_latestTicket;
+    }
+
+    bool AsyncTextureLoader::TakeResult(Result& result)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_hasResult) {
+            return false;
+        }
+        result = std::move(m_result);
+        m_result = {};
+        m_hasResult = false;
+        return true;
+    }
+
+    void AsyncTextureLoader::Complete(uint64_t ticket, bool success, const std::string& error)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (ticket != m_latestTicket || m_status.state != State::Pending) {
+            return;
+        }
+        m_status.state = success ? State::Ready : State::Failed;
+        m_status.error = success ? std::string() : error;
+    }
+
+    AsyncTextureLoader::Status AsyncTextureLoader::GetStatus() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_status;
+    }
+
+    void AsyncTextureLoader::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_worker.joinable()) {
+                return;
+            }
+            m_stop = true;
+            m_hasRequest = false;
+            m_hasResult = false;
+            m_result = {};
+            if (m_status.state == State::Pending) {
+                m_status = {};
+            }
+        }
+        m_wake.notify_one();
+        m_worker.join();
+    }
+
+    void AsyncTextureLoader::WorkerLoop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [this] { return m_stop || m_hasRequest; });
+            if (m_stop) {
+                return;
+            }
+
+            Result result;
+            result.ticket = m_latestTicket;
+            result.path = m_requestPath;
+            m_hasRequest = false;
+            const ResourceCreator creator = m_creator;
+
+            // File I/O, validation and resource creation outside the lock so Request() never waits
+            lock.unlock();
+            result.success = m_reader(result.path, result.data, result.error);
+            if (result.success && creator) {
+                result.success = creator(result.path, result.data, result.resource, result.error);
+                result.data = {};
+            }
+            if (!result.success) {
+                result.data = {};
+                result.resource.reset();
+            }
+            lock.lock();
+
+            // Superseded while reading: drop it, the loop picks up the newer request
+            if (result.ticket == m_latestTicket && !m_stop) {
+                m_result = std::move(result);
+                m_hasResult = true;
+            }
+        }
+    }
+
+    bool AsyncTextureLoader::ReadDDSFile(const std::string& path, std::vector<uint8_t>& data, std::string& error)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            error = "cannot open file";
+            return false;
+        }
+
+        const std::streamoff size = file.tellg();
+        if (size <= 0) {
+            error = "empty file";
+            return false;
+        }
+        data.resize(static_cast<size_t>(size));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
+            error = "read failed";
+            return false;
+        }
+
+        DDSInfo info;
+        return ParseDDSHeader(data.data(), data.size(), info, error);
+    }
+
+    bool AsyncTextureLoader::ParseDDSHeader(const uint8_t* data, size_t size, DDSInfo& info, std::string& error)
+    {
+        // magic + DDS_HEADER (+ DDS_HEADER_DXT10)
+        if (!data || size < 4 + kDDSHeaderSize) {
+            error = "file too small for a DDS header";
+            return false;
+        }
+        if (ReadU32(data, 0) != kDDSMagic) {
+            error = "not a DDS file";
+            return false;
+        }
+        if (ReadU32(data, 4) != kDDSHeaderSize || ReadU32(data, 4 + 72) != kDDSPixelFormatSize) {
+            error = "invalid DDS header size";
+            return false;
+        }
+
+        info = {};
+        info.height = ReadU32(data, 4 + 8);
+        info.width = ReadU32(data, 4 + 12);
+        info.depth = ReadU32(data, 4 + 20);
+        info.mipCount = ReadU32(data, 4 + 24);
+        const uint32_t pixelFormatFlags = ReadU32(data, 4 + 76);
+        const uint32_t fourCC = ReadU32(data, 4 + 80);
+        info.hasDX10Header = (pixelFormatFlags & kDDPFFourCC) && fourCC == kFourCCDX10;
+
+        if (info.width == 0 || info.height == 0 || info.width > kMaxDimension || info.height > kMaxDimension) {
+            error = "invalid DDS dimensions";
+            return false;
+        }
+        const size_t headerBytes = 4 + kDDSHeaderSize + (info.hasDX10Header ? kDX10HeaderSize : 0);
+        if (size <= headerBytes) {
+            error = "DDS file has no pixel data";
+            return false;
+        }
+        return true;
+    }
+}
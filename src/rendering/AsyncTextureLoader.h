@@ -0,0 +1,124 @@
+#pragma once
+
+// Portable background loader for textures that are swapped in at runtime (the reticle).
+// No D3D / CommonLib dependencies; D3DResourceManager installs a creator that builds the texture
+// on the worker thread, then swaps it in on the render thread and reports the outcome back.
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Latest-wins request queue with one worker thread
+     *
+     * Request() may be called from any thread. The worker reads and validates the file and, when
+     * a ResourceCreator is set, also builds the GPU resource from the bytes; the owner polls
+     * TakeResult() once per frame on the render thread, swaps the resource in and calls
+     * Complete(). A newer request supersedes older ones: results of stale tickets are dropped
+     * (a resource built for one is released on the worker).
+     *
+     * State of the latest request: Pending from Request() until Complete(), then Ready or Failed.
+     */
+    class AsyncTextureLoader
+    {
+    public:
+        enum class State : uint8_t
+        {
+            Idle,
+            Pending,
+            Ready,
+            Failed,
+        };
+
+        struct Status
+        {
+            State state = State::Idle;
+            std::string path;    // Path of the latest request
+            std::string error;   // Set when Failed
+        };
+
+        struct Result
+        {
+            uint64_t ticket = 0;
+            std::string path;
+            std::vector<uint8_t> data;          // File contents; released once a resource was created
+            std::shared_ptr<void> resource;     // Built by the ResourceCreator, null without one
+            bool success = false;
+            std::string error;
+        };
+
+        /// Reads path into data; returns false and sets error on failure. Runs on the worker thread
+        using FileReader = std::function<bool(const std::string& path, std::vector<uint8_t>& data, std::string& error)>;
+
+        /// Builds the resource from a successfully read file; returns false and sets error on failure.
+        /// Runs on the worker thread
+        using ResourceCreator = std::function<bool(const std::string& path, const std::vector<uint8_t>& data,
+            std::shared_ptr<void>& resource, std::string& error)>;
+
+        /// Default reader: ReadDDSFile
+        AsyncTextureLoader();
+        explicit AsyncTextureLoader(FileReader reader);
+        ~AsyncTextureLoader();
+
+        AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+        AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+        /// Applies to requests the worker picks up afterwards; an empty creator hands over the bytes only
+        void SetResourceCreator(ResourceCreator creator);
+
+        /// Queue a load (the worker starts on the first request); returns its ticket
+        uint64_t Request(const std::string& path);
+
+        /// Hand over the finished latest request, if any; stale results are discarded
+        bool TakeResult(Result& result);
+
+        /// Outcome of creating the resource for result.ticket (ignored if a newer request exists)
+        void Complete(uint64_t ticket, bool success, const std::string& error = {});
+
+        Status GetStatus() const;
+
+        /// Stop and join the worker; pending requests are dropped. Request() restarts it
+        void Shutdown();
+
+        /// Whole file, rejected unless it starts with a valid DDS header (see ParseDDSHeader)
+        static bool ReadDDSFile(const std::string& path, std::vector<uint8_t>& data, std::string& error);
+
+        struct DDSInfo
+        {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint32_t depth = 0;
+            uint32_t mipCount = 0;
+            bool hasDX10Header = false;
+        };
+
+        /// Check the magic, header sizes and dimensions of a DDS file in memory
+        static bool ParseDDSHeader(const uint8_t* data, size_t size, DDSInfo& info, std::string& error);
+
+    private:
+        void WorkerLoop();
+
+        FileReader m_reader;
+        ResourceCreator m_creator;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::thread m_worker;
+        bool m_stop = false;
+
+        uint64_t m_latestTicket = 0;
+        bool m_hasRequest = false;       // m_latestTicket not picked up by the worker yet
+        std::string m_requestPath;
+        bool m_hasResult = false;
+        Result m_result;
+        Status m_status;
+    };
+}
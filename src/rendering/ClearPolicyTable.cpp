@@ -0,0 +1,152 @@
+#include "ClearPolicyTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ThroughScope
+{
+    std::vector<ClearPolicyTable::Entry> ClearPolicyTable::DefaultTable()
+    {
+        std::vector<Entry> entries;
+        for (uint32_t rt = 0; rt < 4; ++rt) {
+            entries.push_back({ rt, Policy::MustClear, { 0.0f, 0.0f, 0.0f, 1.0f } });
+        }
+        for (uint32_t rt = 5; rt <= 19; ++rt) {
+            entries.push_back({ rt, Policy::MustClear, { 0.0f, 0.0f, 0.0f, 0.0f } });
+        }
+        for (auto& entry : entries) {
+            // RT8: default normal (0.5, 0.5, 1.0) pointing up
+            if (entry.renderTarget == 8) {
+                entry.clearValue[0] = 0.5f;
+                entry.clearValue[1] = 0.5f;
+                entry.clearValue[2] = 1.0f;
+                entry.clearValue[3] = 1.0f;
+            }
+            // RT17/18: UI and UI temp, not touched before the UI pass
+            if (entry.renderTarget == 17 || entry.renderTarget == 18) {
+                entry.policy = Policy::Skip;
+            }
+        }
+        return entries;
+    }
+
+    ClearPolicyTable::ClearPolicyTable()
+        : m_entries(DefaultTable())
+        , m_stats(m_entries.size())
+    {
+    }
+
+    void ClearPolicyTable::SetPolicy(size_t entry, Policy policy)
+    {
+        if (entry < m_entries.size() && policy < Policy::Count) {
+            m_entries[entry].policy = policy;
+        }
+    }
+
+    void ClearPolicyTable::ResetPolicies()
+    {
+        std::vector<Entry> defaults = DefaultTable();
+        for (size_t i = 0; i < m_entries.size() && i < defaults.size(); ++i) {
+            m_entries[i].policy = defaults[i].policy;
+        }
+    }
+
+    bool ClearPolicyTable::ShouldClear(size_t entry) const
+    {
+        return entry < m_entries.size() && m_entries[entry].policy == Policy::MustClear;
+    }
+
+    void ClearPolicyTable::SetValidating(bool validating)
+    {
+        m_validating = validating;
+    }
+
+    size_t ClearPolicyTable::NextProbe()
+    {
+        if (!m_validating || m_entries.empty()) {
+            return NO_PROBE;
+        }
+        const size_t entry = m_nextProbe % m_entries.size();
+        m_nextProbe = entry + 1;
+        return entry;
+    }
+
+    void ClearPolicyTable::RecordProbe(size_t entry, uint64_t untouchedTexels, uint64_t totalTexels)
+    {
+        if (entry >= m_stats.size() || totalTexels == 0) {
+            return;
+        }
+        ProbeStats& stats = m_stats[entry];
+        const float fraction = static_cast<float>(double(std::min(untouchedTexels, totalTexels)) / double(totalTexels));
+        ++stats.probes;
+        if (untouchedTexels > 0) {
+            ++stats.leakedProbes;
+        }
+        stats.lastLeakFraction = fraction;
+        stats.maxLeakFraction = std::max(stats.maxLeakFraction, fraction);
+    }
+
+    void ClearPolicyTable::ResetValidation()
+    {
+        std::fill(m_stats.begin(), m_stats.end(), ProbeStats{});
+        m_nextProbe = 0;
+    }
+
+    ClearPolicyTable::Verdict ClearPolicyTable::GetVerdict(size_t entry) const
+    {
+        if (entry >= m_entries.size() || m_stats[entry].probes == 0) {
+            return Verdict::Untested;
+        }
+        const ProbeStats& stats = m_stats[entry];
+        switch (m_entries[entry].policy) {
+        case Policy::MustClear:
+            return stats.leakedProbes == 0 ? Verdict::CouldSkipClear : Verdict::Consistent;
+        case Policy::Overwritten:
+            return stats.leakedProbes > 0 ? Verdict::ShouldClear : Verdict::Consistent;
+        default:
+            // Skip accepts stale texels by definition; the leak fraction is informational
+            return Verdict::Consistent;
+        }
+    }
+
+    uint64_t ClearPolicyTable::CountUnchangedTexels(const uint8_t* before, size_t beforePitch, const uint8_t* after,
+        size_t afterPitch, uint32_t width, uint32_t height, size_t texelSize)
+    {
+        const size_t rowBytes = size_t(width) * texelSize;
+        if (!before || !after || texelSize == 0 || beforePitch < rowBytes || afterPitch < rowBytes) {
+            return 0;
+        }
+        uint64_t count = 0;
+        for (uint32_t y = 0; y < height; ++y) {
+            const uint8_t* beforeRow = before + size_t(y) * beforePitch;
+            const uint8_t* afterRow = after + size_t(y) * afterPitch;
+            if (std::memcmp(beforeRow, afterRow, rowBytes) == 0) {
+                count += width;
+                continue;
+            }
+            for (uint32_t x = 0; x < width; ++x) {
+                const size_t offset = size_t(x) * texelSize;
+                if (std::memcmp(beforeRow + offset, afterRow + offset, texelSize) == 0) {
+                    ++count;
+                }
+            }
+        }
+        return count;
+    }
+
+    const char* ClearPolicyTable::GetVerdictName(Verdict verdict)
+    {
+        switch (verdict) {
+        case Verdict::Untested:
+            return "untested";
+        case Verdict::Consistent:
+            return "ok";
+        case Verdict::ShouldClear:
+            return "LEAKS - should clear";
+        case Verdict::CouldSkipClear:
+            return "fully overwritten - could skip";
+        default:
+            return "?";
+        }
+    }
+}
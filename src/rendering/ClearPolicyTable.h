@@ -0,0 +1,108 @@
+#pragma once
+
+// Portable per-render-target clear policy for the scope pass, plus the bookkeeping of the
+// validation mode that checks each policy against what the pass actually writes.
+// No D3D / CommonLib dependencies; entries refer to RendererData::renderTargets indices.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Which render targets SecondPassRenderer::ClearRenderTargets clears, and with what
+     *
+     * Policies:
+     *  - MustClear:   the pass reads or blends over texels it doesn't write; clear every frame
+     *  - Overwritten: the pass writes every texel of the scope region before reading it; no clear
+     *  - Skip:        stale first-pass content is harmless (not read by the pass, restored later)
+     *
+     * Validation probes one entry per probe cycle without touching its contents: the caller copies
+     * the scope region after the policy clear and again after the pass, and reports how many texels
+     * are unchanged (RecordProbe). An Overwritten entry with unchanged texels may show stale content.
+     * A MustClear entry counts texels the pass wrote with the clear value itself as unchanged, so
+     * "never leaks" is only reported when the pass provably replaced every texel and the clear can
+     * be demoted. Only whole-texel writes are detected; a pass that masks some channels counts as
+     * a write.
+     */
+    class ClearPolicyTable
+    {
+    public:
+        enum class Policy : uint8_t
+        {
+            MustClear,
+            Overwritten,
+            Skip,
+            Count
+        };
+
+        enum class Verdict : uint8_t
+        {
+            Untested,
+            Consistent,
+            ShouldClear,     // Not cleared, but the pass leaves texels untouched
+            CouldSkipClear,  // Cleared, but every probe found the region fully overwritten
+        };
+
+        struct Entry
+        {
+            uint32_t renderTarget = 0;
+            Policy policy = Policy::MustClear;
+            float clearValue[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        };
+
+        struct ProbeStats
+        {
+            uint32_t probes = 0;
+            uint32_t leakedProbes = 0;    // Probes that found at least one untouched texel
+            float lastLeakFraction = 0.0f;
+            float maxLeakFraction = 0.0f;
+        };
+
+        static constexpr size_t NO_PROBE = static_cast<size_t>(-1);
+
+        /**
+         * @brief Main targets 0-3 and the auxiliary targets 5-19
+         *
+         * MustClear except the UI targets 17 and 18: the scope pass runs before the UI and
+         * never binds them, and the UI pass clears them itself.
+         */
+        static std::vector<Entry> DefaultTable();
+
+        ClearPolicyTable();
+
+        const std::vector<Entry>& GetEntries() const { return m_entries; }
+        void SetPolicy(size_t entry, Policy policy);
+        void ResetPolicies();
+
+        /// True if ClearRenderTargets clears the entry outside of validation probes
+        bool ShouldClear(size_t entry) const;
+
+        bool IsValidating() const { return m_validating; }
+        void SetValidating(bool validating);
+
+        /// Entry to probe next (round-robin over all entries), NO_PROBE when not validating
+        size_t NextProbe();
+        void RecordProbe(size_t entry, uint64_t untouchedTexels, uint64_t totalTexels);
+        void ResetValidation();
+
+        const ProbeStats& GetStats(size_t entry) const { return m_stats[entry]; }
+        Verdict GetVerdict(size_t entry) const;
+
+        /**
+         * @brief Count texels that are byte-identical in two mapped copies of the same region
+         * @param beforePitch, afterPitch Bytes between rows (>= width * texelSize)
+         */
+        static uint64_t CountUnchangedTexels(const uint8_t* before, size_t beforePitch, const uint8_t* after,
+            size_t afterPitch, uint32_t width, uint32_t height, size_t texelSize);
+
+        static const char* GetVerdictName(Verdict verdict);
+
+    private:
+        std::vector<Entry> m_entries;
+        std::vector<ProbeStats> m_stats;
+        bool m_validating = false;
+        size_t m_nextProbe = 0;
+    };
+}
@@ -4,21 +4,67 @@
 #include <DDSTextureLoader11.h>
 
 #pragma comment(lib, "d3dcompiler.lib")
+#pragma comment(lib, "version.lib")
 
 namespace ThroughScope
 {
+    namespace
+    {
+        // 运行时实际加载的 d3dcompiler DLL 的文件版本。D3D_COMPILER_VERSION 只是导入库的版本，
+        // 系统更新或游戏目录自带的另一个 d3dcompiler_47.dll 构建可能生成不同的字节码
+        std::string GetLoadedCompilerVersion()
+        {
+            HMODULE module = GetModuleHandleW(D3DCOMPILER_DLL_W);
+            wchar_t path[MAX_PATH] = {};
+            if (!module || !GetModuleFileNameW(module, path, MAX_PATH)) {
+                return {};
+            }
+
+            DWORD handle = 0;
+            const DWORD size = GetFileVersionInfoSizeW(path, &handle);
+            if (!size) {
+                return {};
+            }
+            std::vector<uint8_t> info(size);
+            VS_FIXEDFILEINFO* fixedInfo = nullptr;
+            UINT fixedInfoSize = 0;
+            if (!GetFileVersionInfoW(path, 0, size, info.data()) ||
+                !VerQueryValueW(info.data(), L"\\", reinterpret_cast<void**>(&fixedInfo), &fixedInfoSize) || !fixedInfo) {
+                return {};
+            }
+            return ShaderBlobCache::FormatCompilerVersion(D3DCOMPILER_DLL_A, fixedInfo->dwFileVersionMS,
+                fixedInfo->dwFileVersionLS);
+        }
+    }
+
     D3DResourceManager* D3DResourceManager::GetSingleton()
     {
         static D3DResourceManager instance;
         return &instance;
     }
 
+    D3DResourceManager::D3DResourceManager()
+    {
+        m_shaderCache.SetDirectory("Data/F4SE/Plugins/TrueThroughScope/ShaderCache");
+        const std::string compilerVersion = GetLoadedCompilerVersion();
+        if (compilerVersion.empty()) {
+            // 无法确定编译器构建时不缓存，避免读到另一个编译器生成的字节码
+            logger::warn("Could not read the {} version, shader cache disabled", D3DCOMPILER_DLL_A);
+            m_shaderCache.SetEnabled(false);
+        } else {
+            m_shaderCache.SetCompilerVersion(compilerVersion);
+        }
+    }
+
     bool D3DResourceManager::Initialize(ID3D11Device* device)
     {
         if (!device) return false;
 
         HRESULT hr;
 
+        // 0. Reticle textures are created on the loader's worker thread
+        InitReticleLoader(device);
+
         // 1. Create Sampler State
         D3D11_SAMPLER_DESC samplerDesc = {};
         samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
@@ -98,19 +144,101 @@ namespace ThroughScope
              return false;
         }
 
+        // 6. Load Scope Shader Variants (optional; the uber shader above covers missing ones)
+        LoadScopeShaderVariants(device);
+
+        // 7. Load Night-Vision Blue Noise (optional; the shader falls back to the sine hash)
+        LoadBlueNoiseTexture(device);
+
         return true;
     }
 
+    void D3DResourceManager::InitReticleLoader(ID3D11Device* device)
+    {
+        // ID3D11Device 的创建方法是线程安全的（游戏未使用 D3D11_CREATE_DEVICE_SINGLETHREADED），
+        // 解析和上传在后台线程完成；不传 context，不会触碰即时上下文
+        Microsoft::WRL::ComPtr<ID3D11Device> loaderDevice(device);
+        m_reticleLoader.SetResourceCreator(
+            [loaderDevice](const std::string&, const std::vector<uint8_t>& data, std::shared_ptr<void>& resource, std::string& error) {
+                ID3D11ShaderResourceView* srv = nullptr;
+                HRESULT hr = CreateDDSTextureFromMemory(loaderDevice.Get(), data.data(), data.size(), nullptr, &srv);
+                if (FAILED(hr) || !srv) {
+                    error = fmt::format("texture creation failed ({:X})", static_cast<uint32_t>(hr));
+                    return false;
+                }
+                resource = std::shared_ptr<void>(srv, [](void* view) { static_cast<ID3D11ShaderResourceView*>(view)->Release(); });
+                return true;
+            });
+    }
+
+    void D3DResourceManager::LoadBlueNoiseTexture(ID3D11Device* device)
+    {
+        m_blueNoiseSRV.Reset();
+        HRESULT hr = CreateDDSTextureFromFile(device, L"Data/Textures/TTS/BlueNoise64.dds", nullptr, m_blueNoiseSRV.GetAddressOf());
+        if (FAILED(hr)) {
+            m_blueNoiseSRV.Reset();
+            logger::warn("Blue noise texture not found, night vision grain uses the procedural hash");
+        }
+    }
+
+    void D3DResourceManager::LoadScopeShaderVariants(ID3D11Device* device)
+    {
+        m_loadedScopeVariants = 0;
+        for (uint32_t features = 0; features < ScopeShaderVariants::kVariantCount; ++features) {
+            m_scopeVariantShaders[features].Reset();
+            if (!ScopeShaderVariants::IsCanonical(features)) {
+                continue;
+            }
+
+            // 变体只随插件发布预编译的 .cso（compile_shader_variants），缺失时使用通用着色器
+            const std::string name = ScopeShaderVariants::GetVariantName(features);
+            const std::wstring csoPath = L"Data\\Shaders\\XiFeiLi\\" + std::wstring(name.begin(), name.end()) + L".cso";
+
+            ID3DBlob* psBlob = nullptr;
+            HRESULT hr = D3DReadFileToBlob(csoPath.c_str(), &psBlob);
+            if (SUCCEEDED(hr) && psBlob) {
+                hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr,
+                    m_scopeVariantShaders[features].ReleaseAndGetAddressOf());
+            }
+            SAFE_RELEASE(psBlob);
+
+            if (SUCCEEDED(hr) && m_scopeVariantShaders[features]) {
+                m_loadedScopeVariants++;
+            } else {
+                m_scopeVariantShaders[features].Reset();
+                logger::debug("Scope shader variant {} not available, using the uber shader", name);
+            }
+        }
+
+        logger::info("Loaded {}/{} scope shader variants", m_loadedScopeVariants, ScopeShaderVariants::CountCanonical());
+    }
+
+    ID3D11PixelShader* D3DResourceManager::GetScopePixelShader(uint32_t features) const
+    {
+        auto& variant = m_scopeVariantShaders[ScopeShaderVariants::Canonicalize(features)];
+        return variant ? variant.Get() : m_scopePixelShader.Get();
+    }
+
     void D3DResourceManager::Cleanup()
     {
         m_scopePixelShader.Reset();
+        for (auto& variant : m_scopeVariantShaders) {
+            variant.Reset();
+        }
+        m_loadedScopeVariants = 0;
         m_samplerState.Reset();
         m_lutSamplerState.Reset();
         m_blendState.Reset();
         m_constantBuffer.Reset();
         m_scopeTextureView.Reset();
+        m_reticleLoader.Shutdown();
         m_reticleTexture.Reset();
         m_reticleSRV.Reset();
+        m_reticlePath.clear();
+        m_distortionLUTTexture.Reset();
+        m_distortionLUTSRV.Reset();
+        m_distortionLUTVersion = 0;
+        m_blueNoiseSRV.Reset();
     }
 
     HRESULT D3DResourceManager::CreateShaderFromFile(const wchar_t* csoFileNameInOut, const wchar_t* hlslFileName, LPCSTR entryPoint, LPCSTR shaderModel, ID3DBlob** ppBlobOut)
@@ -125,9 +253,19 @@ namespace ThroughScope
             dwShaderFlags |= D3DCOMPILE_DEBUG;
             dwShaderFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
+            ID3DBlob* sourceBlob = nullptr;
+            hr = D3DReadFileToBlob(hlslFileName, &sourceBlob);
+            if (FAILED(hr)) {
+                return hr;
+            }
+
+            // 源文件名同时作为 include 的相对路径和缓存文件名前缀
+            const std::string sourceName = std::filesystem::path(hlslFileName).string();
             ID3DBlob* errorBlob = nullptr;
-            hr = D3DCompileFromFile(hlslFileName, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryPoint, shaderModel,
-                dwShaderFlags, 0, ppBlobOut, &errorBlob);
+            hr = CompileShaderCached(static_cast<const char*>(sourceBlob->GetBufferPointer()), sourceBlob->GetBufferSize(),
+                sourceName.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, entryPoint, shaderModel, dwShaderFlags,
+                ppBlobOut, &errorBlob);
+            SAFE_RELEASE(sourceBlob);
             if (FAILED(hr)) {
                 if (errorBlob != nullptr) {
                     logger::error("Shader Compile Error: {}", reinterpret_cast<const char*>(errorBlob->GetBufferPointer()));
@@ -144,32 +282,138 @@ namespace ThroughScope
         return hr;
     }
 
-    bool D3DResourceManager::LoadReticleTexture(ID3D11Device* device, const std::string& path)
+    HRESULT D3DResourceManager::CompileShaderCached(const char* source, size_t sourceSize, LPCSTR sourceName,
+        const D3D_SHADER_MACRO* defines, ID3DInclude* include, LPCSTR entryPoint, LPCSTR shaderModel, UINT flags,
+        ID3DBlob** ppBlobOut, ID3DBlob** ppErrorBlob)
     {
-        if (path.empty() || !device) return false;
-
-        const wchar_t* tempPath = Utilities::GetWC(path.c_str());
-        std::wstring defaultPath = L"Data/Textures/TTS/Reticle/Empty.dds";
+        if (!source || !ppBlobOut) {
+            return E_INVALIDARG;
+        }
+        *ppBlobOut = nullptr;
+        if (ppErrorBlob) {
+            *ppErrorBlob = nullptr;
+        }
 
-        m_reticleTexture.Reset();
-        m_reticleSRV.Reset();
+        const std::string cacheName = sourceName ? std::filesystem::path(sourceName).stem().string() : std::string();
 
-        HRESULT hr = CreateDDSTextureFromFile(
-            device,
-            tempPath ? tempPath : defaultPath.c_str(),
-            nullptr,
-            m_reticleSRV.GetAddressOf());
+        ShaderBlobCache::Request request;
+        request.name = cacheName;
+        request.source = std::string_view(source, sourceSize);
+        request.entryPoint = entryPoint;
+        request.target = shaderModel;
+        request.flags = flags;
+        for (const D3D_SHADER_MACRO* macro = defines; macro && macro->Name; ++macro) {
+            request.defines.emplace_back(macro->Name, macro->Definition ? macro->Definition : "");
+        }
 
-        if (tempPath) ::free((void*)tempPath);
+        HRESULT compileResult = S_OK;
+        auto compile = [&](std::vector<uint8_t>& blob, std::string& error) {
+            ID3DBlob* code = nullptr;
+            ID3DBlob* errors = nullptr;
+            compileResult = D3DCompile(source, sourceSize, sourceName, defines, include, entryPoint, shaderModel, flags, 0,
+                &code, &errors);
+            if (errors) {
+                error.assign(static_cast<const char*>(errors->GetBufferPointer()), errors->GetBufferSize());
+                SAFE_RELEASE(errors);
+            }
+            if (FAILED(compileResult) || !code) {
+                SAFE_RELEASE(code);
+                return false;
+            }
+            const auto* bytes = static_cast<const uint8_t*>(code->GetBufferPointer());
+            blob.assign(bytes, bytes + code->GetBufferSize());
+            SAFE_RELEASE(code);
+            return true;
+        };
+
+        std::vector<uint8_t> blob;
+        std::string error;
+        const uint32_t writeFailures = m_shaderCache.GetStats().writeFailures;
+        if (!m_shaderCache.GetOrCompile(request, compile, blob, error)) {
+            if (ppErrorBlob && !error.empty() && SUCCEEDED(D3DCreateBlob(error.size() + 1, ppErrorBlob))) {
+                memcpy((*ppErrorBlob)->GetBufferPointer(), error.c_str(), error.size() + 1);
+            }
+            return FAILED(compileResult) ? compileResult : E_FAIL;
+        }
+        if (m_shaderCache.GetStats().writeFailures != writeFailures) {
+            logger::warn("Failed to write shader cache entry for {}", cacheName);
+        }
 
+        HRESULT hr = D3DCreateBlob(blob.size(), ppBlobOut);
         if (FAILED(hr)) {
-            logger::error("Failed to load reticle texture from path: {}", path);
-            return false;
+            return hr;
         }
+        memcpy((*ppBlobOut)->GetBufferPointer(), blob.data(), blob.size());
+        return S_OK;
+    }
 
+    bool D3DResourceManager::RequestReticleTexture(const std::string& path)
+    {
+        if (path.empty()) return false;
+
+        m_reticleLoader.Request(path);
         return true;
     }
 
+    void D3DResourceManager::UpdateReticleTexture()
+    {
+        AsyncTextureLoader::Result result;
+        if (!m_reticleLoader.TakeResult(result)) return;
+
+        // 读取、解析和上传都已在后台线程完成，这里只替换指针；失败时保留旧纹理
+        if (!result.success || !result.resource) {
+            const std::string error = result.success ? "renderer not initialized" : result.error;
+            logger::error("Failed to load reticle texture from path: {} ({})", result.path, error);
+            m_reticleLoader.Complete(result.ticket, false, error);
+            return;
+        }
+
+        // 在帧之间替换，当前帧绑定的仍是旧 SRV
+        m_reticleTexture.Reset();
+        m_reticleSRV = static_cast<ID3D11ShaderResourceView*>(result.resource.get());
+        m_reticlePath = result.path;
+        m_reticleLoader.Complete(result.ticket, true);
+    }
+
+    ID3D11ShaderResourceView* D3DResourceManager::UpdateDistortionLUT(ID3D11Device* device, ID3D11DeviceContext* context,
+        const DistortionLUT& lut)
+    {
+        if (!device || !context || lut.GetVersion() == 0) {
+            return nullptr;
+        }
+
+        if (!m_distortionLUTTexture) {
+            D3D11_TEXTURE2D_DESC desc = {};
+            desc.Width = static_cast<UINT>(DistortionLUT::kSize);
+            desc.Height = 1;
+            desc.MipLevels = 1;
+            desc.ArraySize = 1;
+            desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
+            desc.SampleDesc.Count = 1;
+            desc.Usage = D3D11_USAGE_DEFAULT;
+            desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+            HRESULT hr = device->CreateTexture2D(&desc, nullptr, m_distortionLUTTexture.ReleaseAndGetAddressOf());
+            if (SUCCEEDED(hr)) {
+                hr = device->CreateShaderResourceView(m_distortionLUTTexture.Get(), nullptr, m_distortionLUTSRV.ReleaseAndGetAddressOf());
+            }
+            if (FAILED(hr)) {
+                logger::error("Failed to create distortion LUT texture: {:X}", hr);
+                m_distortionLUTTexture.Reset();
+                m_distortionLUTSRV.Reset();
+                return nullptr;
+            }
+            m_distortionLUTVersion = 0;
+        }
+
+        if (m_distortionLUTVersion != lut.GetVersion()) {
+            context->UpdateSubresource(m_distortionLUTTexture.Get(), 0, nullptr, lut.GetTexels(),
+                static_cast<UINT>(DistortionLUT::kSize * DistortionLUT::kChannels * sizeof(uint16_t)), 0);
+            m_distortionLUTVersion = lut.GetVersion();
+        }
+        return m_distortionLUTSRV.Get();
+    }
+
     bool D3DResourceManager::EnsureStagingTexture(ID3D11Device* device, const D3D11_TEXTURE2D_DESC* desc)
     {
         if (!device || !desc) return false;
@@ -3,6 +3,11 @@
 #include <DirectXMath.h>
 #include <wrl/client.h>
 #include <string>
+#include <array>
+#include "ScopeShaderVariants.h"
+#include "ShaderBlobCache.h"
+#include "DistortionLUT.h"
+#include "AsyncTextureLoader.h"
 
 namespace ThroughScope
 {
@@ -22,7 +27,10 @@ namespace ThroughScope
         // Viewport dimensions
         float viewportWidth;
         float viewportHeight;
-        float padding_viewport[3];
+
+        // Dynamic-resolution scope pass
+        float scopeResolutionScale[2];
+        int scopeUpsampleFilter;    // 0 = 全分辨率, 1 = 双线性, 2 = Catmull-Rom
 
         float cameraPosition[3];
         float padding2;
@@ -67,7 +75,7 @@ namespace ThroughScope
         float parallaxFogRadius;             // 边缘渐变半径
         float parallaxMaxTravel;             // 最大移动距离
         float reticleParallaxStrength;       // 准星偏移强度
-        float _padding1;                     // 对齐填充
+        int useBlueNoise;                    // 1 = 夜视噪点读取蓝噪声纹理
 
         // Distortion
         float sphericalDistortionStrength;
@@ -78,6 +86,12 @@ namespace ThroughScope
         int enableChromaticAberration;
         float brightnessBoost;
         float ambientOffset;
+
+        // Temporal amortization: current NDC (x, y, 1) -> previous homogeneous NDC, one row per float4
+        float reprojection[3][4];
+        int enableReprojection;
+        int useDistortionLUT;           // 1 = 畸变系数从 DistortionLUT 纹理采样
+        float nightVisionNoiseOffset[2];  // 蓝噪声每帧的平铺偏移（纹素）
     };
 
 
@@ -91,6 +105,9 @@ namespace ThroughScope
 
         // Resource Accessors
         ID3D11PixelShader* GetScopePixelShader() const { return m_scopePixelShader.Get(); }
+        // 按功能位选择编译期变体（ScopeShaderVariants::Feature），缺失时返回通用着色器
+        ID3D11PixelShader* GetScopePixelShader(uint32_t features) const;
+        size_t GetLoadedScopeVariantCount() const { return m_loadedScopeVariants; }
         ID3D11SamplerState* GetSamplerState() const { return m_samplerState.Get(); }
         ID3D11SamplerState* GetLUTSamplerState() const { return m_lutSamplerState.Get(); }
         ID3D11BlendState* GetBlendState() const { return m_blendState.Get(); }
@@ -100,10 +117,27 @@ namespace ThroughScope
         void SetScopeTextureView(ID3D11ShaderResourceView* view) { m_scopeTextureView = view; }
 
         ID3D11ShaderResourceView* GetReticleSRV() const { return m_reticleSRV.Get(); }
+        // 当前绑定的准星纹理路径（渲染线程更新）
+        const std::string& GetReticlePath() const { return m_reticlePath; }
+        // 最近一次准星加载请求的状态（Pending 期间仍使用旧纹理）
+        AsyncTextureLoader::Status GetReticleLoadStatus() const { return m_reticleLoader.GetStatus(); }
+        // 夜视蓝噪声（Data/Textures/TTS/BlueNoise64.dds），缺失时为 nullptr，着色器回退到正弦哈希
+        ID3D11ShaderResourceView* GetBlueNoiseSRV() const { return m_blueNoiseSRV.Get(); }
+
+        // 球形畸变/色散系数表：版本变化时上传，返回可用的 SRV（失败时为 nullptr）
+        ID3D11ShaderResourceView* UpdateDistortionLUT(ID3D11Device* device, ID3D11DeviceContext* context, const DistortionLUT& lut);
 
         // Resource Operations
         HRESULT CreateShaderFromFile(const wchar_t* csoFileName, const wchar_t* hlslFileName, LPCSTR entryPoint, LPCSTR shaderModel, ID3DBlob** ppBlobOut);
-        bool LoadReticleTexture(ID3D11Device* device, const std::string& path);
+        // 与 D3DCompile 参数一致（无 Flags2）；结果缓存在 Data/F4SE/Plugins/TrueThroughScope/ShaderCache，
+        // 键为源码、入口、目标、宏、编译选项和运行时加载的编译器 DLL 版本。include 的文件内容不参与键
+        HRESULT CompileShaderCached(const char* source, size_t sourceSize, LPCSTR sourceName, const D3D_SHADER_MACRO* defines,
+            ID3DInclude* include, LPCSTR entryPoint, LPCSTR shaderModel, UINT flags, ID3DBlob** ppBlobOut, ID3DBlob** ppErrorBlob);
+        ShaderBlobCache& GetShaderCache() { return m_shaderCache; }
+        // 后台线程读取、校验 DDS 并创建纹理，渲染线程的 UpdateReticleTexture 中替换
+        bool RequestReticleTexture(const std::string& path);
+        // 渲染线程每帧调用：后台创建成功的准星纹理替换当前 SRV（只交换指针）
+        void UpdateReticleTexture();
         
         // Ensures the staging texture exists and matches the description. Returns true if recreated or valid.
         bool EnsureStagingTexture(ID3D11Device* device, const D3D11_TEXTURE2D_DESC* desc);
@@ -112,12 +146,19 @@ namespace ThroughScope
         void UpdateConstantBuffer(ID3D11DeviceContext* context, const ScopeConstantBuffer& data);
 
     private:
-        D3DResourceManager() = default;
+        D3DResourceManager();
         ~D3DResourceManager() = default;
         D3DResourceManager(const D3DResourceManager&) = delete;
         D3DResourceManager& operator=(const D3DResourceManager&) = delete;
 
+        void LoadScopeShaderVariants(ID3D11Device* device);
+        void LoadBlueNoiseTexture(ID3D11Device* device);
+        void InitReticleLoader(ID3D11Device* device);
+
         Microsoft::WRL::ComPtr<ID3D11PixelShader> m_scopePixelShader;
+        std::array<Microsoft::WRL::ComPtr<ID3D11PixelShader>, ScopeShaderVariants::kVariantCount> m_scopeVariantShaders;
+        size_t m_loadedScopeVariants = 0;
+        ShaderBlobCache m_shaderCache;
         Microsoft::WRL::ComPtr<ID3D11SamplerState> m_samplerState;
         Microsoft::WRL::ComPtr<ID3D11SamplerState> m_lutSamplerState;
         Microsoft::WRL::ComPtr<ID3D11BlendState> m_blendState;
@@ -127,5 +168,11 @@ namespace ThroughScope
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_scopeTextureView;
         Microsoft::WRL::ComPtr<ID3D11Texture2D> m_reticleTexture;
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_reticleSRV;
+        std::string m_reticlePath;
+        AsyncTextureLoader m_reticleLoader;
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> m_distortionLUTTexture;
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_distortionLUTSRV;
+        uint32_t m_distortionLUTVersion = 0;
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_blueNoiseSRV;
     };
 }
@@ -0,0 +1,194 @@
+#include "D3DStateCache.h"
+
+namespace ThroughScope
+{
+    // D3D11_DEPTH_STENCIL_DESC and D3D11_BLEND_DESC contain UINT8 members followed by padding.
+    // Rebuild them field by field into zeroed storage so the bytewise key ignores caller padding.
+    static D3D11_DEPTH_STENCIL_DESC Canonicalize(const D3D11_DEPTH_STENCIL_DESC& desc)
+    {
+        D3D11_DEPTH_STENCIL_DESC result;
+        memset(&result, 0, sizeof(result));
+        result.DepthEnable = desc.DepthEnable;
+        result.DepthWriteMask = desc.DepthWriteMask;
+        result.DepthFunc = desc.DepthFunc;
+        result.StencilEnable = desc.StencilEnable;
+        result.StencilReadMask = desc.StencilReadMask;
+        result.StencilWriteMask = desc.StencilWriteMask;
+        result.FrontFace = desc.FrontFace;
+        result.BackFace = desc.BackFace;
+        return result;
+    }
+
+    static D3D11_BLEND_DESC Canonicalize(const D3D11_BLEND_DESC& desc)
+    {
+        D3D11_BLEND_DESC result;
+        memset(&result, 0, sizeof(result));
+        result.AlphaToCoverageEnable = desc.AlphaToCoverageEnable;
+        result.IndependentBlendEnable = desc.IndependentBlendEnable;
+        for (UINT i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+            const auto& src = desc.RenderTarget[i];
+            auto& dst = result.RenderTarget[i];
+            dst.BlendEnable = src.BlendEnable;
+            dst.SrcBlend = src.SrcBlend;
+            dst.DestBlend = src.DestBlend;
+            dst.BlendOp = src.BlendOp;
+            dst.SrcBlendAlpha = src.SrcBlendAlpha;
+            dst.DestBlendAlpha = src.DestBlendAlpha;
+            dst.BlendOpAlpha = src.BlendOpAlpha;
+            dst.RenderTargetWriteMask = src.RenderTargetWriteMask;
+        }
+        return result;
+    }
+
+    D3DStateCache* D3DStateCache::GetSingleton()
+    {
+        static D3DStateCache instance;
+        return &instance;
+    }
+
+    ID3D11DepthStencilState* D3DStateCache::GetDepthStencilState(ID3D11Device* device, const D3D11_DEPTH_STENCIL_DESC& desc)
+    {
+        if (!device) {
+            return nullptr;
+        }
+        auto* handle = m_devices.Get(device).depthStencilStates.GetOrCreate(Canonicalize(desc),
+            [device](const D3D11_DEPTH_STENCIL_DESC& d, Microsoft::WRL::ComPtr<ID3D11DepthStencilState>& out) {
+                HRESULT hr = device->CreateDepthStencilState(&d, out.GetAddressOf());
+                if (FAILED(hr)) {
+                    logger::error("D3DStateCache: CreateDepthStencilState failed: 0x{:X}", (UINT)hr);
+                    return false;
+                }
+                return true;
+            });
+        return handle ? handle->Get() : nullptr;
+    }
+
+    ID3D11RasterizerState* D3DStateCache::GetRasterizerState(ID3D11Device* device, const D3D11_RASTERIZER_DESC& desc)
+    {
+        if (!device) {
+            return nullptr;
+        }
+        auto* handle = m_devices.Get(device).rasterizerStates.GetOrCreate(desc,
+            [device](const D3D11_RASTERIZER_DESC& d, Microsoft::WRL::ComPtr<ID3D11RasterizerState>& out) {
+                HRESULT hr = device->CreateRasterizerState(&d, out.GetAddressOf());
+                if (FAILED(hr)) {
+                    logger::error("D3DStateCache: CreateRasterizerState failed: 0x{:X}", (UINT)hr);
+                    return false;
+                }
+                return true;
+            });
+        return handle ? handle->Get() : nullptr;
+    }
+
+    ID3D11SamplerState* D3DStateCache::GetSamplerState(ID3D11Device* device, const D3D11_SAMPLER_DESC& desc)
+    {
+        if (!device) {
+            return nullptr;
+        }
+        auto* handle = m_devices.Get(device).samplerStates.GetOrCreate(desc,
+            [device](const D3D11_SAMPLER_DESC& d, Microsoft::WRL::ComPtr<ID3D11SamplerState>& out) {
+                HRESULT hr = device->CreateSamplerState(&d, out.GetAddressOf());
+                if (FAILED(hr)) {
+                    logger::error("D3DStateCache: CreateSamplerState failed: 0x{:X}", (UINT)hr);
+                    return false;
+                }
+                return true;
+            });
+        return handle ? handle->Get() : nullptr;
+    }
+
+    ID3D11BlendState* D3DStateCache::GetBlendState(ID3D11Device* device, const D3D11_BLEND_DESC& desc)
+    {
+        if (!device) {
+            return nullptr;
+        }
+        auto* handle = m_devices.Get(device).blendStates.GetOrCreate(Canonicalize(desc),
+            [device](const D3D11_BLEND_DESC& d, Microsoft::WRL::ComPtr<ID3D11BlendState>& out) {
+                HRESULT hr = device->CreateBlendState(&d, out.GetAddressOf());
+                if (FAILED(hr)) {
+                    logger::error("D3DStateCache: CreateBlendState failed: 0x{:X}", (UINT)hr);
+                    return false;
+                }
+                return true;
+            });
+        return handle ? handle->Get() : nullptr;
+    }
+
+    ID3D11Buffer* D3DStateCache::UploadConstants(ID3D11Device* device, ID3D11DeviceContext* context, const void* data, UINT byteWidth)
+    {
+        if (!device || !context || !data || byteWidth == 0) {
+            return nullptr;
+        }
+        D3D11_BUFFER_DESC cbDesc;
+        memset(&cbDesc, 0, sizeof(cbDesc));
+        cbDesc.ByteWidth = (byteWidth + 15) & ~15u;  // 常量缓冲区必须 16 字节对齐
+        cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+        cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+        auto* handle = m_devices.Get(device).constantBuffers.GetOrCreate(cbDesc,
+            [device](const D3D11_BUFFER_DESC& d, Microsoft::WRL::ComPtr<ID3D11Buffer>& out) {
+                HRESULT hr = device->CreateBuffer(&d, nullptr, out.GetAddressOf());
+                if (FAILED(hr)) {
+                    logger::error("D3DStateCache: CreateBuffer ({} bytes) failed: 0x{:X}", d.ByteWidth, (UINT)hr);
+                    return false;
+                }
+                return true;
+            });
+        if (!handle) {
+            return nullptr;
+        }
+
+        ID3D11Buffer* buffer = handle->Get();
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        if (FAILED(context->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+            return nullptr;
+        }
+        memcpy(mapped.pData, data, byteWidth);
+        context->Unmap(buffer, 0);
+        return buffer;
+    }
+
+    void D3DStateCache::RemoveDevice(ID3D11Device* device)
+    {
+        m_devices.Remove(device);
+    }
+
+    void D3DStateCache::Clear()
+    {
+        m_devices.Clear();
+    }
+
+    uint64_t D3DStateCache::GetHitCount() const
+    {
+        uint64_t hits = 0;
+        m_devices.ForEach([&hits](const DeviceCaches& caches) {
+            hits += caches.depthStencilStates.GetHitCount() + caches.rasterizerStates.GetHitCount() +
+                    caches.samplerStates.GetHitCount() + caches.blendStates.GetHitCount() +
+                    caches.constantBuffers.GetHitCount();
+        });
+        return hits;
+    }
+
+    uint64_t D3DStateCache::GetMissCount() const
+    {
+        uint64_t misses = 0;
+        m_devices.ForEach([&misses](const DeviceCaches& caches) {
+            misses += caches.depthStencilStates.GetMissCount() + caches.rasterizerStates.GetMissCount() +
+                      caches.samplerStates.GetMissCount() + caches.blendStates.GetMissCount() +
+                      caches.constantBuffers.GetMissCount();
+        });
+        return misses;
+    }
+
+    size_t D3DStateCache::GetLiveCount() const
+    {
+        size_t live = 0;
+        m_devices.ForEach([&live](const DeviceCaches& caches) {
+            live += caches.depthStencilStates.GetLiveCount() + caches.rasterizerStates.GetLiveCount() +
+                    caches.samplerStates.GetLiveCount() + caches.blendStates.GetLiveCount() +
+                    caches.constantBuffers.GetLiveCount();
+        });
+        return live;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include "DescKeyedCache.h"
+
+namespace ThroughScope
+{
+    /**
+     * @brief Central cache for immutable D3D11 state objects and scratch constant buffers
+     *
+     * Per-frame code paths (RT merge, MV/GBuffer masks, scope stencil write) used to
+     * create their depth-stencil, rasterizer, sampler and blend states on every call.
+     * Each distinct desc is now created once and the same object is returned afterwards.
+     *
+     * Objects are cached per device: callers that pass another device (e.g. a proxy
+     * device) get their own set, and switching back and forth recreates nothing.
+     * Returned pointers are owned by the cache and stay valid until Clear() or
+     * RemoveDevice(). Render thread only.
+     */
+    class D3DStateCache
+    {
+    public:
+        static D3DStateCache* GetSingleton();
+
+        ID3D11DepthStencilState* GetDepthStencilState(ID3D11Device* device, const D3D11_DEPTH_STENCIL_DESC& desc);
+        ID3D11RasterizerState* GetRasterizerState(ID3D11Device* device, const D3D11_RASTERIZER_DESC& desc);
+        ID3D11SamplerState* GetSamplerState(ID3D11Device* device, const D3D11_SAMPLER_DESC& desc);
+        ID3D11BlendState* GetBlendState(ID3D11Device* device, const D3D11_BLEND_DESC& desc);
+
+        /**
+         * @brief Dynamic constant buffer of at least byteWidth bytes, filled with data
+         *
+         * Buffers are shared per size and written with WRITE_DISCARD, so several passes
+         * in one frame can use the same buffer as long as each binds it right after upload.
+         */
+        ID3D11Buffer* UploadConstants(ID3D11Device* device, ID3D11DeviceContext* context, const void* data, UINT byteWidth);
+
+        /// Drop the objects created on one device (device teardown)
+        void RemoveDevice(ID3D11Device* device);
+
+        void Clear();
+
+        uint64_t GetHitCount() const;
+        uint64_t GetMissCount() const;
+        size_t GetLiveCount() const;
+
+    private:
+        D3DStateCache() = default;
+        ~D3DStateCache() = default;
+        D3DStateCache(const D3DStateCache&) = delete;
+        D3DStateCache& operator=(const D3DStateCache&) = delete;
+
+        struct DeviceCaches
+        {
+            DescKeyedCache<D3D11_DEPTH_STENCIL_DESC, Microsoft::WRL::ComPtr<ID3D11DepthStencilState>> depthStencilStates;
+            DescKeyedCache<D3D11_RASTERIZER_DESC, Microsoft::WRL::ComPtr<ID3D11RasterizerState>> rasterizerStates;
+            DescKeyedCache<D3D11_SAMPLER_DESC, Microsoft::WRL::ComPtr<ID3D11SamplerState>> samplerStates;
+            DescKeyedCache<D3D11_BLEND_DESC, Microsoft::WRL::ComPtr<ID3D11BlendState>> blendStates;
+            DescKeyedCache<D3D11_BUFFER_DESC, Microsoft::WRL::ComPtr<ID3D11Buffer>> constantBuffers;
+        };
+
+        PerDeviceCache<ID3D11Device, DeviceCaches> m_devices;
+    };
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+// Portable cache core for D3D-style immutable objects keyed by their desc struct.
+// No D3D / CommonLib dependencies; D3DStateCache instantiates it for the D3D11 state types.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace ThroughScope
+{
+    /**
+     * @brief FNV-1a over the raw bytes of a desc struct
+     */
+    inline uint64_t HashDescBytes(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Map from a POD desc to the object created from it
+     *
+     * Descs are compared and hashed bytewise, so callers must pass fully zeroed
+     * structs (padding included) for equal states to share one entry.
+     *
+     * @tparam Desc Trivially copyable description struct
+     * @tparam Handle Owning handle stored per entry (e.g. ComPtr<ID3D11BlendState>)
+     */
+    template <class Desc, class Handle>
+    class DescKeyedCache
+    {
+        static_assert(std::is_trivially_copyable_v<Desc>, "Desc must be a POD struct");
+
+    public:
+        /**
+         * @brief Return the cached handle for desc, calling create(desc, handle) on a miss
+         * @return Stored handle, or nullptr if create returned false (nothing is cached)
+         */
+        template <class CreateFn>
+        Handle* GetOrCreate(const Desc& desc, CreateFn&& create)
+        {
+            Key key(desc);
+            auto it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                ++m_hits;
+                return &it->second;
+            }
+
+            ++m_misses;
+            Handle handle{};
+            if (!create(desc, handle)) {
+                return nullptr;
+            }
+
+            auto inserted = m_entries.emplace(key, std::move(handle));
+            return &inserted.first->second;
+        }
+
+        void Clear() { m_entries.clear(); }
+
+        size_t GetLiveCount() const { return m_entries.size(); }
+        uint64_t GetHitCount() const { return m_hits; }
+        uint64_t GetMissCount() const { return m_misses; }
+
+    private:
+        struct Key
+        {
+            explicit Key(const Desc& d) :
+                hash(HashDescBytes(&d, sizeof(Desc)))
+            {
+                std::memcpy(&desc, &d, sizeof(Desc));
+            }
+
+            Desc desc;
+            uint64_t hash;
+
+            bool operator==(const Key& other) const
+            {
+                return hash == other.hash && std::memcmp(&desc, &other.desc, sizeof(Desc)) == 0;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+        };
+
+        std::unordered_map<Key, Handle, KeyHash> m_entries;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+    };
+
+    /**
+     * @brief One set of caches per device
+     *
+     * Objects created on one device must not be bound on another, and callers may hand in
+     * more than one device (the game's and a proxy's) in the same frame. Each device gets its
+     * own Caches instance; switching between devices keeps every instance alive instead of
+     * rebuilding it. The last device looked up is remembered so the common single-device case
+     * skips the map.
+     *
+     * Cached objects normally hold a reference on their device, so a device pointer cannot be
+     * reused while its entry exists; call Remove() when a device is torn down.
+     *
+     * @tparam Device Device type, only used as an identity key
+     * @tparam Caches Default-constructible per-device cache set
+     */
+    template <class Device, class Caches>
+    class PerDeviceCache
+    {
+    public:
+        Caches& Get(const Device* device)
+        {
+            if (device == m_lastDevice && m_last) {
+                return *m_last;
+            }
+
+            auto& slot = m_caches[device];
+            if (!slot) {
+                slot = std::make_unique<Caches>();
+            }
+            m_lastDevice = device;
+            m_last = slot.get();
+            return *slot;
+        }
+
+        /// Drop the caches of one device
+        void Remove(const Device* device)
+        {
+            m_caches.erase(device);
+            if (device == m_lastDevice) {
+                m_lastDevice = nullptr;
+                m_last = nullptr;
+            }
+        }
+
+        void Clear()
+        {
+            m_caches.clear();
+            m_lastDevice = nullptr;
+            m_last = nullptr;
+        }
+
+        template <class Fn>
+        void ForEach(Fn&& fn) const
+        {
+            for (const auto& entry : m_caches) {
+                fn(*entry.second);
+            }
+        }
+
+        size_t GetDeviceCount() const { return m_caches.size(); }
+
+    private:
+        std::unordered_map<const Device*, std::unique_ptr<Caches>> m_caches;
+        const Device* m_lastDevice = nullptr;
+        Caches* m_last = nullptr;
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+// Portable dirty set for the incremental scene-graph update before the scope pass.
+// No D3D / CommonLib dependencies; ScopeCamera instantiates it for RE::NiAVObject.
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Nodes whose local transform changed since the first pass
+     *
+     * Marked nodes are referenced until Clear(), so a node detached in between can't dangle.
+     * There is deliberately no destructor that releases them: the game may already be gone
+     * when static storage is destroyed.
+     *
+     * @tparam Node Needs a `parent` pointer (convertible to const Node*), IncRefCount(),
+     *              DecRefCount() returning the new count, and DeleteThis() (NiRefObject)
+     */
+    template <class Node>
+    class DirtyNodeSet
+    {
+    public:
+        void Mark(Node* node)
+        {
+            if (!node || Contains(node)) {
+                return;
+            }
+            node->IncRefCount();
+            m_nodes.push_back(node);
+        }
+
+        bool Contains(const Node* node) const
+        {
+            return std::find(m_nodes.begin(), m_nodes.end(), node) != m_nodes.end();
+        }
+
+        void Clear()
+        {
+            for (Node* node : m_nodes) {
+                if (node->DecRefCount() == 0) {
+                    node->DeleteThis();
+                }
+            }
+            m_nodes.clear();
+        }
+
+        size_t Size() const { return m_nodes.size(); }
+        bool Empty() const { return m_nodes.empty(); }
+
+        /**
+         * @brief Marked nodes without a marked ancestor, in mark order
+         *
+         * Updating these (downward) covers every marked node exactly once.
+         */
+        void CollectRoots(std::vector<Node*>& roots) const
+        {
+            roots.clear();
+            for (Node* node : m_nodes) {
+                bool covered = false;
+                for (const Node* ancestor = node->parent; ancestor; ancestor = ancestor->parent) {
+                    if (Contains(ancestor)) {
+                        covered = true;
+                        break;
+                    }
+                }
+                if (!covered) {
+                    roots.push_back(node);
+                }
+            }
+        }
+
+    private:
+        std::vector<Node*> m_nodes;
+    };
+}
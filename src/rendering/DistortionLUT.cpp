@@ -0,0 +1,199 @@
+#include "DistortionLUT.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define TTS_DISTORTION_LUT_SSE 1
+#endif
+
+namespace ThroughScope
+{
+    namespace
+    {
+        float Saturate(float x)
+        {
+            return std::clamp(x, 0.0f, 1.0f);
+        }
+
+        // HLSL smoothstep
+        float SmoothStep(float edge0, float edge1, float x)
+        {
+            const float t = Saturate((x - edge0) / (edge1 - edge0));
+            return t * t * (3.0f - 2.0f * t);
+        }
+
+        float Lerp(float a, float b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        constexpr float kMonoFadeStart = 0.8f;
+        constexpr float kChromaticFadeStart = 0.9f;
+
+#ifdef TTS_DISTORTION_LUT_SSE
+        __m128 SmoothStep4(__m128 edge0, __m128 invRange, __m128 x)
+        {
+            __m128 t = _mm_mul_ps(_mm_sub_ps(x, edge0), invRange);
+            t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_add_ps(t, t)));
+        }
+#endif
+    }
+
+    float DistortionLUT::ReferenceMonoFactor(float strength, float radius, float distance)
+    {
+        float distortionFactor = 1.0f + strength * distance * distance;
+        const float radiusMask = SmoothStep(radius * kMonoFadeStart, radius, distance);
+        return Lerp(distortionFactor, 1.0f, radiusMask);
+    }
+
+    float DistortionLUT::ReferenceChromaticFactor(float strength, float radius, float distance, size_t channel)
+    {
+        const float edgeFade = 1.0f - SmoothStep(radius * kChromaticFadeStart, radius, distance);
+        const float distortion = 1.0f + strength * kChromaticScale[channel] * distance * distance;
+        return Lerp(1.0f, distortion, edgeFade);
+    }
+
+    void DistortionLUT::Generate(const Params& params, float* texels)
+    {
+        if (!(params.radius > 0.0f) || params.strength == 0.0f) {
+            std::fill(texels, texels + kSize * kChannels, 0.0f);
+            return;
+        }
+
+        const float step = params.radius / float(kSize - 1);
+        const float monoStart = params.radius * kMonoFadeStart;
+        const float chromaticStart = params.radius * kChromaticFadeStart;
+        const float monoInvRange = 1.0f / (params.radius - monoStart);
+        const float chromaticInvRange = 1.0f / (params.radius - chromaticStart);
+
+#ifdef TTS_DISTORTION_LUT_SSE
+        // Four texels per iteration, transposed from channel-major to RGBA
+        static_assert(kSize % 4 == 0, "the SSE path has no scalar tail");
+        const __m128 strength = _mm_set1_ps(params.strength);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 chromaticR = _mm_set1_ps(kChromaticScale[0]);
+        const __m128 chromaticB = _mm_set1_ps(kChromaticScale[2]);
+        for (size_t i = 0; i < kSize; i += 4) {
+            const __m128 index = _mm_set_ps(float(i + 3), float(i + 2), float(i + 1), float(i));
+            const __m128 distance = _mm_mul_ps(index, _mm_set1_ps(step));
+            const __m128 offset = _mm_mul_ps(strength, _mm_mul_ps(distance, distance));
+
+            const __m128 monoMask = SmoothStep4(_mm_set1_ps(monoStart), _mm_set1_ps(monoInvRange), distance);
+            const __m128 chromaticFade =
+                _mm_sub_ps(one, SmoothStep4(_mm_set1_ps(chromaticStart), _mm_set1_ps(chromaticInvRange), distance));
+
+            __m128 a = _mm_mul_ps(offset, _mm_sub_ps(one, monoMask));
+            __m128 g = _mm_mul_ps(offset, chromaticFade);
+            __m128 r = _mm_mul_ps(g, chromaticR);
+            __m128 b = _mm_mul_ps(g, chromaticB);
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+            _mm_storeu_ps(texels + (i + 0) * kChannels, r);
+            _mm_storeu_ps(texels + (i + 1) * kChannels, g);
+            _mm_storeu_ps(texels + (i + 2) * kChannels, b);
+            _mm_storeu_ps(texels + (i + 3) * kChannels, a);
+        }
+#else
+        for (size_t i = 0; i < kSize; ++i) {
+            const float distance = float(i) * step;
+            const float offset = params.strength * distance * distance;
+            const float monoMask = Saturate((distance - monoStart) * monoInvRange);
+            const float chromaticT = Saturate((distance - chromaticStart) * chromaticInvRange);
+            const float chromaticFade = 1.0f - chromaticT * chromaticT * (3.0f - 2.0f * chromaticT);
+            const float g = offset * chromaticFade;
+            texels[i * kChannels + 0] = g * kChromaticScale[0];
+            texels[i * kChannels + 1] = g;
+            texels[i * kChannels + 2] = g * kChromaticScale[2];
+            texels[i * kChannels + 3] = offset * (1.0f - monoMask * monoMask * (3.0f - 2.0f * monoMask));
+        }
+#endif
+    }
+
+    uint16_t DistortionLUT::FloatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        const uint32_t exponent = (bits >> 23) & 0xFFu;
+        uint32_t mantissa = bits & 0x7FFFFFu;
+
+        if (exponent == 0xFFu) {
+            // Inf / NaN (keep NaN quiet)
+            return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+        }
+
+        const int32_t halfExponent = int32_t(exponent) - 127 + 15;
+        if (halfExponent >= 0x1F) {
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        }
+        if (halfExponent <= 0) {
+            // Subnormal half (or zero)
+            if (halfExponent < -10) {
+                return static_cast<uint16_t>(sign);
+            }
+            mantissa |= 0x800000u;
+            const uint32_t shift = uint32_t(14 - halfExponent);
+            uint32_t halfMantissa = mantissa >> shift;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (halfMantissa & 1u))) {
+                ++halfMantissa;
+            }
+            return static_cast<uint16_t>(sign | halfMantissa);
+        }
+
+        uint32_t half = sign | (uint32_t(halfExponent) << 10) | (mantissa >> 13);
+        const uint32_t remainder = mantissa & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+            ++half;  // May carry into the exponent, which is the correct rounding
+        }
+        return static_cast<uint16_t>(half);
+    }
+
+    float DistortionLUT::HalfToFloat(uint16_t value)
+    {
+        const uint32_t sign = uint32_t(value & 0x8000u) << 16;
+        uint32_t exponent = (value >> 10) & 0x1Fu;
+        uint32_t mantissa = value & 0x3FFu;
+        uint32_t bits;
+
+        if (exponent == 0x1Fu) {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        } else if (exponent == 0) {
+            if (mantissa == 0) {
+                bits = sign;
+            } else {
+                // Normalize the subnormal
+                exponent = 127 - 15 + 1;
+                while (!(mantissa & 0x400u)) {
+                    mantissa <<= 1;
+                    --exponent;
+                }
+                bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+            }
+        } else {
+            bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+        }
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    bool DistortionLUT::Update(const Params& params)
+    {
+        if (m_version != 0 && params == m_params) {
+            return false;
+        }
+
+        m_params = params;
+        Generate(params, m_scratch);
+        for (size_t i = 0; i < kSize * kChannels; ++i) {
+            m_texels[i] = FloatToHalf(m_scratch[i]);
+        }
+        ++m_version;
+        return true;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// Portable radial lookup table for the scope shader's spherical distortion and chromatic
+// aberration, regenerated on the CPU only when the distortion settings change.
+// No D3D / CommonLib dependencies; D3DResourceManager uploads the texels as R16G16B16A16_FLOAT.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ThroughScope
+{
+    /**
+     * @brief 1D table of the radial UV scale factors used by TrueScopeShader.hlsl
+     *
+     * Texel i holds the factors at distance d = radius * i / (kSize - 1) from the distortion
+     * center (aspect-corrected UV units), stored as factor - 1 so half floats keep their
+     * precision near 1:
+     *  - r, g, b: chromatic path, strength scaled by kChromaticScale, faded out over
+     *             [0.9 radius, radius]
+     *  - a:       single-channel path, faded out over [0.8 radius, radius]
+     * Both fades reach 0 at d = radius, so the last texel is exactly 0 and clamped sampling
+     * at saturate(d / radius) covers every distance.
+     */
+    class DistortionLUT
+    {
+    public:
+        static constexpr size_t kSize = 1024;
+        static constexpr size_t kChannels = 4;
+        static constexpr float kChromaticScale[3] = { 1.05f, 1.0f, 0.95f };
+
+        struct Params
+        {
+            float strength = 0.0f;
+            float radius = 0.0f;
+
+            bool operator==(const Params& other) const { return strength == other.strength && radius == other.radius; }
+            bool operator!=(const Params& other) const { return !(*this == other); }
+        };
+
+        /// Scalar ports of the shader math (applySphericalDistortion / the chromatic path)
+        static float ReferenceMonoFactor(float strength, float radius, float distance);
+        static float ReferenceChromaticFactor(float strength, float radius, float distance, size_t channel);
+
+        /// Fill kSize * kChannels floats (factor - 1), SIMD where available
+        static void Generate(const Params& params, float* texels);
+
+        /// IEEE 754 binary16, round to nearest even; overflow saturates to infinity
+        static uint16_t FloatToHalf(float value);
+        static float HalfToFloat(uint16_t value);
+
+        /**
+         * @brief Regenerate the half-float texels if params changed
+         * @return true when the table was rebuilt (the GPU copy needs an upload)
+         */
+        bool Update(const Params& params);
+
+        const uint16_t* GetTexels() const { return m_texels; }
+        const Params& GetParams() const { return m_params; }
+        /// Incremented on every rebuild; 0 = never built
+        uint32_t GetVersion() const { return m_version; }
+
+    private:
+        Params m_params;
+        uint32_t m_version = 0;
+        float m_scratch[kSize * kChannels] = {};
+        uint16_t m_texels[kSize * kChannels] = {};
+    };
+}
@@ -0,0 +1,123 @@
+#include "FrameBudgetGovernor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope
+{
+    std::vector<FrameBudgetGovernor::Knobs> FrameBudgetGovernor::DefaultLadder()
+    {
+        //      margin  shadows  contribution  skipMerges
+        return {
+            { 1.0f,  1.0f,  0.0f, false },
+            { 0.5f,  1.0f,  1.0f, false },
+            { 0.5f,  0.75f, 2.0f, false },
+            { 0.25f, 0.5f,  3.0f, true },
+            { 0.0f,  0.35f, 4.0f, true },
+            { 0.0f,  0.25f, 6.0f, true },
+        };
+    }
+
+    void FrameBudgetGovernor::SetLadder(std::vector<Knobs> ladder)
+    {
+        if (ladder.empty()) {
+            return;
+        }
+        m_ladder = std::move(ladder);
+        m_level = std::min(m_level, GetLevelCount() - 1);
+    }
+
+    uint32_t FrameBudgetGovernor::Update(float measuredMs)
+    {
+        if (!m_settings.enabled) {
+            if (m_level != 0 || m_lastAction != Action::Disabled) {
+                Reset();
+            }
+            return m_level;
+        }
+        if (!std::isfinite(measuredMs) || measuredMs < 0.0f) {
+            return m_level;
+        }
+
+        ++m_samples;
+        m_lastSampleMs = measuredMs;
+
+        // Samples still in flight when the level changed measure the old configuration
+        if (m_settle > 0) {
+            --m_settle;
+            m_lastAction = Action::Settling;
+            return m_level;
+        }
+
+        if (m_hasAverage) {
+            const float alpha = std::clamp(m_settings.smoothing, 0.01f, 1.0f);
+            m_smoothedMs += alpha * (measuredMs - m_smoothedMs);
+        } else {
+            m_smoothedMs = measuredMs;
+            m_hasAverage = true;
+        }
+
+        const float target = std::max(m_settings.targetMs, 0.01f);
+        if (m_smoothedMs > target * (1.0f + m_settings.upperBand)) {
+            ++m_overFrames;
+            m_underFrames = 0;
+        } else if (m_smoothedMs < target * (1.0f - m_settings.lowerBand)) {
+            ++m_underFrames;
+            m_overFrames = 0;
+        } else {
+            m_overFrames = 0;
+            m_underFrames = 0;
+        }
+
+        if (m_overFrames >= std::max(m_settings.degradeFrames, 1u) && m_level + 1 < GetLevelCount()) {
+            ChangeLevel(m_level + 1, Action::Degrade);
+        } else if (m_underFrames >= std::max(m_settings.improveFrames, 1u) && m_level > 0) {
+            ChangeLevel(m_level - 1, Action::Improve);
+        } else {
+            m_lastAction = Action::Hold;
+        }
+        return m_level;
+    }
+
+    void FrameBudgetGovernor::ChangeLevel(uint32_t level, Action action)
+    {
+        Event& event = m_history[m_historyCount % HISTORY_SIZE];
+        event.sample = m_samples;
+        event.fromLevel = m_level;
+        event.toLevel = level;
+        event.smoothedMs = m_smoothedMs;
+        ++m_historyCount;
+
+        m_level = level;
+        m_lastAction = action;
+        m_overFrames = 0;
+        m_underFrames = 0;
+        m_settle = m_settings.settleFrames;
+        m_hasAverage = false;
+    }
+
+    void FrameBudgetGovernor::Reset()
+    {
+        m_level = 0;
+        m_hasAverage = false;
+        m_smoothedMs = 0.0f;
+        m_lastSampleMs = 0.0f;
+        m_overFrames = 0;
+        m_underFrames = 0;
+        m_settle = 0;
+        m_samples = 0;
+        m_lastAction = Action::Disabled;
+        m_historyCount = 0;
+    }
+
+    std::vector<FrameBudgetGovernor::Event> FrameBudgetGovernor::GetHistory() const
+    {
+        std::vector<Event> events;
+        const size_t count = std::min(m_historyCount, HISTORY_SIZE);
+        events.reserve(count);
+        for (size_t i = m_historyCount - count; i < m_historyCount; ++i) {
+            events.push_back(m_history[i % HISTORY_SIZE]);
+        }
+        return events;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+// Portable closed-loop controller that trades scope-pass quality for a GPU time budget.
+// No D3D / CommonLib dependencies; the caller measures the cost and applies the knobs.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Picks a quality level from a ladder so the measured scope-pass cost holds a target
+     *
+     * Each Update() takes one measured frame cost (ms):
+     *  - the cost is smoothed with an exponential moving average
+     *  - above targetMs * (1 + upperBand) for degradeFrames frames in a row: one level cheaper
+     *  - below targetMs * (1 - lowerBand) for improveFrames frames in a row: one level better
+     *  - after a change, settleFrames samples are ignored (timestamp readback lags the change)
+     *    and the average restarts from the next sample
+     *
+     * The dead band between the two thresholds plus the asymmetric frame counts (degrade fast,
+     * improve slowly) keep the level from oscillating around the budget.
+     */
+    class FrameBudgetGovernor
+    {
+    public:
+        /// Quality knobs for one level; level 0 is the user's configuration (all neutral)
+        struct Knobs
+        {
+            float cullingMarginScale = 1.0f;      // Multiplier on the user's culling safety margin
+            float shadowCasterRangeScale = 1.0f;  // Multiplier on the user's shadow caster range
+            float contributionCullPixels = 0.0f;  // Cull objects projecting smaller than this (0 = off)
+            bool skipOptionalMerges = false;      // Don't merge RTs only screen-space effects read
+        };
+
+        struct Settings
+        {
+            bool enabled = false;
+            float targetMs = 2.0f;
+            float upperBand = 0.10f;
+            float lowerBand = 0.25f;
+            float smoothing = 0.2f;      // EMA weight of the newest sample
+            uint32_t degradeFrames = 5;
+            uint32_t improveFrames = 60;
+            uint32_t settleFrames = 4;
+        };
+
+        enum class Action : uint8_t
+        {
+            Disabled,
+            Hold,
+            Settling,
+            Degrade,
+            Improve
+        };
+
+        struct Event
+        {
+            uint64_t sample = 0;
+            uint32_t fromLevel = 0;
+            uint32_t toLevel = 0;
+            float smoothedMs = 0.0f;
+        };
+
+        static constexpr size_t HISTORY_SIZE = 16;
+
+        FrameBudgetGovernor() : m_ladder(DefaultLadder()) {}
+
+        /// Cheapest-last ladder: culling first, then shadows, then merges
+        static std::vector<Knobs> DefaultLadder();
+
+        /// Replace the ladder (must not be empty); the level is clamped to it
+        void SetLadder(std::vector<Knobs> ladder);
+
+        /**
+         * @brief Feed one measured frame cost
+         * @return The level to use from now on
+         */
+        uint32_t Update(float measuredMs);
+
+        /// Back to level 0 with no history (settings change, scope change)
+        void Reset();
+
+        const Knobs& GetKnobs() const { return m_ladder[m_level]; }
+        uint32_t GetLevel() const { return m_level; }
+        uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_ladder.size()); }
+        float GetSmoothedMs() const { return m_smoothedMs; }
+        float GetLastSampleMs() const { return m_lastSampleMs; }
+        Action GetLastAction() const { return m_lastAction; }
+        uint64_t GetSampleCount() const { return m_samples; }
+
+        /// Level changes, oldest first
+        std::vector<Event> GetHistory() const;
+
+        Settings& GetSettings() { return m_settings; }
+        const Settings& GetSettings() const { return m_settings; }
+
+    private:
+        void ChangeLevel(uint32_t level, Action action);
+
+        Settings m_settings;
+        std::vector<Knobs> m_ladder;
+        uint32_t m_level = 0;
+        bool m_hasAverage = false;
+        float m_smoothedMs = 0.0f;
+        float m_lastSampleMs = 0.0f;
+        uint32_t m_overFrames = 0;
+        uint32_t m_underFrames = 0;
+        uint32_t m_settle = 0;
+        uint64_t m_samples = 0;
+        Action m_lastAction = Action::Disabled;
+
+        Event m_history[HISTORY_SIZE];
+        size_t m_historyCount = 0;
+    };
+}
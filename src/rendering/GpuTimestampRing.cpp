@@ -0,0 +1,136 @@
+#include "GpuTimestampRing.h"
+
+namespace ThroughScope
+{
+    bool GpuTimestampRing::Initialize(ID3D11Device* device, uint32_t timerCount)
+    {
+        Shutdown();
+        if (!device || timerCount == 0) {
+            return false;
+        }
+
+        D3D11_QUERY_DESC disjointDesc = { D3D11_QUERY_TIMESTAMP_DISJOINT, 0 };
+        D3D11_QUERY_DESC timestampDesc = { D3D11_QUERY_TIMESTAMP, 0 };
+
+        for (auto& frame : m_frames) {
+            if (FAILED(device->CreateQuery(&disjointDesc, frame.disjoint.GetAddressOf()))) {
+                logger::warn("GpuTimestampRing: failed to create disjoint query");
+                Shutdown();
+                return false;
+            }
+            frame.timers.resize(timerCount);
+            for (auto& timer : frame.timers) {
+                if (FAILED(device->CreateQuery(&timestampDesc, timer.begin.GetAddressOf())) ||
+                    FAILED(device->CreateQuery(&timestampDesc, timer.end.GetAddressOf()))) {
+                    logger::warn("GpuTimestampRing: failed to create timestamp query");
+                    Shutdown();
+                    return false;
+                }
+            }
+        }
+
+        m_results.assign(timerCount, Result{});
+        m_initialized = true;
+        return true;
+    }
+
+    void GpuTimestampRing::Shutdown()
+    {
+        for (auto& frame : m_frames) {
+            frame.disjoint.Reset();
+            frame.timers.clear();
+            frame.pending = false;
+        }
+        m_results.clear();
+        m_current = 0;
+        m_inFrame = false;
+        m_initialized = false;
+    }
+
+    void GpuTimestampRing::BeginFrame(ID3D11DeviceContext* context)
+    {
+        if (!m_initialized || !context || m_inFrame) {
+            return;
+        }
+
+        Frame& frame = m_frames[m_current];
+        if (frame.pending) {
+            Resolve(context, frame);
+        }
+
+        for (auto& timer : frame.timers) {
+            timer.issued = false;
+        }
+        context->Begin(frame.disjoint.Get());
+        m_inFrame = true;
+    }
+
+    void GpuTimestampRing::Begin(ID3D11DeviceContext* context, uint32_t timer)
+    {
+        if (!m_inFrame || timer >= m_results.size()) {
+            return;
+        }
+        context->End(m_frames[m_current].timers[timer].begin.Get());
+    }
+
+    void GpuTimestampRing::End(ID3D11DeviceContext* context, uint32_t timer)
+    {
+        if (!m_inFrame || timer >= m_results.size()) {
+            return;
+        }
+        auto& entry = m_frames[m_current].timers[timer];
+        context->End(entry.end.Get());
+        entry.issued = true;
+    }
+
+    void GpuTimestampRing::EndFrame(ID3D11DeviceContext* context)
+    {
+        if (!m_inFrame) {
+            return;
+        }
+
+        Frame& frame = m_frames[m_current];
+        context->End(frame.disjoint.Get());
+        frame.pending = true;
+        m_inFrame = false;
+        m_current = (m_current + 1) % RING_SIZE;
+    }
+
+    void GpuTimestampRing::Resolve(ID3D11DeviceContext* context, Frame& frame)
+    {
+        frame.pending = false;
+
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint = {};
+        if (context->GetData(frame.disjoint.Get(), &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+            disjoint.Disjoint || disjoint.Frequency == 0) {
+            ++m_droppedFrames;
+            return;
+        }
+
+        for (size_t i = 0; i < frame.timers.size(); ++i) {
+            auto& timer = frame.timers[i];
+            if (!timer.issued) {
+                continue;
+            }
+            UINT64 begin = 0, end = 0;
+            if (context->GetData(timer.begin.Get(), &begin, sizeof(begin), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+                context->GetData(timer.end.Get(), &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+                end < begin) {
+                continue;
+            }
+            m_results[i].milliseconds = static_cast<float>(double(end - begin) * 1000.0 / double(disjoint.Frequency));
+            m_results[i].fresh = true;
+        }
+        ++m_resolvedFrames;
+    }
+
+    bool GpuTimestampRing::ConsumeResult(uint32_t timer, float& milliseconds)
+    {
+        if (timer >= m_results.size() || !m_results[timer].fresh) {
+            return false;
+        }
+        milliseconds = m_results[timer].milliseconds;
+        m_results[timer].fresh = false;
+        return true;
+    }
+}
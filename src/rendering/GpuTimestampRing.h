@@ -0,0 +1,75 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Non-blocking GPU interval timing with D3D11 timestamp queries
+     *
+     * Per frame: BeginFrame(), Begin(timer)/End(timer) around the measured work, EndFrame().
+     * Queries live in a ring of FRAME_LATENCY + 1 frames; BeginFrame() reads the frame that
+     * is about to be reused (issued FRAME_LATENCY frames ago) with DONOTFLUSH, so the CPU
+     * never waits on the GPU. A frame whose data isn't ready yet, or that was disjoint
+     * (clock change), is dropped.
+     */
+    class GpuTimestampRing
+    {
+    public:
+        static constexpr uint32_t FRAME_LATENCY = 3;
+
+        bool Initialize(ID3D11Device* device, uint32_t timerCount);
+        void Shutdown();
+        bool IsInitialized() const { return m_initialized; }
+
+        void BeginFrame(ID3D11DeviceContext* context);
+        void Begin(ID3D11DeviceContext* context, uint32_t timer);
+        void End(ID3D11DeviceContext* context, uint32_t timer);
+        void EndFrame(ID3D11DeviceContext* context);
+
+        /**
+         * @brief Take the newest resolved result of a timer, once
+         * @return false when nothing was resolved since the last call
+         */
+        bool ConsumeResult(uint32_t timer, float& milliseconds);
+
+        uint64_t GetResolvedFrames() const { return m_resolvedFrames; }
+        uint64_t GetDroppedFrames() const { return m_droppedFrames; }
+
+    private:
+        static constexpr uint32_t RING_SIZE = FRAME_LATENCY + 1;
+
+        struct Timer
+        {
+            Microsoft::WRL::ComPtr<ID3D11Query> begin;
+            Microsoft::WRL::ComPtr<ID3D11Query> end;
+            bool issued = false;
+        };
+
+        struct Frame
+        {
+            Microsoft::WRL::ComPtr<ID3D11Query> disjoint;
+            std::vector<Timer> timers;
+            bool pending = false;
+        };
+
+        struct Result
+        {
+            float milliseconds = 0.0f;
+            bool fresh = false;
+        };
+
+        void Resolve(ID3D11DeviceContext* context, Frame& frame);
+
+        Frame m_frames[RING_SIZE];
+        std::vector<Result> m_results;
+        uint32_t m_current = 0;
+        bool m_inFrame = false;
+        bool m_initialized = false;
+        uint64_t m_resolvedFrames = 0;
+        uint64_t m_droppedFrames = 0;
+    };
+}
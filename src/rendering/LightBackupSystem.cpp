@@ -1,7 +1,6 @@
 #include "LightBackupSystem.h"
 #include <ScopeCamera.h>
-#include "LightBackupSystem.h"
-#include <ScopeCamera.h>
+#include "ScopeCulling.h"
 
 namespace ThroughScope
 {
@@ -23,9 +22,6 @@ namespace ThroughScope
         // 保存ShadowSceneNode指针
         m_shadowNode = shadowNode;
 
-        // 清空之前的备份
-        m_lightBackups.clear();
-
         // 备份可见性计数器
         m_visibleNonShadowLights = shadowNode->uiVisibleNonShadowLights;
         m_visibleShadowLights = shadowNode->uiVisibleShadowLights;
@@ -35,24 +31,27 @@ namespace ThroughScope
         size_t totalLights = shadowNode->lLightList.size() + 
                             shadowNode->lShadowLightList.size() + 
                             shadowNode->lAmbientLightList.size();
-        m_lightBackups.reserve(totalLights);
-
-        m_lightBackups.reserve(totalLights);
-
-        // Lambda函数用于备份单个光源
-        auto backupLight = [this](const RE::NiPointer<RE::BSLight>& bsLight) {
-            if (bsLight && bsLight.get() && IsValidLight(bsLight.get())) {
-                LightStateBackup backup{};
-                backup.light = bsLight;
-                backup.frustumCull = bsLight->usFrustumCull;
-                backup.occluded = bsLight->bOccluded;
-                backup.temporary = bsLight->bTemporary;
-                backup.dynamic = bsLight->bDynamicLight;
-                backup.lodDimmer = bsLight->fLODDimmer;
-                backup.camera = bsLight->spCamera;
-                backup.cullingProcess = bsLight->pCullingProcess;
-                m_lightBackups.push_back(backup);
+        if (m_lights.size() < totalLights) {
+            m_lights.resize(totalLights);
+            m_lightCameras.resize(totalLights);
+        }
+        m_snapshot.Resize(totalLights);
+
+        // 快照写入并行数组；光源和相机引用原地赋值，光源列表和上一帧相同时没有引用计数开销
+        size_t count = 0;
+        auto backupLight = [this, &count](const RE::NiPointer<RE::BSLight>& bsLight) {
+            auto light = bsLight.get();
+            if (!light || !IsValidLight(light)) {
+                return;
             }
+            if (m_lights[count].get() != light) {
+                m_lights[count] = bsLight;
+            }
+            if (m_lightCameras[count].get() != light->spCamera.get()) {
+                m_lightCameras[count] = light->spCamera;
+            }
+            m_snapshot.Store(count, ReadLightState(light));
+            ++count;
         };
 
         // 遍历所有光源列表并备份每个光源
@@ -62,10 +61,16 @@ namespace ThroughScope
         for (const auto& light : shadowNode->lShadowLightList) {
             backupLight(light);
         }
+        m_firstAmbientBackup = count;
         for (const auto& light : shadowNode->lAmbientLightList) {
             backupLight(light);
         }
 
+        m_lights.resize(count);
+        m_lightCameras.resize(count);
+        m_snapshot.Resize(count);
+        m_snapshot.BeginFrame();
+
         // 备份环境光状态
         BackupAmbientLightStates();
 
@@ -73,9 +78,9 @@ namespace ThroughScope
     }
 
 
-    void LightBackupSystem::ApplyLightStatesForScope(bool limitCount, size_t maxLights)
+    void LightBackupSystem::ApplyLightStatesForScope(bool limitCount, size_t maxLights, RE::NiCamera* scopeCamera)
     {
-        if (m_lightBackups.empty()) {
+        if (m_lights.empty()) {
             logger::warn("ApplyLightStatesForScope: No backup states available");
             return;
         }
@@ -89,17 +94,93 @@ namespace ThroughScope
             m_shadowNode->uiVisibleAmbientLights = m_visibleAmbientLights;
         }
 
-        // 直接应用所有光源
-        for (const auto& backup : m_lightBackups) {
-            ApplySingleLightState(backup);
+        if (limitCount && scopeCamera) {
+            SelectLightsForScope(maxLights, scopeCamera);
+        }
+
+        // 快照是刚读取的当前状态：一次遍历并行数组得到每个光源要改的字段，只写入有变化的光源
+        // 重要：DeferredLightsImpl 会跳过 usFrustumCull == 255 的光源！255 表示被完全剔除，0 表示未剔除（可见）
+        // 同时强制不被遮挡、关闭 LODFade（暂不持久保存，保持关闭以提升可见性），并设置光源影响选项
+        m_snapshot.BuildApplyMasks(m_cullingProcess);
+        for (uint32_t index : m_snapshot.GetChangedLights()) {
+            WriteLightState(index, m_snapshot.GetApplyTarget(index), m_snapshot.GetApplyMask(index));
         }
 
         m_applyCount++;
     }
 
+    bool LightBackupSystem::BuildLightCandidate(size_t index, LightSelector::Candidate& candidate) const
+    {
+        auto bsLight = m_lights[index].get();
+        auto niLight = bsLight ? bsLight->spLight.get() : nullptr;
+        if (!niLight) {
+            return false;
+        }
+
+        const RE::NiPoint3& position = niLight->world.translate;
+        candidate.position[0] = position.x;
+        candidate.position[1] = position.y;
+        candidate.position[2] = position.z;
+        candidate.radius = niLight->radius.x;
+
+        // 亮度（Rec.709）x 淡出 x LOD 衰减
+        const RE::NiColor& diffuse = niLight->diffuse;
+        const float luminance = 0.2126f * diffuse.r + 0.7152f * diffuse.g + 0.0722f * diffuse.b;
+        candidate.intensity = std::max(luminance, 0.0f) * niLight->fade * m_snapshot.Load(index).lodDimmer;
+        candidate.alwaysKeep = false;
+        return true;
+    }
+
+    void LightBackupSystem::SelectLightsForScope(size_t maxLights, RE::NiCamera* scopeCamera)
+    {
+        m_candidates.resize(m_lights.size());
+        for (size_t i = 0; i < m_lights.size(); ++i) {
+            auto& candidate = m_candidates[i];
+            candidate = {};
+            // 环境光和无法读取几何信息的光源始终保留
+            if (i >= m_firstAmbientBackup || !BuildLightCandidate(i, candidate)) {
+                candidate.alwaysKeep = true;
+            }
+        }
+
+        // 瞄具视锥体（与几何体自定义裁剪相同的平面），只在这里临时使用
+        UpdateCachedScopeFrustumPlanes(scopeCamera);
+        LightSelector::Frustum frustum;
+        const RE::NiFrustumPlanes* planes = GetCachedScopeFrustumPlanes();
+        if (planes) {
+            frustum.activeMask = 0;
+            for (uint32_t i = 0; i < 6; ++i) {
+                const RE::NiPlane& plane = planes->GetPlane(i);
+                frustum.planes[i].normal[0] = plane.m_kNormal.x;
+                frustum.planes[i].normal[1] = plane.m_kNormal.y;
+                frustum.planes[i].normal[2] = plane.m_kNormal.z;
+                frustum.planes[i].constant = plane.m_fConstant;
+                if (planes->IsPlaneActive(i)) {
+                    frustum.activeMask |= 1u << i;
+                }
+            }
+        }
+        InvalidateCachedScopeFrustumPlanes();
+
+        const RE::NiPoint3& eyePos = scopeCamera->world.translate;
+        const float eye[3] = { eyePos.x, eyePos.y, eyePos.z };
+        m_selector.Select(m_candidates, planes ? &frustum : nullptr, eye, maxLights, m_selected);
+
+        // 未选中的光源在应用时直接写入 255（剔除），不再先写 0 再写 255
+        std::sort(m_selected.begin(), m_selected.end());
+        size_t next = 0;
+        for (size_t i = 0; i < m_lights.size(); ++i) {
+            if (next < m_selected.size() && m_selected[next] == i) {
+                ++next;
+                continue;
+            }
+            m_snapshot.MarkCulled(i);
+        }
+    }
+
     void LightBackupSystem::RestoreLightStates()
     {
-        if (m_lightBackups.empty()) {
+        if (m_lights.empty()) {
             logger::warn("RestoreLightStates: No backup states available");
             return;
         }
@@ -107,9 +188,17 @@ namespace ThroughScope
         // 恢复环境光状态
         RestoreAmbientLightStates();
 
-        // 恢复原始光源状态
-        for (const auto& backup : m_lightBackups) {
-            RestoreSingleLightState(backup);
+        // 恢复原始光源状态：第二次渲染期间引擎也会改写剔除/遮挡状态，所以和当前值比较，
+        // 只写回不同的字段。LODFade 和影响选项保持应用后的值（与之前的行为一致）
+        for (size_t i = 0; i < m_lights.size(); ++i) {
+            auto bsLight = m_lights[i].get();
+            if (!bsLight || !IsValidLight(bsLight)) {
+                continue;
+            }
+            const uint32_t mask = m_snapshot.BuildRestoreMask(i, ReadLightState(bsLight));
+            if (mask) {
+                WriteLightState(i, m_snapshot.Load(i), mask);
+            }
         }
 
         m_restoreCount++;
@@ -117,8 +206,10 @@ namespace ThroughScope
 
     void LightBackupSystem::Clear()
     {
-        logger::debug("Clearing {} light backup states", m_lightBackups.size());
-        m_lightBackups.clear();
+        logger::debug("Clearing {} light backup states", m_lights.size());
+        m_lights.clear();
+        m_lightCameras.clear();
+        m_snapshot.Resize(0);
         m_cullingProcess = nullptr;
         m_ambientBackup.isValid = false;
     }
@@ -240,12 +331,12 @@ namespace ThroughScope
 
     bool LightBackupSystem::HasBackupStates() const
     {
-        return !m_lightBackups.empty();
+        return !m_lights.empty();
     }
 
     size_t LightBackupSystem::GetBackupCount() const
     {
-        return m_lightBackups.size();
+        return m_lights.size();
     }
 
     void LightBackupSystem::SetCullingProcess(RE::BSCullingProcess* cullingProcess)
@@ -273,82 +364,81 @@ namespace ThroughScope
         }
     }
 
-    void LightBackupSystem::ApplySingleLightState(const LightStateBackup& backup)
+    LightStateSnapshot::State LightBackupSystem::ReadLightState(const RE::BSLight* light)
     {
-        auto bsLight = backup.light.get();
-        if (!bsLight || !IsValidLight(bsLight)) {
-            return;
-        }
-
-        try {
-            // 应用视锥体剔除状态 - 强制所有光源可见
-            // 重要：DeferredLightsImpl 会跳过 usFrustumCull == 255 的光源！
-            // 255 表示被完全剔除，0 表示未剔除（可见）
-            bsLight->usFrustumCull = 0;  // 设为0表示光源未被剔除，应该被渲染
-
-            // 应用基本状态 - 强制不被遮挡
-            bsLight->SetOccluded(false);
-            bsLight->SetTemporary(backup.temporary);
-            bsLight->SetLODFade(false);  // 暂不持久保存LODFade，保持关闭以提升可见性
-            bsLight->fLODDimmer = backup.lodDimmer;
-
-            // 应用动态光源状态
-            if (bsLight->bDynamicLight != backup.dynamic) {
-                bsLight->SetDynamic(backup.dynamic);
-            }
-
-            // 设置光源影响选项（优化瞄具渲染效果）
-            bsLight->SetAffectLand(true);
-            bsLight->SetAffectWater(true);
-            bsLight->SetIgnoreRoughness(false);
-            bsLight->SetIgnoreRim(false);
-            bsLight->SetAttenuationOnly(false);
-
-            // 应用相机和剔除进程
-            bsLight->spCamera = backup.camera;
-
-            if (backup.cullingProcess) {
-                bsLight->SetCullingProcess(backup.cullingProcess);
-            } else if (m_cullingProcess) {
-                bsLight->SetCullingProcess(m_cullingProcess);
-            }
-
-        } catch (const std::exception& e) {
-            logger::error("Exception while applying light state: {}", e.what());
-        } catch (...) {
-            logger::error("Unknown exception while applying light state for light: 0x{:X}",
-                reinterpret_cast<uintptr_t>(bsLight));
-        }
+        using Field = LightStateSnapshot::Field;
+        LightStateSnapshot::State state;
+        state.frustumCull = light->usFrustumCull;
+        state.lodDimmer = light->fLODDimmer;
+        state.camera = light->spCamera.get();
+        state.cullingProcess = light->pCullingProcess;
+        state.Set(Field::Occluded, light->bOccluded);
+        state.Set(Field::Temporary, light->bTemporary);
+        state.Set(Field::Dynamic, light->bDynamicLight);
+        state.Set(Field::LODFade, light->bLODFade);
+        state.Set(Field::AffectLand, light->bAffectLand);
+        state.Set(Field::AffectWater, light->bAffectWater);
+        state.Set(Field::IgnoreRoughness, light->bIgnoreRoughness);
+        state.Set(Field::IgnoreRim, light->bIgnoreRim);
+        state.Set(Field::AttenuationOnly, light->bAttenuationOnly);
+        return state;
     }
 
-    void LightBackupSystem::RestoreSingleLightState(const LightStateBackup& backup)
+    void LightBackupSystem::WriteLightState(size_t index, const LightStateSnapshot::State& state, uint32_t mask)
     {
-        auto bsLight = backup.light.get();
-        if (!bsLight || !IsValidLight(bsLight)) {
+        using Field = LightStateSnapshot::Field;
+        auto bsLight = m_lights[index].get();
+        if (!mask || !bsLight) {
             return;
         }
 
         try {
-            // 恢复原始状态
-            bsLight->usFrustumCull = backup.frustumCull;
-            bsLight->SetOccluded(backup.occluded);
-            bsLight->SetTemporary(backup.temporary);
-            bsLight->fLODDimmer = backup.lodDimmer;
-            bsLight->spCamera = backup.camera;
-            bsLight->SetCullingProcess(backup.cullingProcess);
-
-            // 恢复动态光源状态
-            if (bsLight->bDynamicLight != backup.dynamic) {
-                bsLight->SetDynamic(backup.dynamic);
+            if (mask & Field::FrustumCull) {
+                bsLight->usFrustumCull = state.frustumCull;
+            }
+            if (mask & Field::Occluded) {
+                bsLight->SetOccluded(state.Has(Field::Occluded));
+            }
+            if (mask & Field::Temporary) {
+                bsLight->SetTemporary(state.Has(Field::Temporary));
+            }
+            if (mask & Field::Dynamic) {
+                bsLight->SetDynamic(state.Has(Field::Dynamic));
+            }
+            if (mask & Field::LODFade) {
+                bsLight->SetLODFade(state.Has(Field::LODFade));
+            }
+            if (mask & Field::AffectLand) {
+                bsLight->SetAffectLand(state.Has(Field::AffectLand));
+            }
+            if (mask & Field::AffectWater) {
+                bsLight->SetAffectWater(state.Has(Field::AffectWater));
+            }
+            if (mask & Field::IgnoreRoughness) {
+                bsLight->SetIgnoreRoughness(state.Has(Field::IgnoreRoughness));
+            }
+            if (mask & Field::IgnoreRim) {
+                bsLight->SetIgnoreRim(state.Has(Field::IgnoreRim));
+            }
+            if (mask & Field::AttenuationOnly) {
+                bsLight->SetAttenuationOnly(state.Has(Field::AttenuationOnly));
+            }
+            if (mask & Field::LODDimmer) {
+                bsLight->fLODDimmer = state.lodDimmer;
+            }
+            if (mask & Field::Camera) {
+                // 写入的状态都来自快照，相机就是快照持有引用的那个
+                bsLight->spCamera = m_lightCameras[index];
+            }
+            if (mask & Field::CullingProcess) {
+                bsLight->SetCullingProcess(static_cast<RE::BSCullingProcess*>(const_cast<void*>(state.cullingProcess)));
             }
-
         } catch (const std::exception& e) {
-            logger::error("Exception while restoring light state: {}", e.what());
+            logger::error("Exception while writing light state: {}", e.what());
         } catch (...) {
-            logger::error("Unknown exception while restoring light state for light: 0x{:X}",
+            logger::error("Unknown exception while writing light state for light: 0x{:X}",
                 reinterpret_cast<uintptr_t>(bsLight));
         }
     }
 
-
 }
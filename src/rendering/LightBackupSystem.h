@@ -5,6 +5,8 @@
 #include "RE/Bethesda/BSShaderManager.hpp"
 #include "RE/Bethesda/Sky.hpp"
 #include "RE/Bethesda/ImageSpaceManager.hpp"
+#include "LightSelector.h"
+#include "LightStateSnapshot.h"
 
 namespace ThroughScope
 {
@@ -54,10 +56,17 @@ namespace ThroughScope
          * 在第二次渲染之前调用，将第一次渲染的光源状态应用到当前光源
          * 同时进行一些优化设置以确保瞄具渲染的质量
          *
+         * 限制数量时，用瞄具视锥体剔除光源的影响球，剩余光源按 强度 x 立体角 排序，
+         * 只保留前 maxLights 个，其余标记为剔除（usFrustumCull = 255），延迟光照不再着色
+         *
          * @param limitCount 是否限制光源数量
-         * @param maxLights 最大光源数量（默认8个）
+         * @param maxLights 参与排序的光源上限（环境光等始终保留的光源不计入），0 表示只做视锥体剔除
+         * @param scopeCamera 瞄具相机，用于视锥体和立体角（limitCount 时必需）
          */
-        void ApplyLightStatesForScope(bool limitCount = false, size_t maxLights = 8);
+        void ApplyLightStatesForScope(bool limitCount = false, size_t maxLights = 8, RE::NiCamera* scopeCamera = nullptr);
+        const LightSelector::Stats& GetSelectionStats() const { return m_selector.GetStats(); }
+        /// 本帧应用/恢复写入的光源字段数
+        const LightStateSnapshot::Stats& GetWriteStats() const { return m_snapshot.GetStats(); }
         void RestoreLightStates();
         void Clear();
 
@@ -92,14 +101,25 @@ namespace ThroughScope
         LightBackupSystem(const LightBackupSystem&) = delete;
         LightBackupSystem& operator=(const LightBackupSystem&) = delete;
         bool IsValidLight(RE::BSLight* light) const;
-        void ApplySingleLightState(const LightStateBackup& backup);
-        void RestoreSingleLightState(const LightStateBackup& backup);
-        float CalculateLightPriority(const LightStateBackup& backup, const RE::NiPoint3& cameraPos) const;
+        static LightStateSnapshot::State ReadLightState(const RE::BSLight* light);
+        void WriteLightState(size_t index, const LightStateSnapshot::State& state, uint32_t mask);
+        bool BuildLightCandidate(size_t index, LightSelector::Candidate& candidate) const;
+        void SelectLightsForScope(size_t maxLights, RE::NiCamera* scopeCamera);
 
         // ========== 内部数据 ==========
 
-        /// 光源状态备份列表
-        std::vector<LightStateBackup> m_lightBackups;
+        /// 光源状态快照（SoA）：光源和相机引用与 m_snapshot 的字段数组按下标对应
+        std::vector<RE::NiPointer<RE::BSLight>> m_lights;
+        std::vector<RE::NiPointer<RE::NiCamera>> m_lightCameras;
+        LightStateSnapshot m_snapshot;
+
+        /// lAmbientLightList 的光源在备份列表中的起始位置（环境光不参与剔除）
+        size_t m_firstAmbientBackup = 0;
+
+        /// 光源剔除和预算
+        LightSelector m_selector;
+        std::vector<LightSelector::Candidate> m_candidates;
+        std::vector<uint32_t> m_selected;
 
         /// 环境光状态备份
         AmbientLightStateBackup m_ambientBackup;
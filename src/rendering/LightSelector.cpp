@@ -0,0 +1,89 @@
+#include "LightSelector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope
+{
+    bool LightSelector::SphereIntersects(const Frustum& frustum, const float center[3], float radius)
+    {
+        if (radius <= 0.0f) {
+            return true;
+        }
+        for (uint32_t i = 0; i < 6; ++i) {
+            if (!(frustum.activeMask & (1u << i))) {
+                continue;
+            }
+            const Plane& plane = frustum.planes[i];
+            const float distance = plane.normal[0] * center[0] + plane.normal[1] * center[1] +
+                                   plane.normal[2] * center[2] - plane.constant;
+            if (distance < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float LightSelector::SolidAngle(const float eye[3], const float center[3], float radius)
+    {
+        constexpr float kTwoPi = 6.28318530718f;
+        if (radius <= 0.0f) {
+            return 0.0f;
+        }
+        const float dx = center[0] - eye[0];
+        const float dy = center[1] - eye[1];
+        const float dz = center[2] - eye[2];
+        const float distanceSq = dx * dx + dy * dy + dz * dz;
+        const float radiusSq = radius * radius;
+        if (distanceSq <= radiusSq) {
+            return 2.0f * kTwoPi;
+        }
+        // Cap of half-angle asin(r/d): 2*pi*(1 - cos), cos = sqrt(1 - r^2/d^2). Written as
+        // x / (1 + sqrt(1 - x)) so distant lights don't cancel to 0 in float
+        const float x = radiusSq / distanceSq;
+        return kTwoPi * x / (1.0f + std::sqrt(1.0f - x));
+    }
+
+    const LightSelector::Stats& LightSelector::Select(const std::vector<Candidate>& candidates, const Frustum* frustum,
+        const float eye[3], size_t budget, std::vector<uint32_t>& selected)
+    {
+        m_stats = {};
+        m_stats.candidates = static_cast<uint32_t>(candidates.size());
+        selected.clear();
+        m_ranked.clear();
+
+        for (uint32_t i = 0; i < candidates.size(); ++i) {
+            const Candidate& candidate = candidates[i];
+            if (candidate.alwaysKeep) {
+                selected.push_back(i);
+                continue;
+            }
+            if (frustum && !SphereIntersects(*frustum, candidate.position, candidate.radius)) {
+                ++m_stats.culled;
+                continue;
+            }
+            // Unbounded lights rank above every bounded one
+            const float priority = candidate.radius > 0.0f ?
+                candidate.intensity * SolidAngle(eye, candidate.position, candidate.radius) :
+                HUGE_VALF;
+            m_ranked.push_back({ priority, i });
+        }
+
+        auto byPriority = [](const Ranked& a, const Ranked& b) {
+            return a.priority > b.priority || (a.priority == b.priority && a.index < b.index);
+        };
+        size_t keep = m_ranked.size();
+        if (budget > 0 && keep > budget) {
+            std::nth_element(m_ranked.begin(), m_ranked.begin() + budget, m_ranked.end(), byPriority);
+            keep = budget;
+        }
+        std::sort(m_ranked.begin(), m_ranked.begin() + keep, byPriority);
+
+        m_stats.overBudget = static_cast<uint32_t>(m_ranked.size() - keep);
+        for (size_t i = 0; i < keep; ++i) {
+            selected.push_back(m_ranked[i].index);
+        }
+        m_stats.selected = static_cast<uint32_t>(selected.size());
+        return m_stats;
+    }
+}
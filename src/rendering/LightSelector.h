@@ -0,0 +1,76 @@
+#pragma once
+
+// Portable light selection for the scope pass: cull light spheres against the scope frustum,
+// rank the survivors by intensity x solid angle and keep the best ones within a budget.
+// No D3D / CommonLib dependencies; LightBackupSystem fills the candidates from BSLight.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope
+{
+    class LightSelector
+    {
+    public:
+        /**
+         * @brief Plane in the engine's convention: signed distance = dot(normal, p) - constant,
+         *        positive inside (same as NiFrustumPlanes / TestBoundAgainstFrustum)
+         */
+        struct Plane
+        {
+            float normal[3] = { 0.0f, 0.0f, 0.0f };
+            float constant = 0.0f;
+        };
+
+        struct Frustum
+        {
+            Plane planes[6];
+            uint32_t activeMask = 0x3F;
+        };
+
+        struct Candidate
+        {
+            float position[3] = { 0.0f, 0.0f, 0.0f };
+            float radius = 0.0f;     // Influence radius; <= 0 means unbounded (never culled)
+            float intensity = 0.0f;  // Luminance x dimmer
+            bool alwaysKeep = false; // Ambient / non-spatial lights: bypass culling and budget
+        };
+
+        struct Stats
+        {
+            uint32_t candidates = 0;
+            uint32_t culled = 0;      // Outside the frustum
+            uint32_t overBudget = 0;  // Visible but ranked below the budget
+            uint32_t selected = 0;    // Including always-keep lights
+        };
+
+        /// Sphere vs. frustum; true when the sphere touches the inside of every active plane
+        static bool SphereIntersects(const Frustum& frustum, const float center[3], float radius);
+
+        /// Solid angle (steradians) of a sphere seen from eye; 4*pi when eye is inside it
+        static float SolidAngle(const float eye[3], const float center[3], float radius);
+
+        /**
+         * @brief Select the lights to shade in the scope pass
+         * @param frustum Scope frustum, or nullptr to skip culling
+         * @param budget Maximum number of ranked (not always-keep) lights; 0 = unlimited
+         * @param selected Receives candidate indices: always-keep lights in input order, then by
+         *                 descending priority
+         */
+        const Stats& Select(const std::vector<Candidate>& candidates, const Frustum* frustum, const float eye[3],
+            size_t budget, std::vector<uint32_t>& selected);
+
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        struct Ranked
+        {
+            float priority;
+            uint32_t index;
+        };
+
+        std::vector<Ranked> m_ranked;
+        Stats m_stats;
+    };
+}
@@ -0,0 +1,110 @@
+#include "LightStateSnapshot.h"
+
+#include <bitset>
+
+namespace ThroughScope
+{
+    uint32_t LightStateSnapshot::Diff(const State& a, const State& b)
+    {
+        uint32_t mask = (a.flags ^ b.flags) & kBoolFields;
+        if (a.frustumCull != b.frustumCull) {
+            mask |= FrustumCull;
+        }
+        if (a.lodDimmer != b.lodDimmer) {
+            mask |= LODDimmer;
+        }
+        if (a.camera != b.camera) {
+            mask |= Camera;
+        }
+        if (a.cullingProcess != b.cullingProcess) {
+            mask |= CullingProcess;
+        }
+        return mask;
+    }
+
+    uint32_t LightStateSnapshot::CountFields(uint32_t mask)
+    {
+        return static_cast<uint32_t>(std::bitset<32>(mask & kAllFields).count());
+    }
+
+    void LightStateSnapshot::Resize(size_t count)
+    {
+        m_frustumCull.resize(count);
+        m_lodDimmer.resize(count);
+        m_camera.resize(count);
+        m_cullingProcess.resize(count);
+        m_flags.resize(count);
+        m_culled.resize(count);
+        m_applyMask.resize(count);
+    }
+
+    void LightStateSnapshot::Store(size_t index, const State& state)
+    {
+        m_frustumCull[index] = state.frustumCull;
+        m_lodDimmer[index] = state.lodDimmer;
+        m_camera[index] = state.camera;
+        m_cullingProcess[index] = state.cullingProcess;
+        m_flags[index] = state.flags;
+        m_culled[index] = 0;
+    }
+
+    LightStateSnapshot::State LightStateSnapshot::Load(size_t index) const
+    {
+        State state;
+        state.frustumCull = m_frustumCull[index];
+        state.lodDimmer = m_lodDimmer[index];
+        state.camera = m_camera[index];
+        state.cullingProcess = m_cullingProcess[index];
+        state.flags = m_flags[index];
+        return state;
+    }
+
+    void LightStateSnapshot::BeginFrame()
+    {
+        m_stats = {};
+        m_stats.lights = static_cast<uint32_t>(Size());
+        m_changed.clear();
+    }
+
+    void LightStateSnapshot::BuildApplyMasks(const void* fallbackCullingProcess)
+    {
+        m_fallbackCullingProcess = fallbackCullingProcess;
+        const uint32_t fallbackMask = fallbackCullingProcess ? uint32_t(CullingProcess) : 0u;
+
+        m_changed.clear();
+        m_stats.appliedFields = 0;
+        for (size_t i = 0; i < m_flags.size(); ++i) {
+            const uint32_t frustumCull = m_culled[i] ? 255u : 0u;
+            uint32_t mask = (m_flags[i] ^ kForcedValues) & kForcedFields;
+            mask |= m_frustumCull[i] != frustumCull ? uint32_t(FrustumCull) : 0u;
+            mask |= m_cullingProcess[i] ? 0u : fallbackMask;
+            m_applyMask[i] = mask;
+            if (mask) {
+                m_changed.push_back(static_cast<uint32_t>(i));
+                m_stats.appliedFields += CountFields(mask);
+            }
+        }
+        m_stats.appliedLights = static_cast<uint32_t>(m_changed.size());
+    }
+
+    LightStateSnapshot::State LightStateSnapshot::GetApplyTarget(size_t index) const
+    {
+        State target = Load(index);
+        target.frustumCull = m_culled[index] ? 255u : 0u;
+        target.flags = (target.flags & ~uint32_t(kForcedFields)) | kForcedValues;
+        if (!target.cullingProcess) {
+            target.cullingProcess = m_fallbackCullingProcess;
+        }
+        return target;
+    }
+
+    uint32_t LightStateSnapshot::BuildRestoreMask(size_t index, const State& live)
+    {
+        const uint32_t mask = Diff(live, Load(index)) & kRestoredFields;
+        if (mask) {
+            ++m_stats.restoredLights;
+            m_stats.restoredFields += CountFields(mask);
+        }
+        return mask;
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+// Portable SoA snapshot of the per-light state the scope pass overrides, with per-field
+// change masks so apply/restore only write what differs.
+// No D3D / CommonLib dependencies; LightBackupSystem reads and writes the BSLight fields.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope
+{
+    class LightStateSnapshot
+    {
+    public:
+        /// One bit per field; boolean fields use the same bit in State::flags
+        enum Field : uint32_t
+        {
+            FrustumCull = 1u << 0,
+            Occluded = 1u << 1,
+            Temporary = 1u << 2,
+            Dynamic = 1u << 3,
+            LODFade = 1u << 4,
+            AffectLand = 1u << 5,
+            AffectWater = 1u << 6,
+            IgnoreRoughness = 1u << 7,
+            IgnoreRim = 1u << 8,
+            AttenuationOnly = 1u << 9,
+            LODDimmer = 1u << 10,
+            Camera = 1u << 11,
+            CullingProcess = 1u << 12,
+
+            kBoolFields = Occluded | Temporary | Dynamic | LODFade | AffectLand | AffectWater | IgnoreRoughness |
+                          IgnoreRim | AttenuationOnly,
+            kAllFields = (1u << 13) - 1,
+
+            /// Boolean fields the scope pass forces, and the values it forces them to
+            kForcedFields = Occluded | LODFade | AffectLand | AffectWater | IgnoreRoughness | IgnoreRim | AttenuationOnly,
+            kForcedValues = AffectLand | AffectWater,
+
+            /// Fields restore compares; LODFade and the affect flags keep their applied values
+            kRestoredFields = FrustumCull | Occluded | Temporary | Dynamic | LODDimmer | Camera | CullingProcess,
+        };
+
+        struct State
+        {
+            uint32_t frustumCull = 0;
+            float lodDimmer = 0.0f;
+            const void* camera = nullptr;
+            const void* cullingProcess = nullptr;
+            uint32_t flags = 0;  // Field bits of the boolean fields that are set
+
+            bool Has(Field field) const { return (flags & field) != 0; }
+            void Set(Field field, bool value) { flags = (flags & ~uint32_t(field)) | (value ? uint32_t(field) : 0u); }
+        };
+
+        struct Stats
+        {
+            uint32_t lights = 0;
+            uint32_t appliedLights = 0;   // Lights with at least one field written by apply
+            uint32_t appliedFields = 0;
+            uint32_t restoredLights = 0;
+            uint32_t restoredFields = 0;
+        };
+
+        /// Fields whose values differ between two states
+        static uint32_t Diff(const State& a, const State& b);
+        static uint32_t CountFields(uint32_t mask);
+
+        void Resize(size_t count);
+        size_t Size() const { return m_frustumCull.size(); }
+
+        /// Store a light's state as read after the main pass; clears its culled mark
+        void Store(size_t index, const State& state);
+        State Load(size_t index) const;
+
+        /// Start a frame's statistics (call after the snapshot is taken)
+        void BeginFrame();
+
+        /// Cull a light for the scope pass (frustum or budget); call before BuildApplyMasks
+        void MarkCulled(size_t index) { m_culled[index] = 1; }
+
+        /**
+         * @brief Diff every stored light against the scope-pass state in one pass over the arrays
+         *
+         * The scope pass shows unculled lights (usFrustumCull 0, culled ones 255), clears occlusion
+         * and LOD fade, forces the affect flags to kForcedValues and gives lights without a culling
+         * process the fallback one. Everything else keeps the snapshot value, so it never differs.
+         *
+         * @param fallbackCullingProcess Culling process for lights that have none (may be null)
+         */
+        void BuildApplyMasks(const void* fallbackCullingProcess);
+
+        /// Lights whose apply mask is non-zero, in index order
+        const std::vector<uint32_t>& GetChangedLights() const { return m_changed; }
+        uint32_t GetApplyMask(size_t index) const { return m_applyMask[index]; }
+        State GetApplyTarget(size_t index) const;
+
+        /// Restored fields where a light's live state differs from the snapshot; counted in the stats
+        uint32_t BuildRestoreMask(size_t index, const State& live);
+
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        std::vector<uint32_t> m_frustumCull;
+        std::vector<float> m_lodDimmer;
+        std::vector<const void*> m_camera;
+        std::vector<const void*> m_cullingProcess;
+        std::vector<uint32_t> m_flags;
+        std::vector<uint8_t> m_culled;
+
+        std::vector<uint32_t> m_applyMask;
+        std::vector<uint32_t> m_changed;
+        const void* m_fallbackCullingProcess = nullptr;
+        Stats m_stats;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// Portable grouping of render target merges into MRT draws for RenderTargetMerger.
+// No D3D / CommonLib dependencies; works on any target type with width/height members.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope::MergeBatching
+{
+    /**
+     * @brief Order targets so equal sizes are adjacent (MRT needs one size per draw)
+     *
+     * Stable, so targets of one size keep their configured order.
+     */
+    template <class Target>
+    void SortBySize(std::vector<Target*>& group)
+    {
+        std::stable_sort(group.begin(), group.end(), [](const Target* a, const Target* b) {
+            return a->width != b->width ? a->width < b->width : a->height < b->height;
+        });
+    }
+
+    /**
+     * @brief Call fn(Target** batch, uint32_t count) once per draw
+     *
+     * Each batch holds up to maxBatch consecutive targets of one size; group must be sorted
+     * with SortBySize first.
+     */
+    template <class Target, class Fn>
+    void ForEachBatch(std::vector<Target*>& group, size_t maxBatch, Fn&& fn)
+    {
+        size_t begin = 0;
+        while (begin < group.size()) {
+            size_t end = begin + 1;
+            while (end < group.size() && end - begin < maxBatch &&
+                   group[end]->width == group[begin]->width && group[end]->height == group[begin]->height) {
+                ++end;
+            }
+            fn(&group[begin], static_cast<uint32_t>(end - begin));
+            begin = end;
+        }
+    }
+}
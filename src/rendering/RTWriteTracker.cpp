@@ -0,0 +1,94 @@
+#include "RTWriteTracker.h"
+
+namespace ThroughScope
+{
+    void RTWriteTracker::Reset()
+    {
+        m_enabled = 0;
+        m_backedUp = 0;
+        m_written = 0;
+        m_previousWritten = 0;
+        m_warmUp = true;
+        m_inFrame = false;
+    }
+
+    void RTWriteTracker::BeginFrame(uint64_t enabledMask)
+    {
+        // Enabling a target invalidates the prediction for it
+        if (enabledMask & ~m_enabled) {
+            m_warmUp = true;
+        }
+        m_enabled = enabledMask;
+        m_backedUp = 0;
+        m_written = 0;
+        m_inFrame = true;
+    }
+
+    bool RTWriteTracker::ShouldBackup(size_t slot) const
+    {
+        if (slot >= MAX_SLOTS || !(m_enabled & Bit(slot))) {
+            return false;
+        }
+        return m_warmUp || (m_previousWritten & Bit(slot)) != 0;
+    }
+
+    void RTWriteTracker::MarkBackedUp(size_t slot)
+    {
+        if (slot < MAX_SLOTS) {
+            m_backedUp |= Bit(slot);
+        }
+    }
+
+    bool RTWriteTracker::MarkWritten(size_t slot)
+    {
+        if (!m_inFrame || slot >= MAX_SLOTS || !(m_enabled & Bit(slot))) {
+            return false;
+        }
+
+        m_written |= Bit(slot);
+        if (m_backedUp & Bit(slot)) {
+            return false;
+        }
+
+        m_backedUp |= Bit(slot);
+        ++m_stats[slot].lateBackups;
+        return true;
+    }
+
+    bool RTWriteTracker::WasWritten(size_t slot) const
+    {
+        return slot < MAX_SLOTS && (m_written & Bit(slot)) != 0;
+    }
+
+    void RTWriteTracker::EndFrame()
+    {
+        if (!m_inFrame) {
+            return;
+        }
+        m_inFrame = false;
+
+        for (size_t slot = 0; slot < MAX_SLOTS; ++slot) {
+            if (!(m_enabled & Bit(slot))) {
+                continue;
+            }
+            ++m_stats[slot].frames;
+            if (!(m_backedUp & Bit(slot)) && !(m_written & Bit(slot))) {
+                ++m_stats[slot].skipped;
+            }
+        }
+
+        // Safety fallback: back up everything next frame whenever the written set moves
+        bool changed = m_written != m_previousWritten;
+        if (changed) {
+            ++m_changedFrames;
+        }
+        m_warmUp = changed;
+        m_previousWritten = m_written;
+    }
+
+    const RTWriteTracker::SlotStats& RTWriteTracker::GetStats(size_t slot) const
+    {
+        static const SlotStats empty{};
+        return slot < MAX_SLOTS ? m_stats[slot] : empty;
+    }
+}
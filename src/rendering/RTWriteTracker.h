@@ -0,0 +1,68 @@
+#pragma once
+
+// Portable write-set tracking for RenderTargetMerger: which managed render targets the
+// scope pass wrote, and which ones need an up-front backup next frame.
+// No D3D / CommonLib dependencies; slots are indices into the merger's backup list.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Predicts the render targets written by the scope pass from the previous frame
+     *
+     * Per scope frame:
+     *  1. BeginFrame() with the set of enabled slots
+     *  2. ShouldBackup() / MarkBackedUp() for the up-front backups
+     *  3. MarkWritten() from the D3D hooks; returns true if the caller must back up now
+     *  4. WasWritten() decides which slots get merged
+     *  5. EndFrame() updates statistics and the prediction
+     *
+     * The first frame after Reset() and the frame after any change of the written set
+     * back up every enabled slot (warm-up), so a mispredicted frame can't repeat.
+     */
+    class RTWriteTracker
+    {
+    public:
+        static constexpr size_t MAX_SLOTS = 64;
+
+        struct SlotStats
+        {
+            uint64_t frames = 0;       // Scope frames the slot was enabled
+            uint64_t skipped = 0;      // Frames with neither backup nor merge
+            uint64_t lateBackups = 0;  // Writes that were not predicted (backed up on first write)
+        };
+
+        void Reset();
+
+        void BeginFrame(uint64_t enabledMask);
+        void EndFrame();
+
+        bool IsWarmingUp() const { return m_warmUp; }
+        bool ShouldBackup(size_t slot) const;
+        void MarkBackedUp(size_t slot);
+
+        /**
+         * @brief Record a write to slot during the scope pass
+         * @return true if the slot has not been backed up yet this frame
+         */
+        bool MarkWritten(size_t slot);
+        bool WasWritten(size_t slot) const;
+
+        const SlotStats& GetStats(size_t slot) const;
+        uint64_t GetChangedFrameCount() const { return m_changedFrames; }
+
+    private:
+        static uint64_t Bit(size_t slot) { return uint64_t(1) << slot; }
+
+        uint64_t m_enabled = 0;
+        uint64_t m_backedUp = 0;
+        uint64_t m_written = 0;
+        uint64_t m_previousWritten = 0;
+        bool m_warmUp = true;
+        bool m_inFrame = false;
+        uint64_t m_changedFrames = 0;
+        SlotStats m_stats[MAX_SLOTS];
+    };
+}
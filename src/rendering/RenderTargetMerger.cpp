@@ -1,6 +1,9 @@
 #include "RenderTargetMerger.h"
 #include "RenderUtilities.h"
+#include "D3DStateCache.h"
+#include "MergeBatching.h"
 #include <d3d9.h>  // For D3DPERF markers
+#include <algorithm>
 
 namespace ThroughScope
 {
@@ -49,17 +52,17 @@ namespace ThroughScope
 			config.enabled = true;
 			m_configs.push_back(config);
 
-			// Create backup
+			// Register backup (textures are acquired per frame while aiming)
 			RTBackup backup;
 			backup.rtIndex = rtIndex;
 			backup.name = rtName;
 			backup.enabled = true;
 
-			if (CreateBackupTexture(backup, device)) {
+			if (rendererData->renderTargets[rtIndex].texture) {
 				m_rtBackups.push_back(backup);
-				logger::info("RenderTargetMerger: Created backup for RT_{} ({})", rtIndex, rtName);
+				logger::info("RenderTargetMerger: Registered backup for RT_{} ({})", rtIndex, rtName);
 			} else {
-				logger::warn("RenderTargetMerger: Failed to create backup for RT_{} ({})", rtIndex, rtName);
+				logger::warn("RenderTargetMerger: RT_{} ({}) texture is null, not managed", rtIndex, rtName);
 			}
 		}
 
@@ -70,80 +73,168 @@ namespace ThroughScope
 
 	void RenderTargetMerger::Shutdown()
 	{
-		for (auto& backup : m_rtBackups) {
-			ReleaseBackupTexture(backup);
-		}
 		m_rtBackups.clear();
+		m_backupTextures.clear();
+		m_backupPlanner.Reset();
+		m_backupKeys.Reset();
 		m_configs.clear();
 		m_initialized = false;
 		logger::info("RenderTargetMerger: Shutdown complete");
 	}
 
-	bool RenderTargetMerger::CreateBackupTexture(RTBackup& backup, ID3D11Device* device)
+	// Approximate bytes per texel for the formats used by the managed RTs
+	static uint64_t BytesPerPixel(DXGI_FORMAT format)
 	{
-		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
-		if (!rendererData || backup.rtIndex < 0 || backup.rtIndex >= 101) {
-			return false;
+		switch (format) {
+		case DXGI_FORMAT_R32G32B32A32_FLOAT:
+		case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+			return 16;
+		case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		case DXGI_FORMAT_R16G16B16A16_UNORM:
+		case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+		case DXGI_FORMAT_R32G32_FLOAT:
+			return 8;
+		case DXGI_FORMAT_R8G8_UNORM:
+		case DXGI_FORMAT_R16_FLOAT:
+		case DXGI_FORMAT_R16_UNORM:
+			return 2;
+		case DXGI_FORMAT_R8_UNORM:
+			return 1;
+		default:
+			return 4;
 		}
+	}
 
-		auto& rt = rendererData->renderTargets[backup.rtIndex];
-		if (!rt.texture) {
-			logger::warn("RenderTargetMerger: RT_{} texture is null", backup.rtIndex);
-			return false;
+	bool RenderTargetMerger::AcquireBackupTexture(RTBackup& backup, ID3D11Device* device, const D3D11_TEXTURE2D_DESC& rtDesc)
+	{
+		// Same key = interchangeable backup textures (CopyResource needs the full desc to match)
+		TransientTextureDesc keyDesc;
+		keyDesc.width = rtDesc.Width;
+		keyDesc.height = rtDesc.Height;
+		keyDesc.format = rtDesc.Format;
+		keyDesc.mipLevels = rtDesc.MipLevels;
+		keyDesc.arraySize = rtDesc.ArraySize;
+		keyDesc.sampleCount = rtDesc.SampleDesc.Count;
+		keyDesc.sampleQuality = rtDesc.SampleDesc.Quality;
+		uint64_t key = m_backupKeys.GetKey(keyDesc);
+		uint64_t bytes = (uint64_t)rtDesc.Width * rtDesc.Height * BytesPerPixel(rtDesc.Format) *
+		                 rtDesc.ArraySize * std::max(rtDesc.SampleDesc.Count, 1u);
+
+		bool created = false;
+		auto slot = m_backupPlanner.Acquire(key, bytes, m_lifetimeClock, created, backup.plannedSlot);
+		if (slot >= m_backupTextures.size()) {
+			m_backupTextures.resize(slot + 1);
 		}
+		auto& physical = m_backupTextures[slot];
+
+		if (created || !physical.texture) {
+			physical.texture.Reset();
+			physical.srv.Reset();
+
+			// Create backup texture (SRV only, no RTV needed)
+			D3D11_TEXTURE2D_DESC backupDesc = rtDesc;
+			backupDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+			backupDesc.Usage = D3D11_USAGE_DEFAULT;
+			backupDesc.CPUAccessFlags = 0;
+			backupDesc.MiscFlags = 0;
+
+			HRESULT hr = device->CreateTexture2D(&backupDesc, nullptr, physical.texture.GetAddressOf());
+			if (FAILED(hr)) {
+				logger::error("RenderTargetMerger: Failed to create backup texture for RT_{}. HRESULT: 0x{:X}", 
+					backup.rtIndex, hr);
+				m_backupPlanner.Release(slot);
+				return false;
+			}
 
-		ID3D11Texture2D* originalTex = (ID3D11Texture2D*)rt.texture;
-		D3D11_TEXTURE2D_DESC desc;
-		originalTex->GetDesc(&desc);
+			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+			ZeroMemory(&srvDesc, sizeof(srvDesc));
+			srvDesc.Format = rtDesc.Format;
+			if (rtDesc.SampleDesc.Count > 1) {
+				srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DMS;
+			} else {
+				srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+				srvDesc.Texture2D.MostDetailedMip = 0;
+				srvDesc.Texture2D.MipLevels = 1;
+			}
 
-		// Store original properties
-		backup.format = desc.Format;
-		backup.width = desc.Width;
-		backup.height = desc.Height;
+			hr = device->CreateShaderResourceView(physical.texture.Get(), &srvDesc, physical.srv.GetAddressOf());
+			if (FAILED(hr)) {
+				logger::error("RenderTargetMerger: Failed to create backup SRV for RT_{}. HRESULT: 0x{:X}", 
+					backup.rtIndex, hr);
+				physical.texture.Reset();
+				m_backupPlanner.Release(slot);
+				return false;
+			}
+		}
 
-		// Create backup texture (SRV only, no RTV needed)
-		D3D11_TEXTURE2D_DESC backupDesc = desc;
-		backupDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-		backupDesc.Usage = D3D11_USAGE_DEFAULT;
-		backupDesc.CPUAccessFlags = 0;
-		backupDesc.MiscFlags = 0;
+		backup.slot = slot;
+		backup.lifetime.key = key;
+		backup.lifetime.bytes = bytes;
+		backup.lifetime.begin = m_lifetimeClock;
+		backup.backupTexture = physical.texture.Get();
+		backup.backupSRV = physical.srv.Get();
+		backup.format = rtDesc.Format;
+		backup.width = rtDesc.Width;
+		backup.height = rtDesc.Height;
+		return true;
+	}
 
-		HRESULT hr = device->CreateTexture2D(&backupDesc, nullptr, &backup.backupTexture);
-		if (FAILED(hr)) {
-			logger::error("RenderTargetMerger: Failed to create backup texture for RT_{}. HRESULT: 0x{:X}", 
-				backup.rtIndex, hr);
-			return false;
+	void RenderTargetMerger::ReleaseBackupTexture(RTBackup& backup)
+	{
+		// End of lifetime: the texture stays reserved and can back another RT
+		if (backup.slot != TransientAliasPlanner::INVALID_SLOT) {
+			m_backupPlanner.Release(backup.slot);
+			backup.lifetime.end = m_lifetimeClock;
+			backup.hasLastLifetime = true;
 		}
+		backup.slot = TransientAliasPlanner::INVALID_SLOT;
+		backup.plannedSlot = TransientAliasPlanner::INVALID_SLOT;
+		backup.backupTexture = nullptr;
+		backup.backupSRV = nullptr;
+	}
 
-		// Create SRV
-		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
-		ZeroMemory(&srvDesc, sizeof(srvDesc));
-		srvDesc.Format = desc.Format;
-		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-		srvDesc.Texture2D.MostDetailedMip = 0;
-		srvDesc.Texture2D.MipLevels = 1;
-
-		hr = device->CreateShaderResourceView(backup.backupTexture, &srvDesc, &backup.backupSRV);
-		if (FAILED(hr)) {
-			logger::error("RenderTargetMerger: Failed to create backup SRV for RT_{}. HRESULT: 0x{:X}", 
-				backup.rtIndex, hr);
-			backup.backupTexture->Release();
-			backup.backupTexture = nullptr;
-			return false;
+	void RenderTargetMerger::PlanBackupTextures()
+	{
+		// Expect last frame's schedule again; a backup that runs differently just gets another texture
+		m_plannedLifetimes.clear();
+		m_plannedBackups.clear();
+		for (auto& backup : m_rtBackups) {
+			backup.plannedSlot = TransientAliasPlanner::INVALID_SLOT;
+			if (backup.hasLastLifetime && IsMergeActive(backup)) {
+				m_plannedLifetimes.push_back(backup.lifetime);
+				m_plannedBackups.push_back(&backup);
+			}
+			backup.hasLastLifetime = false;
 		}
 
-		return true;
+		m_backupPlanner.Plan(m_plannedLifetimes, m_plannedSlots);
+		for (size_t i = 0; i < m_plannedBackups.size(); ++i) {
+			m_plannedBackups[i]->plannedSlot = m_plannedSlots[i];
+		}
 	}
 
-	void RenderTargetMerger::ReleaseBackupTexture(RTBackup& backup)
+	void RenderTargetMerger::ReleaseBatch(RTBackup** batch, UINT count)
 	{
-		if (backup.backupSRV) {
-			backup.backupSRV->Release();
-			backup.backupSRV = nullptr;
+		// The draw consumed these backups, their textures can back anything after it
+		++m_lifetimeClock;
+		for (UINT i = 0; i < count; ++i) {
+			ReleaseBackupTexture(*batch[i]);
 		}
-		if (backup.backupTexture) {
-			backup.backupTexture->Release();
-			backup.backupTexture = nullptr;
+	}
+
+	void RenderTargetMerger::EndFrame()
+	{
+		if (!m_initialized) return;
+
+		m_backupPlanner.EndFrame(m_mergedThisFrame);
+		m_mergedThisFrame = false;
+		m_backedUpThisFrame = false;
+
+		for (auto slot : m_backupPlanner.CollectEvictions(m_memoryBudgetBytes, m_releaseAfterFrames)) {
+			logger::debug("RenderTargetMerger: releasing backup texture slot {} ({} KB)",
+				slot, m_backupPlanner.GetSlot(slot).bytes / 1024);
+			m_backupTextures[slot].texture.Reset();
+			m_backupTextures[slot].srv.Reset();
 		}
 	}
 
@@ -194,46 +285,151 @@ namespace ThroughScope
 			return;
 		}
 
+		// New backup lifetimes start this frame
+		m_backupPlanner.BeginFrame();
+		m_backedUpThisFrame = true;
+		m_lifetimeClock = 0;
 		for (auto& backup : m_rtBackups) {
-			if (!backup.enabled || !backup.backupTexture) continue;
-
-			auto& rt = rendererData->renderTargets[backup.rtIndex];
-			if (rt.texture) {
-                // Check for dimension/format mismatch (Dynamic Resolution / DLSS support)
-                D3D11_TEXTURE2D_DESC rtDesc;
-                ((ID3D11Texture2D*)rt.texture)->GetDesc(&rtDesc);
-
-                if (rtDesc.Width != backup.width || rtDesc.Height != backup.height || rtDesc.Format != backup.format) {
-                   logger::info("RenderTargetMerger: resizing backup for RT_{} from {}x{} to {}x{}", 
-                       backup.rtIndex, backup.width, backup.height, rtDesc.Width, rtDesc.Height);
-                   ReleaseBackupTexture(backup);
-                   // CreateBackupTexture will update backup struct with new dimensions from current RT
-                   ID3D11Device* device = (ID3D11Device*)rendererData->device;
-                   if (!CreateBackupTexture(backup, device)) {
-                       logger::warn("RenderTargetMerger: Failed to resize backup for RT_{}", backup.rtIndex);
-                       continue;
-                   }
-                }
-
-                // Use SafeCopyTexture to handle potential dimension mismatches
-                ID3D11Device* device = (ID3D11Device*)rendererData->device;
-                if (device) {
-				    RenderUtilities::SafeCopyTexture(context, device, backup.backupTexture, (ID3D11Texture2D*)rt.texture);
-                }
+			backup.slot = TransientAliasPlanner::INVALID_SLOT;
+			backup.backupTexture = nullptr;
+			backup.backupSRV = nullptr;
+		}
+		PlanBackupTextures();
+
+		uint64_t enabledMask = 0;
+		for (size_t i = 0; i < m_rtBackups.size() && i < RTWriteTracker::MAX_SLOTS; ++i) {
+			if (IsMergeActive(m_rtBackups[i])) {
+				enabledMask |= uint64_t(1) << i;
+			}
+		}
+		m_trackingFrame = m_writeTracking;
+		m_recordingWrites = m_trackingFrame;
+		if (m_trackingFrame) {
+			m_writeTracker.BeginFrame(enabledMask);
+		}
+
+		for (size_t i = 0; i < m_rtBackups.size(); ++i) {
+			auto& backup = m_rtBackups[i];
+			if (!IsMergeActive(backup)) continue;
+
+			backup.sourceTexture = (ID3D11Resource*)rendererData->renderTargets[backup.rtIndex].texture;
+
+			// Not written last frame: skip, NotifyScopeWrite backs it up if the scope pass does write it
+			if (m_trackingFrame && !m_writeTracker.ShouldBackup(i)) continue;
+
+			BackupSingleRT(backup, context);
+			if (m_trackingFrame) {
+				m_writeTracker.MarkBackedUp(i);
+			}
+		}
+
+		// RTs still bound from the first pass can be drawn to without another OMSetRenderTargets
+		if (m_trackingFrame) {
+			ID3D11RenderTargetView* boundRTVs[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+			context->OMGetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, boundRTVs, nullptr);
+			for (auto* rtv : boundRTVs) {
+				if (!rtv) continue;
+				ID3D11Resource* resource = nullptr;
+				rtv->GetResource(&resource);
+				NotifyScopeWrite(context, resource);
+				if (resource) resource->Release();
+				rtv->Release();
 			}
 		}
 
 		D3DPERF_EndEvent();
 	}
 
+	void RenderTargetMerger::BackupSingleRT(RTBackup& backup, ID3D11DeviceContext* context)
+	{
+		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
+		auto& rt = rendererData->renderTargets[backup.rtIndex];
+		if (!rt.texture) return;
+
+		ID3D11Device* device = (ID3D11Device*)rendererData->device;
+		if (!device) return;
+
+		// Backup texture follows the current RT size/format (Dynamic Resolution / DLSS support)
+		if (!backup.backupTexture) {
+			D3D11_TEXTURE2D_DESC rtDesc;
+			((ID3D11Texture2D*)rt.texture)->GetDesc(&rtDesc);
+			if (!AcquireBackupTexture(backup, device, rtDesc)) {
+				logger::warn("RenderTargetMerger: Failed to acquire backup for RT_{}", backup.rtIndex);
+				return;
+			}
+		}
+
+		// Region-limited pass: only the scope region can change, so only it needs a backup
+		RenderUtilities::CopyTextureScopeRegion(context, device, backup.backupTexture, (ID3D11Texture2D*)rt.texture);
+		++m_lifetimeClock;
+	}
+
+	void RenderTargetMerger::NotifyScopeWrite(ID3D11DeviceContext* context, ID3D11Resource* resource)
+	{
+		if (!m_recordingWrites || !resource) return;
+
+		for (size_t i = 0; i < m_rtBackups.size(); ++i) {
+			if (m_rtBackups[i].sourceTexture != resource) continue;
+
+			// First write to an RT that wasn't predicted: back it up before the write lands
+			if (m_writeTracker.MarkWritten(i)) {
+				D3DPERF_BeginEvent(0xFF00FFFF, L"RenderTargetMerger_LateBackup");
+				BackupSingleRT(m_rtBackups[i], context);
+				D3DPERF_EndEvent();
+			}
+			return;
+		}
+	}
+
+	bool RenderTargetMerger::NeedsMerge(const RTBackup& backup) const
+	{
+		if (!m_trackingFrame) return true;
+		return m_writeTracker.WasWritten(static_cast<size_t>(&backup - m_rtBackups.data()));
+	}
+
+	void RenderTargetMerger::FinishWriteTracking()
+	{
+		m_recordingWrites = false;
+		if (m_trackingFrame) {
+			m_writeTracker.EndFrame();
+			m_trackingFrame = false;
+		}
+	}
+
+	void RenderTargetMerger::SetWriteTrackingEnabled(bool enabled)
+	{
+		if (m_writeTracking != enabled) {
+			m_writeTracking = enabled;
+			m_writeTracker.Reset();
+		}
+	}
+
+	RTWriteTracker::SlotStats RenderTargetMerger::GetWriteStats(int rtIndex) const
+	{
+		for (size_t i = 0; i < m_rtBackups.size(); ++i) {
+			if (m_rtBackups[i].rtIndex == rtIndex) {
+				return m_writeTracker.GetStats(i);
+			}
+		}
+		return {};
+	}
+
 	void RenderTargetMerger::MergeRenderTargets(ID3D11DeviceContext* context, ID3D11Device* device)
 	{
 		if (!m_initialized || !context || !device) return;
 
+		// Nothing was re-rendered this frame (scope pass skipped or reprojected); the backups are stale
+		if (!m_backedUpThisFrame) return;
+
+		// The merge draws below write the managed RTs themselves
+		m_recordingWrites = false;
+		m_mergedThisFrame = true;
+
 		D3DPERF_BeginEvent(0xFF00FF00, L"RenderTargetMerger_MergeAll");
 
 		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
 		if (!rendererData) {
+			FinishWriteTracking();
 			D3DPERF_EndEvent();
 			return;
 		}
@@ -245,12 +441,12 @@ namespace ThroughScope
 		}
 		if (!stencilDSV) {
 			logger::warn("RenderTargetMerger: Stencil DSV not available");
+			FinishWriteTracking();
 			D3DPERF_EndEvent();
 			return;
 		}
 
-		// Create stencil test state: pass where stencil != 127 (outside scope)
-		Microsoft::WRL::ComPtr<ID3D11DepthStencilState> stencilTestDSS;
+		// Stencil test state: pass where stencil != 127 (outside scope)
 		D3D11_DEPTH_STENCIL_DESC dssDesc;
 		ZeroMemory(&dssDesc, sizeof(dssDesc));
 		dssDesc.DepthEnable = FALSE;
@@ -264,9 +460,10 @@ namespace ThroughScope
 		dssDesc.FrontFace.StencilFunc = D3D11_COMPARISON_NOT_EQUAL;
 		dssDesc.BackFace = dssDesc.FrontFace;
 
-		HRESULT hr = device->CreateDepthStencilState(&dssDesc, &stencilTestDSS);
-		if (FAILED(hr)) {
+		ID3D11DepthStencilState* stencilTestDSS = D3DStateCache::GetSingleton()->GetDepthStencilState(device, dssDesc);
+		if (!stencilTestDSS) {
 			logger::error("RenderTargetMerger: Failed to create stencil test state");
+			FinishWriteTracking();
 			D3DPERF_EndEvent();
 			return;
 		}
@@ -287,6 +484,10 @@ namespace ThroughScope
 		Microsoft::WRL::ComPtr<ID3D11RasterizerState> oldRS;
 		context->RSGetState(oldRS.GetAddressOf());
 
+		D3D11_RECT oldScissorRects[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+		UINT numScissorRects = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+		context->RSGetScissorRects(&numScissorRects, oldScissorRects);
+
 		Microsoft::WRL::ComPtr<ID3D11BlendState> oldBS;
 		float oldBlendFactor[4];
 		UINT oldSampleMask;
@@ -325,10 +526,11 @@ namespace ThroughScope
 			rsDesc.FillMode = D3D11_FILL_SOLID;
 			rsDesc.CullMode = D3D11_CULL_NONE;
 			rsDesc.DepthClipEnable = TRUE;
+			// Region-limited pass: pixels outside the scope region were never touched, skip them
+			rsDesc.ScissorEnable = RenderUtilities::IsScopeRegionActive() ? TRUE : FALSE;
 
-			Microsoft::WRL::ComPtr<ID3D11RasterizerState> rsState;
-			device->CreateRasterizerState(&rsDesc, &rsState);
-			context->RSSetState(rsState.Get());
+			ID3D11RasterizerState* rsState = D3DStateCache::GetSingleton()->GetRasterizerState(device, rsDesc);
+			context->RSSetState(rsState);
 
 			D3D11_SAMPLER_DESC sampDesc;
 			ZeroMemory(&sampDesc, sizeof(sampDesc));
@@ -336,9 +538,8 @@ namespace ThroughScope
 			sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
 			sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
 			sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-			Microsoft::WRL::ComPtr<ID3D11SamplerState> pointSampler;
-			device->CreateSamplerState(&sampDesc, &pointSampler);
-			context->PSSetSamplers(0, 1, pointSampler.GetAddressOf());
+			ID3D11SamplerState* pointSampler = D3DStateCache::GetSingleton()->GetSamplerState(device, sampDesc);
+			context->PSSetSamplers(0, 1, &pointSampler);
 
 			context->IASetInputLayout(nullptr);
 			context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -347,19 +548,27 @@ namespace ThroughScope
 			ZeroMemory(&blendDesc, sizeof(blendDesc));
 			blendDesc.RenderTarget[0].BlendEnable = FALSE;
 			blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-			Microsoft::WRL::ComPtr<ID3D11BlendState> blendState;
-			device->CreateBlendState(&blendDesc, &blendState);
+			ID3D11BlendState* blendState = D3DStateCache::GetSingleton()->GetBlendState(device, blendDesc);
 			float blendFactor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
-			context->OMSetBlendState(blendState.Get(), blendFactor, 0xFFFFFFFF);
+			context->OMSetBlendState(blendState, blendFactor, 0xFFFFFFFF);
 
 			context->VSSetShader(RenderUtilities::GetFullscreenVS(), nullptr, 0);
 			context->PSSetShader(RenderUtilities::GetGBufferCopyPS(), nullptr, 0);
 
-			// Merge each enabled RT
-			for (auto& backup : m_rtBackups) {
-				if (!backup.enabled || !backup.backupSRV) continue;
-
-				MergeSingleRT(backup, context, device, stencilDSV, stencilTestDSS.Get());
+			m_lastMergeDrawCount = 0;
+			if (RenderUtilities::GetMRTMergePS()) {
+				// Grouped merge: full-res RTs share MRT draws, half-res RTs share one masked draw
+				MergeGrouped(context, device, stencilDSV, stencilTestDSS);
+			} else {
+				// Fallback: one draw per RT
+				for (auto& backup : m_rtBackups) {
+					if (!IsMergeActive(backup) || !backup.backupSRV || !NeedsMerge(backup)) continue;
+
+					MergeSingleRT(backup, context, device, stencilDSV, stencilTestDSS);
+					++m_lastMergeDrawCount;
+					RTBackup* merged = &backup;
+					ReleaseBatch(&merged, 1);
+				}
 			}
 
 		} catch (...) {
@@ -371,6 +580,7 @@ namespace ThroughScope
 		context->OMSetDepthStencilState(oldDSS.Get(), oldStencilRef);
 		context->RSSetState(oldRS.Get());
 		context->RSSetViewports(numViewports, oldViewports);
+		context->RSSetScissorRects(numScissorRects, oldScissorRects);
 		context->OMSetBlendState(oldBS.Get(), oldBlendFactor, oldSampleMask);
 		context->VSSetShader(oldVS.Get(), nullptr, 0);
 		context->PSSetShader(oldPS.Get(), nullptr, 0);
@@ -388,6 +598,154 @@ namespace ThroughScope
 		context->PSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, restorePSSRV);
 		context->PSSetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, restorePSSamplers);
 
+		// Backups no draw consumed (not written, or skipped) end with the merge
+		++m_lifetimeClock;
+		for (auto& backup : m_rtBackups) {
+			ReleaseBackupTexture(backup);
+		}
+
+		FinishWriteTracking();
+		D3DPERF_EndEvent();
+	}
+
+	// Scissor to the scope region scaled to this RT (only used when the merge RS state has ScissorEnable)
+	static void SetRegionScissor(ID3D11DeviceContext* context, UINT width, UINT height)
+	{
+		if (!RenderUtilities::IsScopeRegionActive()) return;
+
+		D3D11_RECT rect;
+		RenderUtilities::GetScopeRegionRect(width, height, rect);
+		context->RSSetScissorRects(1, &rect);
+	}
+
+	void RenderTargetMerger::MergeGrouped(ID3D11DeviceContext* context, ID3D11Device* device,
+		ID3D11DepthStencilView* stencilDSV, ID3D11DepthStencilState* stencilTestDSS)
+	{
+		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
+
+		m_fullResGroup.clear();
+		m_halfResGroup.clear();
+		for (auto& backup : m_rtBackups) {
+			if (!IsMergeActive(backup) || !backup.backupSRV || !rendererData->renderTargets[backup.rtIndex].rtView) continue;
+			// Untouched by the scope pass: still holds first-pass content
+			if (!NeedsMerge(backup)) continue;
+
+			if (IsHalfResRT(backup.rtIndex)) {
+				m_halfResGroup.push_back(&backup);
+			} else {
+				m_fullResGroup.push_back(&backup);
+			}
+		}
+
+		// MRT 要求同一次 draw 的所有 RT 尺寸一致，按尺寸排序后切分
+		MergeBatching::SortBySize(m_fullResGroup);
+		MergeBatching::SortBySize(m_halfResGroup);
+
+		MergeBatching::ForEachBatch(m_fullResGroup, MAX_MRT_BATCH, [&](RTBackup** batch, UINT count) {
+			MergeFullResBatch(batch, count, context, stencilDSV, stencilTestDSS);
+			++m_lastMergeDrawCount;
+			ReleaseBatch(batch, count);
+		});
+
+		if (RenderUtilities::GetHalfResMRTMergePS()) {
+			MergeBatching::ForEachBatch(m_halfResGroup, MAX_HALF_RES_MRT_BATCH, [&](RTBackup** batch, UINT count) {
+				MergeHalfResBatch(batch, count, context, device);
+				++m_lastMergeDrawCount;
+				ReleaseBatch(batch, count);
+			});
+		} else {
+			for (auto*& backup : m_halfResGroup) {
+				MergeSingleRT(*backup, context, device, stencilDSV, stencilTestDSS);
+				++m_lastMergeDrawCount;
+				ReleaseBatch(&backup, 1);
+			}
+		}
+	}
+
+	void RenderTargetMerger::MergeFullResBatch(RTBackup** batch, UINT count, ID3D11DeviceContext* context,
+		ID3D11DepthStencilView* stencilDSV, ID3D11DepthStencilState* stencilTestDSS)
+	{
+		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
+
+		D3DPERF_BeginEvent(0xFF00FF00, L"Merge_FullRes_MRT");
+
+		ID3D11RenderTargetView* rtvs[MAX_MRT_BATCH] = {};
+		ID3D11ShaderResourceView* srvs[MAX_MRT_BATCH] = {};
+		for (UINT i = 0; i < count; ++i) {
+			rtvs[i] = (ID3D11RenderTargetView*)rendererData->renderTargets[batch[i]->rtIndex].rtView;
+			srvs[i] = batch[i]->backupSRV;
+		}
+
+		D3D11_VIEWPORT vp;
+		vp.Width = (float)batch[0]->width;
+		vp.Height = (float)batch[0]->height;
+		vp.MinDepth = 0.0f;
+		vp.MaxDepth = 1.0f;
+		vp.TopLeftX = 0;
+		vp.TopLeftY = 0;
+		context->RSSetViewports(1, &vp);
+		SetRegionScissor(context, batch[0]->width, batch[0]->height);
+
+		// Hardware stencil test: restore only where stencil != 127
+		context->OMSetRenderTargets(count, rtvs, stencilDSV);
+		context->OMSetDepthStencilState(stencilTestDSS, 127);
+		context->PSSetShader(RenderUtilities::GetMRTMergePS(), nullptr, 0);
+		context->PSSetShaderResources(0, count, srvs);
+
+		context->Draw(3, 0);
+
+		ID3D11ShaderResourceView* nullSRVs[MAX_MRT_BATCH] = {};
+		context->PSSetShaderResources(0, count, nullSRVs);
+
+		D3DPERF_EndEvent();
+	}
+
+	void RenderTargetMerger::MergeHalfResBatch(RTBackup** batch, UINT count, ID3D11DeviceContext* context, ID3D11Device* device)
+	{
+		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
+
+		D3DPERF_BeginEvent(0xFF00FF00, L"Merge_HalfRes_MRT");
+
+		ID3D11RenderTargetView* rtvs[MAX_HALF_RES_MRT_BATCH] = {};
+		// t0..t1 = backups, t2 = stencil SRV
+		ID3D11ShaderResourceView* srvs[MAX_HALF_RES_MRT_BATCH + 1] = {};
+		for (UINT i = 0; i < count; ++i) {
+			rtvs[i] = (ID3D11RenderTargetView*)rendererData->renderTargets[batch[i]->rtIndex].rtView;
+			srvs[i] = batch[i]->backupSRV;
+		}
+		srvs[MAX_HALF_RES_MRT_BATCH] = RenderUtilities::GetStencilSRV();
+
+		D3D11_VIEWPORT vp;
+		vp.Width = (float)batch[0]->width;
+		vp.Height = (float)batch[0]->height;
+		vp.MinDepth = 0.0f;
+		vp.MaxDepth = 1.0f;
+		vp.TopLeftX = 0;
+		vp.TopLeftY = 0;
+		context->RSSetViewports(1, &vp);
+		SetRegionScissor(context, batch[0]->width, batch[0]->height);
+
+		// Half-res RTs can't use the full-res DSV, the shader samples stencil and discards instead
+		context->OMSetRenderTargets(count, rtvs, nullptr);
+		context->OMSetDepthStencilState(nullptr, 0);
+		context->PSSetShader(RenderUtilities::GetHalfResMRTMergePS(), nullptr, 0);
+
+		struct HalfResParams {
+			float FullResWidth;
+			float FullResHeight;
+			float Padding[2];
+		};
+		HalfResParams params = { (float)RenderUtilities::GetScreenWidth(), (float)RenderUtilities::GetScreenHeight(), 0.0f, 0.0f };
+		ID3D11Buffer* cbuffer = D3DStateCache::GetSingleton()->UploadConstants(device, context, &params, sizeof(HalfResParams));
+		context->PSSetConstantBuffers(0, 1, &cbuffer);
+
+		context->PSSetShaderResources(0, MAX_HALF_RES_MRT_BATCH + 1, srvs);
+
+		context->Draw(3, 0);
+
+		ID3D11ShaderResourceView* nullSRVs[MAX_HALF_RES_MRT_BATCH + 1] = {};
+		context->PSSetShaderResources(0, MAX_HALF_RES_MRT_BATCH + 1, nullSRVs);
+
 		D3DPERF_EndEvent();
 	}
 
@@ -417,9 +775,10 @@ namespace ThroughScope
 		vp.TopLeftX = 0;
 		vp.TopLeftY = 0;
 		context->RSSetViewports(1, &vp);
+		SetRegionScissor(context, backup.width, backup.height);
 
 		// Check if this is a half-resolution RT (RT_09 SSR or RT_28 SSAO)
-		bool isHalfRes = (backup.rtIndex == 9 || backup.rtIndex == 28);
+		bool isHalfRes = IsHalfResRT(backup.rtIndex);
 		
 		if (isHalfRes && RenderUtilities::GetHalfResMergePS()) {
 			// For half-res RTs, use shader-based stencil sampling with UV*2
@@ -442,15 +801,8 @@ namespace ThroughScope
 			params.FullResWidth = (float)RenderUtilities::GetScreenWidth();
 			params.FullResHeight = (float)RenderUtilities::GetScreenHeight();
 			
-			Microsoft::WRL::ComPtr<ID3D11Buffer> cbuffer;
-			D3D11_BUFFER_DESC cbDesc;
-			ZeroMemory(&cbDesc, sizeof(cbDesc));
-			cbDesc.ByteWidth = sizeof(HalfResParams);
-			cbDesc.Usage = D3D11_USAGE_DEFAULT;
-			cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-			D3D11_SUBRESOURCE_DATA initData = { &params, 0, 0 };
-			device->CreateBuffer(&cbDesc, &initData, &cbuffer);
-			context->PSSetConstantBuffers(0, 1, cbuffer.GetAddressOf());
+			ID3D11Buffer* cbuffer = D3DStateCache::GetSingleton()->UploadConstants(device, context, &params, sizeof(HalfResParams));
+			context->PSSetConstantBuffers(0, 1, &cbuffer);
 			
 			// t0 = backup (first-pass content)
 			// t1 = stencil SRV
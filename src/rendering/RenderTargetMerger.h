@@ -4,6 +4,8 @@
 #include <wrl/client.h>
 #include <vector>
 #include <string>
+#include "RTWriteTracker.h"
+#include "TransientAliasPlanner.h"
 
 namespace ThroughScope
 {
@@ -13,6 +15,17 @@ namespace ThroughScope
 	 * During scope rendering, the second pass overwrites various render targets.
 	 * This class backs up the first-pass content and merges it back after scope rendering,
 	 * using stencil test to only restore pixels outside the scope region (stencil != 127).
+	 * Full-res targets are restored in MRT batches of up to 8 per draw and the half-res
+	 * pair in a single shader-masked draw (~3 full-screen passes instead of 11).
+	 * With write tracking, only RTs the scope pass wrote in the previous frame are backed
+	 * up up front; an unpredicted write is backed up from the D3D hooks right before it
+	 * happens, and RTs the scope pass never wrote are not merged at all.
+	 *
+	 * Backup textures are transient: acquired per frame through a TransientAliasPlanner,
+	 * trimmed to a memory budget while idle, and all released after a number of frames
+	 * without a merge (i.e. out of ADS). Each backup's lifetime runs from its copy to the
+	 * merge draw that consumes it; last frame's lifetimes are planned up front so same
+	 * size/format backups whose lifetimes don't overlap share a texture.
 	 * 
 	 * Managed Render Targets:
 	 * - RT_09: SSR_BlurredExtra (half-res)
@@ -47,14 +60,37 @@ namespace ThroughScope
 		void SetRTEnabled(int rtIndex, bool enabled);
 		bool IsRTEnabled(int rtIndex) const;
 		const std::vector<RTConfig>& GetConfiguredRTs() const { return m_configs; }
+		// Budget governor: skip the RTs only screen-space effects read (SSR/SSAO, half-res)
+		// without touching the per-RT configuration
+		void SetOptionalMergesSkipped(bool skipped) { m_skipOptionalMerges = skipped; }
+		bool AreOptionalMergesSkipped() const { return m_skipOptionalMerges; }
 
 		// Main operations - called from SecondPassRenderer
 		void BackupRenderTargets(ID3D11DeviceContext* context);
 		void MergeRenderTargets(ID3D11DeviceContext* context, ID3D11Device* device);
 
+		// Write tracking - D3DHooks reports every written resource between BackupRenderTargets
+		// and MergeRenderTargets (this covers SecondPassRenderer's own clears as well as the scope pass)
+		void NotifyScopeWrite(ID3D11DeviceContext* context, ID3D11Resource* resource);
+		bool IsRecordingWrites() const { return m_recordingWrites; }
+		void SetWriteTrackingEnabled(bool enabled);
+		bool IsWriteTrackingEnabled() const { return m_writeTracking; }
+
 		// Debug
 		int GetBackupCount() const { return static_cast<int>(m_rtBackups.size()); }
+		RTWriteTracker::SlotStats GetWriteStats(int rtIndex) const;
+
+		// Transient backup memory
+		void EndFrame();  // Once per presented frame: ages and evicts backup textures
+		void SetMemoryBudget(uint64_t bytes) { m_memoryBudgetBytes = bytes; }
+		uint64_t GetMemoryBudget() const { return m_memoryBudgetBytes; }
+		void SetReleaseAfterFrames(uint32_t frames) { m_releaseAfterFrames = frames; }
+		uint32_t GetReleaseAfterFrames() const { return m_releaseAfterFrames; }
+		uint64_t GetReservedBytes() const { return m_backupPlanner.GetReservedBytes(); }
+		uint64_t GetUsedBytes() const { return m_backupPlanner.GetUsedBytes(); }
+		uint64_t GetRequestedBytes() const { return m_backupPlanner.GetRequestedBytes(); }
 		int GetEnabledCount() const;
+		int GetLastMergeDrawCount() const { return m_lastMergeDrawCount; }  // Full-screen draws in the last merge
 
 	private:
 		RenderTargetMerger() = default;
@@ -69,18 +105,63 @@ namespace ThroughScope
 		{
 			int rtIndex = -1;
 			const char* name = nullptr;
+			// Transient, valid from the backup to the end of the merge (owned by m_backupTextures)
 			ID3D11Texture2D* backupTexture = nullptr;
 			ID3D11ShaderResourceView* backupSRV = nullptr;
+			TransientAliasPlanner::SlotId slot = TransientAliasPlanner::INVALID_SLOT;
+			TransientAliasPlanner::SlotId plannedSlot = TransientAliasPlanner::INVALID_SLOT;
+			TransientAliasPlanner::Lifetime lifetime;  // This frame's, on m_lifetimeClock
+			bool hasLastLifetime = false;              // lifetime holds last frame's, plan it
 			DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
 			UINT width = 0;
 			UINT height = 0;
 			bool enabled = true;
+			ID3D11Resource* sourceTexture = nullptr;  // Game RT texture seen at backup time (not owned)
 		};
 
 		std::vector<RTBackup> m_rtBackups;
 		std::vector<RTConfig> m_configs;
 		bool m_initialized = false;
 
+		// Per-merge scratch lists (kept to avoid per-frame allocation)
+		std::vector<RTBackup*> m_fullResGroup;
+		std::vector<RTBackup*> m_halfResGroup;
+		int m_lastMergeDrawCount = 0;
+
+		// Write tracking (see RTWriteTracker), slot = index into m_rtBackups
+		RTWriteTracker m_writeTracker;
+		bool m_writeTracking = true;
+		bool m_trackingFrame = false;    // Backup skipped by prediction this frame, merge only written RTs
+		bool m_recordingWrites = false;  // Between BackupRenderTargets and MergeRenderTargets
+
+		// Transient backup textures, indexed by planner slot
+		struct BackupTexture
+		{
+			Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+			Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+		};
+		TransientAliasPlanner m_backupPlanner;
+		TransientKeyTable m_backupKeys;  // Planner keys for backup descs, reset with the planner
+		std::vector<BackupTexture> m_backupTextures;
+		uint32_t m_lifetimeClock = 0;  // One tick per backup copy and per merge draw
+		std::vector<TransientAliasPlanner::Lifetime> m_plannedLifetimes;
+		std::vector<TransientAliasPlanner::SlotId> m_plannedSlots;
+		std::vector<RTBackup*> m_plannedBackups;
+		uint64_t m_memoryBudgetBytes = 512ull * 1024 * 1024;
+		uint32_t m_releaseAfterFrames = 120;  // ~2s out of ADS at 60 fps
+		bool m_mergedThisFrame = false;
+		bool m_skipOptionalMerges = false;
+		bool m_backedUpThisFrame = false;  // Backups are from this frame (not a skipped/reprojected scope frame)
+
+		static constexpr UINT MAX_MRT_BATCH = D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT;  // 8
+		static constexpr UINT MAX_HALF_RES_MRT_BATCH = 2;  // HalfResMRTMergePS outputs
+
+		static bool IsHalfResRT(int rtIndex) { return rtIndex == 9 || rtIndex == 28; }
+		static bool IsOptionalRT(int rtIndex) { return rtIndex == 9 || rtIndex == 28; }
+		bool IsMergeActive(const RTBackup& backup) const {
+			return backup.enabled && !(m_skipOptionalMerges && IsOptionalRT(backup.rtIndex));
+		}
+
 		// Default RTs to merge (excludes RT_03 SceneMain)
 		static constexpr int DEFAULT_MERGE_RTS[] = {
 			9,   // SSR_BlurredExtra (half-res)
@@ -110,8 +191,18 @@ namespace ThroughScope
 			"DeferredSpecular"   // 59
 		};
 
-		bool CreateBackupTexture(RTBackup& backup, ID3D11Device* device);
+		bool AcquireBackupTexture(RTBackup& backup, ID3D11Device* device, const D3D11_TEXTURE2D_DESC& rtDesc);
 		void ReleaseBackupTexture(RTBackup& backup);
+		void PlanBackupTextures();
+		void ReleaseBatch(RTBackup** batch, UINT count);
+		void BackupSingleRT(RTBackup& backup, ID3D11DeviceContext* context);
+		bool NeedsMerge(const RTBackup& backup) const;
+		void FinishWriteTracking();
+		void MergeGrouped(ID3D11DeviceContext* context, ID3D11Device* device,
+			ID3D11DepthStencilView* stencilDSV, ID3D11DepthStencilState* stencilTestDSS);
+		void MergeFullResBatch(RTBackup** batch, UINT count, ID3D11DeviceContext* context,
+			ID3D11DepthStencilView* stencilDSV, ID3D11DepthStencilState* stencilTestDSS);
+		void MergeHalfResBatch(RTBackup** batch, UINT count, ID3D11DeviceContext* context, ID3D11Device* device);
 		void MergeSingleRT(RTBackup& backup, ID3D11DeviceContext* context,
 			ID3D11Device* device, ID3D11DepthStencilView* stencilDSV,
 			ID3D11DepthStencilState* stencilTestDSS);
@@ -0,0 +1,113 @@
+#include "ScopeAmortizationPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope
+{
+    static float Distance(const float a[3], const float b[3])
+    {
+        const float dx = a[0] - b[0];
+        const float dy = a[1] - b[1];
+        const float dz = a[2] - b[2];
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    float ScopeAmortizationPolicy::AngleBetweenDeg(const float a[3][3], const float b[3][3])
+    {
+        // Relative rotation R = A^T B; trace(R) = 1 + 2cos(theta), |skew(R)| = 2sin(theta).
+        // atan2 of both stays accurate for the sub-0.1 degree angles acos alone loses in float.
+        // The angle is the same for A B^T, so the row/column vector convention doesn't matter.
+        double r[3][3] = {};
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                for (int k = 0; k < 3; ++k) {
+                    r[i][j] += static_cast<double>(a[k][i]) * b[k][j];
+                }
+            }
+        }
+        const double cosTerm = r[0][0] + r[1][1] + r[2][2] - 1.0;
+        const double sx = r[2][1] - r[1][2];
+        const double sy = r[0][2] - r[2][0];
+        const double sz = r[1][0] - r[0][1];
+        const double sinTerm = std::sqrt(sx * sx + sy * sy + sz * sz);
+        return static_cast<float>(std::atan2(sinTerm, cosTerm) * 57.29577951308232);
+    }
+
+    ScopeAmortizationPolicy::Decision ScopeAmortizationPolicy::Decide(const FrameInput& input)
+    {
+        const Pose& pose = input.pose;
+        const bool hadPrevious = m_hasPrevious;
+        const Pose previous = m_previousPose;
+        m_previousPose = pose;
+        m_hasPrevious = true;
+
+        auto render = [&](Reason reason) {
+            m_renderedPose = pose;
+            m_hasHistory = true;
+            m_framesSinceRender = 0;
+            return Record(Decision::Render, reason);
+        };
+
+        if (!m_settings.enabled) {
+            m_cooldown = 0;
+            return render(Reason::Disabled);
+        }
+        if (input.forceRender) {
+            return render(Reason::Forced);
+        }
+        if (!m_hasHistory || !hadPrevious) {
+            return render(Reason::NoHistory);
+        }
+
+        // Fallbacks restart the cooldown
+        auto fallback = [&](Reason reason) {
+            m_cooldown = m_settings.cooldownFrames;
+            return render(reason);
+        };
+
+        if (input.flash) {
+            return fallback(Reason::Flash);
+        }
+        if (std::fabs(pose.fovDeg - m_renderedPose.fovDeg) > m_settings.fovToleranceDeg) {
+            return fallback(Reason::Zoom);
+        }
+        if (AngleBetweenDeg(pose.rotation, previous.rotation) > m_settings.maxAngularDeltaDeg ||
+            AngleBetweenDeg(pose.rotation, m_renderedPose.rotation) > m_settings.maxAccumulatedAngleDeg ||
+            Distance(pose.position, previous.position) > m_settings.maxPositionalDelta) {
+            return fallback(Reason::Motion);
+        }
+
+        if (m_cooldown > 0) {
+            --m_cooldown;
+            return render(Reason::Cooldown);
+        }
+        if (m_framesSinceRender + 1 >= std::max(m_settings.renderInterval, 1u)) {
+            return render(Reason::Schedule);
+        }
+
+        ++m_framesSinceRender;
+        return Record(Decision::Reproject, Reason::Steady);
+    }
+
+    ScopeAmortizationPolicy::Decision ScopeAmortizationPolicy::Record(Decision decision, Reason reason)
+    {
+        m_lastReason = reason;
+        ++m_stats.frames;
+        ++m_stats.byReason[static_cast<size_t>(reason)];
+        if (decision == Decision::Reproject) {
+            ++m_stats.reprojected;
+        }
+        return decision;
+    }
+
+    void ScopeAmortizationPolicy::Reset()
+    {
+        m_hasHistory = false;
+        m_hasPrevious = false;
+        m_framesSinceRender = 0;
+        m_cooldown = 0;
+        m_lastReason = Reason::Disabled;
+        m_stats = {};
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+// Portable decision policy for temporal amortization of the scope pass: whether this frame
+// renders the scope view or reprojects the last rendered image.
+// No D3D / CommonLib dependencies; poses are plain arrays filled by the caller.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Decides per frame between a full second pass and reprojecting the previous one
+     *
+     * A frame may reproject only when all of these hold:
+     *  - a rendered frame exists and fewer than renderInterval - 1 frames were reprojected since
+     *  - camera rotation since last frame is below maxAngularDeltaDeg and, accumulated since the
+     *    last render, below maxAccumulatedAngleDeg
+     *  - camera movement since last frame is below maxPositionalDelta
+     *  - FOV matches the last render within fovToleranceDeg (no zoom change)
+     *  - no flash (muzzle flash, explosion) is active and none ended in the last cooldownFrames
+     *
+     * Any fallback also keeps rendering for cooldownFrames, so motion that is just settling
+     * doesn't flip between the two paths every frame.
+     */
+    class ScopeAmortizationPolicy
+    {
+    public:
+        struct Settings
+        {
+            bool enabled = false;
+            uint32_t renderInterval = 2;          // Render at least every N frames (2 = alternate frames)
+            float maxAngularDeltaDeg = 0.05f;
+            float maxAccumulatedAngleDeg = 0.25f;
+            float maxPositionalDelta = 0.5f;      // Game units per frame
+            float fovToleranceDeg = 0.01f;
+            uint32_t cooldownFrames = 2;
+        };
+
+        struct Pose
+        {
+            float rotation[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+            float position[3] = { 0.0f, 0.0f, 0.0f };
+            float fovDeg = 0.0f;
+        };
+
+        struct FrameInput
+        {
+            Pose pose;
+            bool flash = false;       // Transient light (muzzle flash etc.) in the scene
+            bool forceRender = false; // Caller has no valid history (resize, scope change, ...)
+        };
+
+        enum class Decision : uint8_t
+        {
+            Render,
+            Reproject
+        };
+
+        enum class Reason : uint8_t
+        {
+            Disabled,
+            NoHistory,
+            Forced,
+            Schedule,
+            Motion,
+            Zoom,
+            Flash,
+            Cooldown,
+            Steady,     // Reprojected
+            Count
+        };
+
+        struct Stats
+        {
+            uint64_t frames = 0;
+            uint64_t reprojected = 0;
+            uint64_t byReason[static_cast<size_t>(Reason::Count)] = {};
+        };
+
+        /**
+         * @brief Decide for this frame
+         *
+         * A Render decision takes the pose as the new reference; call Invalidate() if the
+         * render then fails so the next frame doesn't reproject a stale image.
+         */
+        Decision Decide(const FrameInput& input);
+
+        /// Drop the rendered reference (failed render, device or scope change)
+        void Invalidate() { m_hasHistory = false; }
+        void Reset();
+
+        /// Rotation angle between two orientations, in degrees
+        static float AngleBetweenDeg(const float a[3][3], const float b[3][3]);
+
+        Settings& GetSettings() { return m_settings; }
+        const Settings& GetSettings() const { return m_settings; }
+        Reason GetLastReason() const { return m_lastReason; }
+        const Stats& GetStats() const { return m_stats; }
+
+    private:
+        Decision Record(Decision decision, Reason reason);
+
+        Settings m_settings;
+        Pose m_renderedPose;
+        Pose m_previousPose;
+        bool m_hasHistory = false;
+        bool m_hasPrevious = false;
+        uint32_t m_framesSinceRender = 0;
+        uint32_t m_cooldown = 0;
+        Reason m_lastReason = Reason::Disabled;
+        Stats m_stats;
+    };
+}
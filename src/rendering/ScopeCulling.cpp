@@ -83,6 +83,11 @@ namespace ThroughScope
     static RE::NiFrustumPlanes s_CachedScopePlanes;
     static bool s_CachedScopePlanesValid = false;
 
+    // Contribution culling: scope camera position and pixels per unit of (radius / distance)
+    static float s_ContributionCullPixels = 0.0f;
+    static RE::NiPoint3 s_CachedScopeCameraPos;
+    static float s_CachedPixelsPerTangent = 0.0f;
+
     bool TestBoundAgainstFrustum(const RE::NiBound* bound, const RE::NiFrustumPlanes& scopePlanes)
     {
         if (!bound) {
@@ -270,6 +275,11 @@ namespace ThroughScope
 
         s_CachedScopePlanes.m_uiActivePlanes = 0x3F;  // All 6 planes active
         s_CachedScopePlanesValid = true;
+
+        // 贡献裁剪：视锥体边界是单位距离处的正切值，整个视锥高度对应屏幕高度
+        s_CachedScopeCameraPos = camPos;
+        const auto& state = RE::BSGraphics::State::GetSingleton();
+        s_CachedPixelsPerTangent = height > 0.0f ? static_cast<float>(state.backBufferHeight) / height : 0.0f;
     }
 
     void InvalidateCachedScopeFrustumPlanes()
@@ -335,4 +345,34 @@ namespace ThroughScope
     {
         return s_ShadowCasterRange;
     }
+
+    // ========== Contribution Culling ==========
+
+    void SetContributionCullPixels(float pixels)
+    {
+        s_ContributionCullPixels = pixels;
+    }
+
+    float GetContributionCullPixels()
+    {
+        return s_ContributionCullPixels;
+    }
+
+    bool TestBoundContribution(const RE::NiBound* bound)
+    {
+        if (!bound || s_ContributionCullPixels <= 0.0f || !s_CachedScopePlanesValid || s_CachedPixelsPerTangent <= 0.0f) {
+            return true;
+        }
+
+        float dx = bound->center.x - s_CachedScopeCameraPos.x;
+        float dy = bound->center.y - s_CachedScopeCameraPos.y;
+        float dz = bound->center.z - s_CachedScopeCameraPos.z;
+        float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+        if (distance <= bound->fRadius) {
+            return true;  // Camera inside the bound
+        }
+
+        float projectedDiameter = 2.0f * bound->fRadius / distance * s_CachedPixelsPerTangent;
+        return projectedDiameter >= s_ContributionCullPixels;
+    }
 }
@@ -146,4 +146,22 @@ namespace ThroughScope
 
     void SetShadowCasterRange(float range);
     float GetShadowCasterRange();
+
+    // ========== Contribution Culling ==========
+
+    /**
+     * @brief Minimum projected diameter (pixels) of objects in the scope view, 0 = off
+     */
+    void SetContributionCullPixels(float pixels);
+    float GetContributionCullPixels();
+
+    /**
+     * @brief Test if a bounding sphere covers at least the contribution threshold
+     * 
+     * Uses the scope camera cached by UpdateCachedScopeFrustumPlanes.
+     * 
+     * @param bound The bounding sphere to test
+     * @return true if the object is large enough (or the test is off), false to cull it
+     */
+    bool TestBoundContribution(const RE::NiBound* bound);
 }
@@ -0,0 +1,145 @@
+#include "ScopeProjection.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope::ScopeProjection
+{
+    static constexpr float kMinClipW = 1e-4f;
+
+    Float4 Transform(const Matrix4& matrix, const Float3& point)
+    {
+        Float4 result;
+        result.x = matrix.m[0][0] * point.x + matrix.m[0][1] * point.y + matrix.m[0][2] * point.z + matrix.m[0][3];
+        result.y = matrix.m[1][0] * point.x + matrix.m[1][1] * point.y + matrix.m[1][2] * point.z + matrix.m[1][3];
+        result.z = matrix.m[2][0] * point.x + matrix.m[2][1] * point.y + matrix.m[2][2] * point.z + matrix.m[2][3];
+        result.w = matrix.m[3][0] * point.x + matrix.m[3][1] * point.y + matrix.m[3][2] * point.z + matrix.m[3][3];
+        return result;
+    }
+
+    // Rows 0/1 of a perspective view-projection are the camera right/up axes scaled by the projection
+    static bool ExtractAxis(const Matrix4& matrix, int row, Float3& outAxis)
+    {
+        float x = matrix.m[row][0];
+        float y = matrix.m[row][1];
+        float z = matrix.m[row][2];
+        float length = std::sqrt(x * x + y * y + z * z);
+        if (length < 1e-8f) {
+            return false;
+        }
+
+        outAxis = { x / length, y / length, z / length };
+        return true;
+    }
+
+    // D3D NDC: X [-1,1] left-to-right, Y [-1,1] bottom-to-top -> UV with V down
+    static bool ProjectToUV(const Matrix4& matrix, const Float3& point, float& outU, float& outV)
+    {
+        Float4 clip = Transform(matrix, point);
+        if (clip.w < kMinClipW) {
+            return false;
+        }
+
+        outU = (clip.x / clip.w) * 0.5f + 0.5f;
+        outV = -(clip.y / clip.w) * 0.5f + 0.5f;
+        return true;
+    }
+
+    ScreenEllipse ProjectSphere(const Matrix4& viewProj, const Float3& center, float radius)
+    {
+        ScreenEllipse result;
+
+        Float3 right;
+        Float3 up;
+        if (radius <= 0.0f || !ExtractAxis(viewProj, 0, right) || !ExtractAxis(viewProj, 1, up)) {
+            return result;
+        }
+
+        const Float3 samples[4] = {
+            { center.x + right.x * radius, center.y + right.y * radius, center.z + right.z * radius },
+            { center.x - right.x * radius, center.y - right.y * radius, center.z - right.z * radius },
+            { center.x + up.x * radius, center.y + up.y * radius, center.z + up.z * radius },
+            { center.x - up.x * radius, center.y - up.y * radius, center.z - up.z * radius },
+        };
+
+        float minU = 0.0f, maxU = 0.0f, minV = 0.0f, maxV = 0.0f;
+        for (int i = 0; i < 4; ++i) {
+            float u = 0.0f;
+            float v = 0.0f;
+            if (!ProjectToUV(viewProj, samples[i], u, v)) {
+                return result;
+            }
+
+            if (i == 0) {
+                minU = maxU = u;
+                minV = maxV = v;
+            } else {
+                minU = std::min(minU, u);
+                maxU = std::max(maxU, u);
+                minV = std::min(minV, v);
+                maxV = std::max(maxV, v);
+            }
+        }
+
+        // Under perspective the projected silhouette center is not the projected sphere center,
+        // use the middle of the extremes
+        result.centerU = (minU + maxU) * 0.5f;
+        result.centerV = (minV + maxV) * 0.5f;
+        result.radiusU = (maxU - minU) * 0.5f;
+        result.radiusV = (maxV - minV) * 0.5f;
+        result.minU = minU;
+        result.minV = minV;
+        result.maxU = maxU;
+        result.maxV = maxV;
+        result.valid = true;
+        return result;
+    }
+
+    ScreenEllipse ProjectScopeQuad(const Matrix4& viewProj, const Float3& boundCenter, float boundRadius)
+    {
+        return ProjectSphere(viewProj, boundCenter, boundRadius * kScopeQuadHalfEdgePerBoundRadius);
+    }
+
+    bool RotationReprojection(const Matrix4& previous, const Matrix4& current, float out[3][3])
+    {
+        // Directions (w = 0) only see the upper-left 3 columns of the x, y and w rows
+        static constexpr int kRows[3] = { 0, 1, 3 };
+
+        double cur[3][3];
+        double prev[3][3];
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                cur[r][c] = current.m[kRows[r]][c];
+                prev[r][c] = previous.m[kRows[r]][c];
+            }
+        }
+
+        // Inverse of the current 3x3 via the adjugate
+        double inv[3][3];
+        inv[0][0] = cur[1][1] * cur[2][2] - cur[1][2] * cur[2][1];
+        inv[0][1] = cur[0][2] * cur[2][1] - cur[0][1] * cur[2][2];
+        inv[0][2] = cur[0][1] * cur[1][2] - cur[0][2] * cur[1][1];
+        inv[1][0] = cur[1][2] * cur[2][0] - cur[1][0] * cur[2][2];
+        inv[1][1] = cur[0][0] * cur[2][2] - cur[0][2] * cur[2][0];
+        inv[1][2] = cur[0][2] * cur[1][0] - cur[0][0] * cur[1][2];
+        inv[2][0] = cur[1][0] * cur[2][1] - cur[1][1] * cur[2][0];
+        inv[2][1] = cur[0][1] * cur[2][0] - cur[0][0] * cur[2][1];
+        inv[2][2] = cur[0][0] * cur[1][1] - cur[0][1] * cur[1][0];
+
+        const double det = cur[0][0] * inv[0][0] + cur[0][1] * inv[1][0] + cur[0][2] * inv[2][0];
+        if (std::fabs(det) < 1e-12) {
+            return false;
+        }
+
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                double sum = 0.0;
+                for (int k = 0; k < 3; ++k) {
+                    sum += prev[r][k] * inv[k][c];
+                }
+                out[r][c] = static_cast<float>(sum / det);
+            }
+        }
+        return true;
+    }
+}
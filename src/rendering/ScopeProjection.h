@@ -0,0 +1,93 @@
+#pragma once
+
+// Portable math used to locate the scope quad on screen.
+// No D3D / CommonLib dependencies so it can be reasoned about (and reused) outside the game.
+
+namespace ThroughScope::ScopeProjection
+{
+    struct Float3
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    struct Float4
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 0.0f;
+    };
+
+    /**
+     * @brief Row-major 4x4 matrix, clip[i] = dot(m[i], (x, y, z, 1))
+     *
+     * Same layout as NiCamera::worldToCam and the WVP rows the game uploads to VS cb2.
+     */
+    struct Matrix4
+    {
+        float m[4][4] = {};
+    };
+
+    /**
+     * @brief Screen-space ellipse covered by the scope quad, in viewport UV (0-1, V down)
+     */
+    struct ScreenEllipse
+    {
+        bool valid = false;
+        float centerU = 0.0f;
+        float centerV = 0.0f;
+        float radiusU = 0.0f;
+        float radiusV = 0.0f;
+        float minU = 0.0f;
+        float minV = 0.0f;
+        float maxU = 0.0f;
+        float maxV = 0.0f;
+    };
+
+    Float4 Transform(const Matrix4& matrix, const Float3& point);
+
+    /**
+     * @brief Project a world-space bounding sphere through a view-projection matrix
+     *
+     * The sphere is sampled along the camera's right/up axes (recovered from rows 0/1
+     * of the matrix), which gives the exact silhouette of a camera-facing disk such as
+     * the scope quad. Returns an invalid ellipse when any sample is behind the near plane.
+     *
+     * @param viewProj World to clip matrix
+     * @param center Sphere center in world space
+     * @param radius Sphere radius in world units
+     */
+    ScreenEllipse ProjectSphere(const Matrix4& viewProj, const Float3& center, float radius);
+
+    /**
+     * @brief Half edge of the square scope quad over its bounding-sphere radius
+     *
+     * TTSEffectShape is a square with a unit half edge in model space (the extent the old
+     * cb2-WVP readback projected); its bound is the circumscribed sphere, whose radius is
+     * the half diagonal.
+     */
+    constexpr float kScopeQuadHalfEdgePerBoundRadius = 0.70710678f;
+
+    /**
+     * @brief Screen ellipse of the scope aperture from the TTSEffectShape world bound
+     *
+     * Projects the disk inscribed in the quad (radius = half edge), not the bounding sphere,
+     * so the result matches the quad's own edge extent.
+     */
+    ScreenEllipse ProjectScopeQuad(const Matrix4& viewProj, const Float3& boundCenter, float boundRadius);
+
+    /**
+     * @brief Homography taking current NDC (x, y, 1) to the previous frame's homogeneous NDC
+     *
+     * Built from the x/y/w rows of both world-to-clip matrices, i.e. for points at infinity:
+     * rotation and projection (zoom) changes are compensated, camera translation is not.
+     * That is exact for distant content and close for small moves, which is all the scope
+     * image reprojection needs.
+     *
+     * @param out prev = out * (x, y, 1); divide by prev[2] (<= 0 means behind the old camera)
+     * @return false when the current matrix is singular
+     */
+    bool RotationReprojection(const Matrix4& previous, const Matrix4& current, float out[3][3]);
+}
@@ -0,0 +1,174 @@
+#include "ScopeQuadVerdictCache.h"
+
+namespace ThroughScope
+{
+    ScopeQuadVerdictCache* ScopeQuadVerdictCache::GetSingleton()
+    {
+        static ScopeQuadVerdictCache instance;
+        return &instance;
+    }
+
+    size_t ScopeQuadVerdictCache::HashKey(const Key& key)
+    {
+        // Buffers are at least 16-byte aligned, drop the low bits before mixing
+        auto mix = [](uint64_t h, uint64_t value) {
+            h ^= value + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            return h;
+        };
+        uint64_t h = reinterpret_cast<uintptr_t>(key.vertexBuffer) >> 4;
+        h = mix(h, reinterpret_cast<uintptr_t>(key.indexBuffer) >> 4);
+        h = mix(h, static_cast<uint64_t>(key.indexCount) << 32 | key.stride);
+        h = mix(h, static_cast<uint64_t>(key.vertexOffset) << 32 | key.indexOffset);
+        h = mix(h, static_cast<uint64_t>(key.startIndex) << 32 | static_cast<uint32_t>(key.baseVertex));
+        // Murmur3 finalizer so every input bit reaches the set index
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return static_cast<size_t>(h) & (kSetCount - 1);
+    }
+
+    ScopeQuadVerdictCache::Verdict ScopeQuadVerdictCache::Lookup(const Key& key, const Context& context)
+    {
+        if (m_hasDestroyed.load(std::memory_order_acquire)) {
+            ProcessDestroyedBuffers();
+        }
+
+        const Set& set = m_sets[HashKey(key)];
+        for (const Entry& entry : set.ways) {
+            if (entry.verdict != Verdict::Unknown &&
+                entry.key == key &&
+                entry.context.registryGeneration == context.registryGeneration &&
+                entry.context.scopeNode == context.scopeNode) {
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                return entry.verdict;
+            }
+        }
+
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return Verdict::Unknown;
+    }
+
+    void ScopeQuadVerdictCache::Store(const Key& key, const Context& context, bool isScopeQuad)
+    {
+        if (!m_enabled || !key.vertexBuffer || !key.indexBuffer) {
+            return;
+        }
+
+        // Same key with a stale context, else an empty way, else round-robin
+        Set& set = m_sets[HashKey(key)];
+        size_t way = kWays;
+        for (size_t i = 0; i < kWays; ++i) {
+            if (set.ways[i].verdict != Verdict::Unknown && set.ways[i].key == key) {
+                way = i;
+                break;
+            }
+            if (way == kWays && set.ways[i].verdict == Verdict::Unknown) {
+                way = i;
+            }
+        }
+        if (way == kWays) {
+            way = set.nextVictim;
+            set.nextVictim = static_cast<uint8_t>((way + 1) % kWays);
+        }
+        Entry& entry = set.ways[way];
+        ClearEntry(entry);
+
+        BufferWatch* vertexWatch = AcquireBuffer(key.vertexBuffer);
+        BufferWatch* indexWatch = vertexWatch ? AcquireBuffer(key.indexBuffer) : nullptr;
+        if (!indexWatch) {
+            // No destruction notification: a reused pointer would return a wrong verdict
+            if (vertexWatch) {
+                --vertexWatch->entryCount;
+            }
+            Invalidate();
+            m_enabled = false;
+            return;
+        }
+
+        entry.key = key;
+        entry.context = context;
+        entry.vertexWatch = vertexWatch;
+        entry.indexWatch = indexWatch;
+        entry.verdict = isScopeQuad ? Verdict::ScopeQuad : Verdict::NotScopeQuad;
+    }
+
+    void ScopeQuadVerdictCache::Invalidate()
+    {
+        for (Set& set : m_sets) {
+            for (Entry& entry : set.ways) {
+                ClearEntry(entry);
+            }
+        }
+    }
+
+    void ScopeQuadVerdictCache::OnBufferDestroyed(void* token)
+    {
+        auto* watch = static_cast<BufferWatch*>(token);
+        ScopeQuadVerdictCache* owner = watch->owner;
+        std::lock_guard<std::mutex> lock(owner->m_destroyedMutex);
+        owner->m_destroyed.push_back(watch);
+        owner->m_hasDestroyed.store(true, std::memory_order_release);
+    }
+
+    ScopeQuadVerdictCache::BufferWatch* ScopeQuadVerdictCache::AcquireBuffer(const void* buffer)
+    {
+        auto it = m_watches.find(buffer);
+        if (it == m_watches.end()) {
+            if (!m_watch) {
+                return nullptr;
+            }
+            // Registered once; the runtime drops the callback when the buffer is destroyed
+            auto watch = std::make_unique<BufferWatch>();
+            watch->owner = this;
+            watch->buffer = buffer;
+            if (!m_watch(buffer, watch.get())) {
+                return nullptr;
+            }
+            it = m_watches.emplace(buffer, std::move(watch)).first;
+        }
+        ++it->second->entryCount;
+        return it->second.get();
+    }
+
+    void ScopeQuadVerdictCache::ClearEntry(Entry& entry)
+    {
+        if (entry.verdict == Verdict::Unknown) {
+            return;
+        }
+        --entry.vertexWatch->entryCount;
+        --entry.indexWatch->entryCount;
+        entry = {};
+    }
+
+    void ScopeQuadVerdictCache::ProcessDestroyedBuffers()
+    {
+        std::vector<BufferWatch*> destroyed;
+        {
+            std::lock_guard<std::mutex> lock(m_destroyedMutex);
+            destroyed.swap(m_destroyed);
+            m_hasDestroyed.store(false, std::memory_order_relaxed);
+        }
+
+        for (BufferWatch* watch : destroyed) {
+            const void* buffer = watch->buffer;
+            // Only entries that mention the destroyed buffer are stale
+            for (Set& set : m_sets) {
+                if (watch->entryCount == 0) {
+                    break;
+                }
+                for (Entry& entry : set.ways) {
+                    if (entry.verdict != Verdict::Unknown &&
+                        (entry.vertexWatch == watch || entry.indexWatch == watch)) {
+                        ClearEntry(entry);
+                    }
+                }
+            }
+            auto it = m_watches.find(buffer);
+            if (it != m_watches.end() && it->second.get() == watch) {
+                m_watches.erase(it);
+            }
+        }
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+// Portable per-draw verdict cache for the scope quad classification.
+// No D3D / CommonLib dependencies; D3DHooks supplies the buffer destruction notification.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Per-draw verdict cache for scope quad classification in hkDrawIndexed
+     *
+     * hkDrawIndexed runs for every indexed draw of the game. The full check needs
+     * GetDesc on both buffers plus a registry/scene-graph lookup, but its result only
+     * depends on the draw's geometry window (buffers, offsets, start index, base vertex,
+     * index count, stride) and on which scope model is loaded. This cache stores that
+     * verdict in a fixed-size four-way set-associative table so the steady state costs one
+     * hash and at most four compares per draw, with no heap allocation.
+     *
+     * A buffer pointer can be reused after the buffer is destroyed, so every cached buffer
+     * is watched for destruction (once per buffer lifetime):
+     * - destroying a buffer drops only the entries that reference it
+     * - a stale registry generation or scope node is a miss (context mismatch)
+     * - if a buffer cannot be watched, caching is disabled and every draw is classified
+     */
+    class ScopeQuadVerdictCache
+    {
+    public:
+        struct Key
+        {
+            const void* vertexBuffer = nullptr;
+            const void* indexBuffer = nullptr;
+            uint32_t vertexOffset = 0;   // IASetVertexBuffers offset (bytes)
+            uint32_t indexOffset = 0;    // IASetIndexBuffer offset (bytes)
+            uint32_t startIndex = 0;
+            int32_t baseVertex = 0;
+            uint32_t indexCount = 0;
+            uint32_t stride = 0;
+
+            bool operator==(const Key& other) const
+            {
+                return vertexBuffer == other.vertexBuffer && indexBuffer == other.indexBuffer &&
+                       vertexOffset == other.vertexOffset && indexOffset == other.indexOffset &&
+                       startIndex == other.startIndex && baseVertex == other.baseVertex &&
+                       indexCount == other.indexCount && stride == other.stride;
+            }
+        };
+
+        /// State the verdict was computed against (scope model identity)
+        struct Context
+        {
+            uint64_t registryGeneration = 0;
+            const void* scopeNode = nullptr;
+        };
+
+        enum class Verdict : uint8_t
+        {
+            Unknown = 0,
+            NotScopeQuad,
+            ScopeQuad
+        };
+
+        /**
+         * @brief Ask the runtime to call OnBufferDestroyed(token) when buffer is destroyed
+         * @return false if the buffer does not support destruction notification
+         */
+        using WatchFunction = bool (*)(const void* buffer, void* token);
+
+        static ScopeQuadVerdictCache* GetSingleton();
+
+        ScopeQuadVerdictCache() = default;
+        ~ScopeQuadVerdictCache() = default;
+        ScopeQuadVerdictCache(const ScopeQuadVerdictCache&) = delete;
+        ScopeQuadVerdictCache& operator=(const ScopeQuadVerdictCache&) = delete;
+
+        /// Must be set before the first Store(); without it nothing is cached
+        void SetWatchFunction(WatchFunction watch) { m_watch = watch; }
+
+        /**
+         * @brief Look up a cached verdict
+         * @return Verdict::Unknown on miss, stale entry or when caching is disabled
+         */
+        Verdict Lookup(const Key& key, const Context& context);
+
+        /**
+         * @brief Store a verdict; watches both buffers the first time they are cached
+         */
+        void Store(const Key& key, const Context& context, bool isScopeQuad);
+
+        /**
+         * @brief Drop all cached verdicts
+         */
+        void Invalidate();
+
+        /**
+         * @brief Destruction callback target; token is the value passed to the WatchFunction
+         *
+         * May run on any thread. The affected entries are dropped by the next Lookup().
+         */
+        static void OnBufferDestroyed(void* token);
+
+        bool IsEnabled() const { return m_enabled; }
+        uint64_t GetHitCount() const { return m_hits.load(std::memory_order_relaxed); }
+        uint64_t GetMissCount() const { return m_misses.load(std::memory_order_relaxed); }
+
+    private:
+        /// One per watched buffer, alive until the buffer's destruction callback was handled
+        struct BufferWatch
+        {
+            ScopeQuadVerdictCache* owner = nullptr;
+            const void* buffer = nullptr;
+            uint32_t entryCount = 0;  // Table entries referencing the buffer
+        };
+
+        struct Entry
+        {
+            Key key;
+            Context context;
+            BufferWatch* vertexWatch = nullptr;
+            BufferWatch* indexWatch = nullptr;
+            Verdict verdict = Verdict::Unknown;
+        };
+
+        // Power of two; a forward pass draws a few hundred distinct windows
+        static constexpr size_t kSetCount = 256;
+        static constexpr size_t kWays = 4;
+
+        struct Set
+        {
+            std::array<Entry, kWays> ways{};
+            uint8_t nextVictim = 0;  // Ways are replaced round-robin when the set is full
+        };
+
+        static size_t HashKey(const Key& key);
+        BufferWatch* AcquireBuffer(const void* buffer);
+        void ClearEntry(Entry& entry);
+        void ProcessDestroyedBuffers();
+
+        std::array<Set, kSetCount> m_sets{};
+        WatchFunction m_watch = nullptr;
+        bool m_enabled = true;
+
+        /// Buffers with a registered destruction callback (render thread only)
+        std::unordered_map<const void*, std::unique_ptr<BufferWatch>> m_watches;
+
+        /// Filled by destruction callbacks on any thread, drained by Lookup()
+        std::mutex m_destroyedMutex;
+        std::vector<BufferWatch*> m_destroyed;
+        std::atomic<bool> m_hasDestroyed{ false };
+
+        std::atomic<uint64_t> m_hits{ 0 };
+        std::atomic<uint64_t> m_misses{ 0 };
+    };
+}
@@ -0,0 +1,82 @@
+#include "ScopeRegion.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope::ScopeRegion
+{
+    UVRect ExpandAperture(const UVRect& aperture, float margin)
+    {
+        UVRect result;
+        result.minU = std::clamp(aperture.minU - margin, 0.0f, 1.0f);
+        result.minV = std::clamp(aperture.minV - margin, 0.0f, 1.0f);
+        result.maxU = std::clamp(aperture.maxU + margin, 0.0f, 1.0f);
+        result.maxV = std::clamp(aperture.maxV + margin, 0.0f, 1.0f);
+        return result;
+    }
+
+    PixelRect ToPixelRect(const UVRect& rect, uint32_t width, uint32_t height, uint32_t alignment)
+    {
+        PixelRect result;
+        if (rect.IsEmpty() || width == 0 || height == 0) {
+            return result;
+        }
+
+        if (alignment == 0) {
+            alignment = 1;
+        }
+        const uint32_t mask = ~(alignment - 1);
+
+        auto toPixel = [](float uv, uint32_t size, bool roundUp) -> uint32_t {
+            float pixel = std::clamp(uv, 0.0f, 1.0f) * static_cast<float>(size);
+            pixel = roundUp ? std::ceil(pixel) : std::floor(pixel);
+            return static_cast<uint32_t>(pixel);
+        };
+
+        result.left = toPixel(rect.minU, width, false) & mask;
+        result.top = toPixel(rect.minV, height, false) & mask;
+        result.right = std::min((toPixel(rect.maxU, width, true) + alignment - 1) & mask, width);
+        result.bottom = std::min((toPixel(rect.maxV, height, true) + alignment - 1) & mask, height);
+        return result;
+    }
+
+    bool MatchesAspect(uint32_t width, uint32_t height, uint32_t refWidth, uint32_t refHeight, float tolerance)
+    {
+        if (width == 0 || height == 0 || refWidth == 0 || refHeight == 0) {
+            return false;
+        }
+        const float aspect = static_cast<float>(width) / static_cast<float>(height);
+        const float refAspect = static_cast<float>(refWidth) / static_cast<float>(refHeight);
+        return std::fabs(aspect - refAspect) <= refAspect * tolerance;
+    }
+
+    bool SurfaceRect(const UVRect& region, uint32_t refWidth, uint32_t refHeight, uint32_t width, uint32_t height, PixelRect& rect)
+    {
+        rect = { 0, 0, width, height };
+        if (width == 0 || height == 0 || !MatchesAspect(width, height, refWidth, refHeight)) {
+            return false;
+        }
+        rect = ToPixelRect(region, width, height);
+        return true;
+    }
+
+    ScissorRect Intersect(const ScissorRect& a, const ScissorRect& b)
+    {
+        ScissorRect result;
+        result.left = std::max(a.left, b.left);
+        result.top = std::max(a.top, b.top);
+        result.right = std::max(std::min(a.right, b.right), result.left);
+        result.bottom = std::max(std::min(a.bottom, b.bottom), result.top);
+        return result;
+    }
+
+    ScissorRect ViewportScissor(const PixelRect& region, int32_t viewportLeft, int32_t viewportTop, const ScissorRect* gameScissor)
+    {
+        ScissorRect rect;
+        rect.left = viewportLeft + static_cast<int32_t>(region.left);
+        rect.top = viewportTop + static_cast<int32_t>(region.top);
+        rect.right = viewportLeft + static_cast<int32_t>(region.right);
+        rect.bottom = viewportTop + static_cast<int32_t>(region.bottom);
+        return gameScissor ? Intersect(rect, *gameScissor) : rect;
+    }
+}
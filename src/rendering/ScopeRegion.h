@@ -0,0 +1,96 @@
+#pragma once
+
+// Portable helpers for the region-limited scope pass: aperture rect in UV space and its
+// pixel rect on surfaces of different resolutions (full-res, half-res, upscaler input).
+// No D3D / CommonLib dependencies.
+
+#include <cstdint>
+
+namespace ThroughScope::ScopeRegion
+{
+    /**
+     * @brief Rectangle in viewport UV (0-1, V down)
+     */
+    struct UVRect
+    {
+        float minU = 0.0f;
+        float minV = 0.0f;
+        float maxU = 1.0f;
+        float maxV = 1.0f;
+
+        float Area() const { return (maxU - minU) * (maxV - minV); }
+        bool IsEmpty() const { return maxU <= minU || maxV <= minV; }
+    };
+
+    /**
+     * @brief Pixel rectangle, right/bottom exclusive (same convention as D3D11_RECT / D3D11_BOX)
+     */
+    struct PixelRect
+    {
+        uint32_t left = 0;
+        uint32_t top = 0;
+        uint32_t right = 0;
+        uint32_t bottom = 0;
+
+        uint32_t Width() const { return right > left ? right - left : 0; }
+        uint32_t Height() const { return bottom > top ? bottom - top : 0; }
+        bool IsEmpty() const { return Width() == 0 || Height() == 0; }
+    };
+
+    /**
+     * @brief Signed pixel rectangle in render-target coordinates (D3D11_RECT layout), right/bottom exclusive
+     */
+    struct ScissorRect
+    {
+        int32_t left = 0;
+        int32_t top = 0;
+        int32_t right = 0;
+        int32_t bottom = 0;
+
+        bool IsEmpty() const { return right <= left || bottom <= top; }
+    };
+
+    /**
+     * @brief Grow the aperture bounds by margin on every side and clamp to the screen
+     *
+     * The margin covers parallax offset and spherical distortion, which make the scope
+     * shader sample slightly outside the aperture silhouette.
+     */
+    UVRect ExpandAperture(const UVRect& aperture, float margin);
+
+    /**
+     * @brief Map a UV rect onto a width x height surface
+     *
+     * Edges are rounded outward and aligned to alignment pixels (power of two) so
+     * the rect stays conservative and tile friendly, then clamped to the surface.
+     */
+    PixelRect ToPixelRect(const UVRect& rect, uint32_t width, uint32_t height, uint32_t alignment = 8);
+
+    /**
+     * @brief Whether a width x height surface has the screen's aspect ratio
+     *
+     * Screen-space targets (full-res, half-res, upscaler input) are limited to the region;
+     * anything else (shadow maps, cubemaps, LUTs) is left untouched.
+     */
+    bool MatchesAspect(uint32_t width, uint32_t height, uint32_t refWidth, uint32_t refHeight, float tolerance = 0.02f);
+
+    /**
+     * @brief The region's pixel rect on a width x height surface (scissor, ClearView, region copies)
+     *
+     * @return false and the whole surface when it is not a screen-space surface (see MatchesAspect)
+     */
+    bool SurfaceRect(const UVRect& region, uint32_t refWidth, uint32_t refHeight, uint32_t width, uint32_t height, PixelRect& rect);
+
+    /**
+     * @brief Intersection of two rects; an empty one collapses to zero size (right = left, bottom = top)
+     *        so D3D11 culls everything instead of reading an inverted rect
+     */
+    ScissorRect Intersect(const ScissorRect& a, const ScissorRect& b);
+
+    /**
+     * @brief Scissor submitted for the scope pass: the region's rect on a viewport, offset by the
+     *        viewport origin, intersected with the game's own scissor when it enabled one
+     * @param gameScissor The game's scissor rect, nullptr when its rasterizer state has scissor off
+     */
+    ScissorRect ViewportScissor(const PixelRect& region, int32_t viewportLeft, int32_t viewportTop, const ScissorRect* gameScissor);
+}
@@ -0,0 +1,67 @@
+#include "ScopeResolutionScaler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope
+{
+    float ScopeResolutionScaler::ComputeTargetScale(const Settings& settings, float apertureDiameterPx, float magnification)
+    {
+        const float minScale = std::clamp(settings.minScale, 0.05f, 1.0f);
+        const float maxScale = std::clamp(settings.maxScale, minScale, 1.0f);
+        if (!(apertureDiameterPx > 0.0f)) {
+            return maxScale;
+        }
+
+        float density = 1.0f;
+        const float fullDetail = std::max(settings.fullDetailMagnification, 1.0f);
+        if (magnification > fullDetail) {
+            density = std::pow(fullDetail / magnification, std::max(settings.magnificationFalloff, 0.0f));
+        }
+
+        float renderedDiameter = apertureDiameterPx * density;
+        if (settings.maxAperturePixels > 0.0f) {
+            renderedDiameter = std::min(renderedDiameter, settings.maxAperturePixels);
+        }
+
+        return std::clamp(renderedDiameter / apertureDiameterPx, minScale, maxScale);
+    }
+
+    float ScopeResolutionScaler::OpticalMagnification(float baseFovDegrees, float scopeFovDegrees)
+    {
+        constexpr float kHalfDegreeToRadians = 3.14159265f / 360.0f;
+        if (!(scopeFovDegrees > 0.0f) || !(baseFovDegrees > scopeFovDegrees) || baseFovDegrees >= 180.0f) {
+            return 1.0f;
+        }
+        return std::tan(baseFovDegrees * kHalfDegreeToRadians) / std::tan(scopeFovDegrees * kHalfDegreeToRadians);
+    }
+
+    uint32_t ScopeResolutionScaler::ScaleExtent(uint32_t size, float scale)
+    {
+        const float scaled = std::floor(static_cast<float>(size) * scale + 0.5f);
+        return std::clamp(static_cast<uint32_t>(std::max(scaled, 1.0f)), 1u, std::max(size, 1u));
+    }
+
+    float ScopeResolutionScaler::Update(float apertureDiameterPx, float magnification)
+    {
+        m_targetScale = ComputeTargetScale(m_settings, apertureDiameterPx, magnification);
+
+        // Round up so quantization never drops below the requested density
+        float quantized = m_targetScale;
+        if (m_settings.step > 0.0f) {
+            quantized = std::ceil(m_targetScale / m_settings.step - 1e-4f) * m_settings.step;
+        }
+        const float minScale = std::clamp(m_settings.minScale, 0.05f, 1.0f);
+        const float maxScale = std::clamp(m_settings.maxScale, minScale, 1.0f);
+        quantized = std::clamp(quantized, minScale, maxScale);
+
+        // Hysteresis on the unquantized target, so a target sitting on a step boundary
+        // doesn't toggle between two sizes; settings changes that move the range always apply
+        const bool outOfRange = m_scale < minScale || m_scale > maxScale;
+        if (!m_initialized || outOfRange || std::fabs(m_targetScale - m_scale) >= m_settings.hysteresis) {
+            m_scale = quantized;
+            m_initialized = true;
+        }
+        return m_scale;
+    }
+}
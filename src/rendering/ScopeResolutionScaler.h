@@ -0,0 +1,74 @@
+#pragma once
+
+// Portable render-scale policy for the scope pass: how much of the full render resolution
+// the second pass needs, from the on-screen aperture size and the scope magnification.
+// No D3D / CommonLib dependencies; the caller applies the scale through the engine's
+// dynamic-resolution ratio.
+
+#include <cstdint>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Chooses the second-pass render scale (fraction of full resolution per axis)
+     *
+     * The scope image is shown 1:1 inside the aperture, so the target is a pixel density
+     * relative to native:
+     *  - up to fullDetailMagnification the aperture keeps native density; above it the
+     *    density falls off as (fullDetailMagnification / magnification)^magnificationFalloff,
+     *    since the magnified distant LODs carry less detail than the screen can show
+     *  - the aperture diameter is capped at maxAperturePixels rendered pixels
+     *
+     * The result is clamped to [minScale, maxScale], rounded up to step and only changed
+     * when it moves by at least hysteresis, so the render size doesn't flicker between
+     * frames while the aperture breathes.
+     */
+    class ScopeResolutionScaler
+    {
+    public:
+        struct Settings
+        {
+            float minScale = 0.5f;
+            float maxScale = 1.0f;
+            float fullDetailMagnification = 2.0f;
+            float magnificationFalloff = 0.5f;
+            float maxAperturePixels = 1440.0f;
+            float step = 1.0f / 16.0f;
+            float hysteresis = 0.05f;
+        };
+
+        /**
+         * @brief Optical (angular) magnification of a scope rendered with scopeFovDegrees
+         *
+         * tan(baseFov / 2) / tan(scopeFov / 2): how much larger a distant object appears in the
+         * aperture than on screen. The plain FOV ratio understates it at wide base FOVs.
+         * @return 1 for invalid or wider-than-base FOVs
+         */
+        static float OpticalMagnification(float baseFovDegrees, float scopeFovDegrees);
+
+        /// Unquantized scale for one frame
+        static float ComputeTargetScale(const Settings& settings, float apertureDiameterPx, float magnification);
+
+        /// Scaled pixel extent, rounded to nearest and never below 1
+        static uint32_t ScaleExtent(uint32_t size, float scale);
+
+        /**
+         * @brief Feed this frame's aperture and magnification
+         * @return The scale to render at
+         */
+        float Update(float apertureDiameterPx, float magnification);
+
+        void Reset() { m_scale = 1.0f; m_targetScale = 1.0f; m_initialized = false; }
+
+        float GetScale() const { return m_scale; }
+        float GetTargetScale() const { return m_targetScale; }
+        Settings& GetSettings() { return m_settings; }
+        const Settings& GetSettings() const { return m_settings; }
+
+    private:
+        Settings m_settings;
+        float m_scale = 1.0f;
+        float m_targetScale = 1.0f;
+        bool m_initialized = false;
+    };
+}
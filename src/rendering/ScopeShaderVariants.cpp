@@ -0,0 +1,86 @@
+#include "ScopeShaderVariants.h"
+
+namespace ThroughScope
+{
+    namespace
+    {
+        struct FeatureInfo
+        {
+            ScopeShaderVariants::Feature feature;
+            const char* define;
+            const char* suffix;
+        };
+
+        // Order matches the bit order and the suffix order of the variant names
+        constexpr FeatureInfo kFeatures[ScopeShaderVariants::kFeatureCount] = {
+            { ScopeShaderVariants::NightVision, "TTS_NIGHT_VISION", "NV" },
+            { ScopeShaderVariants::Parallax, "TTS_PARALLAX", "PX" },
+            { ScopeShaderVariants::SphericalDistortion, "TTS_SPHERICAL_DISTORTION", "SD" },
+            { ScopeShaderVariants::ChromaticAberration, "TTS_CHROMATIC_ABERRATION", "CA" },
+        };
+    }
+
+    uint32_t ScopeShaderVariants::FromSwitches(bool nightVision, bool parallax, bool sphericalDistortion,
+        bool chromaticAberration)
+    {
+        uint32_t features = 0;
+        if (nightVision) {
+            features |= NightVision;
+        }
+        if (parallax) {
+            features |= Parallax;
+        }
+        if (sphericalDistortion) {
+            features |= SphericalDistortion;
+        }
+        if (chromaticAberration) {
+            features |= ChromaticAberration;
+        }
+        return Canonicalize(features);
+    }
+
+    uint32_t ScopeShaderVariants::Canonicalize(uint32_t features)
+    {
+        features &= kAllFeatures;
+        if (!(features & SphericalDistortion)) {
+            features &= ~uint32_t(ChromaticAberration);
+        }
+        return features;
+    }
+
+    size_t ScopeShaderVariants::CountCanonical()
+    {
+        size_t count = 0;
+        for (uint32_t features = 0; features < kVariantCount; ++features) {
+            if (IsCanonical(features)) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    std::string ScopeShaderVariants::GetVariantName(uint32_t features)
+    {
+        features = Canonicalize(features);
+        std::string name = "TrueScopeShader";
+        if (!features) {
+            return name + "_Base";
+        }
+        for (const auto& info : kFeatures) {
+            if (features & info.feature) {
+                name += '_';
+                name += info.suffix;
+            }
+        }
+        return name;
+    }
+
+    void ScopeShaderVariants::GetDefines(uint32_t features, Define (&defines)[kFeatureCount + 1])
+    {
+        features = Canonicalize(features);
+        defines[0] = { "TTS_SHADER_VARIANT", "1" };
+        for (size_t i = 0; i < kFeatureCount; ++i) {
+            defines[i + 1] = { kFeatures[i].define, (features & kFeatures[i].feature) ? "1" : "0" };
+        }
+    }
+}
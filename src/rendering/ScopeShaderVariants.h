@@ -0,0 +1,60 @@
+#pragma once
+
+// Portable feature-bitmask -> compile-time permutation mapping for TrueScopeShader.hlsl.
+// No D3D / CommonLib dependencies; D3DResourceManager loads one .cso per variant and
+// scripts/compile_shader_variants.py builds them (the two must agree on names and defines).
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Shader permutations of the scope pixel shader
+     *
+     * Each feature that TrueScopeShader.hlsl used to branch on at runtime (enableNightVision,
+     * enableParallax, enableSphericalDistortion, enableChromaticAberration) becomes a 0/1 define.
+     * Chromatic aberration only exists on top of spherical distortion, so masks with the
+     * chromatic bit but without distortion collapse onto the variant without it.
+     */
+    class ScopeShaderVariants
+    {
+    public:
+        enum Feature : uint32_t
+        {
+            NightVision = 1u << 0,
+            Parallax = 1u << 1,
+            SphericalDistortion = 1u << 2,
+            ChromaticAberration = 1u << 3,
+
+            kAllFeatures = (1u << 4) - 1,
+        };
+
+        static constexpr size_t kVariantCount = size_t(kAllFeatures) + 1;
+        static constexpr size_t kFeatureCount = 4;
+
+        struct Define
+        {
+            const char* name;
+            const char* value;
+        };
+
+        /// Build a feature mask from the runtime switches
+        static uint32_t FromSwitches(bool nightVision, bool parallax, bool sphericalDistortion, bool chromaticAberration);
+
+        /// Drop feature bits that have no effect (chromatic aberration without distortion)
+        static uint32_t Canonicalize(uint32_t features);
+        static bool IsCanonical(uint32_t features) { return Canonicalize(features) == features; }
+
+        /// Number of distinct variants (canonical masks)
+        static size_t CountCanonical();
+
+        /// "TrueScopeShader_Base" or e.g. "TrueScopeShader_NV_PX"; no extension
+        static std::string GetVariantName(uint32_t features);
+
+        /// Defines for one variant: TTS_SHADER_VARIANT plus one 0/1 define per feature
+        /// @param defines Receives kFeatureCount + 1 entries
+        static void GetDefines(uint32_t features, Define (&defines)[kFeatureCount + 1]);
+    };
+}
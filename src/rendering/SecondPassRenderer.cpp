@@ -10,10 +10,15 @@
 #include "ScopeRenderingManager.h"
 #include "STSCompatibility.h"
 #include "ScopeCulling.h"
+#include "TexturePool.h"
+#include "D3DStateCache.h"
+#include "ScopeRegion.h"
+#include "DataPersistence.h"
+#include <d3d11_1.h>
 
 namespace ThroughScope
 {
-	void SafeShadowNodeUpdate(RE::NiNode* node, RE::NiUpdateData* ctx)
+	void SafeShadowNodeUpdate(RE::NiAVObject* node, RE::NiUpdateData* ctx)
 	{
 		__try {
 			if (node && ctx) {
@@ -24,6 +29,7 @@ namespace ThroughScope
 			// Catch potential 0xC0000005 AV from background thread race
 		}
 	}
+
 	SecondPassRenderer::SecondPassRenderer(ID3D11DeviceContext* context, ID3D11Device* device, D3DHooks* d3dHooks) 
 		: m_context(context)
 		, m_device(device)
@@ -44,12 +50,73 @@ namespace ThroughScope
 
 	}
 
+	SecondPassRenderer& SecondPassRenderer::GetInstance(ID3D11DeviceContext* context, ID3D11Device* device, D3DHooks* d3dHooks)
+	{
+		static std::unique_ptr<SecondPassRenderer> s_instance;
+		if (!s_instance || s_instance->m_context != context || s_instance->m_device != device || s_instance->m_d3dHooks != d3dHooks) {
+			if (s_instance && s_instance->m_device != device) {
+				// 旧 device 的纹理不能继续使用
+				TexturePool::GetSingleton()->Clear();
+			}
+			s_instance = std::make_unique<SecondPassRenderer>(context, device, d3dHooks);
+		}
+		return *s_instance;
+	}
+
+	bool SecondPassRenderer::s_RegionLimited = false;
+	float SecondPassRenderer::s_RegionMargin = 0.05f;
+	float SecondPassRenderer::s_LastRegionCoverage = 1.0f;
+	bool SecondPassRenderer::s_DynamicResolution = true;
+	ScopeResolutionScaler SecondPassRenderer::s_ResolutionScaler;
+	float SecondPassRenderer::s_LastResolutionScale = 1.0f;
+	ScopeAmortizationPolicy SecondPassRenderer::s_Amortization;
+	FrameBudgetGovernor SecondPassRenderer::s_BudgetGovernor;
+	float SecondPassRenderer::s_LastSecondPassGpuMs = 0.0f;
+	bool SecondPassRenderer::s_BudgetKnobsApplied = false;
+	ClearPolicyTable SecondPassRenderer::s_ClearPolicy;
+	bool SecondPassRenderer::s_IncrementalSceneUpdate = false;
+	bool SecondPassRenderer::s_LightCulling = false;
+	uint32_t SecondPassRenderer::s_LightBudget = 32;
+	TimingStatsStore SecondPassRenderer::s_PhaseTimings({
+		"Total",
+		"BackupFirstPassTextures",
+		"UpdateScopeCamera",
+		"ClearRenderTargets",
+		"SyncLighting",
+		"DrawScopeContent",
+		"RestoreFirstPass",
+		"Reproject",
+		"MergeRenderTargets",
+		"MotionVectorMask",
+	});
+
+	void SecondPassRenderer::EndFrame()
+	{
+		// RT 合并完成后才能关闭区域
+		RenderUtilities::ClearScopeRegion();
+		RenderUtilities::ClearScopeResolutionScale();
+		RenderUtilities::ClearScopeReprojection();
+		// 第二次渲染中途失败时 DrawScopeContent 没有清空，不把标记留到下一帧
+		ScopeCamera::GetDirtyNodes().Clear();
+		EndFrameTiming();
+		CleanupResources();
+	}
+
 	bool SecondPassRenderer::ExecuteSecondPass()
 	{
 		if (!CanExecuteSecondPass()) {
 
 			return false;
 		}
+
+		// 上一帧如果没有调用 EndFrame，先释放遗留的引用
+		CleanupResources();
+		RenderUtilities::ClearScopeRegion();
+		RenderUtilities::ClearScopeResolutionScale();
+		RenderUtilities::ClearScopeReprojection();
+
+		// 帧预算：回读几帧前的耗时，调整本帧的质量参数，然后开始计时
+		BeginFrameTiming();
 			
 		// 初始化相机指针
 		m_scopeCamera = ScopeCamera::GetScopeCamera();
@@ -66,6 +133,18 @@ namespace ThroughScope
 		RenderUtilities::SetSecondPassComplete(false);
 
 		try {
+			// 0. 时域分摊：相机稳定时复用上一次的瞄具图像
+			if (s_Amortization.Decide(BuildAmortizationInput()) == ScopeAmortizationPolicy::Decision::Reproject) {
+				if (ReprojectPreviousFrame()) {
+					return true;
+				}
+				// 无法重投影（分辨率变化等），本帧改为完整渲染
+				CleanupResources();
+				RenderUtilities::ClearScopeResolutionScale();
+				RenderUtilities::ClearScopeReprojection();
+			}
+			m_hasRenderedFrame = false;
+
 			// 1. 备份第一次渲染的纹理
 			if (!BackupFirstPassTextures()) {
 				logger::error("Failed to backup first pass textures");
@@ -79,6 +158,10 @@ namespace ThroughScope
 				return false;
 			}
 
+			// 重投影的参考：本次渲染的瞄具相机和渲染缩放
+			ScopeProjection::Matrix4 renderedWorldToCam;
+			memcpy(renderedWorldToCam.m, m_scopeCamera->worldToCam, sizeof(renderedWorldToCam.m));
+
 			// 3. 清理渲染目标
 			ClearRenderTargets();
 
@@ -103,6 +186,7 @@ namespace ThroughScope
 			
 			DrawScopeContent();
 			m_renderExecuted = true;
+			CaptureClearProbe();
 			
 			// [STS兼容] 恢复ScopeAiming节点可见性
 			stsCompat->RestoreScopeAimingAfterRender(weaponNode);
@@ -112,6 +196,18 @@ namespace ThroughScope
 
 			// 6. 恢复第一次渲染状态
 			RestoreFirstPass();
+
+			if (m_mainRTTexture) {
+				D3D11_TEXTURE2D_DESC mainDesc;
+				m_mainRTTexture->GetDesc(&mainDesc);
+				m_lastRenderedSize[0] = mainDesc.Width;
+				m_lastRenderedSize[1] = mainDesc.Height;
+				m_lastRenderedWorldToCam = renderedWorldToCam;
+				m_lastRenderedScale[0] = RenderUtilities::GetScopeResolutionScaleX();
+				m_lastRenderedScale[1] = RenderUtilities::GetScopeResolutionScaleY();
+				m_lastRenderedScopeNode = ScopeCamera::s_CurrentScopeNode;
+				m_hasRenderedFrame = true;
+			}
 			return true;
 
 		} catch (const std::exception& e) {
@@ -154,7 +250,7 @@ namespace ThroughScope
 		return true;
 	}
 
-	bool SecondPassRenderer::BackupFirstPassTextures()
+	bool SecondPassRenderer::AcquireFrameTargets()
 	{
 		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
 		if (!rendererData || !rendererData->context) {
@@ -170,6 +266,16 @@ namespace ThroughScope
 
 		// 获取当前绑定的渲染目标
 		m_context->OMGetRenderTargets(2, m_savedRTVs, nullptr);
+		return true;
+	}
+
+	bool SecondPassRenderer::BackupFirstPassTextures()
+	{
+		ScopedPhase phaseTimer(*this, Phase::BackupFirstPassTextures);
+		if (!AcquireFrameTargets()) {
+			return false;
+		}
+		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
 
 		// 获取后缓冲纹理
 		// 优先从当前绑定的 RT 获取，如果不可用则使用 renderTargets[0] (SwapChain)
@@ -210,7 +316,47 @@ namespace ThroughScope
 			return false;
 		}
 
-		// 创建临时后缓冲纹理
+		// 分辨率变化时丢弃池中所有临时纹理
+		D3D11_TEXTURE2D_DESC referenceDesc;
+		m_rtTexture2D->GetDesc(&referenceDesc);
+		TexturePool::GetSingleton()->BeginFrame(referenceDesc.Width, referenceDesc.Height);
+
+		float minU, minV, maxU, maxV;
+		RenderUtilities::GetScopeQuadScreenBounds(minU, minV, maxU, maxV);
+
+		// 动态分辨率：孔径直径（像素）和光学放大倍率决定渲染缩放，DrawScopeContent 中通过引擎的动态分辨率比例生效
+		float scale = 1.0f;
+		if (s_DynamicResolution && RenderUtilities::GetDynamicResolutionViewportOwner()) {
+			float apertureDiameter = (std::max)((maxU - minU) * referenceDesc.Width, (maxV - minV) * referenceDesc.Height);
+			float magnification = ScopeResolutionScaler::OpticalMagnification(ScopeCamera::GetBaseFOV(), ScopeCamera::GetTargetFOV());
+			scale = s_ResolutionScaler.Update(apertureDiameter, magnification);
+		} else {
+			s_ResolutionScaler.Reset();
+		}
+
+		float scaleX = 1.0f, scaleY = 1.0f;
+		if (scale < 1.0f) {
+			scaleX = (float)ScopeResolutionScaler::ScaleExtent(referenceDesc.Width, scale) / referenceDesc.Width;
+			scaleY = (float)ScopeResolutionScaler::ScaleExtent(referenceDesc.Height, scale) / referenceDesc.Height;
+			RenderUtilities::SetScopeResolutionScale(scaleX, scaleY);
+		}
+		s_LastResolutionScale = scaleX;
+
+		// 区域限定模式：之后的备份/清除/合并只处理孔径区域
+		s_LastRegionCoverage = 1.0f;
+		if (s_RegionLimited) {
+			ScopeRegion::UVRect region = ScopeRegion::ExpandAperture({ minU, minV, maxU, maxV }, s_RegionMargin);
+			// 缩小渲染时内容落在 region * scale，区域扩展为两者的包围盒
+			region.minU *= scaleX;
+			region.minV *= scaleY;
+			if (!region.IsEmpty()) {
+				RenderUtilities::SetScopeRegion(region.minU, region.minV, region.maxU, region.maxV,
+					referenceDesc.Width, referenceDesc.Height);
+				s_LastRegionCoverage = region.Area();
+			}
+		}
+
+		// 从池中获取临时后缓冲纹理
 		if (!CreateTemporaryBackBuffer()) {
 			return false;
 		}
@@ -229,7 +375,7 @@ namespace ThroughScope
 		}
 
 		// 复制当前渲染目标内容到临时BackBuffer
-		if (!RenderUtilities::SafeCopyTexture(m_context, m_device, m_tempBackBufferTex, m_rtTexture2D)) {
+		if (!RenderUtilities::CopyTextureScopeRegion(m_context, m_device, m_tempBackBufferTex, m_rtTexture2D)) {
 			logger::warn("BackupFirstPassTextures: Failed to backup RT to TempBackBuffer due to mismatch or error");
 			// Continue anyway, maybe we can use mainRTTexture
 		}
@@ -243,7 +389,7 @@ namespace ThroughScope
 			RenderUtilities::ResizeFirstPassTextures(m_device, srcDesc.Width, srcDesc.Height);
 
 			// 验证尺寸匹配 (Logic now inside SafeCopyTexture, but we keep the wrapper or just call it)
-			if (!RenderUtilities::SafeCopyTexture(m_context, m_device, RenderUtilities::GetFirstPassColorTexture(), m_mainRTTexture)) {
+			if (!RenderUtilities::CopyTextureScopeRegion(m_context, m_device, RenderUtilities::GetFirstPassColorTexture(), m_mainRTTexture)) {
 				logger::warn("BackupFirstPassTextures: Failed to backup MainRT to FirstPassColor");
 			}
 
@@ -267,6 +413,7 @@ namespace ThroughScope
 
 	bool SecondPassRenderer::UpdateScopeCamera()
 	{
+		ScopedPhase phaseTimer(*this, Phase::UpdateScopeCamera);
 		// 创建原始相机的克隆
 		RE::NiCloningProcess tempP{};
 		m_originalCamera = (RE::NiCamera*)(m_playerCamera->CreateClone(tempP));
@@ -304,6 +451,7 @@ namespace ThroughScope
 		m_scopeCamera->Update(updateData);
 		m_scopeCamera->UpdateWorldData(&updateData);
 		m_scopeCamera->UpdateWorldBound();
+		ScopeCamera::MarkTransformDirty(m_scopeCamera);
 
 		m_cameraUpdated = true;
 		return true;
@@ -311,18 +459,8 @@ namespace ThroughScope
 
 	void SecondPassRenderer::ClearRenderTargets()
 	{
-		// 清理主输出，准备第二次渲染
-		float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-
+		ScopedPhase phaseTimer(*this, Phase::ClearRenderTargets);
 		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
-		auto RTVs = rendererData->renderTargets;
-
-		// 清理主要的渲染目标
-		for (size_t i = 0; i < 4; i++) {
-			if (RTVs[i].rtView) {
-				m_context->ClearRenderTargetView((ID3D11RenderTargetView*)RTVs[i].rtView, clearColor);
-			}
-		}
 
 		// 清理深度模板缓冲区
 		// [ENB FIX] 使用 0.0f (远平面) 而不是 1.0f (近平面) 清除深度
@@ -340,26 +478,211 @@ namespace ThroughScope
 			m_context->ClearDepthStencilView(shadowMapDSV, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 0.0f, 0);
 		}
 
-		static const int allGBuffers[] = { 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
-		for (int bufIdx : allGBuffers) {
-			if (bufIdx < 100 && rendererData->renderTargets[bufIdx].rtView) {
-				float clearValue[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-				// 对于法线缓冲区 (RT8)，使用默认法线值 (0.5, 0.5, 1.0) 表示向上的法线
-				if (bufIdx == 8) {
-					clearValue[0] = 0.5f;
-					clearValue[1] = 0.5f;
-					clearValue[2] = 1.0f;
-					clearValue[3] = 1.0f;
+		ResolveClearProbe();
+		size_t probeEntry = ClearPolicyTable::NO_PROBE;
+		if (m_clearProbe.state == ClearProbe::State::Idle) {
+			probeEntry = s_ClearPolicy.NextProbe();
+		}
+
+		// 按策略表清除渲染目标（区域限定模式下只清除孔径区域，区域外保持第一次渲染的内容）
+		// Overwritten/Skip 的 RT 不清除；验证探测只在清除之后拷贝区域，不改变 RT 内容
+		const auto& entries = s_ClearPolicy.GetEntries();
+		for (size_t i = 0; i < entries.size(); ++i) {
+			const auto& entry = entries[i];
+			const bool clear = s_ClearPolicy.ShouldClear(i);
+			const bool probe = (i == probeEntry);
+			if (!clear && !probe) {
+				continue;
+			}
+			auto& rt = rendererData->renderTargets[entry.renderTarget];
+			if (!rt.rtView) {
+				continue;
+			}
+			if (clear) {
+				auto rtv = (ID3D11RenderTargetView*)rt.rtView;
+				// ClearView 不经过 hook，需要手动通知写入跟踪
+				RenderTargetMerger::GetInstance().NotifyScopeWrite(m_context, (ID3D11Resource*)rt.texture);
+				if (!RenderUtilities::ClearRenderTargetScopeRegion(m_context, rtv, entry.clearValue)) {
+					m_context->ClearRenderTargetView(rtv, entry.clearValue);
 				}
-				m_context->ClearRenderTargetView(
-					(ID3D11RenderTargetView*)rendererData->renderTargets[bufIdx].rtView, 
-					clearValue);
 			}
+			if (probe) {
+				m_clearProbe.entry = i;
+				BeginClearProbe((ID3D11Texture2D*)rt.texture);
+			}
+		}
+	}
+
+	// 可逐字节比较的非压缩格式的 texel 大小，其它格式返回 0（不探测）
+	static UINT GetProbeTexelSize(DXGI_FORMAT format)
+	{
+		switch (format) {
+		case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+		case DXGI_FORMAT_R32G32B32A32_FLOAT:
+			return 16;
+		case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+		case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		case DXGI_FORMAT_R16G16B16A16_UNORM:
+		case DXGI_FORMAT_R16G16B16A16_SNORM:
+		case DXGI_FORMAT_R32G32_TYPELESS:
+		case DXGI_FORMAT_R32G32_FLOAT:
+			return 8;
+		case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+		case DXGI_FORMAT_R10G10B10A2_UNORM:
+		case DXGI_FORMAT_R11G11B10_FLOAT:
+		case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+		case DXGI_FORMAT_R8G8B8A8_UNORM:
+		case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+		case DXGI_FORMAT_R8G8B8A8_SNORM:
+		case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+		case DXGI_FORMAT_B8G8R8A8_UNORM:
+		case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+		case DXGI_FORMAT_R16G16_TYPELESS:
+		case DXGI_FORMAT_R16G16_FLOAT:
+		case DXGI_FORMAT_R16G16_UNORM:
+		case DXGI_FORMAT_R16G16_SNORM:
+		case DXGI_FORMAT_R32_TYPELESS:
+		case DXGI_FORMAT_R32_FLOAT:
+			return 4;
+		case DXGI_FORMAT_R8G8_TYPELESS:
+		case DXGI_FORMAT_R8G8_UNORM:
+		case DXGI_FORMAT_R8G8_SNORM:
+		case DXGI_FORMAT_R16_TYPELESS:
+		case DXGI_FORMAT_R16_FLOAT:
+		case DXGI_FORMAT_R16_UNORM:
+			return 2;
+		case DXGI_FORMAT_R8_TYPELESS:
+		case DXGI_FORMAT_R8_UNORM:
+		case DXGI_FORMAT_A8_UNORM:
+			return 1;
+		default:
+			return 0;
 		}
 	}
 
+	void SecondPassRenderer::BeginClearProbe(ID3D11Texture2D* texture)
+	{
+		m_clearProbe.state = ClearProbe::State::Idle;
+		if (!texture) {
+			return;
+		}
+
+		D3D11_TEXTURE2D_DESC desc;
+		texture->GetDesc(&desc);
+		const UINT texelSize = GetProbeTexelSize(desc.Format);
+		if (texelSize == 0 || desc.SampleDesc.Count != 1) {
+			return;
+		}
+
+		// 只检查第二次渲染写入的孔径区域
+		D3D11_RECT rect;
+		RenderUtilities::GetScopeRegionRect(desc.Width, desc.Height, rect);
+		if (rect.right <= rect.left || rect.bottom <= rect.top) {
+			return;
+		}
+		const UINT width = (UINT)(rect.right - rect.left);
+		const UINT height = (UINT)(rect.bottom - rect.top);
+
+		// staging 只增不减，孔径区域逐帧变化时不必重建
+		auto& staging = m_clearProbe.stagingDesc;
+		if (!m_clearProbe.before || !m_clearProbe.after || staging.Format != desc.Format ||
+			staging.Width < width || staging.Height < height) {
+			const bool sameFormat = staging.Format == desc.Format;
+			const UINT stagingWidth = sameFormat ? std::max(width, staging.Width) : width;
+			const UINT stagingHeight = sameFormat ? std::max(height, staging.Height) : height;
+			m_clearProbe.before.Reset();
+			m_clearProbe.after.Reset();
+			staging = {};
+			staging.Width = stagingWidth;
+			staging.Height = stagingHeight;
+			staging.MipLevels = 1;
+			staging.ArraySize = 1;
+			staging.Format = desc.Format;
+			staging.SampleDesc.Count = 1;
+			staging.Usage = D3D11_USAGE_STAGING;
+			staging.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+			if (FAILED(m_device->CreateTexture2D(&staging, nullptr, m_clearProbe.before.GetAddressOf())) ||
+				FAILED(m_device->CreateTexture2D(&staging, nullptr, m_clearProbe.after.GetAddressOf()))) {
+				m_clearProbe.before.Reset();
+				m_clearProbe.after.Reset();
+				staging = {};
+				return;
+			}
+		}
+
+		// 策略清除之后的内容：MustClear 为清除值，其它为第一次渲染的结果
+		m_clearProbe.box = { (UINT)rect.left, (UINT)rect.top, 0, (UINT)rect.right, (UINT)rect.bottom, 1 };
+		m_context->CopySubresourceRegion(m_clearProbe.before.Get(), 0, 0, 0, 0, texture, 0, &m_clearProbe.box);
+
+		m_clearProbe.texture = texture;
+		m_clearProbe.texelSize = texelSize;
+		m_clearProbe.state = ClearProbe::State::Armed;
+	}
+
+	void SecondPassRenderer::CaptureClearProbe()
+	{
+		if (m_clearProbe.state != ClearProbe::State::Armed) {
+			return;
+		}
+		m_context->CopySubresourceRegion(m_clearProbe.after.Get(), 0, 0, 0, 0, m_clearProbe.texture, 0, &m_clearProbe.box);
+		m_clearProbe.texture = nullptr;
+		m_clearProbe.framesWaiting = 0;
+		m_clearProbe.state = ClearProbe::State::Captured;
+	}
+
+	void SecondPassRenderer::ResolveClearProbe()
+	{
+		constexpr uint32_t kMaxWaitFrames = 8;
+
+		if (m_clearProbe.state == ClearProbe::State::Armed) {
+			// 上一帧在抓取前就中止了
+			m_clearProbe.state = ClearProbe::State::Idle;
+			m_clearProbe.texture = nullptr;
+			return;
+		}
+		if (m_clearProbe.state != ClearProbe::State::Captured) {
+			return;
+		}
+
+		// 两次拷贝按提交顺序完成，after 可读时 before 一定也可读
+		D3D11_MAPPED_SUBRESOURCE before, after;
+		HRESULT hr = m_context->Map(m_clearProbe.after.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &after);
+		if (hr == DXGI_ERROR_WAS_STILL_DRAWING) {
+			if (++m_clearProbe.framesWaiting > kMaxWaitFrames) {
+				m_clearProbe.state = ClearProbe::State::Idle;
+			}
+			return;
+		}
+		if (FAILED(hr)) {
+			m_clearProbe.state = ClearProbe::State::Idle;
+			return;
+		}
+		hr = m_context->Map(m_clearProbe.before.Get(), 0, D3D11_MAP_READ, 0, &before);
+		if (FAILED(hr)) {
+			m_context->Unmap(m_clearProbe.after.Get(), 0);
+			m_clearProbe.state = ClearProbe::State::Idle;
+			return;
+		}
+
+		const UINT width = m_clearProbe.box.right - m_clearProbe.box.left;
+		const UINT height = m_clearProbe.box.bottom - m_clearProbe.box.top;
+		const uint64_t untouched = ClearPolicyTable::CountUnchangedTexels((const uint8_t*)before.pData, before.RowPitch,
+			(const uint8_t*)after.pData, after.RowPitch, width, height, m_clearProbe.texelSize);
+		m_context->Unmap(m_clearProbe.before.Get(), 0);
+		m_context->Unmap(m_clearProbe.after.Get(), 0);
+
+		const size_t entry = m_clearProbe.entry;
+		s_ClearPolicy.RecordProbe(entry, untouched, (uint64_t)width * height);
+		if (s_ClearPolicy.GetVerdict(entry) == ClearPolicyTable::Verdict::ShouldClear && untouched > 0) {
+			logger::warn("Clear policy: RT{} is marked Overwritten but {} of {} texels were not written by the scope pass",
+				s_ClearPolicy.GetEntries()[entry].renderTarget, untouched, (uint64_t)width * height);
+		}
+		m_clearProbe.state = ClearProbe::State::Idle;
+	}
+
 	bool SecondPassRenderer::SyncLighting()
 	{
+		ScopedPhase phaseTimer(*this, Phase::SyncLighting);
 
 		auto pShadowSceneNode = *ptr_DrawWorldShadowNode;
 		if (!pShadowSceneNode) {
@@ -375,10 +698,11 @@ namespace ThroughScope
 			m_lightBackup->SetCullingProcess(*DrawWorldCullingProcess);
 		}
 
-		// 应用优化的光源状态用于第二次渲染（使用RenderOptimization设置）
+		// 应用优化的光源状态用于第二次渲染；启用光源剔除时只保留瞄具视锥体内优先级最高的光源
 		m_lightBackup->ApplyLightStatesForScope(
-			false,
-			32);
+			s_LightCulling,
+			s_LightBudget,
+			m_scopeCamera);
 
 		// 同步累积器的眼睛位置
 		SyncAccumulatorEyePosition(m_scopeCamera);
@@ -445,62 +769,27 @@ namespace ThroughScope
 			return false;
 		}
 
-		bool needsRecreate = !m_depthBackupCreated;
-		if (m_depthBackupCreated && m_depthBackupTex) {
-			D3D11_TEXTURE2D_DESC backupDesc{};
-			m_depthBackupTex->GetDesc(&backupDesc);
-			if (backupDesc.Width != depthDesc.Width || backupDesc.Height != depthDesc.Height || backupDesc.Format != typelessFormat) {
-				needsRecreate = true;
-			}
-		}
-
-		if (needsRecreate) {
-			if (m_depthBackupSRV) {
-				m_depthBackupSRV->Release();
-				m_depthBackupSRV = nullptr;
-			}
-			if (m_depthBackupTex) {
-				m_depthBackupTex->Release();
-				m_depthBackupTex = nullptr;
-			}
-
-			// 创建可用于 SRV 的深度备份纹理
-			D3D11_TEXTURE2D_DESC backupDesc = depthDesc;
-			backupDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-			backupDesc.Format = typelessFormat;
-			backupDesc.Usage = D3D11_USAGE_DEFAULT;
-			backupDesc.CPUAccessFlags = 0;
-
-			if (FAILED(m_device->CreateTexture2D(&backupDesc, nullptr, &m_depthBackupTex))) {
-				logger::error("Failed to create depth backup texture");
-				D3DPERF_EndEvent();
-				return false;
-			}
-
-			// 创建 SRV
-			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
-			ZeroMemory(&srvDesc, sizeof(srvDesc));
-			srvDesc.Format = srvFormat;
-			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-			srvDesc.Texture2D.MipLevels = 1;
-			srvDesc.Texture2D.MostDetailedMip = 0;
-
-			if (FAILED(m_device->CreateShaderResourceView(m_depthBackupTex, &srvDesc, &m_depthBackupSRV))) {
-				logger::error("Failed to create depth backup SRV");
-				m_depthBackupTex->Release();
-				m_depthBackupTex = nullptr;
-				D3DPERF_EndEvent();
-				return false;
-			}
+		// 创建可用于 SRV 的深度备份纹理（跨帧复用）
+		D3D11_TEXTURE2D_DESC backupDesc = depthDesc;
+		backupDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		backupDesc.Format = typelessFormat;
 
-			static bool s_depthBackupLogged = false;
-			if (!s_depthBackupLogged) {
-				logger::info("Depth backup created: depth={:X}, typeless={:X}, srv={:X}, size={}x{}",
-					(UINT)depthDesc.Format, (UINT)typelessFormat, (UINT)srvFormat, depthDesc.Width, depthDesc.Height);
-				s_depthBackupLogged = true;
-			}
+		auto pooled = TexturePool::GetSingleton()->Acquire(m_device, backupDesc, srvFormat);
+		if (!pooled.texture || !pooled.srv) {
+			logger::error("Failed to acquire depth backup texture");
+			m_depthBackupTex = nullptr;
+			m_depthBackupSRV = nullptr;
+			D3DPERF_EndEvent();
+			return false;
+		}
+		m_depthBackupTex = pooled.texture;
+		m_depthBackupSRV = pooled.srv;
 
-			m_depthBackupCreated = true;
+		static bool s_depthBackupLogged = false;
+		if (!s_depthBackupLogged) {
+			logger::info("Depth backup created: depth={:X}, typeless={:X}, srv={:X}, size={}x{}",
+				(UINT)depthDesc.Format, (UINT)typelessFormat, (UINT)srvFormat, depthDesc.Width, depthDesc.Height);
+			s_depthBackupLogged = true;
 		}
 
 		D3DPERF_EndEvent();
@@ -509,6 +798,7 @@ namespace ThroughScope
 
 	void SecondPassRenderer::DrawScopeContent()
 	{
+		ScopedPhase phaseTimer(*this, Phase::DrawScopeContent);
 		HookManager::FlushBackgroundTasks();
 
 		if (ptr_DrawWorldShadowNode.get() && ptr_DrawWorldShadowNode.address()) {
@@ -527,9 +817,23 @@ namespace ThroughScope
 				}
 			}
 
-			SafeShadowNodeUpdate(updateTarget, &ctx);
+			auto& dirtyNodes = ScopeCamera::GetDirtyNodes();
+			if (s_IncrementalSceneUpdate && g_pchar) {
+				// 第一次渲染后其它物体的变换没有变化，只更新玩家（含武器和瞄具）、相机和标记过的子树
+				dirtyNodes.Mark(g_pchar->Get3D(true));
+				dirtyNodes.Mark(g_pchar->Get3D(false));
+
+				static std::vector<RE::NiAVObject*> s_updateRoots;
+				dirtyNodes.CollectRoots(s_updateRoots);
+				for (auto root : s_updateRoots) {
+					SafeShadowNodeUpdate(root, &ctx);
+				}
+			} else {
+				SafeShadowNodeUpdate(updateTarget, &ctx);
+			}
 			D3DPERF_EndEvent();
 		}
+		ScopeCamera::GetDirtyNodes().Clear();
 
 		D3DPERF_BeginEvent(0xffffffff, L"Second Render_PreUI");
 
@@ -542,6 +846,8 @@ namespace ThroughScope
 		*ptr_BSShaderManagerSpCamera = m_scopeCamera;
 
 		ScopeCamera::SetRenderingForScope(true);
+		BeginScopeDynamicResolution();
+		D3DHooks::BeginScopeRegionScissor(m_context);
 		ScopedCameraBackup cameraGuard;
 
 		auto gState = RE::BSGraphics::State::GetSingleton();
@@ -689,6 +995,8 @@ namespace ThroughScope
 			GetAndResetCullingStats(tested, passed, filtered);
 
 			// 清除渲染标志
+			D3DHooks::EndScopeRegionScissor(m_context);
+			EndScopeDynamicResolution();
 			ScopeCamera::SetRenderingForScope(false);
 
 			D3DPERF_EndEvent();
@@ -699,8 +1007,56 @@ namespace ThroughScope
 
 
 
+	void SecondPassRenderer::BeginScopeDynamicResolution()
+	{
+		m_dynamicResolutionApplied = false;
+		if (!RenderUtilities::IsScopeResolutionScaled()) {
+			return;
+		}
+
+		auto hookMgr = HookManager::GetSingleton();
+		void* viewportOwner = RenderUtilities::GetDynamicResolutionViewportOwner();
+		if (!hookMgr->g_SetUseDynamicResolutionViewport || !viewportOwner) {
+			// 游戏还没调用过动态分辨率开关，本帧按全分辨率渲染（TrueScopeShader 不缩放采样）
+			RenderUtilities::ClearScopeResolutionScale();
+			s_LastResolutionScale = 1.0f;
+			return;
+		}
+
+		// 引擎的场景绘制和全屏 pass 都按动态分辨率比例工作，与 DLSS/FSR 的输入相同的左上角布局；
+		// Upscaling 已经降低的比例再乘以瞄具缩放
+		static REL::Relocation<RE::BSGraphics::State*> g_GlobalState{ REL::RelocationID(600795, 2704621) };
+		auto globalState = g_GlobalState.get();
+		m_savedDynamicResolutionRatio[0] = globalState->dynamicResolutionWidthRatio;
+		m_savedDynamicResolutionRatio[1] = globalState->dynamicResolutionHeightRatio;
+		globalState->dynamicResolutionWidthRatio *= RenderUtilities::GetScopeResolutionScaleX();
+		globalState->dynamicResolutionHeightRatio *= RenderUtilities::GetScopeResolutionScaleY();
+
+		// 打开动态分辨率 viewport（hkSetUseDynamicResolutionViewport 在瞄具渲染期间保持打开）
+		hookMgr->g_SetUseDynamicResolutionViewport(viewportOwner, true);
+		m_dynamicResolutionApplied = true;
+	}
+
+	void SecondPassRenderer::EndScopeDynamicResolution()
+	{
+		if (!m_dynamicResolutionApplied) {
+			return;
+		}
+		m_dynamicResolutionApplied = false;
+
+		static REL::Relocation<RE::BSGraphics::State*> g_GlobalState{ REL::RelocationID(600795, 2704621) };
+		auto globalState = g_GlobalState.get();
+		globalState->dynamicResolutionWidthRatio = m_savedDynamicResolutionRatio[0];
+		globalState->dynamicResolutionHeightRatio = m_savedDynamicResolutionRatio[1];
+
+		// 恢复游戏自己的动态分辨率 viewport 设置
+		HookManager::GetSingleton()->g_SetUseDynamicResolutionViewport(RenderUtilities::GetDynamicResolutionViewportOwner(),
+			RenderUtilities::GameUsesDynamicResolutionViewport());
+	}
+
 	void SecondPassRenderer::RestoreFirstPass()
 	{
+		ScopedPhase phaseTimer(*this, Phase::RestoreFirstPass);
 		D3DPERF_BeginEvent(0xFFF00000, L"SecondPassRenderer::RestoreFirstPass");
 		if (m_lightingSynced) {
 			// 恢复光源状态
@@ -717,14 +1073,14 @@ namespace ThroughScope
 			// 复制第二次渲染结果到我们的纹理
 			// 复制第二次渲染结果到我们的纹理
 			// Dest: SecondPassColorTexture, Src: m_mainRTTexture
-			if (!RenderUtilities::SafeCopyTexture(m_context, m_device, RenderUtilities::GetSecondPassColorTexture(), m_mainRTTexture)) {
+			if (!RenderUtilities::CopyTextureScopeRegion(m_context, m_device, RenderUtilities::GetSecondPassColorTexture(), m_mainRTTexture)) {
 				logger::warn("RestoreFirstPass: Failed to copy SecondPass result from MainRT");
 			}
 
 			// 恢复BackBuffer
 			// Line 651: m_context->CopyResource(m_rtTexture2D, m_tempBackBufferTex);
 			// Dest: m_rtTexture2D (Game BackBuffer), Src: m_tempBackBufferTex (Backup)
-			if (!RenderUtilities::SafeCopyTexture(m_context, m_device, m_rtTexture2D, m_tempBackBufferTex)) {
+			if (!RenderUtilities::CopyTextureScopeRegion(m_context, m_device, m_rtTexture2D, m_tempBackBufferTex)) {
 				logger::warn("RestoreFirstPass: Failed to restore BackBuffer from Temp");
 			}
 
@@ -734,7 +1090,7 @@ namespace ThroughScope
 			if (RenderUtilities::IsSecondPassComplete()) {
 				// Line 667: CopyResource(m_mainRTTexture, RenderUtilities::GetFirstPassColorTexture());
 				// Dest: m_mainRTTexture, Src: GetFirstPassColorTexture (Backup of First Pass)
-				if (!RenderUtilities::SafeCopyTexture(m_context, m_device, m_mainRTTexture, RenderUtilities::GetFirstPassColorTexture())) {
+				if (!RenderUtilities::CopyTextureScopeRegion(m_context, m_device, m_mainRTTexture, RenderUtilities::GetFirstPassColorTexture())) {
 					logger::warn("RestoreFirstPass: Failed to restore MainRT from FirstPassColor");
 				}
 
@@ -745,50 +1101,46 @@ namespace ThroughScope
 				}
 			}
 
-			// 恢复渲染目标
-			ID3D11RenderTargetView* targetRTV = nullptr;
-			ID3D11Texture2D* targetTexture = nullptr;
-			UINT targetWidth = 0, targetHeight = 0;
-			
-			// [FIX] Upscaling 兼容：当 Upscaling 激活时，渲染到 kFrameBuffer (索引0)
-			// 因为 Upscaling::PostDisplay() 从 kFrameBuffer 复制
-			auto scopeRenderMgr = ScopeRenderingManager::GetSingleton();
-			auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
+			DrawScopeQuad();
+		}
+
+		if (m_cameraUpdated) {
+			// 恢复原始相机
+			DrawWorld::SetCamera(m_originalCamera);
+			DrawWorld::SetUpdateCameraFOV(true);
+
+			RE::NiUpdateData nData;
+			nData.camera = m_originalCamera;
+			m_originalCamera->Update(nData);
+		}
+		D3DPERF_EndEvent();
+	}
+
+	void SecondPassRenderer::DrawScopeQuad()
+	{
+		// 恢复渲染目标
+		ID3D11RenderTargetView* targetRTV = nullptr;
+		ID3D11Texture2D* targetTexture = nullptr;
+		UINT targetWidth = 0, targetHeight = 0;
+		
+		// [FIX] Upscaling 兼容：当 Upscaling 激活时，渲染到 kFrameBuffer (索引0)
+		// 因为 Upscaling::PostDisplay() 从 kFrameBuffer 复制
+		auto scopeRenderMgr = ScopeRenderingManager::GetSingleton();
+		auto rendererData = RE::BSGraphics::RendererData::GetSingleton();
+		
+		if (scopeRenderMgr->IsUpscalingActive() && rendererData) {
+			// Upscaling 模式：必须渲染到 kFrameBuffer (索引0)
+			auto& frameBuffer = rendererData->renderTargets[0];  // kFrameBuffer = 0
+			ID3D11RenderTargetView* frameBufferRTV = reinterpret_cast<ID3D11RenderTargetView*>(frameBuffer.rtView);
 			
-			if (scopeRenderMgr->IsUpscalingActive() && rendererData) {
-				// Upscaling 模式：必须渲染到 kFrameBuffer (索引0)
-				auto& frameBuffer = rendererData->renderTargets[0];  // kFrameBuffer = 0
-				ID3D11RenderTargetView* frameBufferRTV = reinterpret_cast<ID3D11RenderTargetView*>(frameBuffer.rtView);
-				
-				if (frameBufferRTV) {
-					targetRTV = frameBufferRTV;
-					// [FIX] 绑定 DSV 以确保 SetScopeTexture 可以正确写入深度
-					m_context->OMSetRenderTargets(1, &frameBufferRTV, m_mainDSV);
-					
-					// 获取 FrameBuffer 尺寸
-					ID3D11Resource* rtResource = nullptr;
-					frameBufferRTV->GetResource(&rtResource);
-					if (rtResource) {
-						ID3D11Texture2D* rtTexture = nullptr;
-						if (SUCCEEDED(rtResource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&rtTexture))) {
-							D3D11_TEXTURE2D_DESC rtDesc;
-							rtTexture->GetDesc(&rtDesc);
-							targetWidth = rtDesc.Width;
-							targetHeight = rtDesc.Height;
-
-							rtTexture->Release();
-						}
-						rtResource->Release();
-					}
-				}
-			} else if (m_savedRTVs[1]) {
-				targetRTV = m_savedRTVs[1];
+			if (frameBufferRTV) {
+				targetRTV = frameBufferRTV;
 				// [FIX] 绑定 DSV 以确保 SetScopeTexture 可以正确写入深度
-				m_context->OMSetRenderTargets(1, &m_savedRTVs[1], m_mainDSV);
+				m_context->OMSetRenderTargets(1, &frameBufferRTV, m_mainDSV);
 				
-				// 获取渲染目标的实际尺寸
+				// 获取 FrameBuffer 尺寸
 				ID3D11Resource* rtResource = nullptr;
-				m_savedRTVs[1]->GetResource(&rtResource);
+				frameBufferRTV->GetResource(&rtResource);
 				if (rtResource) {
 					ID3D11Texture2D* rtTexture = nullptr;
 					if (SUCCEEDED(rtResource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&rtTexture))) {
@@ -796,88 +1148,300 @@ namespace ThroughScope
 						rtTexture->GetDesc(&rtDesc);
 						targetWidth = rtDesc.Width;
 						targetHeight = rtDesc.Height;
+
 						rtTexture->Release();
 					}
 					rtResource->Release();
 				}
-			} else {
-				// PreUI 阶段或其他情况: 使用主渲染目标
-				if (rendererData && m_mainRTV) {
-					targetRTV = m_mainRTV;
-					// [FIX] 绑定 DSV 以确保 SetScopeTexture 可以正确写入深度
-					m_context->OMSetRenderTargets(1, &m_mainRTV, m_mainDSV);
-					
-					if (m_mainRTTexture) {
-						D3D11_TEXTURE2D_DESC mainDesc;
-						m_mainRTTexture->GetDesc(&mainDesc);
-						targetWidth = mainDesc.Width;
-						targetHeight = mainDesc.Height;
-					}
+			}
+		} else if (m_savedRTVs[1]) {
+			targetRTV = m_savedRTVs[1];
+			// [FIX] 绑定 DSV 以确保 SetScopeTexture 可以正确写入深度
+			m_context->OMSetRenderTargets(1, &m_savedRTVs[1], m_mainDSV);
+			
+			// 获取渲染目标的实际尺寸
+			ID3D11Resource* rtResource = nullptr;
+			m_savedRTVs[1]->GetResource(&rtResource);
+			if (rtResource) {
+				ID3D11Texture2D* rtTexture = nullptr;
+				if (SUCCEEDED(rtResource->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&rtTexture))) {
+					D3D11_TEXTURE2D_DESC rtDesc;
+					rtTexture->GetDesc(&rtDesc);
+					targetWidth = rtDesc.Width;
+					targetHeight = rtDesc.Height;
+					rtTexture->Release();
+				}
+				rtResource->Release();
+			}
+		} else {
+			// PreUI 阶段或其他情况: 使用主渲染目标
+			if (rendererData && m_mainRTV) {
+				targetRTV = m_mainRTV;
+				// [FIX] 绑定 DSV 以确保 SetScopeTexture 可以正确写入深度
+				m_context->OMSetRenderTargets(1, &m_mainRTV, m_mainDSV);
+				
+				if (m_mainRTTexture) {
+					D3D11_TEXTURE2D_DESC mainDesc;
+					m_mainRTTexture->GetDesc(&mainDesc);
+					targetWidth = mainDesc.Width;
+					targetHeight = mainDesc.Height;
 				}
 			}
+		}
 
 
-			// 渲染瞄具内容
-			// 注意：SetScopeTexture 内部已经完成 DrawIndexed（已合并 stencil 写入和颜色渲染）
-			int scopeNodeIndexCount = ScopeCamera::GetScopeNodeIndexCount();
-			if (scopeNodeIndexCount != -1 && targetRTV) {
-				try {
-					// 设置 viewport
-					D3D11_VIEWPORT viewport = {};
-					
-					auto scopeRenderMgr = ScopeRenderingManager::GetSingleton();
-					if (scopeRenderMgr->IsUpscalingActive()) {
-						// Upscaling 模式：必须使用 FirstPassViewport（动态分辨率）
-						// Upscaling 动态调整 viewport 大小，如 1129.4 x 635.3
-						if (!RenderUtilities::GetFirstPassViewport(viewport)) 
-						{
-							auto rendererState = RE::BSGraphics::State::GetSingleton();
-								viewport.TopLeftX = 0;
-								viewport.TopLeftY = 0;
-								viewport.Width = static_cast<float>(rendererState.backBufferWidth);
-								viewport.Height = static_cast<float>(rendererState.backBufferHeight);
-								viewport.MinDepth = 0.0f;
-								viewport.MaxDepth = 1.0f;	
-						}
-					} else {
-						// 非 Upscaling 模式：使用 targetWidth/Height
-						viewport.TopLeftX = 0;
-						viewport.TopLeftY = 0;
-						viewport.Width = static_cast<float>(targetWidth);
-						viewport.Height = static_cast<float>(targetHeight);
-						viewport.MinDepth = 0.0f;
-						viewport.MaxDepth = 1.0f;
+		// 渲染瞄具内容
+		// 注意：SetScopeTexture 内部已经完成 DrawIndexed（已合并 stencil 写入和颜色渲染）
+		int scopeNodeIndexCount = ScopeCamera::GetScopeNodeIndexCount();
+		if (scopeNodeIndexCount != -1 && targetRTV) {
+			try {
+				// 设置 viewport
+				D3D11_VIEWPORT viewport = {};
+				
+				auto scopeRenderMgr = ScopeRenderingManager::GetSingleton();
+				if (scopeRenderMgr->IsUpscalingActive()) {
+					// Upscaling 模式：必须使用 FirstPassViewport（动态分辨率）
+					// Upscaling 动态调整 viewport 大小，如 1129.4 x 635.3
+					if (!RenderUtilities::GetFirstPassViewport(viewport)) 
+					{
+						auto rendererState = RE::BSGraphics::State::GetSingleton();
+							viewport.TopLeftX = 0;
+							viewport.TopLeftY = 0;
+							viewport.Width = static_cast<float>(rendererState.backBufferWidth);
+							viewport.Height = static_cast<float>(rendererState.backBufferHeight);
+							viewport.MinDepth = 0.0f;
+							viewport.MaxDepth = 1.0f;	
 					}
-					
-					m_context->RSSetViewports(1, &viewport);
-					
-					RenderUtilities::SetRender_PreUIComplete(true);
-					// SetScopeTexture 现在内部完成 DrawIndexed（stencil + 颜色渲染已合并）
-					m_d3dHooks->SetScopeTexture(m_context);
-					RenderUtilities::SetRender_PreUIComplete(false);
-				} catch (...) {
-					logger::error("Exception during scope content rendering");
-					RenderUtilities::SetRender_PreUIComplete(false);
+				} else {
+					// 非 Upscaling 模式：使用 targetWidth/Height
+					viewport.TopLeftX = 0;
+					viewport.TopLeftY = 0;
+					viewport.Width = static_cast<float>(targetWidth);
+					viewport.Height = static_cast<float>(targetHeight);
+					viewport.MinDepth = 0.0f;
+					viewport.MaxDepth = 1.0f;
 				}
+				
+				m_context->RSSetViewports(1, &viewport);
+				
+				RenderUtilities::SetRender_PreUIComplete(true);
+				// SetScopeTexture 现在内部完成 DrawIndexed（stencil + 颜色渲染已合并）
+				m_d3dHooks->SetScopeTexture(m_context);
+				RenderUtilities::SetRender_PreUIComplete(false);
+			} catch (...) {
+				logger::error("Exception during scope content rendering");
+				RenderUtilities::SetRender_PreUIComplete(false);
 			}
 		}
+	}
 
-		if (m_cameraUpdated) {
-			// 恢复原始相机
-			DrawWorld::SetCamera(m_originalCamera);
-			DrawWorld::SetUpdateCameraFOV(true);
+	void SecondPassRenderer::BeginFrameTiming()
+	{
+		m_frameCpuStart = std::chrono::steady_clock::now();
+		if (!m_gpuTimer.IsInitialized() && !m_gpuTimer.Initialize(m_device, static_cast<uint32_t>(Phase::Count))) {
+			return;
+		}
 
-			RE::NiUpdateData nData;
-			nData.camera = m_originalCamera;
-			m_originalCamera->Update(nData);
+		m_gpuTimer.BeginFrame(m_context);
+
+		// 回读 FRAME_LATENCY 帧前的各阶段 GPU 耗时
+		for (uint32_t phase = 0; phase < static_cast<uint32_t>(Phase::Count); ++phase) {
+			float gpuMs = 0.0f;
+			if (!m_gpuTimer.ConsumeResult(phase, gpuMs)) {
+				continue;
+			}
+			s_PhaseTimings.Add(phase, TimingStatsStore::Clock::Gpu, gpuMs);
+			if (phase == static_cast<uint32_t>(Phase::Total)) {
+				s_LastSecondPassGpuMs = gpuMs;
+				s_BudgetGovernor.Update(gpuMs);
+			}
+		}
+		ApplyBudgetKnobs();
+
+		m_frameTimingOpen = true;
+		m_gpuTimer.Begin(m_context, static_cast<uint32_t>(Phase::Total));
+	}
+
+	void SecondPassRenderer::EndFrameTiming()
+	{
+		if (!m_frameTimingOpen) {
+			return;
+		}
+		m_gpuTimer.End(m_context, static_cast<uint32_t>(Phase::Total));
+		m_gpuTimer.EndFrame(m_context);
+		m_frameTimingOpen = false;
+
+		std::chrono::duration<float, std::milli> cpuTime = std::chrono::steady_clock::now() - m_frameCpuStart;
+		s_PhaseTimings.Add(static_cast<size_t>(Phase::Total), TimingStatsStore::Clock::Cpu, cpuTime.count());
+	}
+
+	SecondPassRenderer::ScopedPhase::ScopedPhase(SecondPassRenderer& renderer, Phase phase)
+		: m_renderer(renderer)
+		, m_phase(phase)
+		, m_start(std::chrono::steady_clock::now())
+	{
+		if (m_renderer.m_frameTimingOpen) {
+			m_renderer.m_gpuTimer.Begin(m_renderer.m_context, static_cast<uint32_t>(m_phase));
+		}
+	}
+
+	SecondPassRenderer::ScopedPhase::~ScopedPhase()
+	{
+		if (m_renderer.m_frameTimingOpen) {
+			m_renderer.m_gpuTimer.End(m_renderer.m_context, static_cast<uint32_t>(m_phase));
+		}
+		std::chrono::duration<float, std::milli> cpuTime = std::chrono::steady_clock::now() - m_start;
+		s_PhaseTimings.Add(static_cast<size_t>(m_phase), TimingStatsStore::Clock::Cpu, cpuTime.count());
+	}
+
+	bool SecondPassRenderer::DumpPhaseTimingsCsv(std::string& outPath)
+	{
+		try {
+			std::filesystem::path dir = "Data/F4SE/Plugins/TrueThroughScope/Profiling";
+			std::filesystem::create_directories(dir);
+
+			std::time_t now = std::time(nullptr);
+			std::tm localTime{};
+			localtime_s(&localTime, &now);
+			char fileName[64];
+			std::strftime(fileName, sizeof(fileName), "ScopeTimings_%Y%m%d_%H%M%S.csv", &localTime);
+
+			std::filesystem::path filePath = dir / fileName;
+			std::ofstream file(filePath);
+			if (!file.is_open()) {
+				logger::error("Failed to open {} for writing", filePath.string());
+				return false;
+			}
+			s_PhaseTimings.WriteCsv(file);
+			outPath = filePath.string();
+			logger::info("Scope pass timings written to {}", outPath);
+			return true;
+		} catch (const std::exception& e) {
+			logger::error("Failed to write scope pass timings: {}", e.what());
+			return false;
+		}
+	}
+
+	void SecondPassRenderer::ApplyBudgetKnobs()
+	{
+		// 调节器关闭后只恢复一次用户设置，不覆盖设置面板的实时预览
+		bool governed = s_BudgetGovernor.GetSettings().enabled;
+		if (!governed && !s_BudgetKnobsApplied) {
+			return;
+		}
+
+		const auto& knobs = s_BudgetGovernor.GetKnobs();
+		const auto& globalSettings = DataPersistence::GetSingleton()->GetGlobalSettings();
+		if (!governed) {
+			SetCullingSafetyMargin(globalSettings.cullingSafetyMargin);
+			SetShadowCasterRange(globalSettings.shadowCasterRange);
+			SetContributionCullPixels(0.0f);
+			RenderTargetMerger::GetInstance().SetOptionalMergesSkipped(false);
+			s_BudgetKnobsApplied = false;
+			return;
+		}
+
+		SetCullingSafetyMargin(globalSettings.cullingSafetyMargin * knobs.cullingMarginScale);
+		SetShadowCasterRange(globalSettings.shadowCasterRange * knobs.shadowCasterRangeScale);
+		SetContributionCullPixels(knobs.contributionCullPixels);
+		RenderTargetMerger::GetInstance().SetOptionalMergesSkipped(knobs.skipOptionalMerges);
+		s_BudgetKnobsApplied = true;
+	}
+
+	ScopeAmortizationPolicy::FrameInput SecondPassRenderer::BuildAmortizationInput() const
+	{
+		ScopeAmortizationPolicy::FrameInput input;
+
+		// 瞄具相机跟随玩家相机，直接用玩家相机的世界变换判断运动
+		const auto& world = m_playerCamera->world;
+		for (int row = 0; row < 3; ++row) {
+			input.pose.rotation[row][0] = world.rotate.entry[row].x;
+			input.pose.rotation[row][1] = world.rotate.entry[row].y;
+			input.pose.rotation[row][2] = world.rotate.entry[row].z;
+		}
+		input.pose.position[0] = world.translate.x;
+		input.pose.position[1] = world.translate.y;
+		input.pose.position[2] = world.translate.z;
+		input.pose.fovDeg = ScopeCamera::GetTargetFOV();
+
+		input.flash = IsFlashActive();
+		// 没有可用的上一次渲染，或换了瞄具
+		input.forceRender = !m_hasRenderedFrame || m_lastRenderedScopeNode != ScopeCamera::s_CurrentScopeNode;
+		return input;
+	}
+
+	bool SecondPassRenderer::IsFlashActive() const
+	{
+		// 枪口火焰、爆炸等都会生成临时光源
+		if (!ptr_DrawWorldShadowNode.get() || !ptr_DrawWorldShadowNode.address()) {
+			return false;
+		}
+		auto shadowNode = *ptr_DrawWorldShadowNode;
+		if (!shadowNode) {
+			return false;
+		}
+
+		auto isTemporary = [](const RE::NiPointer<RE::BSLight>& light) {
+			return light && light->bTemporary;
+		};
+		return std::any_of(shadowNode->lLightList.begin(), shadowNode->lLightList.end(), isTemporary) ||
+		       std::any_of(shadowNode->lShadowLightList.begin(), shadowNode->lShadowLightList.end(), isTemporary);
+	}
+
+	bool SecondPassRenderer::ReprojectPreviousFrame()
+	{
+		ScopedPhase phaseTimer(*this, Phase::Reproject);
+		D3DPERF_BeginEvent(0xFFF0F000, L"SecondPassRenderer::ReprojectPreviousFrame");
+
+		// SecondPassColorTexture 仍是上一次完整渲染的结果，尺寸变化后内容无效
+		if (!m_hasRenderedFrame || !AcquireFrameTargets() || !m_mainRTTexture) {
+			D3DPERF_EndEvent();
+			return false;
+		}
+		D3D11_TEXTURE2D_DESC mainDesc;
+		m_mainRTTexture->GetDesc(&mainDesc);
+		if (mainDesc.Width != m_lastRenderedSize[0] || mainDesc.Height != m_lastRenderedSize[1]) {
+			D3DPERF_EndEvent();
+			return false;
 		}
+
+		// 只更新瞄具相机（不渲染），得到当前帧的 worldToCam
+		if (!UpdateScopeCamera()) {
+			RestoreFirstPass();
+			D3DPERF_EndEvent();
+			return false;
+		}
+
+		ScopeProjection::Matrix4 currentWorldToCam;
+		memcpy(currentWorldToCam.m, m_scopeCamera->worldToCam, sizeof(currentWorldToCam.m));
+
+		float homography[3][3];
+		if (!ScopeProjection::RotationReprojection(m_lastRenderedWorldToCam, currentWorldToCam, homography)) {
+			RestoreFirstPass();
+			D3DPERF_EndEvent();
+			return false;
+		}
+
+		RenderUtilities::SetScopeReprojection(homography);
+		if (m_lastRenderedScale[0] < 1.0f || m_lastRenderedScale[1] < 1.0f) {
+			RenderUtilities::SetScopeResolutionScale(m_lastRenderedScale[0], m_lastRenderedScale[1]);
+		}
+
+		DrawScopeQuad();
+
+		// m_texturesBackedUp 未设置，这里只恢复相机
+		RestoreFirstPass();
 		D3DPERF_EndEvent();
+		return true;
 	}
 
 	void SecondPassRenderer::CleanupResources()
 	{
-		SAFE_RELEASE(m_tempBackBufferTex);
-		SAFE_RELEASE(m_tempBackBufferSRV);
+		// 临时纹理归 TexturePool 所有，这里只清空指针
+		m_tempBackBufferTex = nullptr;
+		m_tempBackBufferSRV = nullptr;
+		m_depthBackupTex = nullptr;
+		m_depthBackupSRV = nullptr;
 		SAFE_RELEASE(m_rtTexture2D);
 		SAFE_RELEASE(m_savedRTVs[0]);
 		SAFE_RELEASE(m_savedRTVs[1]);
@@ -923,38 +1487,17 @@ namespace ThroughScope
 		D3D11_TEXTURE2D_DESC originalDesc;
 		m_rtTexture2D->GetDesc(&originalDesc);
 
-		// 如果已存在临时纹理，检查尺寸是否匹配
-		if (m_tempBackBufferTex) {
-			D3D11_TEXTURE2D_DESC existingDesc;
-			m_tempBackBufferTex->GetDesc(&existingDesc);
-
-			// 如果尺寸匹配，直接返回
-			if (existingDesc.Width == originalDesc.Width &&
-				existingDesc.Height == originalDesc.Height &&
-				existingDesc.Format == originalDesc.Format) {
-				return true;
-			}
-
-			SAFE_RELEASE(m_tempBackBufferTex);
-			SAFE_RELEASE(m_tempBackBufferSRV);
-		}
-
 		D3D11_TEXTURE2D_DESC rtTextureDesc = originalDesc;
 		rtTextureDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
 
-		HRESULT hr = m_device->CreateTexture2D(&rtTextureDesc, nullptr, &m_tempBackBufferTex);
-		if (FAILED(hr)) {
-			m_lastError = "Failed to create temporary BackBuffer texture";
-			return false;
-		}
-
-		hr = m_device->CreateShaderResourceView(m_tempBackBufferTex, NULL, &m_tempBackBufferSRV);
-		if (FAILED(hr)) {
-			m_lastError = "Failed to create temporary BackBuffer SRV";
-			SAFE_RELEASE(m_tempBackBufferTex);
+		auto pooled = TexturePool::GetSingleton()->Acquire(m_device, rtTextureDesc);
+		if (!pooled.texture || !pooled.srv) {
+			m_lastError = "Failed to acquire temporary BackBuffer texture";
 			return false;
 		}
 
+		m_tempBackBufferTex = pooled.texture;
+		m_tempBackBufferSRV = pooled.srv;
 		return true;
 	}
 
@@ -1141,11 +1684,10 @@ namespace ThroughScope
 				dssDesc.FrontFace.StencilFunc = D3D11_COMPARISON_NOT_EQUAL;
 				dssDesc.BackFace = dssDesc.FrontFace;
 
-				Microsoft::WRL::ComPtr<ID3D11DepthStencilState> stencilTestDSS;
-				m_device->CreateDepthStencilState(&dssDesc, &stencilTestDSS);
+				ID3D11DepthStencilState* stencilTestDSS = D3DStateCache::GetSingleton()->GetDepthStencilState(m_device, dssDesc);
 				
 				m_context->OMSetRenderTargets(1, &mvRTV, stencilDSV);
-				m_context->OMSetDepthStencilState(stencilTestDSS.Get(), 127);
+				m_context->OMSetDepthStencilState(stencilTestDSS, 127);
 				m_context->VSSetShader(RenderUtilities::GetFullscreenVS(), nullptr, 0);
 				m_context->PSSetShader(RenderUtilities::GetMVCopyPS(), nullptr, 0);
 				m_context->PSSetShaderResources(0, 1, &firstPassMVSRV);
@@ -1168,12 +1710,11 @@ namespace ThroughScope
 				dssDesc.DepthFunc = D3D11_COMPARISON_ALWAYS;
 				dssDesc.StencilEnable = FALSE;  // 禁用硬件 stencil test
 
-				Microsoft::WRL::ComPtr<ID3D11DepthStencilState> noStencilDSS;
-				m_device->CreateDepthStencilState(&dssDesc, &noStencilDSS);
+				ID3D11DepthStencilState* noStencilDSS = D3DStateCache::GetSingleton()->GetDepthStencilState(m_device, dssDesc);
 				
 				// Step 3: 设置 Render Target（不需要 DSV）
 				m_context->OMSetRenderTargets(1, &mvRTV, nullptr);
-				m_context->OMSetDepthStencilState(noStencilDSS.Get(), 0);
+				m_context->OMSetDepthStencilState(noStencilDSS, 0);
 				
 				// Step 4: 设置 Shaders
 				m_context->VSSetShader(RenderUtilities::GetFullscreenVS(), nullptr, 0);
@@ -1213,21 +1754,8 @@ namespace ThroughScope
 				blendConst.FeatherRadius = 5.0f;  // 5 像素羽化半径
 				blendConst.StencilRef = 127.0f;   // Stencil 参考值
 				
-				D3D11_BUFFER_DESC cbDesc;
-				ZeroMemory(&cbDesc, sizeof(cbDesc));
-				cbDesc.ByteWidth = sizeof(BlendConstants);
-				cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-				cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-				cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-				
-				D3D11_SUBRESOURCE_DATA cbData;
-				cbData.pSysMem = &blendConst;
-				cbData.SysMemPitch = 0;
-				cbData.SysMemSlicePitch = 0;
-				
-				Microsoft::WRL::ComPtr<ID3D11Buffer> blendCB;
-				m_device->CreateBuffer(&cbDesc, &cbData, &blendCB);
-				m_context->PSSetConstantBuffers(0, 1, blendCB.GetAddressOf());
+				ID3D11Buffer* blendCB = D3DStateCache::GetSingleton()->UploadConstants(m_device, m_context, &blendConst, sizeof(BlendConstants));
+				m_context->PSSetConstantBuffers(0, 1, &blendCB);
 			}
 
 			// 配置 Rasterizer State
@@ -1244,9 +1772,8 @@ namespace ThroughScope
 			rsDesc.MultisampleEnable = FALSE;
 			rsDesc.AntialiasedLineEnable = FALSE;
 
-			Microsoft::WRL::ComPtr<ID3D11RasterizerState> rsState;
-			m_device->CreateRasterizerState(&rsDesc, &rsState);
-			m_context->RSSetState(rsState.Get());
+			ID3D11RasterizerState* rsState = D3DStateCache::GetSingleton()->GetRasterizerState(m_device, rsDesc);
+			m_context->RSSetState(rsState);
 
 			// 设置 Viewport
 			UINT mvWidth2 = 0, mvHeight2 = 0;
@@ -1280,9 +1807,8 @@ namespace ThroughScope
 			sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
 			sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
 			sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-			Microsoft::WRL::ComPtr<ID3D11SamplerState> pointSampler;
-			m_device->CreateSamplerState(&sampDesc, &pointSampler);
-			m_context->PSSetSamplers(0, 1, pointSampler.GetAddressOf());
+			ID3D11SamplerState* pointSampler = D3DStateCache::GetSingleton()->GetSamplerState(m_device, sampDesc);
+			m_context->PSSetSamplers(0, 1, &pointSampler);
 			
 			m_context->IASetInputLayout(nullptr);
 			m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -1293,10 +1819,9 @@ namespace ThroughScope
 			blendDesc.RenderTarget[0].BlendEnable = FALSE;
 			blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
 			
-			Microsoft::WRL::ComPtr<ID3D11BlendState> blendState;
-			m_device->CreateBlendState(&blendDesc, &blendState);
+			ID3D11BlendState* blendState = D3DStateCache::GetSingleton()->GetBlendState(m_device, blendDesc);
 			float blendFactor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
-			m_context->OMSetBlendState(blendState.Get(), blendFactor, 0xFFFFFFFF);
+			m_context->OMSetBlendState(blendState, blendFactor, 0xFFFFFFFF);
 
 			// 绘制 Fullscreen Triangle
 			m_context->Draw(3, 0);
@@ -1399,8 +1924,7 @@ namespace ThroughScope
 			dssDesc.FrontFace.StencilFunc = D3D11_COMPARISON_NOT_EQUAL;  // Pass where stencil != 127
 			dssDesc.BackFace = dssDesc.FrontFace;
 
-			Microsoft::WRL::ComPtr<ID3D11DepthStencilState> stencilTestDSS;
-			m_device->CreateDepthStencilState(&dssDesc, &stencilTestDSS);
+			ID3D11DepthStencilState* stencilTestDSS = D3DStateCache::GetSingleton()->GetDepthStencilState(m_device, dssDesc);
 
 			// Setup common rendering state
 			D3D11_RASTERIZER_DESC rsDesc;
@@ -1409,9 +1933,8 @@ namespace ThroughScope
 			rsDesc.CullMode = D3D11_CULL_NONE;
 			rsDesc.DepthClipEnable = TRUE;
 
-			Microsoft::WRL::ComPtr<ID3D11RasterizerState> rsState;
-			m_device->CreateRasterizerState(&rsDesc, &rsState);
-			m_context->RSSetState(rsState.Get());
+			ID3D11RasterizerState* rsState = D3DStateCache::GetSingleton()->GetRasterizerState(m_device, rsDesc);
+			m_context->RSSetState(rsState);
 
 			D3D11_SAMPLER_DESC sampDesc;
 			ZeroMemory(&sampDesc, sizeof(sampDesc));
@@ -1419,9 +1942,8 @@ namespace ThroughScope
 			sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
 			sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
 			sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-			Microsoft::WRL::ComPtr<ID3D11SamplerState> pointSampler;
-			m_device->CreateSamplerState(&sampDesc, &pointSampler);
-			m_context->PSSetSamplers(0, 1, pointSampler.GetAddressOf());
+			ID3D11SamplerState* pointSampler = D3DStateCache::GetSingleton()->GetSamplerState(m_device, sampDesc);
+			m_context->PSSetSamplers(0, 1, &pointSampler);
 
 			m_context->IASetInputLayout(nullptr);
 			m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -1430,10 +1952,9 @@ namespace ThroughScope
 			ZeroMemory(&blendDesc, sizeof(blendDesc));
 			blendDesc.RenderTarget[0].BlendEnable = FALSE;
 			blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-			Microsoft::WRL::ComPtr<ID3D11BlendState> blendState;
-			m_device->CreateBlendState(&blendDesc, &blendState);
+			ID3D11BlendState* blendState = D3DStateCache::GetSingleton()->GetBlendState(m_device, blendDesc);
 			float blendFactor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
-			m_context->OMSetBlendState(blendState.Get(), blendFactor, 0xFFFFFFFF);
+			m_context->OMSetBlendState(blendState, blendFactor, 0xFFFFFFFF);
 
 			m_context->VSSetShader(RenderUtilities::GetFullscreenVS(), nullptr, 0);
 			m_context->PSSetShader(RenderUtilities::GetMVCopyPS(), nullptr, 0);  // Reuse copy PS
@@ -1459,7 +1980,7 @@ namespace ThroughScope
 				m_context->RSSetViewports(1, &vp);
 
 				m_context->OMSetRenderTargets(1, &normalRTV, stencilDSV);
-				m_context->OMSetDepthStencilState(stencilTestDSS.Get(), 127);
+				m_context->OMSetDepthStencilState(stencilTestDSS, 127);
 				m_context->PSSetShaderResources(0, 1, &firstPassNormalSRV);
 
 				m_context->Draw(3, 0);
@@ -1491,7 +2012,7 @@ namespace ThroughScope
 				m_context->RSSetViewports(1, &vp);
 
 				m_context->OMSetRenderTargets(1, &albedoRTV, stencilDSV);
-				m_context->OMSetDepthStencilState(stencilTestDSS.Get(), 127);
+				m_context->OMSetDepthStencilState(stencilTestDSS, 127);
 				m_context->PSSetShaderResources(0, 1, &firstPassAlbedoSRV);
 
 				m_context->Draw(3, 0);
@@ -1583,10 +2104,9 @@ namespace ThroughScope
 			dssDesc.FrontFace.StencilDepthFailOp = D3D11_STENCIL_OP_KEEP;
 			dssDesc.BackFace = dssDesc.FrontFace;
 
-			Microsoft::WRL::ComPtr<ID3D11DepthStencilState> stencilDSS;
-			HRESULT hr = m_device->CreateDepthStencilState(&dssDesc, stencilDSS.GetAddressOf());
-			if (SUCCEEDED(hr)) {
-				m_context->OMSetDepthStencilState(stencilDSS.Get(), 127);
+			ID3D11DepthStencilState* stencilDSS = D3DStateCache::GetSingleton()->GetDepthStencilState(m_device, dssDesc);
+			if (stencilDSS) {
+				m_context->OMSetDepthStencilState(stencilDSS, 127);
 			}
 
 			// Get texture size for viewport
@@ -7,6 +7,14 @@
 #include "LightBackupSystem.h"
 #include "RenderStateManager.h"
 #include "ScopedRenderState.h"
+#include "ScopeResolutionScaler.h"
+#include "ScopeAmortizationPolicy.h"
+#include "ScopeProjection.h"
+#include "FrameBudgetGovernor.h"
+#include "GpuTimestampRing.h"
+#include "TimingStatsStore.h"
+#include "ClearPolicyTable.h"
+#include <chrono>
 
 namespace ThroughScope
 {
@@ -25,14 +33,79 @@ namespace ThroughScope
         SecondPassRenderer(ID3D11DeviceContext* context, ID3D11Device* device, D3DHooks* d3dHooks);
         ~SecondPassRenderer();
 
+        // 跨帧常驻实例，device/context 变化时才重建
+        static SecondPassRenderer& GetInstance(ID3D11DeviceContext* context, ID3D11Device* device, D3DHooks* d3dHooks);
+
         bool ExecuteSecondPass(); //主要的入口点
         bool CanExecuteSecondPass() const;
+        void EndFrame();  // 释放本帧持有的引用（BackBuffer/RTV/相机克隆），临时纹理留在 TexturePool
 
     public:
+        // 区域限定的第二次渲染：只在瞄具孔径（加边距）内绘制/清除/备份/合并
+        static bool s_RegionLimited;   // 默认关闭
+        static float s_RegionMargin;   // 孔径包围盒四周的 UV 边距（覆盖视差和畸变采样）
+        static float s_LastRegionCoverage;  // 上一帧区域占屏幕的比例（调试显示用，未限定时为 1）
+
+        // 动态分辨率的第二次渲染：按孔径直径和放大倍率降低引擎的动态分辨率比例，TrueScopeShader 负责放大
+        static bool s_DynamicResolution;   // 默认开启
+        static ScopeResolutionScaler s_ResolutionScaler;
+        static float s_LastResolutionScale;  // 上一帧实际使用的缩放（调试显示用，未启用时为 1）
+
+        // 时域分摊：相机稳定时隔帧跳过第二次渲染，按相机变化重投影上一次的瞄具图像
+        static ScopeAmortizationPolicy s_Amortization;  // 默认关闭（Settings::enabled）
+
+        // 帧预算调节：按第二次渲染的 GPU 耗时调整裁剪余量、阴影投射范围、贡献裁剪和 RT 合并
+        static FrameBudgetGovernor s_BudgetGovernor;  // 默认关闭（Settings::enabled）
+        static float s_LastSecondPassGpuMs;  // 最近回读的第二次渲染 GPU 耗时（ExecuteSecondPass 到 EndFrame）
+
+        // 分阶段计时：CPU 用 steady_clock，GPU 用时间戳查询环（延迟 3 帧回读，不阻塞）
+        enum class Phase : uint32_t
+        {
+            Total,  // ExecuteSecondPass 到 EndFrame
+            BackupFirstPassTextures,
+            UpdateScopeCamera,
+            ClearRenderTargets,
+            SyncLighting,
+            DrawScopeContent,
+            RestoreFirstPass,
+            Reproject,
+            MergeRenderTargets,  // 模板测试恢复场景外的第一次渲染结果，包括 GBuffer (RT_20-24) 和 MV (RT_29) 遮罩
+            MotionVectorMask,    // 帧生成 MV 遮罩：VanillaHook 的遮罩 MV 拷贝或 XifeiliAPI 的覆盖遮罩写入
+            Count
+        };
+        static TimingStatsStore s_PhaseTimings;
+        // 写入 Data/F4SE/Plugins/TrueThroughScope/Profiling/，成功时返回文件路径
+        static bool DumpPhaseTimingsCsv(std::string& outPath);
+
+        // 选择性清除：每个 RT 的清除策略（必须清除/会被完整覆盖/跳过），验证模式比较渲染前后的区域逐个检查
+        static ClearPolicyTable s_ClearPolicy;
+
+        // 增量场景图更新：第二次渲染前只更新玩家/武器/相机子树和 ScopeCamera 标记的脏节点，
+        // 而不是玩家 3D 的整个父节点（通常是整个单元格）
+        static bool s_IncrementalSceneUpdate;  // 默认关闭
+
+        // 光源剔除：按瞄具视锥体剔除光源，剩余光源按 强度 x 立体角 保留前 s_LightBudget 个
+        static bool s_LightCulling;     // 默认关闭
+        static uint32_t s_LightBudget;  // 0 表示只做视锥体剔除
+
+        class ScopedPhase
+        {
+        public:
+            ScopedPhase(SecondPassRenderer& renderer, Phase phase);
+            ~ScopedPhase();
+            ScopedPhase(const ScopedPhase&) = delete;
+            ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+        private:
+            SecondPassRenderer& m_renderer;
+            Phase m_phase;
+            std::chrono::steady_clock::time_point m_start;
+        };
 
 
 
     private:
+        bool AcquireFrameTargets();  // 本帧的主 RT/DS 和当前绑定的 RTV
         bool BackupFirstPassTextures();
         bool UpdateScopeCamera();
         void ClearRenderTargets();
@@ -44,9 +117,30 @@ namespace ThroughScope
          */
         void DrawScopeContent();
 
+        // 动态分辨率：瞄具渲染期间按 RenderUtilities 的缩放降低引擎的动态分辨率比例并打开动态分辨率 viewport，
+        // 在 SetRenderingForScope(true) 之后、BeginScopeRegionScissor 之前开始（scissor 跟随缩小的 viewport）
+        void BeginScopeDynamicResolution();
+        void EndScopeDynamicResolution();
+
 
         void RestoreFirstPass();
+        void DrawScopeQuad();  // 把瞄具纹理绘制到本帧的输出 RT（SetScopeTexture）
         void CleanupResources();
+
+        // 帧预算调节
+        void BeginFrameTiming();
+        void EndFrameTiming();
+        static void ApplyBudgetKnobs();
+
+        // 清除策略验证：用哨兵值清除一个 RT，第二次渲染后抓取区域，几帧后非阻塞回读
+        void ResolveClearProbe();
+        void BeginClearProbe(ID3D11Texture2D* texture);
+        void CaptureClearProbe();
+
+        // 时域分摊
+        ScopeAmortizationPolicy::FrameInput BuildAmortizationInput() const;
+        bool IsFlashActive() const;
+        bool ReprojectPreviousFrame();
         bool ValidateD3DResources() const;
         bool CreateTemporaryBackBuffer();
         void ConfigureScopeFrustum(RE::NiCamera* scopeCamera, RE::NiCamera* originalCamera);
@@ -58,6 +152,7 @@ namespace ThroughScope
         D3DHooks* m_d3dHooks;
 
         // ========== 渲染资源 ==========
+        // 临时 BackBuffer 由 TexturePool 持有，这里只是非拥有指针
         ID3D11Texture2D* m_tempBackBufferTex = nullptr;
         ID3D11ShaderResourceView* m_tempBackBufferSRV = nullptr;
         ID3D11Texture2D* m_rtTexture2D = nullptr;
@@ -69,10 +164,9 @@ namespace ThroughScope
         ID3D11Texture2D* m_mainRTTexture = nullptr;
         ID3D11Texture2D* m_mainDSTexture = nullptr;
         
-        // ========== 深度备份（用于 MV Mask 深度比较）==========
+        // ========== 深度备份（用于 MV Mask 深度比较，TexturePool 持有）==========
         ID3D11Texture2D* m_depthBackupTex = nullptr;
         ID3D11ShaderResourceView* m_depthBackupSRV = nullptr;
-        bool m_depthBackupCreated = false;
 
         // ========== 相机状态 ==========
         RE::NiCamera* m_playerCamera = nullptr;
@@ -89,6 +183,46 @@ namespace ThroughScope
         bool m_lightingSynced = false;
         bool m_renderExecuted = false;
 
+        // ========== 时域分摊：上一次完整渲染 ==========
+        bool m_hasRenderedFrame = false;
+        ScopeProjection::Matrix4 m_lastRenderedWorldToCam{};
+        float m_lastRenderedScale[2] = { 1.0f, 1.0f };
+
+        // ========== 动态分辨率 ==========
+        bool m_dynamicResolutionApplied = false;
+        float m_savedDynamicResolutionRatio[2] = { 1.0f, 1.0f };  // 引擎的比例（Upscaling 可能已降低）
+        UINT m_lastRenderedSize[2] = { 0, 0 };
+        RE::NiNode* m_lastRenderedScopeNode = nullptr;
+
+        // ========== 帧预算调节 ==========
+        GpuTimestampRing m_gpuTimer;
+        bool m_frameTimingOpen = false;
+        std::chrono::steady_clock::time_point m_frameCpuStart;
+        static bool s_BudgetKnobsApplied;  // 调节器覆盖了用户设置，关闭时需要恢复
+
+        // ========== 清除策略验证 ==========
+        // 不修改 RT：清除（或不清除）后拷贝一次孔径区域，第二次渲染后再拷贝一次，逐 texel 比较
+        struct ClearProbe
+        {
+            enum class State
+            {
+                Idle,
+                Armed,     // 已拷贝第二次渲染前的内容，等待渲染后抓取
+                Captured   // 渲染后的内容已拷贝到 staging，等待 GPU 完成
+            };
+            State state = State::Idle;
+            size_t entry = ClearPolicyTable::NO_PROBE;
+            ID3D11Texture2D* texture = nullptr;  // RendererData 持有
+            D3D11_BOX box = {};
+            UINT texelSize = 0;
+            uint32_t framesWaiting = 0;
+            // 跨探测复用，只在格式变化或区域变大时重建
+            D3D11_TEXTURE2D_DESC stagingDesc = {};
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> before;  // 第二次渲染前（按策略清除后）的区域
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> after;   // 第二次渲染后的区域
+        };
+        ClearProbe m_clearProbe;
+
         // ========== 错误处理 ==========
         mutable std::string m_lastError;
 
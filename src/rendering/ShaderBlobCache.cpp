@@ -0,0 +1,176 @@
+#include "ShaderBlobCache.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace ThroughScope
+{
+    namespace
+    {
+        constexpr uint32_t kMagic = 0x43535454;  // "TTSC"
+        constexpr uint32_t kFormatVersion = 1;
+
+        struct EntryHeader
+        {
+            uint32_t magic;
+            uint32_t formatVersion;
+            uint64_t key;
+            uint64_t blobSize;
+            uint64_t blobHash;
+        };
+
+        uint64_t HashString(uint64_t hash, std::string_view text)
+        {
+            // Length first so ("ab", "c") and ("a", "bc") differ
+            const uint64_t length = text.size();
+            hash = ShaderBlobCache::Hash(&length, sizeof(length), hash);
+            return ShaderBlobCache::Hash(text.data(), text.size(), hash);
+        }
+    }
+
+    uint64_t ShaderBlobCache::Hash(const void* data, size_t size, uint64_t seed)
+    {
+        constexpr uint64_t kPrime = 1099511628211ull;
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= kPrime;
+        }
+        return hash;
+    }
+
+    uint64_t ShaderBlobCache::ComputeKey(const Request& request) const
+    {
+        uint64_t hash = kHashSeed;
+        hash = HashString(hash, request.source);
+        hash = HashString(hash, request.entryPoint);
+        hash = HashString(hash, request.target);
+        const uint64_t defineCount = request.defines.size();
+        hash = Hash(&defineCount, sizeof(defineCount), hash);
+        for (const auto& [name, value] : request.defines) {
+            hash = HashString(hash, name);
+            hash = HashString(hash, value);
+        }
+        hash = Hash(&request.flags, sizeof(request.flags), hash);
+        hash = HashString(hash, m_compilerVersion);
+        return hash;
+    }
+
+    std::string ShaderBlobCache::FormatCompilerVersion(std::string_view module, uint32_t versionMS, uint32_t versionLS)
+    {
+        char version[48];
+        std::snprintf(version, sizeof(version), " %u.%u.%u.%u", versionMS >> 16, versionMS & 0xFFFF, versionLS >> 16,
+            versionLS & 0xFFFF);
+        return std::string(module) + version;
+    }
+
+    std::filesystem::path ShaderBlobCache::GetEntryPath(const Request& request) const
+    {
+        char keyText[17];
+        std::snprintf(keyText, sizeof(keyText), "%016llx", static_cast<unsigned long long>(ComputeKey(request)));
+        std::string fileName(request.name.empty() ? std::string_view("shader") : request.name);
+        fileName += '_';
+        fileName += keyText;
+        fileName += ".bin";
+        return m_directory / fileName;
+    }
+
+    bool ShaderBlobCache::GetOrCompile(const Request& request, const CompileFn& compile, std::vector<uint8_t>& blob,
+        std::string& error)
+    {
+        blob.clear();
+        error.clear();
+
+        std::filesystem::path path;
+        uint64_t key = 0;
+        if (m_enabled) {
+            key = ComputeKey(request);
+            path = GetEntryPath(request);
+
+            std::error_code ec;
+            if (std::filesystem::exists(path, ec)) {
+                if (Load(path, key, blob)) {
+                    ++m_stats.hits;
+                    return true;
+                }
+                ++m_stats.invalid;
+                blob.clear();
+            }
+        }
+
+        ++m_stats.misses;
+        if (!compile(blob, error) || blob.empty()) {
+            ++m_stats.compileFailures;
+            blob.clear();
+            return false;
+        }
+
+        if (m_enabled && !Store(path, key, blob)) {
+            ++m_stats.writeFailures;
+        }
+        return true;
+    }
+
+    bool ShaderBlobCache::Load(const std::filesystem::path& path, uint64_t key, std::vector<uint8_t>& blob) const
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        const std::streamoff fileSize = file.tellg();
+        if (fileSize < static_cast<std::streamoff>(sizeof(EntryHeader))) {
+            return false;
+        }
+        file.seekg(0);
+
+        EntryHeader header{};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        if (header.magic != kMagic || header.formatVersion != kFormatVersion || header.key != key ||
+            header.blobSize == 0 || header.blobSize != static_cast<uint64_t>(fileSize) - sizeof(EntryHeader)) {
+            return false;
+        }
+
+        blob.resize(static_cast<size_t>(header.blobSize));
+        if (!file.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size()))) {
+            return false;
+        }
+        return Hash(blob.data(), blob.size()) == header.blobHash;
+    }
+
+    bool ShaderBlobCache::Store(const std::filesystem::path& path, uint64_t key, const std::vector<uint8_t>& blob) const
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(m_directory, ec);
+        if (ec) {
+            return false;
+        }
+
+        // Write to a temporary file and rename, so a crash never leaves a truncated entry behind
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+            EntryHeader header{ kMagic, kFormatVersion, key, blob.size(), Hash(blob.data(), blob.size()) };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+            if (!file.good()) {
+                file.close();
+                std::filesystem::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Portable on-disk cache of compiled shader blobs, keyed by everything that affects the
+// compiler output. No D3D / CommonLib dependencies; D3DResourceManager plugs D3DCompile in
+// as the compile callback.
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Compile-once cache for shader bytecode
+     *
+     * The key is a 64-bit FNV-1a hash of (source, entry point, target, defines, flags, compiler
+     * version). Each entry is one file "<name>_<key>.bin" holding a small header (magic, format
+     * version, key, blob size, blob hash) followed by the blob; a file whose header or content
+     * doesn't check out is treated as a miss and rewritten. Changing any key input produces a
+     * new file name, so stale entries are never read (they are only left behind on disk).
+     */
+    class ShaderBlobCache
+    {
+    public:
+        struct Request
+        {
+            std::string_view name;        // Readable prefix of the cache file name
+            std::string_view source;
+            std::string_view entryPoint;
+            std::string_view target;
+            std::vector<std::pair<std::string, std::string>> defines;
+            uint32_t flags = 0;
+        };
+
+        struct Stats
+        {
+            uint32_t hits = 0;
+            uint32_t misses = 0;          // Compiled (including after an invalid entry)
+            uint32_t invalid = 0;         // Entries rejected on load
+            uint32_t compileFailures = 0;
+            uint32_t writeFailures = 0;
+        };
+
+        /// Compile callback: fills blob, or returns false with a message in error
+        using CompileFn = std::function<bool(std::vector<uint8_t>& blob, std::string& error)>;
+
+        void SetDirectory(std::filesystem::path directory) { m_directory = std::move(directory); }
+        const std::filesystem::path& GetDirectory() const { return m_directory; }
+
+        /// Part of every key: the build of the compiler DLL loaded at runtime, since different builds
+        /// of the same d3dcompiler_47.dll can emit different bytecode
+        void SetCompilerVersion(std::string version) { m_compilerVersion = std::move(version); }
+        const std::string& GetCompilerVersion() const { return m_compilerVersion; }
+
+        /// "d3dcompiler_47.dll 10.0.19041.868" from the dwFileVersionMS/LS of VS_FIXEDFILEINFO
+        static std::string FormatCompilerVersion(std::string_view module, uint32_t versionMS, uint32_t versionLS);
+
+        /// Disabled: always compile, never touch the disk
+        void SetEnabled(bool enabled) { m_enabled = enabled; }
+        bool IsEnabled() const { return m_enabled; }
+
+        uint64_t ComputeKey(const Request& request) const;
+        std::filesystem::path GetEntryPath(const Request& request) const;
+
+        /**
+         * @brief Load the blob for request from disk, or compile and store it
+         * @param error Compiler message when compilation fails
+         * @return false only when compilation fails (a cache write failure still returns the blob)
+         */
+        bool GetOrCompile(const Request& request, const CompileFn& compile, std::vector<uint8_t>& blob,
+            std::string& error);
+
+        const Stats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = {}; }
+
+        static uint64_t Hash(const void* data, size_t size, uint64_t seed = kHashSeed);
+
+    private:
+        static constexpr uint64_t kHashSeed = 14695981039346656037ull;
+
+        bool Load(const std::filesystem::path& path, uint64_t key, std::vector<uint8_t>& blob) const;
+        bool Store(const std::filesystem::path& path, uint64_t key, const std::vector<uint8_t>& blob) const;
+
+        std::filesystem::path m_directory;
+        std::string m_compilerVersion;
+        bool m_enabled = true;
+        Stats m_stats;
+    };
+}
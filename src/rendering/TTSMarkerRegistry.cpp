@@ -0,0 +1,112 @@
+#include "TTSMarkerRegistry.h"
+
+#include <mutex>
+
+namespace ThroughScope
+{
+    size_t TTSMarkerRegistry::DrawWindowHash::operator()(const DrawWindow& window) const
+    {
+        size_t hash = std::hash<const void*>()(window.vertexBuffer);
+        auto combine = [&hash](uint64_t value) {
+            hash ^= std::hash<uint64_t>()(value) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        };
+        combine(window.vertexOffset);
+        combine(window.startIndex);
+        combine(static_cast<uint32_t>(window.baseVertex));
+        combine(window.indexCount);
+        return hash;
+    }
+
+    TTSMarkerRegistry* TTSMarkerRegistry::GetSingleton()
+    {
+        static TTSMarkerRegistry instance;
+        return &instance;
+    }
+
+    void TTSMarkerRegistry::Register(const void* shape, const void* vertexBuffer, uint32_t indexCount)
+    {
+        if (!shape || !vertexBuffer || indexCount == 0) {
+            return;
+        }
+
+        std::unique_lock lock(m_mutex);
+        m_shapes[shape] = { vertexBuffer, indexCount };
+        m_markedBuffers[vertexBuffer] = indexCount;
+        m_markerWindows.clear();
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    void TTSMarkerRegistry::Clear()
+    {
+        std::unique_lock lock(m_mutex);
+        m_shapes.clear();
+        m_markedBuffers.clear();
+        m_markerWindows.clear();
+        m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    bool TTSMarkerRegistry::IsRegisteredShapeDrawActive() const
+    {
+        const void* active = m_activeShape.load(std::memory_order_relaxed);
+        if (!active) {
+            return false;
+        }
+        std::shared_lock lock(m_mutex);
+        return m_shapes.count(active) != 0;
+    }
+
+    bool TTSMarkerRegistry::IsMarked(const DrawWindow& window)
+    {
+        if (!window.vertexBuffer) {
+            return false;
+        }
+
+        {
+            std::shared_lock lock(m_mutex);
+            auto it = m_markedBuffers.find(window.vertexBuffer);
+            if (it == m_markedBuffers.end() || it->second != window.indexCount) {
+                return false;
+            }
+            if (m_markerWindows.count(window)) {
+                return true;
+            }
+
+            // Not inside DrawTriShape of the registered shape: another mesh of the same pool
+            const void* active = m_activeShape.load(std::memory_order_relaxed);
+            auto shape = active ? m_shapes.find(active) : m_shapes.end();
+            if (shape == m_shapes.end() || shape->second.vertexBuffer != window.vertexBuffer ||
+                shape->second.indexCount != window.indexCount) {
+                return false;
+            }
+        }
+
+        std::unique_lock lock(m_mutex);
+        // Cleared or replaced by a NIF load meanwhile: the active shape no longer belongs to the registry
+        auto shape = m_shapes.find(m_activeShape.load(std::memory_order_relaxed));
+        if (shape == m_shapes.end() || shape->second.vertexBuffer != window.vertexBuffer) {
+            return false;
+        }
+        if (m_markerWindows.insert(window).second) {
+            m_generation.fetch_add(1, std::memory_order_release);
+        }
+        return true;
+    }
+
+    bool TTSMarkerRegistry::IsEmpty() const
+    {
+        std::shared_lock lock(m_mutex);
+        return m_markedBuffers.empty();
+    }
+
+    size_t TTSMarkerRegistry::GetCount() const
+    {
+        std::shared_lock lock(m_mutex);
+        return m_markedBuffers.size();
+    }
+
+    size_t TTSMarkerRegistry::GetWindowCount() const
+    {
+        std::shared_lock lock(m_mutex);
+        return m_markerWindows.size();
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// Portable registry of the TTSEffectShape geometry used to identify the scope quad draw.
+// No D3D / CommonLib dependencies; NIFLoader registers the shape, the DrawTriShape and DrawIndexed
+// hooks feed it the engine's draws.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ThroughScope
+{
+    /**
+     * @brief CPU-side registry of the TTSEffectShape geometry, no GPU access
+     *
+     * NIFLoader records the shape's renderer data (BSGraphics::TriShape), its vertex buffer and
+     * index count when the scope model is loaded. FO4 sub-allocates geometry from shared pool
+     * buffers, so (buffer, index count) also matches every other mesh of that size in the pool.
+     * The exact draw window is learned from the engine itself: the DrawIndexed issued while
+     * BSGraphics::Renderer::DrawTriShape draws the registered TriShape is the marker window.
+     * Later draws match that window by a table lookup; nothing is ever read back from the GPU.
+     */
+    class TTSMarkerRegistry
+    {
+    public:
+        /// Where a DrawIndexed call reads its geometry from
+        struct DrawWindow
+        {
+            const void* vertexBuffer = nullptr;
+            uint32_t vertexOffset = 0;   // IASetVertexBuffers offset (bytes)
+            uint32_t startIndex = 0;     // DrawIndexed StartIndexLocation
+            int32_t baseVertex = 0;      // DrawIndexed BaseVertexLocation
+            uint32_t indexCount = 0;
+
+            bool operator==(const DrawWindow& other) const
+            {
+                return vertexBuffer == other.vertexBuffer && vertexOffset == other.vertexOffset &&
+                       startIndex == other.startIndex && baseVertex == other.baseVertex &&
+                       indexCount == other.indexCount;
+            }
+        };
+
+        static TTSMarkerRegistry* GetSingleton();
+
+        TTSMarkerRegistry() = default;
+        ~TTSMarkerRegistry() = default;
+        TTSMarkerRegistry(const TTSMarkerRegistry&) = delete;
+        TTSMarkerRegistry& operator=(const TTSMarkerRegistry&) = delete;
+
+        /**
+         * @brief Record a marker-carrying shape
+         * @param shape The shape's BSGraphics::TriShape (BSTriShape::rendererData), as passed to DrawTriShape
+         * @param vertexBuffer The D3D11 buffer holding the TTSEffectShape vertices
+         * @param indexCount Index count of the TTSEffectShape (numTriangles * 3)
+         */
+        void Register(const void* shape, const void* vertexBuffer, uint32_t indexCount);
+
+        /**
+         * @brief Forget all recorded shapes and windows (scope model unloaded or replaced)
+         */
+        void Clear();
+
+        /**
+         * @brief The engine starts / finished drawing a TriShape (DrawTriShape hook, render thread)
+         *
+         * Only stores the pointer; whether it is registered is checked by IsMarked.
+         */
+        void BeginShapeDraw(const void* shape) { m_activeShape.store(shape, std::memory_order_relaxed); }
+        void EndShapeDraw() { m_activeShape.store(nullptr, std::memory_order_relaxed); }
+
+        /// A registered shape is being drawn: its DrawIndexed must reach IsMarked (not a cached verdict)
+        bool IsRegisteredShapeDrawActive() const;
+
+        /**
+         * @brief Check whether a draw is the registered TTSEffectShape
+         *
+         * Draws whose (buffer, index count) is not registered are rejected by a table lookup.
+         * A candidate drawn inside DrawTriShape of its registered shape is recorded as a marker
+         * window (and bumps the generation); other candidates match only recorded windows.
+         */
+        bool IsMarked(const DrawWindow& window);
+
+        bool IsEmpty() const;
+        size_t GetCount() const;
+
+        /// Number of recorded marker windows
+        size_t GetWindowCount() const;
+
+        /**
+         * @brief Monotonic counter bumped on every Register/Clear and recorded window
+         *
+         * Lets per-draw caches detect that the registered geometry changed.
+         */
+        uint64_t GetGeneration() const { return m_generation.load(std::memory_order_acquire); }
+
+    private:
+        struct DrawWindowHash
+        {
+            size_t operator()(const DrawWindow& window) const;
+        };
+
+        struct Shape
+        {
+            const void* vertexBuffer = nullptr;
+            uint32_t indexCount = 0;
+        };
+
+        /// BSGraphics::TriShape -> its vertex buffer and index count
+        std::unordered_map<const void*, Shape> m_shapes;
+
+        /// Vertex buffer pointer -> TTSEffectShape index count (fast rejection)
+        std::unordered_map<const void*, uint32_t> m_markedBuffers;
+
+        /// Windows seen inside DrawTriShape of a registered shape, dropped on Register/Clear
+        std::unordered_set<DrawWindow, DrawWindowHash> m_markerWindows;
+
+        /// Written on the main thread (NIF load), read on the render thread (DrawIndexed)
+        mutable std::shared_mutex m_mutex;
+
+        /// TriShape being drawn by DrawTriShape on the render thread
+        std::atomic<const void*> m_activeShape{ nullptr };
+
+        std::atomic<uint64_t> m_generation{ 0 };
+    };
+}
@@ -0,0 +1,98 @@
+#include "TexturePool.h"
+
+namespace ThroughScope
+{
+    TexturePool* TexturePool::GetSingleton()
+    {
+        static TexturePool instance;
+        return &instance;
+    }
+
+    void TexturePool::BeginFrame(UINT referenceWidth, UINT referenceHeight)
+    {
+        if (referenceWidth == m_referenceWidth && referenceHeight == m_referenceHeight) {
+            return;
+        }
+
+        if (!m_entries.empty()) {
+            logger::info("TexturePool: resolution changed {}x{} -> {}x{}, dropping {} textures",
+                m_referenceWidth, m_referenceHeight, referenceWidth, referenceHeight, m_entries.size());
+        }
+
+        m_entries.clear();
+        m_referenceWidth = referenceWidth;
+        m_referenceHeight = referenceHeight;
+    }
+
+    TexturePool::Texture TexturePool::Acquire(ID3D11Device* device, const D3D11_TEXTURE2D_DESC& desc, DXGI_FORMAT srvFormat, UINT slot)
+    {
+        // Only textures with an SRV have a view format; otherwise it must not split the key
+        const DXGI_FORMAT viewFormat = (desc.BindFlags & D3D11_BIND_SHADER_RESOURCE) ?
+            (srvFormat != DXGI_FORMAT_UNKNOWN ? srvFormat : desc.Format) : DXGI_FORMAT_UNKNOWN;
+
+        SlotKey slotKey;
+        slotKey.key.width = desc.Width;
+        slotKey.key.height = desc.Height;
+        slotKey.key.format = desc.Format;
+        slotKey.key.sampleCount = desc.SampleDesc.Count;
+        slotKey.key.sampleQuality = desc.SampleDesc.Quality;
+        slotKey.key.bindFlags = desc.BindFlags;
+        slotKey.key.srvFormat = viewFormat;
+        slotKey.slot = slot;
+
+        auto it = m_entries.find(slotKey);
+        if (it != m_entries.end()) {
+            ++m_hits;
+            return { it->second.texture.Get(), it->second.srv.Get() };
+        }
+
+        ++m_misses;
+        if (!device) {
+            return {};
+        }
+
+        D3D11_TEXTURE2D_DESC createDesc = desc;
+        createDesc.MipLevels = 1;
+        createDesc.ArraySize = 1;
+        createDesc.Usage = D3D11_USAGE_DEFAULT;
+        createDesc.CPUAccessFlags = 0;
+
+        Entry entry;
+        HRESULT hr = device->CreateTexture2D(&createDesc, nullptr, entry.texture.GetAddressOf());
+        if (FAILED(hr)) {
+            logger::error("TexturePool: CreateTexture2D failed {}x{} fmt={} bind=0x{:X}: 0x{:X}",
+                desc.Width, desc.Height, (UINT)desc.Format, desc.BindFlags, (UINT)hr);
+            return {};
+        }
+
+        if (desc.BindFlags & D3D11_BIND_SHADER_RESOURCE) {
+            D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+            srvDesc.Format = viewFormat;
+            if (desc.SampleDesc.Count > 1) {
+                // Texture2DMS has no mip range: the whole (single) subresource is viewed
+                srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DMS;
+                srvDesc.Texture2DMS = {};
+            } else {
+                srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+                srvDesc.Texture2D.MipLevels = 1;
+                srvDesc.Texture2D.MostDetailedMip = 0;
+            }
+
+            hr = device->CreateShaderResourceView(entry.texture.Get(), &srvDesc, entry.srv.GetAddressOf());
+            if (FAILED(hr)) {
+                logger::error("TexturePool: CreateShaderResourceView failed fmt={}: 0x{:X}", (UINT)srvDesc.Format, (UINT)hr);
+                return {};
+            }
+        }
+
+        auto& stored = m_entries[slotKey] = std::move(entry);
+        return { stored.texture.Get(), stored.srv.Get() };
+    }
+
+    void TexturePool::Clear()
+    {
+        m_entries.clear();
+        m_referenceWidth = 0;
+        m_referenceHeight = 0;
+    }
+}
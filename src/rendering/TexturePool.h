@@ -0,0 +1,118 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <unordered_map>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Cross-frame pool for transient 2D textures used by the scope pass
+     *
+     * Textures are keyed by (width, height, format, sample count/quality, bind flags, SRV
+     * format). A pooled texture is
+     * handed out again on the next frame instead of being recreated, so the steady
+     * state performs no CreateTexture2D / CreateShaderResourceView calls.
+     *
+     * All entries are dropped when the reference resolution passed to BeginFrame()
+     * changes (window resize, dynamic resolution), or on Clear().
+     */
+    class TexturePool
+    {
+    public:
+        struct Key
+        {
+            UINT width = 0;
+            UINT height = 0;
+            DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+            UINT sampleCount = 1;
+            UINT sampleQuality = 0;
+            UINT bindFlags = 0;
+            DXGI_FORMAT srvFormat = DXGI_FORMAT_UNKNOWN;  // Resolved SRV format (typeless copies differ from format)
+
+            bool operator==(const Key& other) const
+            {
+                return width == other.width && height == other.height &&
+                       format == other.format && sampleCount == other.sampleCount &&
+                       sampleQuality == other.sampleQuality && bindFlags == other.bindFlags &&
+                       srvFormat == other.srvFormat;
+            }
+        };
+
+        /// Non-owning view of a pooled texture, valid until the pool is cleared
+        struct Texture
+        {
+            ID3D11Texture2D* texture = nullptr;
+            ID3D11ShaderResourceView* srv = nullptr;  // null unless D3D11_BIND_SHADER_RESOURCE
+        };
+
+        static TexturePool* GetSingleton();
+
+        /**
+         * @brief Drop every entry if the reference resolution changed since the last frame
+         */
+        void BeginFrame(UINT referenceWidth, UINT referenceHeight);
+
+        /**
+         * @brief Get a texture matching desc, creating it on a miss
+         *
+         * Usage is forced to DEFAULT with no CPU access and a single mip/array slice.
+         * @param srvFormat SRV format, DXGI_FORMAT_UNKNOWN uses the texture format
+         *                  (needed for typeless depth copies)
+         * @param slot Distinguishes several live textures with the same key within a frame
+         */
+        Texture Acquire(ID3D11Device* device, const D3D11_TEXTURE2D_DESC& desc,
+            DXGI_FORMAT srvFormat = DXGI_FORMAT_UNKNOWN, UINT slot = 0);
+
+        /**
+         * @brief Release every pooled texture
+         */
+        void Clear();
+
+        uint64_t GetHitCount() const { return m_hits; }
+        uint64_t GetMissCount() const { return m_misses; }
+        size_t GetEntryCount() const { return m_entries.size(); }
+
+    private:
+        TexturePool() = default;
+        ~TexturePool() = default;
+        TexturePool(const TexturePool&) = delete;
+        TexturePool& operator=(const TexturePool&) = delete;
+
+        struct SlotKey
+        {
+            Key key;
+            UINT slot = 0;
+
+            bool operator==(const SlotKey& other) const { return key == other.key && slot == other.slot; }
+        };
+
+        struct SlotKeyHash
+        {
+            size_t operator()(const SlotKey& k) const
+            {
+                uint64_t h = (static_cast<uint64_t>(k.key.width) << 32) | k.key.height;
+                h ^= (static_cast<uint64_t>(k.key.format) << 40 | static_cast<uint64_t>(k.key.bindFlags) << 8 | k.slot) *
+                     0x9E3779B97F4A7C15ull;
+                h ^= (static_cast<uint64_t>(k.key.srvFormat) << 40 | static_cast<uint64_t>(k.key.sampleCount) << 16 | k.key.sampleQuality) *
+                     0xC2B2AE3D27D4EB4Full;
+                return static_cast<size_t>(h ^ (h >> 31));
+            }
+        };
+
+        struct Entry
+        {
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+            Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        };
+
+        std::unordered_map<SlotKey, Entry, SlotKeyHash> m_entries;
+
+        UINT m_referenceWidth = 0;
+        UINT m_referenceHeight = 0;
+
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+    };
+}
@@ -0,0 +1,103 @@
+#include "TimingStatsStore.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ThroughScope
+{
+    TimingStatsStore::TimingStatsStore(std::vector<std::string> phaseNames, size_t window)
+        : m_names(std::move(phaseNames))
+        , m_window(std::max<size_t>(window, 1))
+        , m_series(m_names.size() * static_cast<size_t>(Clock::Count))
+    {
+        for (auto& series : m_series) {
+            series.samples.reserve(m_window);
+        }
+    }
+
+    void TimingStatsStore::Add(size_t phase, Clock clock, float milliseconds)
+    {
+        if (phase >= m_names.size() || clock >= Clock::Count || !std::isfinite(milliseconds)) {
+            return;
+        }
+
+        Series& series = GetSeries(phase, clock);
+        if (series.samples.size() < m_window) {
+            series.samples.push_back(milliseconds);
+        } else {
+            series.samples[series.next] = milliseconds;
+        }
+        series.next = (series.next + 1) % m_window;
+        series.last = milliseconds;
+    }
+
+    float TimingStatsStore::Percentile(std::vector<float>& samples, float p)
+    {
+        if (samples.empty()) {
+            return 0.0f;
+        }
+        // Small epsilon so float p (0.99f is slightly above 0.99) doesn't round the rank up
+        const double rank = std::ceil(std::clamp(p, 0.0f, 1.0f) * static_cast<double>(samples.size()) - 1e-4);
+        const size_t index = static_cast<size_t>(std::max(rank, 1.0)) - 1;
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index];
+    }
+
+    TimingStatsStore::Summary TimingStatsStore::GetSummary(size_t phase, Clock clock) const
+    {
+        Summary summary;
+        if (phase >= m_names.size() || clock >= Clock::Count) {
+            return summary;
+        }
+
+        const Series& series = GetSeries(phase, clock);
+        if (series.samples.empty()) {
+            return summary;
+        }
+
+        double sum = 0.0;
+        float minMs = series.samples.front();
+        float maxMs = minMs;
+        for (float sample : series.samples) {
+            sum += sample;
+            minMs = std::min(minMs, sample);
+            maxMs = std::max(maxMs, sample);
+        }
+
+        m_scratch.assign(series.samples.begin(), series.samples.end());
+        summary.samples = static_cast<uint32_t>(series.samples.size());
+        summary.minMs = minMs;
+        summary.maxMs = maxMs;
+        summary.avgMs = static_cast<float>(sum / series.samples.size());
+        summary.p99Ms = Percentile(m_scratch, 0.99f);
+        summary.lastMs = series.last;
+        return summary;
+    }
+
+    void TimingStatsStore::Clear()
+    {
+        for (auto& series : m_series) {
+            series.samples.clear();
+            series.next = 0;
+            series.last = 0.0f;
+        }
+    }
+
+    void TimingStatsStore::WriteCsv(std::ostream& out) const
+    {
+        static const char* clockNames[] = { "cpu", "gpu" };
+
+        out << "phase,clock,samples,min_ms,avg_ms,p99_ms,max_ms,last_ms\n";
+        for (size_t phase = 0; phase < m_names.size(); ++phase) {
+            for (size_t clock = 0; clock < static_cast<size_t>(Clock::Count); ++clock) {
+                Summary summary = GetSummary(phase, static_cast<Clock>(clock));
+                if (summary.samples == 0) {
+                    continue;
+                }
+                out << m_names[phase] << ',' << clockNames[clock] << ',' << summary.samples << ','
+                    << summary.minMs << ',' << summary.avgMs << ',' << summary.p99Ms << ','
+                    << summary.maxMs << ',' << summary.lastMs << '\n';
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+// Portable rolling timing statistics for the scope-pass phases (CPU and GPU, milliseconds).
+// No D3D / CommonLib dependencies; the caller measures and feeds the samples.
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Fixed-window sample store with min / avg / p99 per phase and clock
+     *
+     * Each (phase, clock) series keeps the last `window` samples in a ring; summaries are
+     * computed over that window on demand. p99 uses the nearest-rank method, so with fewer
+     * than 100 samples it is the maximum.
+     */
+    class TimingStatsStore
+    {
+    public:
+        enum class Clock : uint8_t
+        {
+            Cpu,
+            Gpu,
+            Count
+        };
+
+        struct Summary
+        {
+            uint32_t samples = 0;
+            float minMs = 0.0f;
+            float avgMs = 0.0f;
+            float p99Ms = 0.0f;
+            float maxMs = 0.0f;
+            float lastMs = 0.0f;
+        };
+
+        explicit TimingStatsStore(std::vector<std::string> phaseNames, size_t window = 240);
+
+        void Add(size_t phase, Clock clock, float milliseconds);
+        Summary GetSummary(size_t phase, Clock clock) const;
+        void Clear();
+
+        size_t GetPhaseCount() const { return m_names.size(); }
+        const std::string& GetPhaseName(size_t phase) const { return m_names[phase]; }
+        size_t GetWindow() const { return m_window; }
+
+        /// One row per phase and clock that has samples: phase,clock,samples,min,avg,p99,max,last
+        void WriteCsv(std::ostream& out) const;
+
+        /// Nearest-rank percentile (p in 0..1) of an unsorted sample set; reorders samples
+        static float Percentile(std::vector<float>& samples, float p);
+
+    private:
+        struct Series
+        {
+            std::vector<float> samples;
+            size_t next = 0;
+            float last = 0.0f;
+        };
+
+        Series& GetSeries(size_t phase, Clock clock) { return m_series[phase * static_cast<size_t>(Clock::Count) + static_cast<size_t>(clock)]; }
+        const Series& GetSeries(size_t phase, Clock clock) const { return m_series[phase * static_cast<size_t>(Clock::Count) + static_cast<size_t>(clock)]; }
+
+        std::vector<std::string> m_names;
+        size_t m_window;
+        std::vector<Series> m_series;
+        mutable std::vector<float> m_scratch;
+    };
+}
@@ -0,0 +1,212 @@
+#include "TransientAliasPlanner.h"
+
+#include <algorithm>
+
+namespace ThroughScope
+{
+    void TransientAliasPlanner::BeginFrame()
+    {
+        ++m_frame;
+        m_frameUsedBytes = 0;
+        m_frameRequestedBytes = 0;
+        for (auto& slot : m_slots) {
+            slot.live = false;
+            slot.usedThisFrame = false;
+            slot.plannedUntil = 0;
+        }
+    }
+
+    TransientAliasPlanner::SlotId TransientAliasPlanner::FindFreeSlot(uint64_t key, uint64_t bytes, uint32_t time) const
+    {
+        // Lowest id first keeps the mapping stable; planned intervals still running (or
+        // still to come) on a slot keep it for the lifetimes they were planned for
+        for (SlotId i = 0; i < m_slots.size(); ++i) {
+            const auto& slot = m_slots[i];
+            if (slot.allocated && !slot.live && slot.key == key && slot.bytes == bytes && slot.plannedUntil <= time) {
+                return i;
+            }
+        }
+        return INVALID_SLOT;
+    }
+
+    TransientAliasPlanner::SlotId TransientAliasPlanner::CreateSlot(uint64_t key, uint64_t bytes)
+    {
+        SlotId id = INVALID_SLOT;
+        for (SlotId i = 0; i < m_slots.size(); ++i) {
+            if (!m_slots[i].allocated) {
+                id = i;
+                break;
+            }
+        }
+        if (id == INVALID_SLOT) {
+            id = static_cast<SlotId>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        auto& slot = m_slots[id];
+        slot = Slot{};
+        slot.key = key;
+        slot.bytes = bytes;
+        slot.allocated = true;
+        slot.fresh = true;
+        return id;
+    }
+
+    void TransientAliasPlanner::MarkUsed(SlotId id)
+    {
+        auto& slot = m_slots[id];
+        if (!slot.usedThisFrame) {
+            m_frameUsedBytes += slot.bytes;
+        }
+        slot.usedThisFrame = true;
+        slot.lastUsedFrame = m_frame;
+    }
+
+    void TransientAliasPlanner::Plan(const std::vector<Lifetime>& lifetimes, std::vector<SlotId>& slots)
+    {
+        slots.assign(lifetimes.size(), INVALID_SLOT);
+
+        m_planOrder.resize(lifetimes.size());
+        for (uint32_t i = 0; i < lifetimes.size(); ++i) {
+            m_planOrder[i] = i;
+        }
+        std::stable_sort(m_planOrder.begin(), m_planOrder.end(), [&lifetimes](uint32_t a, uint32_t b) {
+            return lifetimes[a].begin < lifetimes[b].begin;
+        });
+
+        // Left edge: everything planned so far began no later, so a slot whose last planned
+        // lifetime has ended is free for the rest of this one
+        for (uint32_t index : m_planOrder) {
+            const Lifetime& lifetime = lifetimes[index];
+            SlotId id = FindFreeSlot(lifetime.key, lifetime.bytes, lifetime.begin);
+            if (id == INVALID_SLOT) {
+                id = CreateSlot(lifetime.key, lifetime.bytes);
+            }
+            m_slots[id].plannedUntil = std::max(lifetime.end, lifetime.begin + 1);
+            MarkUsed(id);
+            slots[index] = id;
+        }
+    }
+
+    TransientAliasPlanner::SlotId TransientAliasPlanner::Acquire(uint64_t key, uint64_t bytes, uint32_t time, bool& created, SlotId planned)
+    {
+        created = false;
+        m_frameRequestedBytes += bytes;
+
+        SlotId id = INVALID_SLOT;
+        if (planned < m_slots.size()) {
+            const auto& plannedSlot = m_slots[planned];
+            if (plannedSlot.allocated && !plannedSlot.live && plannedSlot.key == key && plannedSlot.bytes == bytes) {
+                id = planned;
+            }
+        }
+        if (id == INVALID_SLOT) {
+            id = FindFreeSlot(key, bytes, time);
+        }
+        if (id == INVALID_SLOT) {
+            id = CreateSlot(key, bytes);
+        }
+
+        auto& slot = m_slots[id];
+        created = slot.fresh;
+        slot.fresh = false;
+        slot.live = true;
+        MarkUsed(id);
+        return id;
+    }
+
+    void TransientAliasPlanner::Release(SlotId slot)
+    {
+        if (slot < m_slots.size()) {
+            m_slots[slot].live = false;
+        }
+    }
+
+    void TransientAliasPlanner::EndFrame(bool active)
+    {
+        for (auto& slot : m_slots) {
+            slot.live = false;
+        }
+
+        if (active) {
+            m_idleFrames = 0;
+            m_usedBytes = m_frameUsedBytes;
+            m_requestedBytes = m_frameRequestedBytes;
+        } else {
+            ++m_idleFrames;
+            m_usedBytes = 0;
+            m_requestedBytes = 0;
+        }
+    }
+
+    std::vector<TransientAliasPlanner::SlotId> TransientAliasPlanner::CollectEvictions(uint64_t budgetBytes, uint32_t releaseAfterFrames)
+    {
+        std::vector<SlotId> evicted;
+
+        if (m_idleFrames >= releaseAfterFrames) {
+            for (SlotId i = 0; i < m_slots.size(); ++i) {
+                if (m_slots[i].allocated) {
+                    m_slots[i].allocated = false;
+                    evicted.push_back(i);
+                }
+            }
+            return evicted;
+        }
+
+        uint64_t reserved = GetReservedBytes();
+        if (reserved <= budgetBytes) {
+            return evicted;
+        }
+
+        std::vector<SlotId> idle;
+        for (SlotId i = 0; i < m_slots.size(); ++i) {
+            if (m_slots[i].allocated && !m_slots[i].usedThisFrame) {
+                idle.push_back(i);
+            }
+        }
+        std::sort(idle.begin(), idle.end(), [this](SlotId a, SlotId b) {
+            return m_slots[a].lastUsedFrame < m_slots[b].lastUsedFrame;
+        });
+
+        for (SlotId i : idle) {
+            if (reserved <= budgetBytes) {
+                break;
+            }
+            m_slots[i].allocated = false;
+            reserved -= m_slots[i].bytes;
+            evicted.push_back(i);
+        }
+        return evicted;
+    }
+
+    void TransientAliasPlanner::Reset()
+    {
+        m_slots.clear();
+        m_idleFrames = 0;
+        m_usedBytes = 0;
+        m_requestedBytes = 0;
+        m_frameUsedBytes = 0;
+        m_frameRequestedBytes = 0;
+    }
+
+    uint64_t TransientAliasPlanner::GetReservedBytes() const
+    {
+        uint64_t total = 0;
+        for (const auto& slot : m_slots) {
+            if (slot.allocated) {
+                total += slot.bytes;
+            }
+        }
+        return total;
+    }
+
+    uint64_t TransientKeyTable::GetKey(const TransientTextureDesc& desc)
+    {
+        auto it = std::find(m_descs.begin(), m_descs.end(), desc);
+        if (it == m_descs.end()) {
+            m_descs.push_back(desc);
+            return m_descs.size() - 1;
+        }
+        return static_cast<uint64_t>(it - m_descs.begin());
+    }
+}
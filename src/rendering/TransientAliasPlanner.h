@@ -0,0 +1,154 @@
+#pragma once
+
+// Portable lifetime / aliasing bookkeeping for transient GPU allocations.
+// Decides which physical slot backs each allocation and when slots can be freed;
+// the caller owns the actual D3D resources. No D3D / CommonLib dependencies.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ThroughScope
+{
+    /**
+     * @brief Interval slot planner: same-key allocations with disjoint lifetimes share a slot
+     *
+     * Lifetimes are half-open intervals [begin, end) on a per-frame clock the caller advances
+     * (e.g. one tick per copy and per draw). Per frame: BeginFrame(), then optionally Plan()
+     * with the lifetimes expected this frame (usually last frame's measured ones), then
+     * Acquire() when a lifetime actually starts and Release() when it ends, then EndFrame().
+     *
+     * Plan() assigns slots left edge first: lifetimes sorted by begin each take the lowest
+     * slot of their key whose planned intervals are over, which needs the minimum number of
+     * slots per key (the peak number of overlapping lifetimes). Acquire() takes the planned
+     * slot when it is really free and otherwise any free same-key slot, so a schedule that
+     * differs from the plan costs memory, never correctness. Slots kept from earlier frames
+     * are reused before new ones are created, so the mapping is stable frame to frame.
+     *
+     * Keys identify compatible resources (see TransientKeyTable for texture descs), bytes is
+     * the size used for the reserved/used accounting and the budget.
+     */
+    class TransientAliasPlanner
+    {
+    public:
+        using SlotId = uint32_t;
+        static constexpr SlotId INVALID_SLOT = 0xFFFFFFFFu;
+
+        struct Slot
+        {
+            uint64_t key = 0;
+            uint64_t bytes = 0;
+            bool allocated = false;     // Backed by a resource (reserved)
+            bool live = false;          // Currently acquired
+            bool usedThisFrame = false;
+            bool fresh = false;         // New slot, the caller has not created its resource yet
+            uint32_t plannedUntil = 0;  // End of the last lifetime Plan() put here this frame
+            uint32_t lastUsedFrame = 0;
+        };
+
+        struct Lifetime
+        {
+            uint64_t key = 0;
+            uint64_t bytes = 0;
+            uint32_t begin = 0;  // First use
+            uint32_t end = 0;    // One past the last use
+        };
+
+        void BeginFrame();
+
+        /**
+         * @brief Reserve slots for this frame's expected lifetimes
+         * @param slots Receives the slot of lifetimes[i] at index i, to pass to Acquire()
+         */
+        void Plan(const std::vector<Lifetime>& lifetimes, std::vector<SlotId>& slots);
+
+        /**
+         * @brief Start a lifetime at time
+         * @param planned Slot from Plan(), used if it is still free
+         * @param created Set to true when the returned slot needs a new resource
+         */
+        SlotId Acquire(uint64_t key, uint64_t bytes, uint32_t time, bool& created, SlotId planned = INVALID_SLOT);
+        void Release(SlotId slot);
+
+        /**
+         * @brief Finish the frame
+         * @param active Whether the feature ran this frame (e.g. ADS); counts idle frames otherwise
+         */
+        void EndFrame(bool active);
+
+        /**
+         * @brief Slots the caller must free now, already marked unallocated
+         *
+         * Everything once the feature has been idle for releaseAfterFrames frames; otherwise
+         * least recently used slots not used this frame until reserved bytes fit the budget.
+         * Slots in use this frame are never evicted, so the budget is a soft limit.
+         */
+        std::vector<SlotId> CollectEvictions(uint64_t budgetBytes, uint32_t releaseAfterFrames);
+
+        /// Drop every slot (device change); the caller frees all resources itself
+        void Reset();
+
+        const Slot& GetSlot(SlotId slot) const { return m_slots[slot]; }
+        size_t GetSlotCount() const { return m_slots.size(); }
+        uint64_t GetReservedBytes() const;
+        uint64_t GetUsedBytes() const { return m_usedBytes; }      // Bytes of slots used this/last frame
+        uint64_t GetRequestedBytes() const { return m_requestedBytes; }  // Sum of all acquires, without aliasing
+        uint32_t GetIdleFrames() const { return m_idleFrames; }
+
+    private:
+        SlotId FindFreeSlot(uint64_t key, uint64_t bytes, uint32_t time) const;
+        SlotId CreateSlot(uint64_t key, uint64_t bytes);
+        void MarkUsed(SlotId slot);
+
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_planOrder;  // Scratch for Plan()
+        uint32_t m_frame = 0;
+        uint32_t m_idleFrames = 0;
+        uint64_t m_usedBytes = 0;
+        uint64_t m_requestedBytes = 0;
+        uint64_t m_frameUsedBytes = 0;
+        uint64_t m_frameRequestedBytes = 0;
+    };
+
+    /**
+     * @brief Texture properties that make two transient textures interchangeable
+     *
+     * Mirrors the D3D11_TEXTURE2D_DESC fields a CopyResource / SRV depends on; bind and misc
+     * flags are the caller's own and not part of it.
+     */
+    struct TransientTextureDesc
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;  // DXGI_FORMAT
+        uint32_t mipLevels = 1;
+        uint32_t arraySize = 1;
+        uint32_t sampleCount = 1;
+        uint32_t sampleQuality = 0;
+
+        bool operator==(const TransientTextureDesc& other) const
+        {
+            return width == other.width && height == other.height && format == other.format &&
+                   mipLevels == other.mipLevels && arraySize == other.arraySize &&
+                   sampleCount == other.sampleCount && sampleQuality == other.sampleQuality;
+        }
+    };
+
+    /**
+     * @brief Planner keys for texture descs: equal keys if and only if the descs are equal
+     *
+     * Keys are indices into the descs seen so far, so no field is truncated or hashed away
+     * (sample quality is a full 32-bit value, e.g. D3D11_STANDARD_MULTISAMPLE_PATTERN). Keys
+     * stay valid until Reset(), which must go together with TransientAliasPlanner::Reset().
+     */
+    class TransientKeyTable
+    {
+    public:
+        uint64_t GetKey(const TransientTextureDesc& desc);
+        void Reset() { m_descs.clear(); }
+        size_t GetKeyCount() const { return m_descs.size(); }
+
+    private:
+        std::vector<TransientTextureDesc> m_descs;  // A handful of render target shapes
+    };
+}
@@ -0,0 +1,322 @@
+#include "AnalyticScopeMask.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ThroughScope::AnalyticScopeMask;
+using Ellipse = AnalyticScopeMask::Ellipse;
+
+namespace
+{
+    /// What WriteToMVRegionOverrideMask leaves in the fallback R8 mask: the aperture disk
+    /// rasterized at pixel centres
+    std::vector<uint8_t> RasterizeAperture(const Ellipse& aperture, uint32_t width, uint32_t height)
+    {
+        std::vector<uint8_t> mask(size_t(width) * height, 0);
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                const double dx = ((x + 0.5) / width - aperture.centerU) / aperture.radiusU;
+                const double dy = ((y + 0.5) / height - aperture.centerV) / aperture.radiusV;
+                if (dx * dx + dy * dy <= 1.0) {
+                    mask[size_t(y) * width + x] = 255;
+                }
+            }
+        }
+        return mask;
+    }
+
+    /// Squared normalized distance of a pixel centre from the aperture centre, in double precision
+    double EllipseDistance(const Ellipse& aperture, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        const double dx = ((x + 0.5) / width - aperture.centerU) / aperture.radiusU;
+        const double dy = ((y + 0.5) / height - aperture.centerV) / aperture.radiusV;
+        return dx * dx + dy * dy;
+    }
+
+    /// A frame pair with random apertures, some partly off screen; some frames have no scope
+    AnalyticScopeMask RandomAnalyticMask(std::mt19937& rng, int iteration)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        const auto random = [&] {
+            return Ellipse{ unit(rng) * 1.4f - 0.2f, unit(rng) * 1.4f - 0.2f, 0.001f + 0.4f * unit(rng) * unit(rng),
+                0.001f + 0.4f * unit(rng) * unit(rng) };
+        };
+        AnalyticScopeMask mask;
+        if (iteration % 4 != 0) {
+            mask.SetCurrentAperture(random());
+        }
+        mask.BeginFrame();
+        if (iteration % 7 != 0) {
+            mask.SetCurrentAperture(random());
+        }
+        return mask;
+    }
+
+    std::string ReadShader()
+    {
+        std::ifstream file(TTS_HLSL_DIR "/ApplyMaskToMVCS.hlsl");
+        std::ostringstream text;
+        text << file.rdbuf();
+        return text.str();
+    }
+}
+
+TEST_CASE("The shader's mask test is the one ApplyReference ports", "[AnalyticScopeMask]")
+{
+    // If these lines change in ApplyMaskToMVCS.hlsl, AnalyticScopeMask::IsMasked must follow
+    const std::string shader = ReadShader();
+    REQUIRE_FALSE(shader.empty());
+    CHECK(shader.find("float2 uv = (float2(pixelCoord) + 0.5f) * invOutputSize;") != std::string::npos);
+    CHECK(shader.find("[branch] if ((maskFlags & 1) != 0)\n        currentMasked = insideEllipse(currentEllipse, uv);\n"
+                      "    else if ((maskFlags & 4) != 0)\n        currentMasked = CurrentMask[pixelCoord] > 0.0f;") !=
+          std::string::npos);
+    CHECK(shader.find("[branch] if ((maskFlags & 2) != 0)\n        previousMasked = insideEllipse(previousEllipse, uv);\n"
+                      "    else if ((maskFlags & 8) != 0)\n        previousMasked = PreviousMask[pixelCoord] > 0.0f;") !=
+          std::string::npos);
+    CHECK(shader.find("return d.x * d.x + d.y * d.y <= 1.0f;") != std::string::npos);
+    CHECK(AnalyticScopeMask::kCurrentAnalytic == 1);
+    CHECK(AnalyticScopeMask::kPreviousAnalytic == 2);
+    CHECK(AnalyticScopeMask::kCurrentTexture == 4);
+    CHECK(AnalyticScopeMask::kPreviousTexture == 8);
+}
+
+TEST_CASE("With valid projections the mask is the aperture ellipses, no texture read", "[AnalyticScopeMask]")
+{
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    size_t pixels = 0;
+    size_t boundary = 0;
+
+    for (int iteration = 0; iteration < 120; ++iteration) {
+        const uint32_t width = 320 + rng() % 700;
+        const uint32_t height = 200 + rng() % 500;
+        const Ellipse previous{ unit(rng), unit(rng), 0.01f + 0.25f * unit(rng), 0.01f + 0.25f * unit(rng) };
+        const Ellipse current{ unit(rng), unit(rng), 0.01f + 0.25f * unit(rng), 0.01f + 0.25f * unit(rng) };
+        const bool previousDrawn = iteration % 3 != 0;
+        const bool currentDrawn = iteration % 5 != 0;
+
+        AnalyticScopeMask mask;
+        if (previousDrawn) {
+            mask.SetCurrentAperture(previous);
+        }
+        mask.BeginFrame();
+        if (currentDrawn) {
+            mask.SetCurrentAperture(current);
+        }
+
+        const auto constants = mask.BuildConstants(width, height);
+        CHECK(AnalyticScopeMask::IsAnalytic(constants));
+        std::vector<float> in(size_t(width) * height * 2, 1.0f);
+        std::vector<float> out(in.size());
+        AnalyticScopeMask::ApplyReference(constants, nullptr, nullptr, in.data(), out.data(), width, height);
+
+        // Masked exactly where a pixel centre lies in either aperture (float vs double only at the rim)
+        INFO("iteration " << iteration << ", " << width << "x" << height);
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                const double dc = currentDrawn ? EllipseDistance(current, x, y, width, height) : 2.0;
+                const double dp = previousDrawn ? EllipseDistance(previous, x, y, width, height) : 2.0;
+                const double d = std::min(dc, dp);
+                const bool masked = out[2 * (size_t(y) * width + x)] == 0.0f;
+                if (std::fabs(d - 1.0) < 1e-4) {
+                    ++boundary;
+                } else if (masked != (d <= 1.0)) {
+                    FAIL("pixel " << x << ", " << y << " differs from the aperture");
+                }
+            }
+        }
+        pixels += size_t(width) * height;
+    }
+    WARN(pixels << " pixels matched the apertures (" << boundary << " within float precision of the rim)");
+}
+
+TEST_CASE("An invalid projection falls back to the mask texture for that frame only", "[AnalyticScopeMask]")
+{
+    const uint32_t width = 256;
+    const uint32_t height = 144;
+    const Ellipse aperture{ 0.3f, 0.6f, 0.05f, 0.09f };
+    const auto stencil = RasterizeAperture(aperture, width, height);
+    const std::vector<uint8_t> full(stencil.size(), 255);
+    std::vector<float> in(stencil.size() * 2, 1.0f);
+    std::vector<float> out(in.size());
+    std::vector<uint32_t> tiles;
+
+    AnalyticScopeMask mask;
+    mask.SetCurrentAperture({ 0.3f, 0.6f, 0.0f, 0.09f });   // Projection failed: not a stale default
+    CHECK_FALSE(mask.GetCurrent().IsAnalytic());
+    mask.MarkCurrentTextureDrawn();
+
+    const auto constants = mask.BuildConstants(width, height);
+    CHECK(constants.flags == AnalyticScopeMask::kCurrentTexture);
+    CHECK_FALSE(AnalyticScopeMask::IsAnalytic(constants));
+    CHECK_FALSE(AnalyticScopeMask::ClassifyTiles(constants, width, height, tiles));
+    CHECK(tiles.empty());
+    CHECK(AnalyticScopeMask::ApplyReference(constants, stencil.data(), full.data(), in.data(), out.data(), width, height) ==
+          size_t(std::count(stencil.begin(), stencil.end(), uint8_t(255))));
+
+    // Next frame is analytic: its texture is never read (stale content must not count), the previous
+    // frame's texture still is, so the whole surface is dispatched once more
+    mask.BeginFrame();
+    mask.SetCurrentAperture({ 0.7f, 0.3f, 0.05f, 0.09f });
+    const auto next = mask.BuildConstants(width, height);
+    CHECK(next.flags == (AnalyticScopeMask::kCurrentAnalytic | AnalyticScopeMask::kPreviousTexture));
+    CHECK_FALSE(AnalyticScopeMask::IsAnalytic(next));
+    CHECK_FALSE(AnalyticScopeMask::IsMasked(next, 255, 0, 5, 5));
+    CHECK(AnalyticScopeMask::IsMasked(next, 0, 255, 5, 5));
+    CHECK(AnalyticScopeMask::IsMasked(next, 0, 0, uint32_t(0.7f * width), uint32_t(0.3f * height)));
+
+    // Two analytic frames in a row: tiles again
+    mask.BeginFrame();
+    mask.SetCurrentAperture(aperture);
+    CHECK(AnalyticScopeMask::ClassifyTiles(mask.BuildConstants(width, height), width, height, tiles));
+    CHECK_FALSE(tiles.empty());
+}
+
+TEST_CASE("Frames rotate and frames without a mask are never read", "[AnalyticScopeMask]")
+{
+    AnalyticScopeMask mask;
+    mask.SetCurrentAperture({ 0.5f, 0.5f, 0.1f, 0.1f });
+    mask.BeginFrame();
+    CHECK(mask.GetPrevious().IsAnalytic());
+    CHECK_FALSE(mask.GetCurrent().HasMask());
+    CHECK(mask.HasAny());
+    mask.BeginFrame();
+    CHECK_FALSE(mask.HasAny());
+
+    // A frame without the scope leaves stale content in the other texture; it must not count
+    const auto constants = mask.BuildConstants(64, 64);
+    CHECK(constants.flags == 0);
+    CHECK_FALSE(AnalyticScopeMask::IsMasked(constants, 255, 255, 32, 32));
+    std::vector<uint32_t> tiles;
+    CHECK(AnalyticScopeMask::ClassifyTiles(constants, 64, 64, tiles));
+    CHECK(tiles.empty());
+}
+
+TEST_CASE("Tile lists hold every tile with a maskable pixel, sorted and unique", "[AnalyticScopeMask]")
+{
+    std::mt19937 rng(11);
+    size_t needed = 0;
+    size_t listed = 0;
+    std::vector<uint32_t> tiles;
+
+    for (int iteration = 0; iteration < 400; ++iteration) {
+        const uint32_t width = 16 + rng() % 1300;
+        const uint32_t height = 16 + rng() % 800;
+        const auto constants = RandomAnalyticMask(rng, iteration).BuildConstants(width, height);
+        REQUIRE(AnalyticScopeMask::ClassifyTiles(constants, width, height, tiles));
+
+        // Row by row, left to right, no duplicates
+        INFO("iteration " << iteration << ", " << width << "x" << height);
+        for (size_t i = 1; i < tiles.size(); ++i) {
+            const uint32_t a = tiles[i - 1];
+            const uint32_t b = tiles[i];
+            REQUIRE(((a >> 16) < (b >> 16) || ((a >> 16) == (b >> 16) && (a & 0xFFFF) < (b & 0xFFFF))));
+        }
+
+        // The masked pixels are exactly the ones inside the apertures
+        std::set<uint32_t> need;
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                if (AnalyticScopeMask::IsMasked(constants, 255, 255, x, y)) {
+                    need.insert(AnalyticScopeMask::PackTile(x / AnalyticScopeMask::kTileSize, y / AnalyticScopeMask::kTileSize));
+                }
+            }
+        }
+        const std::set<uint32_t> list(tiles.begin(), tiles.end());
+        for (uint32_t tile : need) {
+            if (!list.count(tile)) {
+                FAIL("tile " << (tile & 0xFFFF) << ", " << (tile >> 16) << " has a masked pixel but is not listed");
+            }
+        }
+        for (uint32_t tile : list) {
+            REQUIRE((tile & 0xFFFF) * AnalyticScopeMask::kTileSize < width);
+            REQUIRE((tile >> 16) * AnalyticScopeMask::kTileSize < height);
+        }
+        needed += need.size();
+        listed += list.size();
+    }
+
+    // Conservative, but only by the one-pixel widening at the edges
+    WARN("Tiles with a maskable pixel: " << needed << ", listed: " << listed);
+    CHECK(listed < needed + needed / 10);
+}
+
+TEST_CASE("Tile classification cost at 4K", "[AnalyticScopeMask][benchmark]")
+{
+    // Aperture 40% of the screen height, slightly moved since the previous frame
+    AnalyticScopeMask mask;
+    mask.SetCurrentAperture({ 0.5f, 0.5f, 0.225f * 9.0f / 16.0f, 0.4f });
+    mask.BeginFrame();
+    mask.SetCurrentAperture({ 0.505f, 0.5f, 0.225f * 9.0f / 16.0f, 0.4f });
+    const auto constants = mask.BuildConstants(3840, 2160);
+
+    std::vector<uint32_t> tiles;
+    REQUIRE(AnalyticScopeMask::ClassifyTiles(constants, 3840, 2160, tiles));
+    const size_t totalTiles = (3840 / 8) * (2160 / 8);
+    CHECK(tiles.size() < totalTiles / 2);
+    WARN("4K: " << tiles.size() << " of " << totalTiles << " tiles dispatched");
+
+    BENCHMARK("classify 3840x2160 into 8x8 tiles")
+    {
+        AnalyticScopeMask::ClassifyTiles(constants, 3840, 2160, tiles);
+        return tiles.size();
+    };
+}
+
+TEST_CASE("Tile count at 4K follows the real aperture, not a quad bound", "[AnalyticScopeMask]")
+{
+    // Same frame pair as the benchmark above: aperture radius 40% of the screen height, moved slightly
+    const uint32_t width = 3840;
+    const uint32_t height = 2160;
+    const Ellipse previous{ 0.5f, 0.5f, 0.225f * 9.0f / 16.0f, 0.4f };
+    const Ellipse current{ 0.505f, 0.5f, 0.225f * 9.0f / 16.0f, 0.4f };
+    const auto constantsFor = [&](float scale, float marginPixels) {
+        const auto grow = [&](Ellipse e) {
+            e.radiusU = e.radiusU * scale + marginPixels / float(width);
+            e.radiusV = e.radiusV * scale + marginPixels / float(height);
+            return e;
+        };
+        AnalyticScopeMask mask;
+        mask.SetCurrentAperture(grow(previous));
+        mask.BeginFrame();
+        mask.SetCurrentAperture(grow(current));
+        return mask.BuildConstants(width, height);
+    };
+    const auto constants = constantsFor(1.0f, 0.0f);
+
+    // Tiles holding a pixel centre inside either aperture
+    std::set<uint32_t> exact;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            if (AnalyticScopeMask::IsMasked(constants, 0, 0, x, y)) {
+                exact.insert(AnalyticScopeMask::PackTile(x / AnalyticScopeMask::kTileSize, y / AnalyticScopeMask::kTileSize));
+            }
+        }
+    }
+
+    std::vector<uint32_t> tiles;
+    REQUIRE(AnalyticScopeMask::ClassifyTiles(constants, width, height, tiles));
+    const std::set<uint32_t> listed(tiles.begin(), tiles.end());
+    CHECK(std::includes(listed.begin(), listed.end(), exact.begin(), exact.end()));
+
+    // Only the one-pixel edge widening separates the list from the aperture's own tiles
+    CHECK(tiles.size() >= exact.size());
+    CHECK(tiles.size() < exact.size() + exact.size() / 50);
+
+    // A bound around the whole quad (sqrt(2) radius + 2 px) would nearly double the dispatch
+    std::vector<uint32_t> quadTiles;
+    REQUIRE(AnalyticScopeMask::ClassifyTiles(constantsFor(1.41421356f, 2.0f), width, height, quadTiles));
+    CHECK(tiles.size() * 3 < quadTiles.size() * 2);
+
+    const size_t totalTiles = (width / 8) * (height / 8);
+    WARN("4K tiles: aperture " << exact.size() << ", dispatched " << tiles.size() << ", quad bound "
+                               << quadTiles.size() << ", of " << totalTiles);
+}
@@ -0,0 +1,277 @@
+#include "AsyncTextureLoader.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ThroughScope::AsyncTextureLoader;
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+namespace
+{
+    /// magic + DDS_HEADER (+ DDS_HEADER_DXT10) + payload bytes of pixel data
+    std::vector<uint8_t> MakeDDS(uint32_t width, uint32_t height, bool dx10, size_t payload)
+    {
+        std::vector<uint8_t> data(4 + 124 + (dx10 ? 20 : 0) + payload, 0);
+        const auto put = [&](size_t offset, uint32_t value) { std::memcpy(&data[offset], &value, sizeof(value)); };
+        put(0, 0x20534444);
+        put(4, 124);
+        put(4 + 8, height);
+        put(4 + 12, width);
+        put(4 + 24, 1);
+        put(4 + 72, 32);
+        if (dx10) {
+            put(4 + 76, 0x4);
+            put(4 + 80, 0x30315844);
+        }
+        return data;
+    }
+
+    /// A fresh directory under the system temp directory
+    struct TempDirectory
+    {
+        fs::path path;
+
+        explicit TempDirectory(const char* name) : path(fs::temp_directory_path() / name)
+        {
+            fs::remove_all(path);
+            fs::create_directories(path);
+        }
+        ~TempDirectory()
+        {
+            std::error_code ec;
+            fs::remove_all(path, ec);
+        }
+
+        std::string Write(const char* name, const std::vector<uint8_t>& data) const
+        {
+            std::ofstream(path / name, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+            return (path / name).string();
+        }
+    };
+
+    /// Poll like the render thread does, up to two seconds
+    template <class Predicate>
+    bool WaitFor(Predicate predicate)
+    {
+        for (int i = 0; i < 2000; ++i) {
+            if (predicate()) {
+                return true;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return false;
+    }
+
+    /// Hands back the path as the file contents
+    AsyncTextureLoader::FileReader EchoReader(std::chrono::milliseconds delay, std::atomic<int>* reads = nullptr)
+    {
+        return [delay, reads](const std::string& path, std::vector<uint8_t>& data, std::string&) {
+            if (reads) {
+                ++*reads;
+            }
+            std::this_thread::sleep_for(delay);
+            data.assign(path.begin(), path.end());
+            return true;
+        };
+    }
+}
+
+TEST_CASE("DDS headers are validated before the texture is created", "[AsyncTextureLoader]")
+{
+    AsyncTextureLoader::DDSInfo info;
+    std::string error;
+
+    const auto plain = MakeDDS(64, 32, false, 16);
+    REQUIRE(AsyncTextureLoader::ParseDDSHeader(plain.data(), plain.size(), info, error));
+    CHECK(info.width == 64);
+    CHECK(info.height == 32);
+    CHECK_FALSE(info.hasDX10Header);
+
+    const auto dx10 = MakeDDS(64, 32, true, 16);
+    REQUIRE(AsyncTextureLoader::ParseDDSHeader(dx10.data(), dx10.size(), info, error));
+    CHECK(info.hasDX10Header);
+
+    const auto noPixels = MakeDDS(64, 32, true, 0);
+    CHECK_FALSE(AsyncTextureLoader::ParseDDSHeader(noPixels.data(), noPixels.size(), info, error));
+    const auto noWidth = MakeDDS(0, 32, false, 16);
+    CHECK_FALSE(AsyncTextureLoader::ParseDDSHeader(noWidth.data(), noWidth.size(), info, error));
+    const auto tooLarge = MakeDDS(32768, 32, false, 16);
+    CHECK_FALSE(AsyncTextureLoader::ParseDDSHeader(tooLarge.data(), tooLarge.size(), info, error));
+    auto badMagic = plain;
+    badMagic[0] = 'X';
+    CHECK_FALSE(AsyncTextureLoader::ParseDDSHeader(badMagic.data(), badMagic.size(), info, error));
+    CHECK_FALSE(AsyncTextureLoader::ParseDDSHeader(plain.data(), 100, info, error));
+    CHECK_FALSE(error.empty());
+}
+
+TEST_CASE("Files are read on the worker and reported through Complete", "[AsyncTextureLoader]")
+{
+    TempDirectory dir("AsyncTextureLoaderTests_Read");
+    const auto dds = MakeDDS(64, 32, false, 16);
+    auto corrupt = dds;
+    corrupt[0] = 'X';
+    const std::string good = dir.Write("good.dds", dds);
+    const std::string bad = dir.Write("bad.dds", corrupt);
+
+    AsyncTextureLoader loader;
+    CHECK(loader.GetStatus().state == AsyncTextureLoader::State::Idle);
+
+    const uint64_t ticket = loader.Request(good);
+    CHECK(loader.GetStatus().state == AsyncTextureLoader::State::Pending);
+    AsyncTextureLoader::Result result;
+    REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+    CHECK(result.ticket == ticket);
+    CHECK(result.success);
+    CHECK(result.data == dds);
+    CHECK_FALSE(result.resource);
+    // Pending until the render thread has swapped the texture in
+    CHECK(loader.GetStatus().state == AsyncTextureLoader::State::Pending);
+    loader.Complete(ticket, true);
+    CHECK(loader.GetStatus().state == AsyncTextureLoader::State::Ready);
+
+    for (const std::string& path : { bad, (dir.path / "missing.dds").string() }) {
+        const uint64_t failed = loader.Request(path);
+        REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+        CHECK(result.ticket == failed);
+        CHECK_FALSE(result.success);
+        CHECK(result.data.empty());
+        CHECK_FALSE(result.error.empty());
+        loader.Complete(result.ticket, false, result.error);
+        const auto status = loader.GetStatus();
+        CHECK(status.state == AsyncTextureLoader::State::Failed);
+        CHECK(status.path == path);
+        CHECK(status.error == result.error);
+    }
+}
+
+TEST_CASE("Resources are created on the worker thread", "[AsyncTextureLoader]")
+{
+    AsyncTextureLoader loader(EchoReader(0ms));
+    const auto callerThread = std::this_thread::get_id();
+    std::atomic<int> alive{ 0 };
+    std::thread::id creatorThread;
+    loader.SetResourceCreator([&](const std::string& path, const std::vector<uint8_t>& data, std::shared_ptr<void>& resource, std::string& error) {
+        creatorThread = std::this_thread::get_id();
+        if (path == "broken") {
+            error = "texture creation failed";
+            return false;
+        }
+        ++alive;
+        resource = std::shared_ptr<void>(new std::string(data.begin(), data.end()), [&](void* p) {
+            --alive;
+            delete static_cast<std::string*>(p);
+        });
+        return true;
+    });
+
+    AsyncTextureLoader::Result result;
+    const uint64_t ticket = loader.Request("reticle");
+    REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+    CHECK(result.ticket == ticket);
+    CHECK(result.success);
+    CHECK(creatorThread != callerThread);
+    REQUIRE(result.resource);
+    CHECK(*static_cast<std::string*>(result.resource.get()) == "reticle");
+    CHECK(result.data.empty());  // The bytes are not kept once the resource exists
+    result = {};
+    CHECK(alive == 0);
+
+    loader.Request("broken");
+    REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+    CHECK_FALSE(result.success);
+    CHECK_FALSE(result.resource);
+    CHECK(result.error == "texture creation failed");
+
+    // Resources of superseded requests are released without reaching the render thread
+    for (int i = 0; i < 20; ++i) {
+        loader.Request("r" + std::to_string(i));
+    }
+    REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+    CHECK(result.path == "r19");
+    loader.Shutdown();
+    CHECK(alive == 1);
+    result = {};
+    CHECK(alive == 0);
+}
+
+TEST_CASE("The latest request wins", "[AsyncTextureLoader]")
+{
+    std::atomic<int> reads{ 0 };
+    AsyncTextureLoader loader(EchoReader(20ms, &reads));
+
+    uint64_t last = 0;
+    for (int i = 0; i < 50; ++i) {
+        last = loader.Request("p" + std::to_string(i));
+    }
+    AsyncTextureLoader::Result result;
+    REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+    CHECK(result.ticket == last);
+    CHECK(result.path == "p49");
+    std::this_thread::sleep_for(50ms);
+    CHECK_FALSE(loader.TakeResult(result));
+    CHECK(reads <= 3);
+
+    // Complete for a stale ticket is ignored
+    loader.Complete(last - 1, true);
+    CHECK(loader.GetStatus().state == AsyncTextureLoader::State::Pending);
+    loader.Complete(last, true);
+    CHECK(loader.GetStatus().state == AsyncTextureLoader::State::Ready);
+
+    // A request during a read drops the result of the one being read
+    loader.Request("x");
+    std::this_thread::sleep_for(5ms);
+    const uint64_t newer = loader.Request("y");
+    REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+    CHECK(result.ticket == newer);
+    CHECK(result.path == "y");
+
+    // Shutdown joins the worker, the next request restarts it
+    loader.Shutdown();
+    const uint64_t restarted = loader.Request("z");
+    REQUIRE(WaitFor([&] { return loader.TakeResult(result); }));
+    CHECK(result.ticket == restarted);
+}
+
+TEST_CASE("Concurrent requesters and a render-thread consumer", "[AsyncTextureLoader]")
+{
+    AsyncTextureLoader loader(EchoReader(0ms));
+    std::atomic<bool> done{ false };
+    std::atomic<int> mismatches{ 0 };
+
+    std::thread consumer([&] {
+        AsyncTextureLoader::Result result;
+        while (!done) {
+            if (loader.TakeResult(result)) {
+                if (std::string(result.data.begin(), result.data.end()) != result.path) {
+                    ++mismatches;
+                }
+                loader.Complete(result.ticket, true);
+            }
+        }
+    });
+    std::vector<std::thread> requesters;
+    for (int k = 0; k < 4; ++k) {
+        requesters.emplace_back([&, k] {
+            for (int i = 0; i < 5000; ++i) {
+                loader.Request(std::to_string(k) + ":" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& requester : requesters) {
+        requester.join();
+    }
+
+    CHECK(WaitFor([&] { return loader.GetStatus().state == AsyncTextureLoader::State::Ready; }));
+    done = true;
+    consumer.join();
+    CHECK(mismatches == 0);
+}
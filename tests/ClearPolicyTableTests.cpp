@@ -0,0 +1,142 @@
+#include "ClearPolicyTable.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <vector>
+
+using ThroughScope::ClearPolicyTable;
+using Policy = ClearPolicyTable::Policy;
+using Verdict = ClearPolicyTable::Verdict;
+
+namespace
+{
+    /// A mapped RGBA8 region with padded rows, like a staging texture's RowPitch
+    struct FakeRegion
+    {
+        uint32_t width;
+        uint32_t height;
+        size_t rowPitch;
+        std::vector<uint8_t> bytes;
+
+        FakeRegion(uint32_t w, uint32_t h, size_t pitch, uint8_t fill)
+            : width(w), height(h), rowPitch(pitch), bytes(pitch * h, 0xCD)
+        {
+            for (uint32_t y = 0; y < h; ++y) {
+                std::memset(bytes.data() + y * pitch, fill, size_t(w) * 4);
+            }
+        }
+
+        uint8_t* Texel(uint32_t x, uint32_t y) { return bytes.data() + y * rowPitch + x * 4; }
+    };
+
+    size_t FindEntry(const ClearPolicyTable& table, uint32_t renderTarget)
+    {
+        const auto& entries = table.GetEntries();
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].renderTarget == renderTarget) {
+                return i;
+            }
+        }
+        return ClearPolicyTable::NO_PROBE;
+    }
+}
+
+TEST_CASE("Default table skips the UI targets only", "[ClearPolicyTable]")
+{
+    ClearPolicyTable table;
+    const auto& entries = table.GetEntries();
+    REQUIRE(entries.size() == 19);
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const bool ui = entries[i].renderTarget == 17 || entries[i].renderTarget == 18;
+        CHECK(entries[i].policy == (ui ? Policy::Skip : Policy::MustClear));
+        CHECK(table.ShouldClear(i) == !ui);
+    }
+    CHECK(FindEntry(table, 4) == ClearPolicyTable::NO_PROBE);
+    CHECK(entries[FindEntry(table, 8)].clearValue[2] == 1.0f);
+
+    // Edits are undone by ResetPolicies
+    table.SetPolicy(0, Policy::Overwritten);
+    table.SetPolicy(FindEntry(table, 17), Policy::MustClear);
+    table.ResetPolicies();
+    CHECK(entries[0].policy == Policy::MustClear);
+    CHECK(entries[FindEntry(table, 17)].policy == Policy::Skip);
+}
+
+TEST_CASE("Unchanged texels are counted across different row pitches", "[ClearPolicyTable]")
+{
+    FakeRegion before(5, 3, 32, 0x00);
+    FakeRegion after(5, 3, 24, 0x00);
+    CHECK(ClearPolicyTable::CountUnchangedTexels(before.bytes.data(), before.rowPitch, after.bytes.data(), after.rowPitch, 5, 3, 4) == 15);
+
+    // The pass writes three texels, one of them with the value that was already there
+    after.Texel(0, 0)[1] = 0x80;
+    after.Texel(4, 2)[3] = 0xFF;
+    std::memset(after.Texel(2, 1), 0x00, 4);
+    CHECK(ClearPolicyTable::CountUnchangedTexels(before.bytes.data(), before.rowPitch, after.bytes.data(), after.rowPitch, 5, 3, 4) == 13);
+
+    // Row padding is never compared
+    before.bytes[before.rowPitch - 1] = 0x11;
+    CHECK(ClearPolicyTable::CountUnchangedTexels(before.bytes.data(), before.rowPitch, after.bytes.data(), after.rowPitch, 5, 3, 4) == 13);
+
+    // Invalid layouts count nothing
+    CHECK(ClearPolicyTable::CountUnchangedTexels(before.bytes.data(), 16, after.bytes.data(), after.rowPitch, 5, 3, 4) == 0);
+    CHECK(ClearPolicyTable::CountUnchangedTexels(nullptr, 32, after.bytes.data(), after.rowPitch, 5, 3, 4) == 0);
+}
+
+TEST_CASE("Probes rotate over the entries only while validating", "[ClearPolicyTable]")
+{
+    ClearPolicyTable table;
+    CHECK(table.NextProbe() == ClearPolicyTable::NO_PROBE);
+
+    table.SetValidating(true);
+    const size_t count = table.GetEntries().size();
+    for (size_t round = 0; round < 2; ++round) {
+        for (size_t i = 0; i < count; ++i) {
+            CHECK(table.NextProbe() == i);
+        }
+    }
+    table.ResetValidation();
+    CHECK(table.NextProbe() == 0);
+}
+
+TEST_CASE("Verdicts compare probe results with the policy", "[ClearPolicyTable]")
+{
+    ClearPolicyTable table;
+    table.SetValidating(true);
+    const size_t mainScene = FindEntry(table, 3);
+    const size_t ssr = FindEntry(table, 7);
+    const size_t ui = FindEntry(table, 17);
+
+    CHECK(table.GetVerdict(mainScene) == Verdict::Untested);
+
+    // Cleared and every texel replaced by the pass: the clear could go
+    table.RecordProbe(mainScene, 0, 1000);
+    table.RecordProbe(mainScene, 0, 1000);
+    CHECK(table.GetVerdict(mainScene) == Verdict::CouldSkipClear);
+    // One probe with a texel still at the clear value keeps it
+    table.RecordProbe(mainScene, 1, 1000);
+    CHECK(table.GetVerdict(mainScene) == Verdict::Consistent);
+    CHECK(table.GetStats(mainScene).leakedProbes == 1);
+    CHECK(table.GetStats(mainScene).maxLeakFraction == Approx(0.001f));
+
+    // Overwritten but the pass left texels alone: wrong policy
+    table.SetPolicy(ssr, Policy::Overwritten);
+    table.RecordProbe(ssr, 0, 500);
+    CHECK(table.GetVerdict(ssr) == Verdict::Consistent);
+    table.RecordProbe(ssr, 250, 500);
+    CHECK(table.GetVerdict(ssr) == Verdict::ShouldClear);
+    CHECK(table.GetStats(ssr).lastLeakFraction == Approx(0.5f));
+
+    // Skip accepts untouched texels
+    table.RecordProbe(ui, 500, 500);
+    CHECK(table.GetVerdict(ui) == Verdict::Consistent);
+
+    // Empty regions are not recorded
+    table.RecordProbe(ui, 0, 0);
+    CHECK(table.GetStats(ui).probes == 1);
+
+    table.ResetValidation();
+    CHECK(table.GetVerdict(ssr) == Verdict::Untested);
+}
@@ -0,0 +1,129 @@
+#include "DescKeyedCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+using ThroughScope::DescKeyedCache;
+using ThroughScope::PerDeviceCache;
+
+namespace
+{
+    struct FakeDesc
+    {
+        uint32_t filter;
+        uint32_t addressMode;
+        float lodBias;
+    };
+
+    /// Stand-in for ID3D11Device: counts the state objects created on it
+    struct FakeDevice
+    {
+        int created = 0;
+    };
+
+    struct FakeState
+    {
+        const FakeDevice* owner = nullptr;
+        FakeDesc desc{};
+    };
+
+    struct FakeDeviceCaches
+    {
+        DescKeyedCache<FakeDesc, std::shared_ptr<FakeState>> samplers;
+    };
+
+    FakeState* GetSampler(PerDeviceCache<FakeDevice, FakeDeviceCaches>& caches, FakeDevice& device, const FakeDesc& desc)
+    {
+        auto* handle = caches.Get(&device).samplers.GetOrCreate(desc,
+            [&device](const FakeDesc& d, std::shared_ptr<FakeState>& out) {
+                ++device.created;
+                out = std::make_shared<FakeState>();
+                out->owner = &device;
+                out->desc = d;
+                return true;
+            });
+        return handle ? handle->get() : nullptr;
+    }
+}
+
+TEST_CASE("Equal descs share one object", "[DescKeyedCache]")
+{
+    DescKeyedCache<FakeDesc, std::shared_ptr<FakeState>> cache;
+    int creates = 0;
+    auto create = [&creates](const FakeDesc&, std::shared_ptr<FakeState>& out) {
+        ++creates;
+        out = std::make_shared<FakeState>();
+        return true;
+    };
+
+    const FakeDesc a{ 1, 3, 0.0f };
+    const FakeDesc b{ 1, 3, 0.5f };
+    auto* first = cache.GetOrCreate(a, create);
+    CHECK(cache.GetOrCreate(a, create) == first);
+    CHECK(cache.GetOrCreate(b, create) != first);
+    CHECK(creates == 2);
+    CHECK(cache.GetHitCount() == 1);
+    CHECK(cache.GetMissCount() == 2);
+
+    // A failed create caches nothing
+    auto fail = [](const FakeDesc&, std::shared_ptr<FakeState>&) { return false; };
+    CHECK(cache.GetOrCreate(FakeDesc{ 7, 7, 7.0f }, fail) == nullptr);
+    CHECK(cache.GetLiveCount() == 2);
+}
+
+TEST_CASE("Alternating devices keep their own objects", "[DescKeyedCache]")
+{
+    PerDeviceCache<FakeDevice, FakeDeviceCaches> caches;
+    FakeDevice game;
+    FakeDevice proxy;
+    const FakeDesc point{ 0, 3, 0.0f };
+    const FakeDesc linear{ 1, 3, 0.0f };
+
+    for (int frame = 0; frame < 100; ++frame) {
+        FakeState* gamePoint = GetSampler(caches, game, point);
+        FakeState* proxyPoint = GetSampler(caches, proxy, point);
+        FakeState* gameLinear = GetSampler(caches, game, linear);
+
+        REQUIRE(gamePoint);
+        REQUIRE(proxyPoint);
+        CHECK(gamePoint->owner == &game);
+        CHECK(proxyPoint->owner == &proxy);
+        CHECK(gameLinear->owner == &game);
+        CHECK(gamePoint != proxyPoint);
+    }
+
+    // Switching devices every call recreated nothing after the first frame
+    CHECK(game.created == 2);
+    CHECK(proxy.created == 1);
+    CHECK(caches.GetDeviceCount() == 2);
+}
+
+TEST_CASE("Removing a device drops only its objects", "[DescKeyedCache]")
+{
+    PerDeviceCache<FakeDevice, FakeDeviceCaches> caches;
+    FakeDevice game;
+    FakeDevice proxy;
+    const FakeDesc point{ 0, 3, 0.0f };
+
+    GetSampler(caches, game, point);
+    FakeState* proxyPoint = GetSampler(caches, proxy, point);
+
+    caches.Remove(&game);
+    CHECK(caches.GetDeviceCount() == 1);
+    CHECK(GetSampler(caches, proxy, point) == proxyPoint);
+    CHECK(proxy.created == 1);
+
+    // Recreated on demand after removal
+    GetSampler(caches, game, point);
+    CHECK(game.created == 2);
+
+    size_t live = 0;
+    caches.ForEach([&live](const FakeDeviceCaches& c) { live += c.samplers.GetLiveCount(); });
+    CHECK(live == 2);
+
+    caches.Clear();
+    CHECK(caches.GetDeviceCount() == 0);
+    GetSampler(caches, proxy, point);
+    CHECK(proxy.created == 2);
+}
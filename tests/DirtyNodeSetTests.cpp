@@ -0,0 +1,180 @@
+#include "DirtyNodeSet.h"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <vector>
+
+using ThroughScope::DirtyNodeSet;
+
+namespace
+{
+    /// Stand-in for RE::NiAVObject/NiNode: parent link, children, NiRefObject-style refcount
+    struct FakeNode
+    {
+        FakeNode* parent = nullptr;
+        std::vector<FakeNode*> children;
+        int refCount = 1;
+        bool deleted = false;
+        float local[12] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0 };
+        float world[12] = {};
+
+        void IncRefCount() { ++refCount; }
+        int DecRefCount() { return --refCount; }
+        void DeleteThis() { deleted = true; }
+    };
+
+    /// Owns the nodes of a fake scene graph
+    struct FakeScene
+    {
+        std::vector<std::unique_ptr<FakeNode>> nodes;
+
+        FakeNode* Add(FakeNode* parent)
+        {
+            nodes.push_back(std::make_unique<FakeNode>());
+            FakeNode* node = nodes.back().get();
+            node->parent = parent;
+            if (parent) {
+                parent->children.push_back(node);
+            }
+            return node;
+        }
+
+        /// A subtree of `count` nodes below parent, `fanout` children per node
+        FakeNode* AddSubtree(FakeNode* parent, size_t count, size_t fanout)
+        {
+            FakeNode* root = Add(parent);
+            std::vector<FakeNode*> open = { root };
+            size_t added = 1;
+            for (size_t i = 0; added < count; ++i) {
+                FakeNode* at = open[i];
+                for (size_t c = 0; c < fanout && added < count; ++c, ++added) {
+                    open.push_back(Add(at));
+                }
+            }
+            return root;
+        }
+    };
+
+    /// What NiAVObject::Update does per node: world = parent world * local, then recurse
+    uint32_t UpdateSubtree(FakeNode* node)
+    {
+        const float* parentWorld = node->parent ? node->parent->world : nullptr;
+        for (int i = 0; i < 12; ++i) {
+            node->world[i] = parentWorld ? parentWorld[i] * node->local[i] + node->local[i] : node->local[i];
+        }
+        uint32_t visited = 1;
+        for (FakeNode* child : node->children) {
+            visited += UpdateSubtree(child);
+        }
+        return visited;
+    }
+
+    /// A loaded exterior cell with the player in it, roughly the shape DrawScopeContent sees
+    struct CellScene
+    {
+        FakeScene scene;
+        FakeNode* cell;
+        FakeNode* firstPerson;
+        FakeNode* thirdPerson;
+        FakeNode* scopeCamera;
+
+        CellScene()
+        {
+            cell = scene.Add(nullptr);
+            for (int reference = 0; reference < 400; ++reference) {
+                scene.AddSubtree(cell, 40, 4);   // statics, actors, effects
+            }
+            firstPerson = scene.AddSubtree(cell, 180, 3);   // arms, weapon, scope
+            thirdPerson = scene.AddSubtree(cell, 140, 3);
+            FakeNode* cameraRoot = scene.Add(cell);
+            scopeCamera = scene.Add(cameraRoot);
+        }
+    };
+
+    /// The incremental path of DrawScopeContent: mark, collapse to roots, update, clear
+    uint32_t IncrementalUpdate(CellScene& cell, DirtyNodeSet<FakeNode>& dirty, std::vector<FakeNode*>& roots)
+    {
+        dirty.Mark(cell.scopeCamera);   // UpdateScopeCamera
+        dirty.Mark(cell.firstPerson);   // Get3D(true)
+        dirty.Mark(cell.thirdPerson);   // Get3D(false)
+        dirty.CollectRoots(roots);
+        uint32_t visited = 0;
+        for (FakeNode* root : roots) {
+            visited += UpdateSubtree(root);
+        }
+        dirty.Clear();
+        return visited;
+    }
+}
+
+TEST_CASE("Roots drop marked nodes below another marked node", "[DirtyNodeSet]")
+{
+    FakeScene scene;
+    FakeNode* root = scene.Add(nullptr);
+    FakeNode* weapon = scene.Add(root);
+    FakeNode* scope = scene.Add(scene.Add(weapon));
+    FakeNode* camera = scene.Add(root);
+
+    DirtyNodeSet<FakeNode> dirty;
+    dirty.Mark(scope);
+    dirty.Mark(camera);
+    dirty.Mark(weapon);
+    dirty.Mark(scope);
+    dirty.Mark(nullptr);
+    CHECK(dirty.Size() == 3);
+
+    std::vector<FakeNode*> roots;
+    dirty.CollectRoots(roots);
+    CHECK(roots == std::vector<FakeNode*>{ camera, weapon });
+
+    dirty.Mark(root);
+    dirty.CollectRoots(roots);
+    CHECK(roots == std::vector<FakeNode*>{ root });
+}
+
+TEST_CASE("Marked nodes stay referenced until Clear", "[DirtyNodeSet]")
+{
+    FakeScene scene;
+    FakeNode* root = scene.Add(nullptr);
+    FakeNode* scope = scene.Add(root);
+
+    DirtyNodeSet<FakeNode> dirty;
+    dirty.Mark(scope);
+    dirty.Mark(scope);
+    CHECK(scope->refCount == 2);
+
+    // The model is unloaded between the mark and the pass: the set's reference keeps it alive
+    CHECK(scope->DecRefCount() == 1);
+    dirty.Clear();
+    CHECK(scope->refCount == 0);
+    CHECK(scope->deleted);
+    CHECK(dirty.Empty());
+    CHECK_FALSE(root->deleted);
+}
+
+TEST_CASE("Nodes visited per frame: incremental vs full update", "[DirtyNodeSet][benchmark]")
+{
+    CellScene cell;
+    DirtyNodeSet<FakeNode> dirty;
+    std::vector<FakeNode*> roots;
+
+    const uint32_t full = UpdateSubtree(cell.cell);
+    const uint32_t incremental = IncrementalUpdate(cell, dirty, roots);
+    CHECK(full == cell.scene.nodes.size());
+    CHECK(roots.size() == 3);
+    CHECK(incremental == 180 + 140 + 1);
+    CHECK(incremental * 40 < full);
+    CHECK(cell.firstPerson->refCount == 1);
+
+    WARN("Nodes visited per frame: full " << full << ", incremental " << incremental);
+
+    BENCHMARK("full update of the player's parent")
+    {
+        return UpdateSubtree(cell.cell);
+    };
+    BENCHMARK("incremental update of the dirty roots")
+    {
+        return IncrementalUpdate(cell, dirty, roots);
+    };
+}
@@ -0,0 +1,230 @@
+#include "DistortionLUT.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using ThroughScope::DistortionLUT;
+
+namespace
+{
+    /// HLSL intrinsics as TrueScopeShader.hlsl uses them
+    namespace hlsl
+    {
+        float saturate(float x) { return std::min(std::max(x, 0.0f), 1.0f); }
+        float lerp(float a, float b, float t) { return a + (b - a) * t; }
+        float smoothstep(float edge0, float edge1, float x)
+        {
+            const float t = saturate((x - edge0) / (edge1 - edge0));
+            return t * t * (3.0f - 2.0f * t);
+        }
+    }
+
+    struct Float2
+    {
+        float x, y;
+    };
+
+    /// The scope constants the distortion paths read
+    struct Constants
+    {
+        float screenWidth = 2560.0f;
+        float screenHeight = 1440.0f;
+        float sphericalDistortionStrength = 0.0f;
+        float sphericalDistortionRadius = 0.0f;
+        Float2 sphericalDistortionCenter = { 0.0f, 0.0f };
+    };
+
+    /// Per-pixel factors: the useDistortionLUT == 0 branches, line for line
+    float ShaderMonoFactor(const Constants& cb, float distance)
+    {
+        float distortionFactor = 1.0f + cb.sphericalDistortionStrength * distance * distance;
+        float radiusMask = hlsl::smoothstep(cb.sphericalDistortionRadius * 0.8f, cb.sphericalDistortionRadius, distance);
+        return hlsl::lerp(distortionFactor, 1.0f, radiusMask);
+    }
+
+    void ShaderChromaticFactors(const Constants& cb, float distance, float (&factors)[3])
+    {
+        float edgeFade = 1.0f - hlsl::smoothstep(cb.sphericalDistortionRadius * 0.9f, cb.sphericalDistortionRadius, distance);
+        float distortionR = 1.0f + cb.sphericalDistortionStrength * 1.05f * distance * distance;
+        float distortionG = 1.0f + cb.sphericalDistortionStrength * distance * distance;
+        float distortionB = 1.0f + cb.sphericalDistortionStrength * 0.95f * distance * distance;
+        factors[0] = hlsl::lerp(1.0f, distortionR, edgeFade);
+        factors[1] = hlsl::lerp(1.0f, distortionG, edgeFade);
+        factors[2] = hlsl::lerp(1.0f, distortionB, edgeFade);
+    }
+
+    /**
+     * sampleDistortionLUT on the uploaded half-float texels: texel-centre mapping, clamp addressing
+     * and a linear filter whose weight is quantized to the 8 bits of sub-texel precision D3D11 guarantees.
+     */
+    float SampleLUT(const Constants& cb, const DistortionLUT& lut, float distance, size_t channel)
+    {
+        const float lutWidth = float(DistortionLUT::kSize);
+        const float t = hlsl::saturate(distance / std::max(cb.sphericalDistortionRadius, 1e-5f));
+        const float u = (t * (lutWidth - 1.0f) + 0.5f) / lutWidth;
+
+        const float texel = u * lutWidth - 0.5f;
+        const float base = std::floor(texel);
+        const float weight = std::round((texel - base) * 256.0f) / 256.0f;
+        const auto clampIndex = [](float i) {
+            return size_t(std::min(std::max(i, 0.0f), float(DistortionLUT::kSize - 1)));
+        };
+        const uint16_t* texels = lut.GetTexels();
+        const float a = DistortionLUT::HalfToFloat(texels[clampIndex(base) * DistortionLUT::kChannels + channel]);
+        const float b = DistortionLUT::HalfToFloat(texels[clampIndex(base + 1.0f) * DistortionLUT::kChannels + channel]);
+        return hlsl::lerp(a, b, weight) + 1.0f;
+    }
+
+    /// applySphericalDistortion with a given factor: texcoord -> distorted texcoord
+    Float2 Distort(const Constants& cb, Float2 texcoord, float distortionFactor)
+    {
+        const float aspect = cb.screenWidth / cb.screenHeight;
+        const Float2 center = { 0.5f + cb.sphericalDistortionCenter.x, 0.5f + cb.sphericalDistortionCenter.y };
+        Float2 uv = { (texcoord.x - center.x) * aspect, texcoord.y - center.y };
+        uv.x *= distortionFactor;
+        uv.y *= distortionFactor;
+        return { uv.x / aspect + center.x, uv.y + center.y };
+    }
+
+    float DistanceFromCenter(const Constants& cb, Float2 texcoord)
+    {
+        const float aspect = cb.screenWidth / cb.screenHeight;
+        const float x = (texcoord.x - 0.5f - cb.sphericalDistortionCenter.x) * aspect;
+        const float y = texcoord.y - 0.5f - cb.sphericalDistortionCenter.y;
+        return std::sqrt(x * x + y * y);
+    }
+
+    std::string ReadShader()
+    {
+        std::ifstream file(TTS_HLSL_DIR "/TrueScopeShader.hlsl");
+        std::ostringstream text;
+        text << file.rdbuf();
+        return text.str();
+    }
+}
+
+TEST_CASE("The shader's per-pixel branch is the math the test ports", "[DistortionLUT]")
+{
+    // If these lines change in TrueScopeShader.hlsl, DistortionLUT and the ports above must follow
+    const std::string shader = ReadShader();
+    REQUIRE_FALSE(shader.empty());
+    CHECK(shader.find("distortionFactor = 1.0 + sphericalDistortionStrength * distance * distance;") != std::string::npos);
+    CHECK(shader.find("smoothstep(sphericalDistortionRadius * 0.8, sphericalDistortionRadius, distance);") != std::string::npos);
+    CHECK(shader.find("distortionFactor = lerp(distortionFactor, 1.0, radiusMask);") != std::string::npos);
+    CHECK(shader.find("1.0 - smoothstep(sphericalDistortionRadius * 0.9, sphericalDistortionRadius, distance);") != std::string::npos);
+    CHECK(shader.find("distortionR = 1.0 + sphericalDistortionStrength * 1.05 * distance * distance;") != std::string::npos);
+    CHECK(shader.find("distortionB = 1.0 + sphericalDistortionStrength * 0.95 * distance * distance;") != std::string::npos);
+    CHECK(shader.find("float t = saturate(distance / max(sphericalDistortionRadius, 1e-5));") != std::string::npos);
+    CHECK(shader.find("float u = (t * (lutWidth - 1.0) + 0.5) / lutWidth;") != std::string::npos);
+    CHECK(shader.find("return distortionLUT.SampleLevel(lutSampler, float2(u, 0.5), 0) + 1.0;") != std::string::npos);
+}
+
+TEST_CASE("Generated texels match the per-pixel HLSL factors", "[DistortionLUT]")
+{
+    static float texels[DistortionLUT::kSize * DistortionLUT::kChannels];
+    // The camera panel's slider ranges: strength [-0.5, 0.5], radius [0.1, 1]
+    for (float strength : { -0.5f, -0.137f, 0.05f, 0.3f, 0.5f }) {
+        for (float radius : { 0.1f, 0.35f, 0.62f, 1.0f }) {
+            Constants cb;
+            cb.sphericalDistortionStrength = strength;
+            cb.sphericalDistortionRadius = radius;
+            DistortionLUT::Generate({ strength, radius }, texels);
+
+            float maxError = 0.0f;
+            for (size_t i = 0; i < DistortionLUT::kSize; ++i) {
+                const float distance = radius * float(i) / float(DistortionLUT::kSize - 1);
+                float chromatic[3];
+                ShaderChromaticFactors(cb, distance, chromatic);
+                for (size_t c = 0; c < 3; ++c) {
+                    maxError = std::max(maxError, std::fabs(texels[i * 4 + c] + 1.0f - chromatic[c]));
+                }
+                maxError = std::max(maxError, std::fabs(texels[i * 4 + 3] + 1.0f - ShaderMonoFactor(cb, distance)));
+            }
+            INFO("strength " << strength << ", radius " << radius);
+            CHECK(maxError < 2e-6f);
+            // The last texel is exactly "no distortion", so clamped sampling covers every distance
+            for (size_t c = 0; c < 4; ++c) {
+                CHECK(texels[(DistortionLUT::kSize - 1) * 4 + c] == 0.0f);
+            }
+        }
+    }
+
+    // Strength 0 or radius 0: an all-identity table
+    DistortionLUT::Generate({ 0.0f, 0.5f }, texels);
+    CHECK(std::all_of(std::begin(texels), std::end(texels), [](float v) { return v == 0.0f; }));
+}
+
+TEST_CASE("Sampled LUT stays within half a pixel of the per-pixel path", "[DistortionLUT]")
+{
+    DistortionLUT lut;
+    float maxErrorPx = 0.0f;
+    for (float strength : { -0.5f, -0.2f, 0.15f, 0.5f }) {
+        for (float radius : { 0.1f, 0.4f, 0.75f, 1.0f }) {
+            Constants cb;
+            cb.sphericalDistortionStrength = strength;
+            cb.sphericalDistortionRadius = radius;
+            cb.sphericalDistortionCenter = { 0.02f, -0.01f };
+            lut.Update({ strength, radius });
+
+            // Every 7th pixel of a 2560x1440 target, out to the corners (beyond the radius)
+            for (int py = 0; py < 1440; py += 7) {
+                for (int px = 0; px < 2560; px += 7) {
+                    const Float2 texcoord = { (px + 0.5f) / 2560.0f, (py + 0.5f) / 1440.0f };
+                    const float distance = DistanceFromCenter(cb, texcoord);
+
+                    const Float2 reference = Distort(cb, texcoord, ShaderMonoFactor(cb, distance));
+                    const Float2 sampled = Distort(cb, texcoord, SampleLUT(cb, lut, distance, 3));
+                    maxErrorPx = std::max({ maxErrorPx, std::fabs(sampled.x - reference.x) * 2560.0f,
+                                            std::fabs(sampled.y - reference.y) * 1440.0f });
+
+                    float chromatic[3];
+                    ShaderChromaticFactors(cb, distance, chromatic);
+                    for (size_t c = 0; c < 3; ++c) {
+                        const Float2 referenceC = Distort(cb, texcoord, chromatic[c]);
+                        const Float2 sampledC = Distort(cb, texcoord, SampleLUT(cb, lut, distance, c));
+                        maxErrorPx = std::max({ maxErrorPx, std::fabs(sampledC.x - referenceC.x) * 2560.0f,
+                                                std::fabs(sampledC.y - referenceC.y) * 1440.0f });
+                    }
+                }
+            }
+        }
+    }
+    WARN("Max UV error of the LUT path at 2560x1440: " << maxErrorPx << " px");
+    CHECK(maxErrorPx < 0.5f);
+}
+
+TEST_CASE("Half conversion rounds to nearest even and round-trips", "[DistortionLUT]")
+{
+    CHECK(DistortionLUT::FloatToHalf(1.0f) == 0x3C00);
+    CHECK(DistortionLUT::FloatToHalf(-2.0f) == 0xC000);
+    CHECK(DistortionLUT::FloatToHalf(65504.0f) == 0x7BFF);
+    CHECK(DistortionLUT::FloatToHalf(65520.0f) == 0x7C00);                 // Rounds up into infinity
+    CHECK(DistortionLUT::FloatToHalf(std::ldexp(1.0f, -24)) == 0x0001);    // Smallest subnormal
+    CHECK(DistortionLUT::FloatToHalf(std::ldexp(1.0f, -26)) == 0x0000);
+    CHECK(DistortionLUT::FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);        // Tie to even
+    CHECK(DistortionLUT::FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3C02);  // Tie to even
+
+    for (uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+        const float value = DistortionLUT::HalfToFloat(uint16_t(bits));
+        if (!std::isnan(value) && DistortionLUT::FloatToHalf(value) != bits) {
+            FAIL("0x" << std::hex << bits << " does not round-trip");
+        }
+    }
+}
+
+TEST_CASE("The table is rebuilt only when the settings change", "[DistortionLUT]")
+{
+    DistortionLUT lut;
+    CHECK(lut.GetVersion() == 0);
+    CHECK(lut.Update({ 0.3f, 0.5f }));
+    CHECK_FALSE(lut.Update({ 0.3f, 0.5f }));
+    CHECK(lut.Update({ 0.31f, 0.5f }));
+    CHECK(lut.Update({ 0.31f, 0.6f }));
+    CHECK(lut.GetVersion() == 3);
+    CHECK(lut.GetParams() == DistortionLUT::Params{ 0.31f, 0.6f });
+}
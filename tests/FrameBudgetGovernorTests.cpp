@@ -0,0 +1,163 @@
+#include "FrameBudgetGovernor.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <random>
+
+using ThroughScope::FrameBudgetGovernor;
+using Action = FrameBudgetGovernor::Action;
+
+namespace
+{
+    /// Relative scope-pass cost at each DefaultLadder() level
+    constexpr float kLevelCost[] = { 1.0f, 0.85f, 0.7f, 0.55f, 0.45f, 0.4f };
+
+    /**
+     * Simulated scope pass: cost = sceneMs(frame) * kLevelCost[level] + noise, read back through a
+     * queue the way GPU timestamps arrive a few frames after the frame that produced them.
+     */
+    struct SimulatedScene
+    {
+        std::function<float(int)> sceneMs;
+        float noiseMs = 0.0f;
+        size_t readbackLatency = 3;
+
+        std::mt19937 rng{ 1234 };
+        std::deque<float> inFlight;
+        int levelChanges = 0;
+
+        void Run(FrameBudgetGovernor& governor, int firstFrame, int frames)
+        {
+            std::normal_distribution<float> noise(0.0f, 1.0f);
+            for (int frame = firstFrame; frame < firstFrame + frames; ++frame) {
+                inFlight.push_back(sceneMs(frame) * kLevelCost[governor.GetLevel()] + noiseMs * noise(rng));
+                if (inFlight.size() > readbackLatency) {
+                    const uint32_t before = governor.GetLevel();
+                    governor.Update(std::max(inFlight.front(), 0.0f));
+                    inFlight.pop_front();
+                    levelChanges += governor.GetLevel() != before;
+                }
+            }
+        }
+    };
+
+    FrameBudgetGovernor EnabledGovernor(float targetMs)
+    {
+        FrameBudgetGovernor governor;
+        governor.GetSettings().enabled = true;
+        governor.GetSettings().targetMs = targetMs;
+        return governor;
+    }
+}
+
+TEST_CASE("Sustained overload degrades to the first level within budget", "[FrameBudgetGovernor]")
+{
+    auto governor = EnabledGovernor(2.0f);
+    SimulatedScene scene;
+    scene.sceneMs = [](int) { return 3.2f; };   // 3.2, 2.72, 2.24, 1.76 ms per level
+    scene.Run(governor, 0, 600);
+
+    // 2.24 ms is still over the 2.2 ms upper edge; 1.76 ms sits in the dead band and holds
+    CHECK(governor.GetLevel() == 3);
+    CHECK(scene.levelChanges == 3);
+    CHECK(governor.GetSmoothedMs() == Approx(3.2f * kLevelCost[3]).epsilon(0.01));
+
+    for (const auto& event : governor.GetHistory()) {
+        CHECK(event.toLevel == event.fromLevel + 1);
+    }
+}
+
+TEST_CASE("Load drop improves one level at a time and recovers fully", "[FrameBudgetGovernor]")
+{
+    auto governor = EnabledGovernor(2.0f);
+    SimulatedScene scene;
+    scene.sceneMs = [](int frame) { return frame < 300 ? 4.4f : 1.0f; };
+    scene.Run(governor, 0, 300);
+    REQUIRE(governor.GetLevel() == 4);
+
+    const auto degraded = governor.GetHistory().size();
+    scene.Run(governor, 300, 1000);
+    CHECK(governor.GetLevel() == 0);
+
+    const auto history = governor.GetHistory();
+    for (size_t i = degraded; i < history.size(); ++i) {
+        CHECK(history[i].toLevel + 1 == history[i].fromLevel);
+        // Improving is slow: at least improveFrames samples between steps
+        if (i > degraded) {
+            CHECK(history[i].sample - history[i - 1].sample >= governor.GetSettings().improveFrames);
+        }
+    }
+}
+
+TEST_CASE("Noisy cost at the budget edge doesn't oscillate", "[FrameBudgetGovernor]")
+{
+    // Level 1 lands just under the upper threshold, level 0 just over: hysteresis must settle on 1
+    auto governor = EnabledGovernor(2.0f);
+    SimulatedScene scene;
+    scene.sceneMs = [](int) { return 2.5f; };   // 2.5 ms at level 0, 2.125 ms at level 1
+    scene.noiseMs = 0.4f;
+    scene.Run(governor, 0, 5000);
+
+    CHECK(governor.GetLevel() >= 1);
+    CHECK(scene.levelChanges <= 3);
+}
+
+TEST_CASE("A spike shorter than degradeFrames is ignored", "[FrameBudgetGovernor]")
+{
+    auto governor = EnabledGovernor(2.0f);
+    governor.GetSettings().smoothing = 1.0f;
+    SimulatedScene scene;
+    scene.sceneMs = [](int frame) { return frame >= 100 && frame < 104 ? 10.0f : 1.8f; };
+    scene.Run(governor, 0, 300);
+    CHECK(governor.GetLevel() == 0);
+    CHECK(scene.levelChanges == 0);
+}
+
+TEST_CASE("Samples right after a change are treated as settling", "[FrameBudgetGovernor]")
+{
+    auto governor = EnabledGovernor(1.0f);
+    governor.GetSettings().degradeFrames = 1;
+    governor.GetSettings().settleFrames = 4;
+
+    CHECK(governor.Update(5.0f) == 1);
+    CHECK(governor.GetLastAction() == Action::Degrade);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(governor.Update(5.0f) == 1);
+        CHECK(governor.GetLastAction() == Action::Settling);
+    }
+    CHECK(governor.Update(5.0f) == 2);
+
+    // Non-finite or negative readings (lost queries) are skipped
+    const auto samples = governor.GetSampleCount();
+    governor.Update(std::nanf(""));
+    governor.Update(-1.0f);
+    CHECK(governor.GetSampleCount() == samples);
+
+    // Disabling drops back to the user's configuration
+    governor.GetSettings().enabled = false;
+    CHECK(governor.Update(5.0f) == 0);
+    CHECK(governor.GetLastAction() == Action::Disabled);
+    CHECK(governor.GetHistory().empty());
+}
+
+TEST_CASE("Ladder ends clamp the level", "[FrameBudgetGovernor]")
+{
+    auto governor = EnabledGovernor(1.0f);
+    governor.GetSettings().degradeFrames = 1;
+    governor.GetSettings().settleFrames = 0;
+    for (int i = 0; i < 50; ++i) {
+        governor.Update(100.0f);
+    }
+    CHECK(governor.GetLevel() == governor.GetLevelCount() - 1);
+    CHECK(governor.GetKnobs().skipOptionalMerges);
+    CHECK(governor.GetHistory().size() == governor.GetLevelCount() - 1);
+
+    governor.SetLadder({ {}, { 0.5f, 0.5f, 1.0f, false } });
+    CHECK(governor.GetLevel() == 1);
+    governor.SetLadder({});
+    CHECK(governor.GetLevelCount() == 2);
+}
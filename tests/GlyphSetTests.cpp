@@ -0,0 +1,141 @@
+#include "GlyphSet.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using ThroughScope::GlyphSet;
+
+namespace
+{
+    void AppendUtf8(std::string& text, uint32_t codePoint)
+    {
+        if (codePoint < 0x80) {
+            text += char(codePoint);
+        } else if (codePoint < 0x800) {
+            text += char(0xC0 | (codePoint >> 6));
+            text += char(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            text += char(0xE0 | (codePoint >> 12));
+            text += char(0x80 | ((codePoint >> 6) & 0x3F));
+            text += char(0x80 | (codePoint & 0x3F));
+        } else {
+            text += char(0xF0 | (codePoint >> 18));
+            text += char(0x80 | ((codePoint >> 12) & 0x3F));
+            text += char(0x80 | ((codePoint >> 6) & 0x3F));
+            text += char(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    /// Mostly CJK ideographs / Hangul, some ASCII and arbitrary code points (no surrogates)
+    uint32_t RandomCodePoint(std::mt19937& rng)
+    {
+        uint32_t codePoint = 0;
+        switch (rng() % 6) {
+        case 0: codePoint = rng() % 0x80; break;
+        case 1: codePoint = 0x4E00 + rng() % 0x5200; break;
+        case 2: codePoint = 0xAC00 + rng() % 0x2BB0; break;
+        case 3: codePoint = 0x3400 + rng() % 0x19C0; break;
+        case 4: codePoint = 0xF900 + rng() % 0x200; break;
+        default: codePoint = rng() % 0x10FFFF; break;
+        }
+        return (codePoint >= 0xD800 && codePoint <= 0xDFFF) ? 'A' : codePoint;
+    }
+
+    std::set<uint32_t> ExpandRanges(const std::vector<uint32_t>& ranges)
+    {
+        std::set<uint32_t> codePoints;
+        for (size_t i = 0; i + 1 < ranges.size(); i += 2) {
+            for (uint32_t c = ranges[i]; c <= ranges[i + 1]; ++c) {
+                codePoints.insert(c);
+            }
+        }
+        return codePoints;
+    }
+}
+
+TEST_CASE("Random UTF-8 text collects exactly its dynamic code points", "[GlyphSet]")
+{
+    std::mt19937 rng(3);
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        GlyphSet glyphs;
+        std::set<uint32_t> reference;
+        std::string text;
+        const int length = int(rng() % 300);
+        for (int i = 0; i < length; ++i) {
+            const uint32_t codePoint = RandomCodePoint(rng);
+            AppendUtf8(text, codePoint);
+            if (GlyphSet::IsDynamic(codePoint)) {
+                reference.insert(codePoint);
+            }
+            if (rng() % 50 == 0) {
+                text += char(0x80 | (rng() % 0x40));  // Stray continuation byte
+            }
+        }
+
+        INFO("iteration " << iteration);
+        REQUIRE(glyphs.AddUtf8(text) == reference.size());
+        CHECK(glyphs.Size() == reference.size());
+        CHECK(glyphs.AddUtf8(text) == 0);
+
+        std::vector<uint32_t> ranges;
+        glyphs.AppendRanges(ranges);
+        REQUIRE(ranges.size() % 2 == 0);
+        for (size_t i = 0; i < ranges.size(); i += 2) {
+            CHECK(ranges[i] <= ranges[i + 1]);
+            if (i > 0) {
+                CHECK(ranges[i] > ranges[i - 1] + 1);  // Sorted and merged
+            }
+        }
+        CHECK(ExpandRanges(ranges) == reference);
+    }
+}
+
+TEST_CASE("Add reports only new dynamic code points", "[GlyphSet]")
+{
+    // Keyboard / IME input is fed one code point at a time; a true return requests an atlas rebuild
+    GlyphSet glyphs;
+    CHECK(glyphs.Add(0x4E2D));        // 中
+    CHECK_FALSE(glyphs.Add(0x4E2D));
+    CHECK(glyphs.Add(0xD55C));        // 한
+    CHECK_FALSE(glyphs.Add('A'));
+    CHECK_FALSE(glyphs.Add(0x3042));  // Hiragana: static range
+    CHECK(glyphs.Size() == 2);
+    CHECK(glyphs.Contains(0x4E2D));
+    CHECK_FALSE(glyphs.Contains('A'));
+
+    glyphs.Clear();
+    CHECK(glyphs.Size() == 0);
+    CHECK(glyphs.Add(0x4E2D));
+}
+
+TEST_CASE("Collecting a language table", "[GlyphSet][benchmark]")
+{
+    // ~6000 characters of ideographs over a 3000-character vocabulary, like a translated table
+    std::string table;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 6000; ++i) {
+        AppendUtf8(table, 0x4E00 + (rng() % 3000) * 3);
+    }
+
+    GlyphSet glyphs;
+    glyphs.AddUtf8(table);
+    std::vector<uint32_t> ranges;
+    glyphs.AppendRanges(ranges);
+    const size_t fullBlocks = (0x9FAF - 0x4E00 + 1) + (0xD7AF - 0xAC00 + 1);
+    WARN(glyphs.Size() << " glyphs in " << ranges.size() / 2 << " ranges instead of " << fullBlocks
+                       << " for the full CJK ideograph + Hangul blocks");
+    CHECK(glyphs.Size() < fullBlocks / 10);
+
+    BENCHMARK("collect and build ranges")
+    {
+        GlyphSet set;
+        set.AddUtf8(table);
+        std::vector<uint32_t> out;
+        set.AppendRanges(out);
+        return out.size();
+    };
+}
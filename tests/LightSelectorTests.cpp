@@ -0,0 +1,164 @@
+#include "LightSelector.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using ThroughScope::LightSelector;
+using Candidate = LightSelector::Candidate;
+
+namespace
+{
+    constexpr float kPi = 3.14159265358979f;
+
+    /// Frustum of a camera at eye looking along +Y (Z up), in the engine's plane convention
+    LightSelector::Frustum ScopeFrustum(const float eye[3], float horizontalFovDeg, float aspect, float nearZ, float farZ)
+    {
+        const float h = horizontalFovDeg * 0.5f * kPi / 180.0f;
+        const float v = std::atan(std::tan(h) / aspect);
+        const float normals[6][3] = {
+            { std::cos(h), std::sin(h), 0.0f },    // left
+            { -std::cos(h), std::sin(h), 0.0f },   // right
+            { 0.0f, std::sin(v), -std::cos(v) },   // top
+            { 0.0f, std::sin(v), std::cos(v) },    // bottom
+            { 0.0f, 1.0f, 0.0f },                  // near
+            { 0.0f, -1.0f, 0.0f },                 // far
+        };
+        LightSelector::Frustum frustum;
+        for (int i = 0; i < 6; ++i) {
+            auto& plane = frustum.planes[i];
+            for (int k = 0; k < 3; ++k) {
+                plane.normal[k] = normals[i][k];
+            }
+            plane.constant = normals[i][0] * eye[0] + normals[i][1] * eye[1] + normals[i][2] * eye[2];
+        }
+        frustum.planes[4].constant += nearZ;
+        frustum.planes[5].constant -= farZ;
+        return frustum;
+    }
+
+    Candidate Light(float x, float y, float z, float radius, float intensity)
+    {
+        Candidate light;
+        light.position[0] = x;
+        light.position[1] = y;
+        light.position[2] = z;
+        light.radius = radius;
+        light.intensity = intensity;
+        return light;
+    }
+
+    /// A loaded exterior: lights scattered around the player, a few ambient lights
+    std::vector<Candidate> SyntheticScene(size_t count)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> horizontal(-8000.0f, 8000.0f);
+        std::uniform_real_distribution<float> height(-200.0f, 1200.0f);
+        std::uniform_real_distribution<float> radius(100.0f, 900.0f);
+        std::uniform_real_distribution<float> intensity(0.2f, 3.0f);
+
+        std::vector<Candidate> lights;
+        lights.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            lights.push_back(Light(horizontal(rng), horizontal(rng), height(rng), radius(rng), intensity(rng)));
+            lights.back().alwaysKeep = i % 200 == 0;
+        }
+        return lights;
+    }
+}
+
+TEST_CASE("Light spheres are culled against the scope frustum", "[LightSelector]")
+{
+    const float eye[3] = { 0.0f, 0.0f, 0.0f };
+    const auto frustum = ScopeFrustum(eye, 10.0f, 16.0f / 9.0f, 5.0f, 10000.0f);
+
+    const float ahead[3] = { 0.0f, 1000.0f, 0.0f };
+    const float behind[3] = { 0.0f, -1000.0f, 0.0f };
+    const float beside[3] = { 500.0f, 1000.0f, 0.0f };   // ~26.6 degrees off axis
+    CHECK(LightSelector::SphereIntersects(frustum, ahead, 10.0f));
+    CHECK_FALSE(LightSelector::SphereIntersects(frustum, behind, 500.0f));
+    CHECK_FALSE(LightSelector::SphereIntersects(frustum, beside, 300.0f));
+    // Sphere reaching into the frustum from outside
+    CHECK(LightSelector::SphereIntersects(frustum, beside, 500.0f));
+    // Beyond the far plane
+    const float far[3] = { 0.0f, 12000.0f, 0.0f };
+    CHECK_FALSE(LightSelector::SphereIntersects(frustum, far, 1000.0f));
+    // Unbounded lights always pass; disabled planes are ignored
+    CHECK(LightSelector::SphereIntersects(frustum, behind, 0.0f));
+    auto open = frustum;
+    open.activeMask = 0;
+    CHECK(LightSelector::SphereIntersects(open, behind, 1.0f));
+}
+
+TEST_CASE("Solid angle of a light sphere", "[LightSelector]")
+{
+    const float eye[3] = { 0.0f, 0.0f, 0.0f };
+    const float near[3] = { 0.0f, 100.0f, 0.0f };
+    const float far[3] = { 0.0f, 10000.0f, 0.0f };
+
+    // Small-angle limit: pi r^2 / d^2
+    CHECK(LightSelector::SolidAngle(eye, far, 10.0f) == Approx(kPi * 100.0f / 1e8f).epsilon(1e-2));
+    CHECK(LightSelector::SolidAngle(eye, near, 100.0f * std::sin(kPi / 6.0f)) ==
+          Approx(2.0f * kPi * (1.0f - std::cos(kPi / 6.0f))).epsilon(1e-4));
+    CHECK(LightSelector::SolidAngle(eye, near, 200.0f) == Approx(4.0f * kPi));
+    CHECK(LightSelector::SolidAngle(eye, near, 0.0f) == 0.0f);
+}
+
+TEST_CASE("Selection keeps always-keep lights and the highest priorities within budget", "[LightSelector]")
+{
+    const float eye[3] = { 0.0f, 0.0f, 0.0f };
+    const auto frustum = ScopeFrustum(eye, 20.0f, 16.0f / 9.0f, 5.0f, 10000.0f);
+
+    std::vector<Candidate> lights = {
+        Light(0.0f, 2000.0f, 0.0f, 200.0f, 1.0f),    // 0: visible, mid
+        Light(0.0f, -2000.0f, 0.0f, 200.0f, 50.0f),  // 1: behind, culled despite intensity
+        Light(0.0f, 500.0f, 0.0f, 200.0f, 1.0f),     // 2: visible, close: highest bounded
+        Light(0.0f, 8000.0f, 0.0f, 200.0f, 1.0f),    // 3: visible, far: lowest
+        Light(0.0f, 3000.0f, 0.0f, 0.0f, 0.1f),      // 4: unbounded: ranks first
+        Light(0.0f, 0.0f, 0.0f, 0.0f, 0.0f),         // 5: ambient
+    };
+    lights[5].alwaysKeep = true;
+
+    LightSelector selector;
+    std::vector<uint32_t> selected;
+    const auto& stats = selector.Select(lights, &frustum, eye, 3, selected);
+    CHECK(selected == std::vector<uint32_t>{ 5, 4, 2, 0 });
+    CHECK(stats.candidates == 6);
+    CHECK(stats.culled == 1);
+    CHECK(stats.overBudget == 1);
+    CHECK(stats.selected == 4);
+
+    // Budget 0 only culls; no frustum only ranks
+    selector.Select(lights, &frustum, eye, 0, selected);
+    CHECK(selected == std::vector<uint32_t>{ 5, 4, 2, 0, 3 });
+    selector.Select(lights, nullptr, eye, 0, selected);
+    CHECK(selected.size() == lights.size());
+    CHECK(selector.GetStats().culled == 0);
+}
+
+TEST_CASE("Light selection cost over a synthetic cell", "[LightSelector][benchmark]")
+{
+    const float eye[3] = { 0.0f, 0.0f, 200.0f };
+    const auto frustum = ScopeFrustum(eye, 8.0f, 16.0f / 9.0f, 5.0f, 20000.0f);
+    const auto lights = SyntheticScene(2000);
+
+    LightSelector selector;
+    std::vector<uint32_t> selected;
+    const auto stats = selector.Select(lights, &frustum, eye, 32, selected);
+    CHECK(stats.candidates == 2000);
+    CHECK(stats.selected <= 32 + 10);
+    CHECK(stats.culled > 1500);
+    WARN("2000 lights: " << stats.culled << " culled, " << stats.overBudget << " over budget, "
+                         << stats.selected << " shaded");
+
+    BENCHMARK("cull and rank 2000 lights, budget 32")
+    {
+        return selector.Select(lights, &frustum, eye, 32, selected).selected;
+    };
+    BENCHMARK("rank 2000 lights without culling, budget 32")
+    {
+        return selector.Select(lights, nullptr, eye, 32, selected).selected;
+    };
+}
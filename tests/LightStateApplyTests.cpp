@@ -0,0 +1,469 @@
+#include <catch2/catch.hpp>
+
+#include "LightStateSnapshot.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+using ThroughScope::LightStateSnapshot;
+
+// LightBackupSystem needs CommonLib, so these drive LightStateSnapshot the way it does, on stand-in
+// lights whose light and camera references are counted like NiPointer, and compare it with the
+// full re-apply it replaced (an array of LightStateBackup, 20 stores per light per frame).
+
+namespace
+{
+    /// NiRefObject: the reference count NiPointer updates atomically
+    struct RefCounted
+    {
+        std::atomic<uint32_t> refCount{ 0 };
+    };
+
+    /// NiPointer: attach on copy, detach on reassignment and destruction
+    template <class T>
+    class Ref
+    {
+    public:
+        Ref() = default;
+        explicit Ref(T* ptr) : m_ptr(ptr) { Attach(); }
+        Ref(const Ref& other) : m_ptr(other.m_ptr) { Attach(); }
+        Ref(Ref&& other) noexcept : m_ptr(other.m_ptr) { other.m_ptr = nullptr; }
+        ~Ref() { Detach(); }
+
+        Ref& operator=(const Ref& other)
+        {
+            if (this != &other) {
+                Detach();
+                m_ptr = other.m_ptr;
+                Attach();
+            }
+            return *this;
+        }
+
+        T* get() const { return m_ptr; }
+        T* operator->() const { return m_ptr; }
+
+    private:
+        void Attach()
+        {
+            if (m_ptr) {
+                m_ptr->refCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        void Detach()
+        {
+            if (m_ptr) {
+                m_ptr->refCount.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+
+        T* m_ptr = nullptr;
+    };
+
+    struct FakeCamera : RefCounted
+    {};
+
+    /// The BSLight fields the scope pass overrides
+    struct FakeLight : RefCounted
+    {
+        uint32_t frustumCull = 0;
+        float lodDimmer = 1.0f;
+        Ref<FakeCamera> camera;
+        void* cullingProcess = nullptr;
+        bool occluded = false, temporary = false, dynamic = false, lodFade = false;
+        bool affectLand = true, affectWater = true, ignoreRoughness = false, ignoreRim = false, attenuationOnly = false;
+    };
+
+    /// ShadowSceneNode's light list over synthetic lights: 10% culled, 1 in 7 occluded, 1 in 5 with a
+    /// shadow camera, 1 in 13 without a culling process
+    struct Scene
+    {
+        explicit Scene(size_t count) : cameras(count / 5 + 1), lights(count)
+        {
+            for (size_t i = 0; i < count; ++i) {
+                auto& light = lights[i];
+                light.frustumCull = i % 10 == 0 ? 255u : 0u;
+                light.lodDimmer = 0.5f + float(i % 3) * 0.25f;
+                light.occluded = i % 7 == 0;
+                light.dynamic = i % 4 == 0;
+                light.cullingProcess = i % 13 == 0 ? nullptr : &cullingProcess;
+                if (i % 5 == 0) {
+                    light.camera = Ref<FakeCamera>(&cameras[i / 5]);
+                }
+                list.emplace_back(&light);
+            }
+        }
+
+        int cullingProcess = 0;
+        std::vector<FakeCamera> cameras;  // Outlives the lights that reference them
+        std::vector<FakeLight> lights;
+        std::vector<Ref<FakeLight>> list;
+    };
+
+    /// Every field the scope pass can touch, for comparing scenes
+    struct Observed
+    {
+        uint32_t frustumCull;
+        float lodDimmer;
+        const void* camera;
+        const void* cullingProcess;
+        bool flags[9];
+
+        bool operator==(const Observed& other) const
+        {
+            if (frustumCull != other.frustumCull || lodDimmer != other.lodDimmer || camera != other.camera ||
+                cullingProcess != other.cullingProcess) {
+                return false;
+            }
+            for (int i = 0; i < 9; ++i) {
+                if (flags[i] != other.flags[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    std::vector<Observed> Observe(const Scene& scene)
+    {
+        std::vector<Observed> observed;
+        for (const auto& light : scene.lights) {
+            observed.push_back({ light.frustumCull, light.lodDimmer, light.camera.get(), light.cullingProcess,
+                { light.occluded, light.temporary, light.dynamic, light.lodFade, light.affectLand, light.affectWater,
+                    light.ignoreRoughness, light.ignoreRim, light.attenuationOnly } });
+        }
+        return observed;
+    }
+
+    std::vector<uint32_t> RefCounts(const Scene& scene)
+    {
+        std::vector<uint32_t> counts;
+        for (const auto& light : scene.lights) {
+            counts.push_back(light.refCount.load());
+        }
+        for (const auto& camera : scene.cameras) {
+            counts.push_back(camera.refCount.load());
+        }
+        return counts;
+    }
+
+    /// The previous LightBackupSystem: LightStateBackup per light, ApplySingleLightState /
+    /// RestoreSingleLightState on every light
+    struct FullReapply
+    {
+        struct LightStateBackup
+        {
+            Ref<FakeLight> light;
+            uint32_t frustumCull;
+            bool occluded;
+            bool temporary;
+            bool dynamic;
+            float lodDimmer;
+            Ref<FakeCamera> camera;
+            void* cullingProcess;
+        };
+
+        std::vector<LightStateBackup> backups;
+
+        void Backup(const Scene& scene)
+        {
+            backups.clear();
+            for (const auto& light : scene.list) {
+                LightStateBackup backup{};
+                backup.light = light;
+                backup.frustumCull = light->frustumCull;
+                backup.occluded = light->occluded;
+                backup.temporary = light->temporary;
+                backup.dynamic = light->dynamic;
+                backup.lodDimmer = light->lodDimmer;
+                backup.camera = light->camera;
+                backup.cullingProcess = light->cullingProcess;
+                backups.push_back(backup);
+            }
+        }
+
+        void Apply(void* fallbackCullingProcess)
+        {
+            for (const auto& backup : backups) {
+                auto light = backup.light.get();
+                light->frustumCull = 0;
+                light->occluded = false;
+                light->temporary = backup.temporary;
+                light->lodFade = false;
+                light->lodDimmer = backup.lodDimmer;
+                light->dynamic = backup.dynamic;
+                light->affectLand = true;
+                light->affectWater = true;
+                light->ignoreRoughness = false;
+                light->ignoreRim = false;
+                light->attenuationOnly = false;
+                light->camera = backup.camera;
+                light->cullingProcess = backup.cullingProcess ? backup.cullingProcess : fallbackCullingProcess;
+            }
+        }
+
+        void Restore()
+        {
+            for (const auto& backup : backups) {
+                auto light = backup.light.get();
+                light->frustumCull = backup.frustumCull;
+                light->occluded = backup.occluded;
+                light->temporary = backup.temporary;
+                light->lodDimmer = backup.lodDimmer;
+                light->camera = backup.camera;
+                light->cullingProcess = backup.cullingProcess;
+                light->dynamic = backup.dynamic;
+            }
+        }
+
+        uint32_t Frame(const Scene& scene, void* fallbackCullingProcess)
+        {
+            Backup(scene);
+            Apply(fallbackCullingProcess);
+            Restore();
+            return static_cast<uint32_t>(backups.size() * 20);
+        }
+    };
+
+    /// LightBackupSystem's snapshot path over FakeLight
+    struct DeltaApply
+    {
+        std::vector<Ref<FakeLight>> lights;
+        std::vector<Ref<FakeCamera>> cameras;
+        LightStateSnapshot snapshot;
+
+        static LightStateSnapshot::State ReadLightState(const FakeLight* light)
+        {
+            LightStateSnapshot::State state;
+            state.frustumCull = light->frustumCull;
+            state.lodDimmer = light->lodDimmer;
+            state.camera = light->camera.get();
+            state.cullingProcess = light->cullingProcess;
+            state.Set(LightStateSnapshot::Occluded, light->occluded);
+            state.Set(LightStateSnapshot::Temporary, light->temporary);
+            state.Set(LightStateSnapshot::Dynamic, light->dynamic);
+            state.Set(LightStateSnapshot::LODFade, light->lodFade);
+            state.Set(LightStateSnapshot::AffectLand, light->affectLand);
+            state.Set(LightStateSnapshot::AffectWater, light->affectWater);
+            state.Set(LightStateSnapshot::IgnoreRoughness, light->ignoreRoughness);
+            state.Set(LightStateSnapshot::IgnoreRim, light->ignoreRim);
+            state.Set(LightStateSnapshot::AttenuationOnly, light->attenuationOnly);
+            return state;
+        }
+
+        void WriteLightState(size_t index, const LightStateSnapshot::State& state, uint32_t mask)
+        {
+            auto light = lights[index].get();
+            if (mask & LightStateSnapshot::FrustumCull) {
+                light->frustumCull = state.frustumCull;
+            }
+            if (mask & LightStateSnapshot::Occluded) {
+                light->occluded = state.Has(LightStateSnapshot::Occluded);
+            }
+            if (mask & LightStateSnapshot::Temporary) {
+                light->temporary = state.Has(LightStateSnapshot::Temporary);
+            }
+            if (mask & LightStateSnapshot::Dynamic) {
+                light->dynamic = state.Has(LightStateSnapshot::Dynamic);
+            }
+            if (mask & LightStateSnapshot::LODFade) {
+                light->lodFade = state.Has(LightStateSnapshot::LODFade);
+            }
+            if (mask & LightStateSnapshot::AffectLand) {
+                light->affectLand = state.Has(LightStateSnapshot::AffectLand);
+            }
+            if (mask & LightStateSnapshot::AffectWater) {
+                light->affectWater = state.Has(LightStateSnapshot::AffectWater);
+            }
+            if (mask & LightStateSnapshot::IgnoreRoughness) {
+                light->ignoreRoughness = state.Has(LightStateSnapshot::IgnoreRoughness);
+            }
+            if (mask & LightStateSnapshot::IgnoreRim) {
+                light->ignoreRim = state.Has(LightStateSnapshot::IgnoreRim);
+            }
+            if (mask & LightStateSnapshot::AttenuationOnly) {
+                light->attenuationOnly = state.Has(LightStateSnapshot::AttenuationOnly);
+            }
+            if (mask & LightStateSnapshot::LODDimmer) {
+                light->lodDimmer = state.lodDimmer;
+            }
+            if (mask & LightStateSnapshot::Camera) {
+                light->camera = cameras[index];
+            }
+            if (mask & LightStateSnapshot::CullingProcess) {
+                light->cullingProcess = const_cast<void*>(state.cullingProcess);
+            }
+        }
+
+        void Backup(const Scene& scene)
+        {
+            const size_t count = scene.list.size();
+            lights.resize(count);
+            cameras.resize(count);
+            snapshot.Resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                auto light = scene.list[i].get();
+                if (lights[i].get() != light) {
+                    lights[i] = scene.list[i];
+                }
+                if (cameras[i].get() != light->camera.get()) {
+                    cameras[i] = light->camera;
+                }
+                snapshot.Store(i, ReadLightState(light));
+            }
+            snapshot.BeginFrame();
+        }
+
+        void Apply(void* fallbackCullingProcess)
+        {
+            snapshot.BuildApplyMasks(fallbackCullingProcess);
+            for (uint32_t index : snapshot.GetChangedLights()) {
+                WriteLightState(index, snapshot.GetApplyTarget(index), snapshot.GetApplyMask(index));
+            }
+        }
+
+        void Restore()
+        {
+            for (size_t i = 0; i < lights.size(); ++i) {
+                const uint32_t mask = snapshot.BuildRestoreMask(i, ReadLightState(lights[i].get()));
+                if (mask) {
+                    WriteLightState(i, snapshot.Load(i), mask);
+                }
+            }
+        }
+
+        uint32_t Frame(const Scene& scene, void* fallbackCullingProcess)
+        {
+            Backup(scene);
+            Apply(fallbackCullingProcess);
+            Restore();
+            const auto& stats = snapshot.GetStats();
+            return stats.appliedFields + stats.restoredFields;
+        }
+    };
+}
+
+TEST_CASE("Field masks cover exactly the fields that differ", "[LightStateSnapshot]")
+{
+    LightStateSnapshot::State a;
+    a.frustumCull = 255;
+    a.lodDimmer = 0.5f;
+    a.Set(LightStateSnapshot::Occluded, true);
+    a.Set(LightStateSnapshot::AffectLand, true);
+
+    CHECK(LightStateSnapshot::Diff(a, a) == 0);
+
+    auto b = a;
+    b.frustumCull = 0;
+    b.Set(LightStateSnapshot::Occluded, false);
+    b.camera = &b;
+    CHECK(LightStateSnapshot::Diff(a, b) ==
+          (LightStateSnapshot::FrustumCull | LightStateSnapshot::Occluded | LightStateSnapshot::Camera));
+    CHECK(LightStateSnapshot::CountFields(LightStateSnapshot::Diff(a, b)) == 3);
+    CHECK(LightStateSnapshot::CountFields(LightStateSnapshot::kAllFields) == 13);
+}
+
+TEST_CASE("Delta apply matches the full re-apply and restores the main-pass state", "[LightStateSnapshot]")
+{
+    int fallback = 0;
+    Scene scene(200);
+    const auto original = Observe(scene);
+
+    FullReapply full;
+    full.Backup(scene);
+    full.Apply(&fallback);
+    const auto fullApplied = Observe(scene);
+    full.Restore();
+    REQUIRE(Observe(scene) == original);
+
+    DeltaApply delta;
+    delta.Backup(scene);
+    delta.Apply(&fallback);
+    const auto deltaApplied = Observe(scene);
+    for (size_t i = 0; i < original.size(); ++i) {
+        INFO("light " << i);
+        CHECK(deltaApplied[i] == fullApplied[i]);
+    }
+
+    // Only culled, occluded and fallback-process lights change
+    uint32_t expected = 0;
+    for (size_t i = 0; i < original.size(); ++i) {
+        if (i % 10 == 0 || i % 7 == 0 || i % 13 == 0) {
+            ++expected;
+        }
+    }
+    CHECK(delta.snapshot.GetStats().appliedLights == expected);
+
+    delta.Restore();
+    CHECK(Observe(scene) == original);
+    // Restore writes back the cull, occlusion and culling-process changes, not the forced LODFade/affect flags
+    CHECK(delta.snapshot.GetStats().restoredLights == expected);
+}
+
+TEST_CASE("Culled lights take 255 in one write and engine changes during the pass are restored", "[LightStateSnapshot]")
+{
+    Scene scene(50);
+    const auto original = Observe(scene);
+
+    DeltaApply delta;
+    delta.Backup(scene);
+    delta.snapshot.MarkCulled(10);  // Culled in the main pass too: nothing to write
+    delta.snapshot.MarkCulled(11);  // Visible in the main pass: one write, straight to 255
+    delta.Apply(nullptr);
+
+    CHECK(scene.lights[10].frustumCull == 255u);
+    CHECK(scene.lights[11].frustumCull == 255u);
+    CHECK(scene.lights[20].frustumCull == 0u);
+    CHECK((delta.snapshot.GetApplyMask(10) & LightStateSnapshot::FrustumCull) == 0);
+    CHECK(delta.snapshot.GetApplyMask(11) == LightStateSnapshot::FrustumCull);
+    // No fallback culling process: lights without one keep none
+    CHECK(scene.lights[13].cullingProcess == nullptr);
+
+    // The scope pass itself re-culls and re-occludes lights and swaps a shadow camera
+    FakeCamera passCamera;
+    scene.lights[3].frustumCull = 7;
+    scene.lights[3].occluded = true;
+    scene.lights[5].camera = Ref<FakeCamera>(&passCamera);
+    scene.lights[6].lodDimmer = 0.0f;
+
+    delta.Restore();
+    CHECK(Observe(scene) == original);
+    CHECK(passCamera.refCount.load() == 0);
+}
+
+TEST_CASE("Light apply/restore: full re-apply vs snapshot delta", "[LightStateSnapshot][benchmark]")
+{
+    int fallback = 0;
+    Scene fullScene(2000);
+    Scene deltaScene(2000);
+    const auto fullOriginal = Observe(fullScene);
+    const auto deltaOriginal = Observe(deltaScene);
+
+    FullReapply full;
+    DeltaApply delta;
+    const uint32_t fullWrites = full.Frame(fullScene, &fallback);
+    const uint32_t deltaWrites = delta.Frame(deltaScene, &fallback);
+    CHECK(Observe(fullScene) == fullOriginal);
+    CHECK(Observe(deltaScene) == deltaOriginal);
+
+    // An unchanged light list costs the delta path no reference-count updates
+    delta.Frame(deltaScene, &fallback);
+    std::vector<uint32_t> heldCounts = RefCounts(deltaScene);
+    delta.Frame(deltaScene, &fallback);
+    CHECK(RefCounts(deltaScene) == heldCounts);
+
+    CHECK(deltaWrites * 20 < fullWrites);
+    WARN("2000 lights, field writes per frame: full " << fullWrites << ", delta " << deltaWrites << " ("
+                                                       << delta.snapshot.GetStats().appliedLights << " lights applied, "
+                                                       << delta.snapshot.GetStats().restoredLights << " restored)");
+
+    BENCHMARK("full re-apply of 2000 lights")
+    {
+        return full.Frame(fullScene, &fallback);
+    };
+    BENCHMARK("snapshot delta of 2000 lights")
+    {
+        return delta.Frame(deltaScene, &fallback);
+    };
+}
@@ -0,0 +1,126 @@
+#include "MergeBatching.h"
+
+#include <catch2/catch.hpp>
+
+#include <set>
+#include <vector>
+
+namespace MergeBatching = ThroughScope::MergeBatching;
+
+namespace
+{
+    struct FakeBackup
+    {
+        int rtIndex;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    /// Records what RenderTargetMerger issues per batch: one OMSetRenderTargets and one Draw
+    struct RecordingContext
+    {
+        int draws = 0;
+        int renderTargetBinds = 0;
+        uint32_t maxBoundTargets = 0;
+        std::multiset<int> restored;
+        bool mixedSizes = false;
+
+        void MergeBatch(FakeBackup** batch, uint32_t count)
+        {
+            ++renderTargetBinds;
+            maxBoundTargets = std::max(maxBoundTargets, count);
+            for (uint32_t i = 0; i < count; ++i) {
+                restored.insert(batch[i]->rtIndex);
+                mixedSizes |= batch[i]->width != batch[0]->width || batch[i]->height != batch[0]->height;
+            }
+            ++draws;
+        }
+    };
+
+    constexpr size_t kMaxMRTBatch = 8;       // D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT
+    constexpr size_t kMaxHalfResBatch = 2;   // HalfResMRTMergePS outputs
+
+    /// The merge loop of RenderTargetMerger::MergeGrouped on the recording context
+    void RunGroupedMerge(std::vector<FakeBackup>& backups, RecordingContext& context)
+    {
+        std::vector<FakeBackup*> fullRes;
+        std::vector<FakeBackup*> halfRes;
+        for (auto& backup : backups) {
+            (backup.rtIndex == 9 || backup.rtIndex == 28 ? halfRes : fullRes).push_back(&backup);
+        }
+        MergeBatching::SortBySize(fullRes);
+        MergeBatching::SortBySize(halfRes);
+        MergeBatching::ForEachBatch(fullRes, kMaxMRTBatch, [&](FakeBackup** batch, uint32_t count) { context.MergeBatch(batch, count); });
+        MergeBatching::ForEachBatch(halfRes, kMaxHalfResBatch, [&](FakeBackup** batch, uint32_t count) { context.MergeBatch(batch, count); });
+    }
+
+    std::vector<FakeBackup> DefaultBackups(uint32_t width, uint32_t height)
+    {
+        std::vector<FakeBackup> backups;
+        for (int rtIndex : { 9, 20, 22, 23, 24, 28, 29, 39, 57, 58, 59 }) {
+            const bool halfRes = rtIndex == 9 || rtIndex == 28;
+            backups.push_back({ rtIndex, halfRes ? width / 2 : width, halfRes ? height / 2 : height });
+        }
+        return backups;
+    }
+}
+
+TEST_CASE("Default merge set needs three full-screen draws instead of eleven", "[MergeBatching]")
+{
+    auto backups = DefaultBackups(2560, 1440);
+
+    RecordingContext perTarget;
+    for (auto& backup : backups) {
+        FakeBackup* single = &backup;
+        perTarget.MergeBatch(&single, 1);
+    }
+    REQUIRE(perTarget.draws == 11);
+
+    RecordingContext grouped;
+    RunGroupedMerge(backups, grouped);
+    CHECK(grouped.draws == 3);
+    CHECK(grouped.renderTargetBinds == 3);
+    CHECK(grouped.maxBoundTargets == kMaxMRTBatch);
+    CHECK_FALSE(grouped.mixedSizes);
+
+    // Every target restored exactly once
+    CHECK(grouped.restored == perTarget.restored);
+    for (const auto& backup : backups) {
+        CHECK(grouped.restored.count(backup.rtIndex) == 1);
+    }
+}
+
+TEST_CASE("Targets of different sizes never share a draw", "[MergeBatching]")
+{
+    auto backups = DefaultBackups(1920, 1080);
+    backups[7].width = 960;  // RT_39 at a reduced size
+    backups[7].height = 540;
+
+    RecordingContext grouped;
+    RunGroupedMerge(backups, grouped);
+    CHECK_FALSE(grouped.mixedSizes);
+    CHECK(grouped.restored.size() == backups.size());
+    // 8 full-res in one draw, RT_39 alone, half-res pair in one draw
+    CHECK(grouped.draws == 3);
+}
+
+TEST_CASE("Batches keep the configured order within a size", "[MergeBatching]")
+{
+    std::vector<FakeBackup> backups = { { 58, 100, 100 }, { 20, 50, 50 }, { 59, 100, 100 }, { 22, 50, 50 } };
+    std::vector<FakeBackup*> group;
+    for (auto& backup : backups) {
+        group.push_back(&backup);
+    }
+    MergeBatching::SortBySize(group);
+
+    std::vector<std::vector<int>> batches;
+    MergeBatching::ForEachBatch(group, 8, [&](FakeBackup** batch, uint32_t count) {
+        batches.emplace_back();
+        for (uint32_t i = 0; i < count; ++i) {
+            batches.back().push_back(batch[i]->rtIndex);
+        }
+    });
+    REQUIRE(batches.size() == 2);
+    CHECK(batches[0] == std::vector<int>{ 20, 22 });
+    CHECK(batches[1] == std::vector<int>{ 58, 59 });
+}
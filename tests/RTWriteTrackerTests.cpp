@@ -0,0 +1,233 @@
+#include "RTWriteTracker.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <vector>
+
+using ThroughScope::RTWriteTracker;
+
+namespace
+{
+    /**
+     * RenderTargetMerger's use of the tracker with the D3D work replaced by integers: each render
+     * target holds a value, the backup copies it, the scope pass overwrites it and the merge
+     * restores the backup (the main frame's content must come back for every written target).
+     */
+    struct MergerModel
+    {
+        RTWriteTracker tracker;
+        std::vector<int> targets;
+        std::vector<int> backups;
+        std::vector<bool> backupValid;
+        int upFrontBackups = 0;
+        int lateBackups = 0;
+        int merges = 0;
+
+        explicit MergerModel(size_t count) :
+            targets(count), backups(count), backupValid(count)
+        {
+        }
+
+        void Backup(size_t slot)
+        {
+            backups[slot] = targets[slot];
+            backupValid[slot] = true;
+        }
+
+        /// RenderTargetMerger::BackupRenderTargets
+        void BeginScopeFrame(uint64_t enabledMask)
+        {
+            std::fill(backupValid.begin(), backupValid.end(), false);
+            tracker.BeginFrame(enabledMask);
+            for (size_t slot = 0; slot < targets.size(); ++slot) {
+                if ((enabledMask >> slot & 1) && tracker.ShouldBackup(slot)) {
+                    Backup(slot);
+                    tracker.MarkBackedUp(slot);
+                    ++upFrontBackups;
+                }
+            }
+        }
+
+        /// A scope-pass draw / clear / copy into slot (RenderTargetMerger::NotifyScopeWrite, then the write)
+        void ScopeWrite(size_t slot, int value)
+        {
+            if (tracker.MarkWritten(slot)) {
+                Backup(slot);
+                ++lateBackups;
+            }
+            targets[slot] = value;
+        }
+
+        /// RenderTargetMerger::MergeRenderTargets + FinishWriteTracking
+        void EndScopeFrame()
+        {
+            for (size_t slot = 0; slot < targets.size(); ++slot) {
+                if (tracker.WasWritten(slot)) {
+                    REQUIRE(backupValid[slot]);
+                    targets[slot] = backups[slot];
+                    ++merges;
+                }
+            }
+            tracker.EndFrame();
+        }
+    };
+}
+
+TEST_CASE("A predicted write is backed up up front", "[RTWriteTracker]")
+{
+    MergerModel model(4);
+    // Warm-up frames back up every enabled target until the written set is stable
+    for (int frame = 0; frame < 2; ++frame) {
+        model.BeginScopeFrame(0b1111);
+        model.ScopeWrite(2, -1);
+        model.EndScopeFrame();
+    }
+    CHECK(model.upFrontBackups == 8);
+    CHECK(model.lateBackups == 0);
+    REQUIRE_FALSE(model.tracker.IsWarmingUp());
+
+    // Steady state: only target 2 is predicted
+    model.upFrontBackups = 0;
+    model.BeginScopeFrame(0b1111);
+    CHECK(model.tracker.ShouldBackup(2));
+    CHECK_FALSE(model.tracker.ShouldBackup(0));
+    CHECK(model.upFrontBackups == 1);
+    CHECK_FALSE(model.tracker.MarkWritten(2));   // Already backed up: no late backup
+    model.EndScopeFrame();
+    CHECK(model.lateBackups == 0);
+    CHECK(model.tracker.GetStats(2).lateBackups == 0);
+}
+
+TEST_CASE("The first write to an unpredicted target backs it up before it lands", "[RTWriteTracker]")
+{
+    MergerModel model(4);
+    model.targets = { 10, 11, 12, 13 };
+    model.BeginScopeFrame(0b1111);
+    model.ScopeWrite(1, -1);
+    model.EndScopeFrame();
+    model.BeginScopeFrame(0b1111);
+    model.ScopeWrite(1, -1);
+    model.EndScopeFrame();
+    REQUIRE_FALSE(model.tracker.IsWarmingUp());
+
+    // Target 3 was not written last frame, so it was not backed up
+    model.BeginScopeFrame(0b1111);
+    CHECK_FALSE(model.backupValid[3]);
+    model.ScopeWrite(3, -3);
+    CHECK(model.lateBackups == 1);
+    CHECK(model.backups[3] == 13);   // The main frame's content, not the scope write
+    model.ScopeWrite(3, -4);
+    CHECK(model.lateBackups == 1);   // Only the first write backs up
+    model.ScopeWrite(1, -1);
+    model.EndScopeFrame();
+
+    CHECK(model.targets == std::vector<int>{ 10, 11, 12, 13 });
+    CHECK(model.tracker.GetStats(3).lateBackups == 1);
+    // The written set moved: the next frame backs up everything again
+    CHECK(model.tracker.IsWarmingUp());
+    CHECK(model.tracker.GetChangedFrameCount() == 2);
+
+    // Disabled targets are never tracked
+    model.BeginScopeFrame(0b0111);
+    CHECK_FALSE(model.tracker.MarkWritten(3));
+    CHECK_FALSE(model.tracker.WasWritten(3));
+    model.EndScopeFrame();
+}
+
+TEST_CASE("Targets the scope pass does not write are neither backed up nor merged", "[RTWriteTracker]")
+{
+    MergerModel model(3);
+    for (int frame = 0; frame < 10; ++frame) {
+        model.BeginScopeFrame(0b111);
+        model.ScopeWrite(0, -frame);
+        model.EndScopeFrame();
+    }
+    CHECK(model.merges == 10);
+    // Slots 1 and 2 were backed up only on the two warm-up frames, and never merged
+    CHECK(model.upFrontBackups == 3 * 2 + 8);
+    CHECK(model.tracker.GetStats(1).frames == 10);
+    CHECK(model.tracker.GetStats(1).skipped == 8);
+    CHECK(model.tracker.GetStats(0).skipped == 0);
+
+    model.BeginScopeFrame(0b111);
+    CHECK_FALSE(model.tracker.WasWritten(1));
+    CHECK_FALSE(model.tracker.WasWritten(0));   // Not written yet this frame
+    model.EndScopeFrame();
+}
+
+TEST_CASE("Reset and frame boundaries clear the write set", "[RTWriteTracker]")
+{
+    RTWriteTracker tracker;
+    tracker.BeginFrame(0b11);
+    CHECK(tracker.MarkWritten(0));
+    tracker.EndFrame();
+    CHECK(tracker.WasWritten(0));   // Still readable between the scope pass and the next frame
+
+    tracker.BeginFrame(0b11);
+    CHECK_FALSE(tracker.WasWritten(0));
+    tracker.EndFrame();
+    CHECK(tracker.IsWarmingUp());   // The written set changed ({0} -> {})
+
+    tracker.BeginFrame(0b11);
+    tracker.EndFrame();
+    CHECK_FALSE(tracker.IsWarmingUp());
+    CHECK_FALSE(tracker.ShouldBackup(0));
+
+    // Writes outside a scope frame are ignored
+    CHECK_FALSE(tracker.MarkWritten(0));
+
+    // Reset (tracking toggled, device lost): warm up again with no stale prediction
+    tracker.Reset();
+    CHECK(tracker.IsWarmingUp());
+    CHECK_FALSE(tracker.MarkWritten(1));
+    tracker.BeginFrame(0b11);
+    CHECK(tracker.ShouldBackup(0));
+    CHECK(tracker.ShouldBackup(1));
+    tracker.EndFrame();
+
+    // Enabling another target invalidates the prediction
+    tracker.BeginFrame(0b11);
+    tracker.EndFrame();
+    REQUIRE_FALSE(tracker.IsWarmingUp());
+    tracker.BeginFrame(0b111);
+    CHECK(tracker.IsWarmingUp());
+    CHECK(tracker.ShouldBackup(2));
+    tracker.EndFrame();
+}
+
+TEST_CASE("Random write sets never corrupt the merged frame", "[RTWriteTracker]")
+{
+    constexpr size_t kTargets = 12;
+    MergerModel model(kTargets);
+    std::mt19937 rng(7);
+    for (int frame = 0; frame < 2000; ++frame) {
+        // Main-frame content of this frame
+        for (size_t slot = 0; slot < kTargets; ++slot) {
+            model.targets[slot] = frame * 100 + int(slot);
+        }
+        const std::vector<int> mainFrame = model.targets;
+
+        // Mostly stable write sets with occasional changes, like weapon / weather switches
+        const uint64_t enabled = (rng() % 50 == 0) ? (rng() & 0xFFF) : 0xFFF;
+        model.BeginScopeFrame(enabled);
+        const uint32_t pattern = (rng() % 10 == 0) ? uint32_t(rng()) : 0x0A5u;
+        for (int write = 0; write < 20; ++write) {
+            const size_t slot = rng() % kTargets;
+            if (pattern >> slot & 1) {
+                model.ScopeWrite(slot, -1);
+            }
+        }
+        model.EndScopeFrame();
+
+        INFO("frame " << frame);
+        // Enabled targets are restored; a disabled one keeps the scope write (the merger ignores it)
+        for (size_t slot = 0; slot < kTargets; ++slot) {
+            if (enabled >> slot & 1) {
+                REQUIRE(model.targets[slot] == mainFrame[slot]);
+            }
+        }
+    }
+    WARN("2000 frames: " << model.upFrontBackups << " up-front backups, " << model.lateBackups << " late backups, "
+                         << model.merges << " merges for " << 2000 * kTargets << " target-frames");
+}
@@ -0,0 +1,171 @@
+#include "ScopeAmortizationPolicy.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+using ThroughScope::ScopeAmortizationPolicy;
+using Decision = ScopeAmortizationPolicy::Decision;
+using Reason = ScopeAmortizationPolicy::Reason;
+
+namespace
+{
+    constexpr float kDegToRad = 0.017453292519943295f;
+
+    /// Camera yawed about Z by yawDeg, at x along the world X axis
+    ScopeAmortizationPolicy::FrameInput Frame(float yawDeg, float x = 0.0f, float fovDeg = 20.0f)
+    {
+        const float c = std::cos(yawDeg * kDegToRad);
+        const float s = std::sin(yawDeg * kDegToRad);
+        ScopeAmortizationPolicy::FrameInput input;
+        input.pose.rotation[0][0] = c;
+        input.pose.rotation[0][1] = -s;
+        input.pose.rotation[1][0] = s;
+        input.pose.rotation[1][1] = c;
+        input.pose.position[0] = x;
+        input.pose.fovDeg = fovDeg;
+        return input;
+    }
+
+    ScopeAmortizationPolicy EnabledPolicy()
+    {
+        ScopeAmortizationPolicy policy;
+        policy.GetSettings().enabled = true;
+        return policy;
+    }
+
+    std::vector<Reason> Run(ScopeAmortizationPolicy& policy, const std::vector<ScopeAmortizationPolicy::FrameInput>& frames)
+    {
+        std::vector<Reason> reasons;
+        for (const auto& frame : frames) {
+            policy.Decide(frame);
+            reasons.push_back(policy.GetLastReason());
+        }
+        return reasons;
+    }
+}
+
+TEST_CASE("Disabled policy always renders", "[ScopeAmortizationPolicy]")
+{
+    ScopeAmortizationPolicy policy;
+    for (int frame = 0; frame < 10; ++frame) {
+        CHECK(policy.Decide(Frame(0.0f)) == Decision::Render);
+        CHECK(policy.GetLastReason() == Reason::Disabled);
+    }
+    CHECK(policy.GetStats().reprojected == 0);
+}
+
+TEST_CASE("A steady camera alternates render and reproject", "[ScopeAmortizationPolicy]")
+{
+    auto policy = EnabledPolicy();
+    std::vector<ScopeAmortizationPolicy::FrameInput> frames(9, Frame(0.0f));
+    const auto reasons = Run(policy, frames);
+
+    CHECK(reasons[0] == Reason::NoHistory);
+    for (size_t i = 1; i < reasons.size(); ++i) {
+        CHECK(reasons[i] == (i % 2 ? Reason::Steady : Reason::Schedule));
+    }
+    CHECK(policy.GetStats().frames == 9);
+    CHECK(policy.GetStats().reprojected == 4);
+
+    // A longer interval reprojects renderInterval - 1 frames in a row
+    auto sparse = EnabledPolicy();
+    sparse.GetSettings().renderInterval = 4;
+    const auto sparseReasons = Run(sparse, std::vector<ScopeAmortizationPolicy::FrameInput>(9, Frame(0.0f)));
+    CHECK(sparseReasons == std::vector<Reason>{ Reason::NoHistory, Reason::Steady, Reason::Steady, Reason::Steady,
+                                                Reason::Schedule, Reason::Steady, Reason::Steady, Reason::Steady,
+                                                Reason::Schedule });
+}
+
+TEST_CASE("Motion, zoom and flash fall back to rendering with a cooldown", "[ScopeAmortizationPolicy]")
+{
+    SECTION("Per-frame rotation")
+    {
+        auto policy = EnabledPolicy();
+        const auto reasons = Run(policy, { Frame(0.0f), Frame(0.0f), Frame(0.1f), Frame(0.1f), Frame(0.1f), Frame(0.1f) });
+        CHECK(reasons == std::vector<Reason>{ Reason::NoHistory, Reason::Steady, Reason::Motion, Reason::Cooldown,
+                                              Reason::Cooldown, Reason::Steady });
+    }
+
+    SECTION("Slow drift accumulated since the last render")
+    {
+        auto policy = EnabledPolicy();
+        policy.GetSettings().renderInterval = 16;
+        // 0.04 degrees a frame stays under the per-frame limit; the seventh frame passes 0.25 total
+        std::vector<Reason> reasons;
+        for (int frame = 0; frame < 8; ++frame) {
+            policy.Decide(Frame(0.04f * frame));
+            reasons.push_back(policy.GetLastReason());
+        }
+        CHECK(reasons[0] == Reason::NoHistory);
+        for (int frame = 1; frame < 7; ++frame) {
+            CHECK(reasons[frame] == Reason::Steady);
+        }
+        CHECK(reasons[7] == Reason::Motion);
+    }
+
+    SECTION("Translation")
+    {
+        auto policy = EnabledPolicy();
+        const auto reasons = Run(policy, { Frame(0.0f, 0.0f), Frame(0.0f, 0.4f), Frame(0.0f, 1.0f) });
+        CHECK(reasons == std::vector<Reason>{ Reason::NoHistory, Reason::Steady, Reason::Motion });
+    }
+
+    SECTION("Zoom compares against the rendered FOV")
+    {
+        auto policy = EnabledPolicy();
+        const auto reasons = Run(policy, { Frame(0.0f, 0.0f, 20.0f), Frame(0.0f, 0.0f, 20.005f), Frame(0.0f, 0.0f, 20.011f) });
+        CHECK(reasons == std::vector<Reason>{ Reason::NoHistory, Reason::Steady, Reason::Zoom });
+    }
+
+    SECTION("Flash")
+    {
+        auto policy = EnabledPolicy();
+        auto flash = Frame(0.0f);
+        flash.flash = true;
+        const auto reasons = Run(policy, { Frame(0.0f), flash, flash, Frame(0.0f), Frame(0.0f), Frame(0.0f) });
+        CHECK(reasons == std::vector<Reason>{ Reason::NoHistory, Reason::Flash, Reason::Flash, Reason::Cooldown,
+                                              Reason::Cooldown, Reason::Steady });
+    }
+}
+
+TEST_CASE("Forced renders and invalidation drop the history", "[ScopeAmortizationPolicy]")
+{
+    auto policy = EnabledPolicy();
+    auto forced = Frame(0.0f);
+    forced.forceRender = true;
+
+    CHECK(policy.Decide(Frame(0.0f)) == Decision::Render);
+    CHECK(policy.Decide(forced) == Decision::Render);
+    CHECK(policy.GetLastReason() == Reason::Forced);
+    CHECK(policy.Decide(Frame(0.0f)) == Decision::Reproject);
+
+    // A failed render must not be reprojected next frame
+    CHECK(policy.Decide(Frame(0.0f)) == Decision::Render);
+    policy.Invalidate();
+    CHECK(policy.Decide(Frame(0.0f)) == Decision::Render);
+    CHECK(policy.GetLastReason() == Reason::NoHistory);
+
+    const auto& stats = policy.GetStats();
+    CHECK(stats.frames == 5);
+    CHECK(stats.byReason[static_cast<size_t>(Reason::Forced)] == 1);
+    CHECK(stats.byReason[static_cast<size_t>(Reason::NoHistory)] == 2);
+
+    policy.Reset();
+    CHECK(policy.GetStats().frames == 0);
+    CHECK(policy.Decide(Frame(0.0f)) == Decision::Render);
+    CHECK(policy.GetLastReason() == Reason::NoHistory);
+}
+
+TEST_CASE("Small rotation angles are measured accurately", "[ScopeAmortizationPolicy]")
+{
+    for (float degrees : { 0.001f, 0.01f, 0.05f, 0.25f, 5.0f, 90.0f, 179.0f }) {
+        const auto a = Frame(0.0f);
+        const auto b = Frame(degrees);
+        CHECK(ScopeAmortizationPolicy::AngleBetweenDeg(a.pose.rotation, b.pose.rotation) == Approx(degrees).epsilon(1e-3));
+        CHECK(ScopeAmortizationPolicy::AngleBetweenDeg(b.pose.rotation, a.pose.rotation) == Approx(degrees).epsilon(1e-3));
+    }
+    const auto a = Frame(37.0f);
+    CHECK(ScopeAmortizationPolicy::AngleBetweenDeg(a.pose.rotation, a.pose.rotation) == Approx(0.0f).margin(1e-5));
+}
@@ -0,0 +1,151 @@
+#include "ScopeProjection.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+
+using namespace ThroughScope::ScopeProjection;
+
+namespace
+{
+    Matrix4 Multiply(const Matrix4& a, const Matrix4& b)
+    {
+        Matrix4 result;
+        for (int r = 0; r < 4; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    sum += a.m[r][k] * b.m[k][c];
+                }
+                result.m[r][c] = sum;
+            }
+        }
+        return result;
+    }
+
+    /// World to clip: camera at eye, yawed about world Z, looking along its forward axis
+    Matrix4 ViewProjection(const Float3& eye, float yaw, float verticalFov, float aspect)
+    {
+        const float c = std::cos(yaw);
+        const float s = std::sin(yaw);
+        const Float3 right{ c, -s, 0.0f };
+        const Float3 up{ 0.0f, 0.0f, 1.0f };
+        const Float3 forward{ s, c, 0.0f };
+        const Float3 axes[3] = { right, up, forward };
+
+        Matrix4 view;
+        for (int r = 0; r < 3; ++r) {
+            view.m[r][0] = axes[r].x;
+            view.m[r][1] = axes[r].y;
+            view.m[r][2] = axes[r].z;
+            view.m[r][3] = -(axes[r].x * eye.x + axes[r].y * eye.y + axes[r].z * eye.z);
+        }
+        view.m[3][3] = 1.0f;
+
+        const float focal = 1.0f / std::tan(verticalFov * 0.5f);
+        const float nearZ = 1.0f;
+        const float farZ = 10000.0f;
+        Matrix4 projection;
+        projection.m[0][0] = focal / aspect;
+        projection.m[1][1] = focal;
+        projection.m[2][2] = farZ / (farZ - nearZ);
+        projection.m[2][3] = -nearZ * farZ / (farZ - nearZ);
+        projection.m[3][2] = 1.0f;
+        return Multiply(projection, view);
+    }
+
+    /// Model to world of a quad facing the camera (model X = camera right, model Y = camera up)
+    Matrix4 QuadWorld(const Matrix4& viewProj, const Float3& position, float scale)
+    {
+        Float3 right{ viewProj.m[0][0], viewProj.m[0][1], viewProj.m[0][2] };
+        Float3 up{ viewProj.m[1][0], viewProj.m[1][1], viewProj.m[1][2] };
+        const float rightLength = std::sqrt(right.x * right.x + right.y * right.y + right.z * right.z);
+        const float upLength = std::sqrt(up.x * up.x + up.y * up.y + up.z * up.z);
+
+        Matrix4 world;
+        world.m[0][0] = right.x / rightLength * scale;
+        world.m[1][0] = right.y / rightLength * scale;
+        world.m[2][0] = right.z / rightLength * scale;
+        world.m[0][1] = up.x / upLength * scale;
+        world.m[1][1] = up.y / upLength * scale;
+        world.m[2][1] = up.z / upLength * scale;
+        world.m[0][3] = position.x;
+        world.m[1][3] = position.y;
+        world.m[2][3] = position.z;
+        world.m[3][3] = 1.0f;
+        return world;
+    }
+
+    struct Cb2Result
+    {
+        float u;
+        float v;
+        float radiusU;
+        float radiusV;
+    };
+
+    /// The removed cb2 readback: model origin and the unit model-space edge through WVP
+    Cb2Result Cb2Reference(const Matrix4& wvp)
+    {
+        const float clipW = wvp.m[3][3];
+        const float u = (wvp.m[0][3] / clipW) * 0.5f + 0.5f;
+        const float v = -(wvp.m[1][3] / clipW) * 0.5f + 0.5f;
+
+        const float edgeU = ((wvp.m[0][0] + wvp.m[0][3]) / (wvp.m[3][0] + wvp.m[3][3])) * 0.5f + 0.5f;
+        const float edgeV = -((wvp.m[1][1] + wvp.m[1][3]) / (wvp.m[3][1] + wvp.m[3][3])) * 0.5f + 0.5f;
+        return { u, v, std::fabs(edgeU - u), std::fabs(edgeV - v) };
+    }
+}
+
+TEST_CASE("Scope quad ellipse matches the cb2-WVP edge extent", "[ScopeProjection]")
+{
+    struct Case
+    {
+        Float3 eye;
+        float yaw;
+        float fov;
+        float aspect;
+        Float3 offset;  // quad position relative to the camera (right, forward, up)
+        float scale;
+    };
+    const Case cases[] = {
+        { { 0.0f, 0.0f, 0.0f }, 0.0f, 1.2f, 16.0f / 9.0f, { 0.0f, 20.0f, 0.0f }, 1.5f },
+        { { 100.0f, -50.0f, 120.0f }, 0.7f, 0.9f, 16.0f / 9.0f, { 0.0f, 12.0f, 0.0f }, 2.0f },
+        { { -3000.0f, 4200.0f, 64.0f }, -2.3f, 0.4f, 21.0f / 9.0f, { 1.5f, 30.0f, -0.8f }, 1.0f },
+        { { 0.0f, 0.0f, 0.0f }, 3.0f, 1.4f, 4.0f / 3.0f, { -3.0f, 15.0f, 2.0f }, 0.8f },
+    };
+
+    for (const Case& test : cases) {
+        const Matrix4 viewProj = ViewProjection(test.eye, test.yaw, test.fov, test.aspect);
+        const float c = std::cos(test.yaw);
+        const float s = std::sin(test.yaw);
+        const Float3 position{
+            test.eye.x + c * test.offset.x + s * test.offset.y,
+            test.eye.y - s * test.offset.x + c * test.offset.y,
+            test.eye.z + test.offset.z,
+        };
+        const Matrix4 wvp = Multiply(viewProj, QuadWorld(viewProj, position, test.scale));
+        const Cb2Result reference = Cb2Reference(wvp);
+
+        // The engine's world bound of the quad: center at the origin, radius = half diagonal
+        const float boundRadius = test.scale * std::sqrt(2.0f);
+        const ScreenEllipse ellipse = ProjectScopeQuad(viewProj, position, boundRadius);
+
+        REQUIRE(ellipse.valid);
+        CHECK(ellipse.centerU == Approx(reference.u).margin(1e-4));
+        CHECK(ellipse.centerV == Approx(reference.v).margin(1e-4));
+        CHECK(ellipse.radiusU == Approx(reference.radiusU).epsilon(1e-3));
+        CHECK(ellipse.radiusV == Approx(reference.radiusV).epsilon(1e-3));
+
+        // Projecting the bounding sphere itself overshoots by the half-diagonal factor
+        const ScreenEllipse sphere = ProjectSphere(viewProj, position, boundRadius);
+        CHECK(sphere.radiusU == Approx(reference.radiusU * std::sqrt(2.0f)).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("Scope quad ellipse is invalid behind the near plane", "[ScopeProjection]")
+{
+    const Matrix4 viewProj = ViewProjection({ 0.0f, 0.0f, 0.0f }, 0.0f, 1.2f, 16.0f / 9.0f);
+    CHECK_FALSE(ProjectScopeQuad(viewProj, { 0.0f, -10.0f, 0.0f }, 1.0f).valid);
+    CHECK_FALSE(ProjectScopeQuad(viewProj, { 0.0f, 10.0f, 0.0f }, 0.0f).valid);
+}
@@ -0,0 +1,232 @@
+#include "ScopeQuadVerdictCache.h"
+#include "TTSMarkerRegistry.h"
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <vector>
+
+using ThroughScope::ScopeQuadVerdictCache;
+using ThroughScope::TTSMarkerRegistry;
+
+namespace
+{
+    /// Stand-in for ID3DDestructionNotifier: remembers the callback tokens per buffer
+    struct FakeNotifier
+    {
+        static std::map<const void*, std::vector<void*>>& Callbacks()
+        {
+            static std::map<const void*, std::vector<void*>> callbacks;
+            return callbacks;
+        }
+
+        static bool Watch(const void* buffer, void* token)
+        {
+            Callbacks()[buffer].push_back(token);
+            return true;
+        }
+
+        static bool Refuse(const void*, void*) { return false; }
+
+        static void Destroy(const void* buffer)
+        {
+            auto it = Callbacks().find(buffer);
+            if (it == Callbacks().end()) {
+                return;
+            }
+            auto tokens = std::move(it->second);
+            Callbacks().erase(it);
+            for (void* token : tokens) {
+                ScopeQuadVerdictCache::OnBufferDestroyed(token);
+            }
+        }
+
+        static size_t Count(const void* buffer)
+        {
+            auto it = Callbacks().find(buffer);
+            return it == Callbacks().end() ? 0 : it->second.size();
+        }
+    };
+
+    ScopeQuadVerdictCache::Key MakeKey(const void* vb, const void* ib, uint32_t startIndex, int32_t baseVertex, uint32_t indexCount = 6)
+    {
+        ScopeQuadVerdictCache::Key key;
+        key.vertexBuffer = vb;
+        key.indexBuffer = ib;
+        key.startIndex = startIndex;
+        key.baseVertex = baseVertex;
+        key.indexCount = indexCount;
+        key.stride = 28;
+        return key;
+    }
+
+    const ScopeQuadVerdictCache::Context kContext{ 1, reinterpret_cast<const void*>(0x1000) };
+}
+
+TEST_CASE("Verdicts are keyed on the draw offsets", "[ScopeQuadVerdictCache]")
+{
+    FakeNotifier::Callbacks().clear();
+    ScopeQuadVerdictCache cache;
+    cache.SetWatchFunction(&FakeNotifier::Watch);
+    int vb = 0, ib = 0;
+
+    cache.Store(MakeKey(&vb, &ib, 0, 0), kContext, true);
+    CHECK(cache.Lookup(MakeKey(&vb, &ib, 0, 0), kContext) == ScopeQuadVerdictCache::Verdict::ScopeQuad);
+    CHECK(cache.Lookup(MakeKey(&vb, &ib, 6, 0), kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+    CHECK(cache.Lookup(MakeKey(&vb, &ib, 0, 4), kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+
+    auto shifted = MakeKey(&vb, &ib, 0, 0);
+    shifted.vertexOffset = 112;
+    CHECK(cache.Lookup(shifted, kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+    shifted = MakeKey(&vb, &ib, 0, 0);
+    shifted.indexOffset = 12;
+    CHECK(cache.Lookup(shifted, kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+
+    const ScopeQuadVerdictCache::Context otherScope{ 1, reinterpret_cast<const void*>(0x2000) };
+    CHECK(cache.Lookup(MakeKey(&vb, &ib, 0, 0), otherScope) == ScopeQuadVerdictCache::Verdict::Unknown);
+    CHECK(cache.GetHitCount() == 1);
+    CHECK(cache.GetMissCount() == 5);
+}
+
+TEST_CASE("Each buffer is watched once however often it is cached", "[ScopeQuadVerdictCache]")
+{
+    FakeNotifier::Callbacks().clear();
+    ScopeQuadVerdictCache cache;
+    cache.SetWatchFunction(&FakeNotifier::Watch);
+    int vb = 0, ib = 0;
+
+    for (int round = 0; round < 50; ++round) {
+        for (uint32_t quad = 0; quad < 64; ++quad) {
+            cache.Store(MakeKey(&vb, &ib, quad * 6, 0), kContext, false);
+        }
+        cache.Invalidate();
+    }
+    CHECK(FakeNotifier::Count(&vb) == 1);
+    CHECK(FakeNotifier::Count(&ib) == 1);
+}
+
+TEST_CASE("Destroying a buffer drops only the entries that reference it", "[ScopeQuadVerdictCache]")
+{
+    FakeNotifier::Callbacks().clear();
+    ScopeQuadVerdictCache cache;
+    cache.SetWatchFunction(&FakeNotifier::Watch);
+    int vbA = 0, vbB = 0, ib = 0;
+
+    cache.Store(MakeKey(&vbA, &ib, 0, 0), kContext, true);
+    cache.Store(MakeKey(&vbB, &ib, 0, 0, 96), kContext, false);
+
+    FakeNotifier::Destroy(&vbA);
+    CHECK(cache.Lookup(MakeKey(&vbA, &ib, 0, 0), kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+    CHECK(cache.Lookup(MakeKey(&vbB, &ib, 0, 0, 96), kContext) == ScopeQuadVerdictCache::Verdict::NotScopeQuad);
+
+    // Same address, new buffer: watched again, and the old verdict is gone
+    cache.Store(MakeKey(&vbA, &ib, 0, 0), kContext, false);
+    CHECK(FakeNotifier::Count(&vbA) == 1);
+    CHECK(cache.Lookup(MakeKey(&vbA, &ib, 0, 0), kContext) == ScopeQuadVerdictCache::Verdict::NotScopeQuad);
+
+    FakeNotifier::Destroy(&ib);
+    CHECK(cache.Lookup(MakeKey(&vbA, &ib, 0, 0), kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+    CHECK(cache.Lookup(MakeKey(&vbB, &ib, 0, 0, 96), kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+}
+
+TEST_CASE("Caching is disabled when buffers cannot be watched", "[ScopeQuadVerdictCache]")
+{
+    int vb = 0, ib = 0;
+
+    ScopeQuadVerdictCache cache;
+    cache.SetWatchFunction(&FakeNotifier::Refuse);
+    cache.Store(MakeKey(&vb, &ib, 0, 0), kContext, true);
+    CHECK_FALSE(cache.IsEnabled());
+    CHECK(cache.Lookup(MakeKey(&vb, &ib, 0, 0), kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+
+    ScopeQuadVerdictCache unwatched;
+    unwatched.Store(MakeKey(&vb, &ib, 0, 0), kContext, true);
+    CHECK(unwatched.Lookup(MakeKey(&vb, &ib, 0, 0), kContext) == ScopeQuadVerdictCache::Verdict::Unknown);
+}
+
+TEST_CASE("Classifier cost over a 10k-draw forward frame", "[ScopeQuadVerdictCache][benchmark]")
+{
+    // 10k draws per frame over 250 distinct windows in 8 pool buffers; window 137 is the scope quad
+    constexpr int kDraws = 10000;
+    constexpr int kWindows = 250;
+    constexpr int kScopeWindow = 137;
+    int pools[8] = {};
+    int indexPool = 0;
+
+    struct Draw
+    {
+        ScopeQuadVerdictCache::Key key;
+        TTSMarkerRegistry::DrawWindow window;
+    };
+    std::vector<Draw> frame;
+    frame.reserve(kDraws);
+    for (int i = 0; i < kDraws; ++i) {
+        const int w = (i * 7919) % kWindows;
+        Draw draw;
+        draw.key = MakeKey(&pools[w % 8], &indexPool, uint32_t(w) * 6, w * 4);
+        draw.window.vertexBuffer = draw.key.vertexBuffer;
+        draw.window.startIndex = draw.key.startIndex;
+        draw.window.baseVertex = draw.key.baseVertex;
+        draw.window.indexCount = draw.key.indexCount;
+        frame.push_back(draw);
+    }
+
+    TTSMarkerRegistry registry;
+    int scopeShape = 0;
+    registry.Register(&scopeShape, &pools[kScopeWindow % 8], 6);
+    // The engine's DrawTriShape of the scope shape teaches the registry its window
+    registry.BeginShapeDraw(&scopeShape);
+    for (const Draw& draw : frame) {
+        if (draw.window.baseVertex == kScopeWindow * 4) {
+            REQUIRE(registry.IsMarked(draw.window));
+            break;
+        }
+    }
+    registry.EndShapeDraw();
+    // Full check per draw (the GetDesc calls are not part of this portable stand-in)
+    auto classify = [&](const Draw& draw) { return registry.IsMarked(draw.window); };
+
+    FakeNotifier::Callbacks().clear();
+    ScopeQuadVerdictCache cache;
+    cache.SetWatchFunction(&FakeNotifier::Watch);
+    const ScopeQuadVerdictCache::Context context{ registry.GetGeneration(), &registry };
+    auto cachedFrame = [&]() {
+        int detected = 0;
+        for (const Draw& draw : frame) {
+            auto verdict = cache.Lookup(draw.key, context);
+            bool isScopeQuad;
+            if (verdict == ScopeQuadVerdictCache::Verdict::Unknown) {
+                isScopeQuad = classify(draw);
+                cache.Store(draw.key, context, isScopeQuad);
+            } else {
+                isScopeQuad = verdict == ScopeQuadVerdictCache::Verdict::ScopeQuad;
+            }
+            detected += isScopeQuad;
+        }
+        return detected;
+    };
+    auto uncachedFrame = [&]() {
+        int detected = 0;
+        for (const Draw& draw : frame) {
+            detected += classify(draw);
+        }
+        return detected;
+    };
+
+    const int scopeDraws = kDraws / kWindows;
+    REQUIRE(uncachedFrame() == scopeDraws);
+    REQUIRE(cachedFrame() == scopeDraws);
+    const uint64_t hitsBefore = cache.GetHitCount();
+    REQUIRE(cachedFrame() == scopeDraws);
+    // A warm frame is answered from the table almost entirely
+    CHECK(cache.GetHitCount() - hitsBefore > uint64_t(kDraws) * 9 / 10);
+
+    BENCHMARK("classify every draw")
+    {
+        return uncachedFrame();
+    };
+    BENCHMARK("verdict cache")
+    {
+        return cachedFrame();
+    };
+}
@@ -0,0 +1,134 @@
+#include "ScopeRegion.h"
+
+#include <catch2/catch.hpp>
+
+namespace ScopeRegion = ThroughScope::ScopeRegion;
+using ScopeRegion::PixelRect;
+using ScopeRegion::ScissorRect;
+using ScopeRegion::UVRect;
+
+namespace ThroughScope::ScopeRegion
+{
+    bool operator==(const PixelRect& a, const PixelRect& b)
+    {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    bool operator==(const ScissorRect& a, const ScissorRect& b)
+    {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ScissorRect& rect)
+    {
+        return os << "{ " << rect.left << ", " << rect.top << ", " << rect.right << ", " << rect.bottom << " }";
+    }
+
+    std::ostream& operator<<(std::ostream& os, const PixelRect& rect)
+    {
+        return os << "{ " << rect.left << ", " << rect.top << ", " << rect.right << ", " << rect.bottom << " }";
+    }
+}
+
+namespace
+{
+    /// A centred aperture at 2560x1440, as SecondPassRenderer sets it
+    const UVRect kRegion = ScopeRegion::ExpandAperture({ 0.4f, 0.3f, 0.6f, 0.7f }, 0.02f);
+}
+
+TEST_CASE("Region pixel rects are conservative, aligned and clamped", "[ScopeRegion]")
+{
+    const PixelRect full = ScopeRegion::ToPixelRect(kRegion, 2560, 1440);
+    CHECK(full == PixelRect{ 968, 400, 1592, 1040 });
+    CHECK(full.left <= 0.38f * 2560);
+    CHECK(full.right >= 0.62f * 2560);
+    CHECK(full.top <= 0.28f * 1440);
+    CHECK(full.bottom >= 0.72f * 1440);
+    CHECK(full.left % 8 == 0);
+    CHECK(full.top % 8 == 0);
+
+    // Half-res and upscaler-input targets get the same UV rect at their own resolution
+    PixelRect half;
+    CHECK(ScopeRegion::SurfaceRect(kRegion, 2560, 1440, 1280, 720, half));
+    CHECK(half == PixelRect{ 480, 200, 800, 520 });
+
+    // Not screen space (shadow map, cubemap face): the whole surface, reported as not limited
+    PixelRect shadow;
+    CHECK_FALSE(ScopeRegion::SurfaceRect(kRegion, 2560, 1440, 2048, 2048, shadow));
+    CHECK(shadow == PixelRect{ 0, 0, 2048, 2048 });
+
+    CHECK(ScopeRegion::ToPixelRect({ 0.5f, 0.5f, 0.5f, 0.8f }, 2560, 1440).IsEmpty());
+}
+
+TEST_CASE("A region partly off-screen stays inside the surface", "[ScopeRegion]")
+{
+    // Aperture hanging over the top-left corner (scope swung to the edge), and over the bottom-right
+    const UVRect topLeft = ScopeRegion::ExpandAperture({ -0.15f, -0.1f, 0.2f, 0.25f }, 0.02f);
+    CHECK(topLeft.minU == 0.0f);
+    CHECK(topLeft.minV == 0.0f);
+    const PixelRect topLeftPixels = ScopeRegion::ToPixelRect(topLeft, 2560, 1440);
+    CHECK(topLeftPixels == PixelRect{ 0, 0, 568, 392 });
+
+    const PixelRect bottomRight = ScopeRegion::ToPixelRect({ 0.9f, 0.95f, 1.3f, 1.2f }, 2557, 1437);
+    CHECK(bottomRight.right == 2557);   // Alignment never rounds past an unaligned surface edge
+    CHECK(bottomRight.bottom == 1437);
+    CHECK(bottomRight.left == 2296);
+    CHECK(bottomRight.top == 1360);
+
+    // Entirely off-screen: clamped to an empty rect, nothing is drawn or copied
+    CHECK(ScopeRegion::ToPixelRect({ 1.1f, 0.2f, 1.4f, 0.5f }, 2560, 1440).IsEmpty());
+
+    // The viewport offset is added before the game's scissor is applied
+    const ScissorRect scissor = ScopeRegion::ViewportScissor(bottomRight, 100, 50, nullptr);
+    CHECK(scissor == ScissorRect{ 2396, 1410, 2657, 1487 });
+}
+
+TEST_CASE("The game's scissor is intersected with the region", "[ScopeRegion]")
+{
+    const PixelRect region = ScopeRegion::ToPixelRect(kRegion, 2560, 1440);
+    const ScissorRect regionScissor = ScopeRegion::ViewportScissor(region, 0, 0, nullptr);
+    CHECK(regionScissor == ScissorRect{ 968, 400, 1592, 1040 });
+
+    SECTION("a game scissor wider than the region leaves the region")
+    {
+        const ScissorRect game{ 0, 0, 2560, 1440 };
+        CHECK(ScopeRegion::ViewportScissor(region, 0, 0, &game) == regionScissor);
+        const ScissorRect wider{ -100, -100, 5000, 5000 };
+        CHECK(ScopeRegion::ViewportScissor(region, 0, 0, &wider) == regionScissor);
+    }
+
+    SECTION("a partly overlapping game scissor clips the region")
+    {
+        const ScissorRect game{ 1200, 0, 2560, 720 };
+        CHECK(ScopeRegion::ViewportScissor(region, 0, 0, &game) == ScissorRect{ 1200, 400, 1592, 720 });
+    }
+
+    SECTION("an empty intersection collapses to a zero-size rect")
+    {
+        const ScissorRect left{ 0, 0, 500, 1440 };
+        const ScissorRect clipped = ScopeRegion::ViewportScissor(region, 0, 0, &left);
+        CHECK(clipped.IsEmpty());
+        CHECK(clipped.right == clipped.left);   // Never inverted
+        CHECK(clipped.bottom >= clipped.top);
+
+        const ScissorRect below{ 0, 1200, 2560, 1440 };
+        const ScissorRect clippedBelow = ScopeRegion::ViewportScissor(region, 0, 0, &below);
+        CHECK(clippedBelow.IsEmpty());
+        CHECK(clippedBelow.bottom == clippedBelow.top);
+
+        // An empty region (e.g. a zero-size aperture) stays empty whatever the game scissor is
+        const ScissorRect game{ 0, 0, 2560, 1440 };
+        CHECK(ScopeRegion::ViewportScissor(PixelRect{}, 0, 0, &game).IsEmpty());
+    }
+}
+
+TEST_CASE("Only screen-aspect surfaces are limited", "[ScopeRegion]")
+{
+    CHECK(ScopeRegion::MatchesAspect(2560, 1440, 2560, 1440));
+    CHECK(ScopeRegion::MatchesAspect(1280, 720, 2560, 1440));
+    CHECK(ScopeRegion::MatchesAspect(1707, 960, 2560, 1440));   // Upscaler input at 0.667
+    CHECK_FALSE(ScopeRegion::MatchesAspect(2048, 2048, 2560, 1440));
+    CHECK_FALSE(ScopeRegion::MatchesAspect(2560, 1080, 2560, 1440));
+    CHECK_FALSE(ScopeRegion::MatchesAspect(0, 1440, 2560, 1440));
+    CHECK_FALSE(ScopeRegion::MatchesAspect(2560, 1440, 0, 0));
+}
@@ -0,0 +1,73 @@
+#include "ScopeResolutionScaler.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+
+using ThroughScope::ScopeResolutionScaler;
+
+TEST_CASE("Magnification is the tangent ratio of the half FOVs", "[ScopeResolutionScaler]")
+{
+    // 90 -> 45 degrees is 2x by FOV ratio but 2.41x optically
+    CHECK(ScopeResolutionScaler::OpticalMagnification(90.0f, 45.0f) == Approx(1.0f / std::tan(0.3926991f)).epsilon(1e-4));
+    CHECK(ScopeResolutionScaler::OpticalMagnification(90.0f, 45.0f) > 90.0f / 45.0f);
+    // Narrow FOVs converge to the plain ratio
+    CHECK(ScopeResolutionScaler::OpticalMagnification(10.0f, 1.0f) == Approx(10.0f).epsilon(0.01));
+
+    CHECK(ScopeResolutionScaler::OpticalMagnification(90.0f, 0.0f) == 1.0f);
+    CHECK(ScopeResolutionScaler::OpticalMagnification(90.0f, 120.0f) == 1.0f);
+    CHECK(ScopeResolutionScaler::OpticalMagnification(90.0f, 90.0f) == 1.0f);
+}
+
+TEST_CASE("The target scale follows aperture size and magnification within the user limits", "[ScopeResolutionScaler]")
+{
+    ScopeResolutionScaler::Settings settings;  // min 0.5, full detail up to 2x, falloff 0.5, cap 1440 px
+
+    // Low magnification, small aperture: native density
+    CHECK(ScopeResolutionScaler::ComputeTargetScale(settings, 600.0f, 1.5f) == Approx(1.0f));
+    // 8x: (2 / 8)^0.5 = 0.5
+    CHECK(ScopeResolutionScaler::ComputeTargetScale(settings, 600.0f, 8.0f) == Approx(0.5f));
+    // 4x: (2 / 4)^0.5
+    CHECK(ScopeResolutionScaler::ComputeTargetScale(settings, 600.0f, 4.0f) == Approx(std::sqrt(0.5f)));
+    // Huge aperture at 1x: capped to 1440 rendered pixels
+    CHECK(ScopeResolutionScaler::ComputeTargetScale(settings, 2000.0f, 1.0f) == Approx(0.72f));
+    // 25x would be 0.28: clamped to the user minimum
+    CHECK(ScopeResolutionScaler::ComputeTargetScale(settings, 600.0f, 25.0f) == Approx(0.5f));
+
+    settings.maxScale = 0.75f;
+    CHECK(ScopeResolutionScaler::ComputeTargetScale(settings, 600.0f, 1.0f) == Approx(0.75f));
+    // Unknown aperture: the upper limit, never a guess below it
+    CHECK(ScopeResolutionScaler::ComputeTargetScale(settings, 0.0f, 8.0f) == Approx(0.75f));
+}
+
+TEST_CASE("Render scale is quantized up and held by hysteresis", "[ScopeResolutionScaler]")
+{
+    ScopeResolutionScaler scaler;
+    // 4x -> 0.7071, rounded up to 12/16
+    CHECK(scaler.Update(600.0f, 4.0f) == Approx(0.75f));
+    CHECK(scaler.GetTargetScale() == Approx(std::sqrt(0.5f)));
+
+    // The target moves by less than the hysteresis: the size stays
+    CHECK(scaler.Update(600.0f, 3.8f) == Approx(0.75f));
+    CHECK(scaler.Update(600.0f, 4.2f) == Approx(0.75f));
+
+    // A real change applies
+    CHECK(scaler.Update(600.0f, 8.0f) == Approx(0.5f));
+
+    // Narrowing the user range applies at once, whatever the hysteresis
+    scaler.GetSettings().minScale = 0.6f;
+    CHECK(scaler.Update(600.0f, 8.0f) == Approx(0.625f));
+
+    scaler.Reset();
+    CHECK(scaler.GetScale() == 1.0f);
+}
+
+TEST_CASE("Scaled extents stay inside the surface", "[ScopeResolutionScaler]")
+{
+    CHECK(ScopeResolutionScaler::ScaleExtent(2560, 0.75f) == 1920);
+    CHECK(ScopeResolutionScaler::ScaleExtent(1440, 0.5f) == 720);
+    CHECK(ScopeResolutionScaler::ScaleExtent(1439, 0.5f) == 720);
+    CHECK(ScopeResolutionScaler::ScaleExtent(3, 0.01f) == 1);
+    CHECK(ScopeResolutionScaler::ScaleExtent(1920, 1.0f) == 1920);
+    CHECK(ScopeResolutionScaler::ScaleExtent(1920, 1.5f) == 1920);
+}
@@ -0,0 +1,200 @@
+#include "ShaderBlobCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using ThroughScope::ShaderBlobCache;
+namespace fs = std::filesystem;
+
+namespace
+{
+    /// Stands in for D3DCompile: the blob is the source text plus a marker byte, "bad" fails
+    struct StubCompiler
+    {
+        int calls = 0;
+
+        ShaderBlobCache::CompileFn For(std::string source)
+        {
+            return [this, source](std::vector<uint8_t>& blob, std::string& error) {
+                ++calls;
+                if (source == "bad") {
+                    error = "syntax error";
+                    return false;
+                }
+                blob.assign(source.begin(), source.end());
+                blob.push_back(0xAB);
+                return true;
+            };
+        }
+    };
+
+    /// A fresh cache directory under the system temp directory
+    struct TempDirectory
+    {
+        fs::path path;
+
+        explicit TempDirectory(const char* name) : path(fs::temp_directory_path() / name)
+        {
+            fs::remove_all(path);
+        }
+        ~TempDirectory()
+        {
+            std::error_code ec;
+            fs::remove_all(path, ec);
+        }
+    };
+
+    ShaderBlobCache MakeCache(const fs::path& directory, const char* compilerVersion)
+    {
+        ShaderBlobCache cache;
+        cache.SetDirectory(directory);
+        cache.SetCompilerVersion(compilerVersion);
+        return cache;
+    }
+
+    const ShaderBlobCache::Request kRequest{ "MVCopyPS", "float4 main() : SV_Target { return 0; }", "main", "ps_5_0", {}, 0 };
+}
+
+TEST_CASE("Compiled blobs are reused across cache instances", "[ShaderBlobCache]")
+{
+    TempDirectory dir("ShaderBlobCacheTests_Reuse");
+    StubCompiler compiler;
+    std::vector<uint8_t> blob;
+    std::string error;
+
+    auto cache = MakeCache(dir.path, "d3dcompiler_47.dll 10.0.19041.868");
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 1);
+    CHECK(blob == std::vector<uint8_t>{ 'A', 0xAB });
+    CHECK(fs::exists(cache.GetEntryPath(kRequest)));
+
+    blob.clear();
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 1);
+    CHECK(blob == std::vector<uint8_t>{ 'A', 0xAB });
+
+    // Next game start
+    auto restarted = MakeCache(dir.path, "d3dcompiler_47.dll 10.0.19041.868");
+    REQUIRE(restarted.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 1);
+    CHECK(restarted.GetStats().hits == 1);
+}
+
+TEST_CASE("Every compiler input is part of the key", "[ShaderBlobCache]")
+{
+    const auto cache = MakeCache("unused", "d3dcompiler_47.dll 10.0.19041.868");
+    const uint64_t key = cache.ComputeKey(kRequest);
+
+    auto source = kRequest;
+    source.source = "float4 main() : SV_Target { return 1; }";
+    auto target = kRequest;
+    target.target = "ps_5_1";
+    auto entry = kRequest;
+    entry.entryPoint = "mainMRT";
+    auto flags = kRequest;
+    flags.flags = 1;
+    auto defineOn = kRequest;
+    defineOn.defines = { { "TTS_PARALLAX", "1" } };
+    auto defineOff = kRequest;
+    defineOff.defines = { { "TTS_PARALLAX", "0" } };
+
+    CHECK(cache.ComputeKey(source) != key);
+    CHECK(cache.ComputeKey(target) != key);
+    CHECK(cache.ComputeKey(entry) != key);
+    CHECK(cache.ComputeKey(flags) != key);
+    CHECK(cache.ComputeKey(defineOn) != key);
+    CHECK(cache.ComputeKey(defineOn) != cache.ComputeKey(defineOff));
+    // The readable name is only a file name prefix
+    auto renamed = kRequest;
+    renamed.name = "Other";
+    CHECK(cache.ComputeKey(renamed) == key);
+}
+
+TEST_CASE("A different build of the loaded compiler DLL misses the cache", "[ShaderBlobCache]")
+{
+    CHECK(ShaderBlobCache::FormatCompilerVersion("d3dcompiler_47.dll", (10u << 16) | 0u, (19041u << 16) | 868u) ==
+          "d3dcompiler_47.dll 10.0.19041.868");
+
+    TempDirectory dir("ShaderBlobCacheTests_Version");
+    StubCompiler compiler;
+    std::vector<uint8_t> blob;
+    std::string error;
+
+    // Same DLL name and D3D_COMPILER_VERSION, different file version
+    auto system = MakeCache(dir.path, "d3dcompiler_47.dll 10.0.19041.868");
+    auto bundled = MakeCache(dir.path, "d3dcompiler_47.dll 10.0.10011.16384");
+    CHECK(system.GetEntryPath(kRequest) != bundled.GetEntryPath(kRequest));
+
+    REQUIRE(system.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    REQUIRE(bundled.GetOrCompile(kRequest, compiler.For("B"), blob, error));
+    CHECK(compiler.calls == 2);
+    CHECK(blob == std::vector<uint8_t>{ 'B', 0xAB });
+    REQUIRE(system.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 2);
+    CHECK(blob == std::vector<uint8_t>{ 'A', 0xAB });
+}
+
+TEST_CASE("Corrupted or truncated entries are recompiled and rewritten", "[ShaderBlobCache]")
+{
+    TempDirectory dir("ShaderBlobCacheTests_Corrupt");
+    StubCompiler compiler;
+    std::vector<uint8_t> blob;
+    std::string error;
+    auto cache = MakeCache(dir.path, "d3dcompiler_47.dll 10.0.19041.868");
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    const fs::path path = cache.GetEntryPath(kRequest);
+
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put(0x00);
+    }
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 2);
+    CHECK(cache.GetStats().invalid == 1);
+    CHECK(blob.back() == 0xAB);
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 2);
+
+    fs::resize_file(path, 10);
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 3);
+    CHECK(cache.GetStats().invalid == 2);
+}
+
+TEST_CASE("Failures, disabled mode and unwritable directories", "[ShaderBlobCache]")
+{
+    TempDirectory dir("ShaderBlobCacheTests_Failures");
+    StubCompiler compiler;
+    std::vector<uint8_t> blob;
+    std::string error;
+    auto cache = MakeCache(dir.path, "d3dcompiler_47.dll 10.0.19041.868");
+
+    // Compile errors are reported and never cached
+    auto broken = kRequest;
+    broken.source = "bad";
+    CHECK_FALSE(cache.GetOrCompile(broken, compiler.For("bad"), blob, error));
+    CHECK(error == "syntax error");
+    CHECK(blob.empty());
+    CHECK_FALSE(fs::exists(cache.GetEntryPath(broken)));
+    CHECK(cache.GetStats().compileFailures == 1);
+
+    // Disabled: always compiles, writes nothing
+    cache.SetEnabled(false);
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    REQUIRE(cache.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(compiler.calls == 3);
+    CHECK_FALSE(fs::exists(cache.GetEntryPath(kRequest)));
+
+    // A cache directory that can't be created still returns the blob
+    fs::create_directories(dir.path);
+    std::ofstream(dir.path / "file").put('x');
+    auto unwritable = MakeCache(dir.path / "file" / "ShaderCache", "d3dcompiler_47.dll 10.0.19041.868");
+    REQUIRE(unwritable.GetOrCompile(kRequest, compiler.For("A"), blob, error));
+    CHECK(blob == std::vector<uint8_t>{ 'A', 0xAB });
+    CHECK(unwritable.GetStats().writeFailures == 1);
+}
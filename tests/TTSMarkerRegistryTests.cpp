@@ -0,0 +1,136 @@
+#include "TTSMarkerRegistry.h"
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using ThroughScope::TTSMarkerRegistry;
+
+namespace
+{
+    TTSMarkerRegistry::DrawWindow Window(const void* vb, int32_t baseVertex, uint32_t indexCount = 6)
+    {
+        TTSMarkerRegistry::DrawWindow window;
+        window.vertexBuffer = vb;
+        window.baseVertex = baseVertex;
+        window.startIndex = 0;
+        window.indexCount = indexCount;
+        return window;
+    }
+
+    /// One BSGraphics::Renderer::DrawTriShape call: the engine's DrawIndexed inside the hook's bracket
+    struct ShapeDraw
+    {
+        const void* shape;
+        TTSMarkerRegistry::DrawWindow window;
+    };
+
+    bool ReplayShapeDraw(TTSMarkerRegistry& registry, const ShapeDraw& draw)
+    {
+        registry.BeginShapeDraw(draw.shape);
+        const bool marked = registry.IsMarked(draw.window);
+        registry.EndShapeDraw();
+        return marked;
+    }
+}
+
+TEST_CASE("Draw stream over a pooled vertex buffer finds the registered shape's window", "[TTSMarkerRegistry]")
+{
+    // 64 six-index quads of 4 vertices each in one pool buffer; quad 37 is the TTSEffectShape
+    constexpr int kQuads = 64;
+    constexpr int kScopeQuad = 37;
+    int pool = 0;
+    int otherBuffer = 0;
+    std::vector<int> shapes(kQuads);
+
+    std::vector<ShapeDraw> frame;
+    for (int quad = 0; quad < kQuads; ++quad) {
+        frame.push_back({ &shapes[quad], Window(&pool, quad * 4) });
+    }
+    // Other geometry: different buffer, and a 96-index mesh in the same pool
+    int otherShape = 0;
+    frame.push_back({ &otherShape, Window(&otherBuffer, 0) });
+    frame.push_back({ &otherShape, Window(&pool, 0, 96) });
+
+    TTSMarkerRegistry registry;
+    registry.Register(&shapes[kScopeQuad], &pool, 6);
+    const uint64_t registered = registry.GetGeneration();
+
+    for (int frameIndex = 0; frameIndex < 100; ++frameIndex) {
+        int detected = 0;
+        for (size_t i = 0; i < frame.size(); ++i) {
+            if (ReplayShapeDraw(registry, frame[i])) {
+                ++detected;
+                CHECK(i == size_t(kScopeQuad));
+            }
+        }
+        REQUIRE(detected == 1);
+    }
+    // Learned once, on the first frame
+    CHECK(registry.GetWindowCount() == 1);
+    CHECK(registry.GetGeneration() == registered + 1);
+
+    // The learned window also matches draws outside DrawTriShape (other engine paths); its pool
+    // neighbours never do
+    CHECK(registry.IsMarked(Window(&pool, kScopeQuad * 4)));
+    CHECK_FALSE(registry.IsMarked(Window(&pool, (kScopeQuad + 1) * 4)));
+    CHECK_FALSE(registry.IsRegisteredShapeDrawActive());
+}
+
+TEST_CASE("Candidates outside the registered shape's draw are never learned", "[TTSMarkerRegistry]")
+{
+    TTSMarkerRegistry registry;
+    int buffer = 0;
+    int shape = 0;
+    int otherShape = 0;
+    CHECK_FALSE(registry.IsMarked(Window(&buffer, 0)));
+    CHECK_FALSE(registry.IsMarked(Window(nullptr, 0)));
+
+    registry.Register(&shape, &buffer, 6);
+    // Same buffer and index count, but no DrawTriShape bracket or another shape's bracket
+    CHECK_FALSE(registry.IsMarked(Window(&buffer, 8)));
+    CHECK_FALSE(ReplayShapeDraw(registry, { &otherShape, Window(&buffer, 8) }));
+    // The registered shape's bracket, but a draw with another index count
+    CHECK_FALSE(ReplayShapeDraw(registry, { &shape, Window(&buffer, 8, 12) }));
+    CHECK(registry.GetWindowCount() == 0);
+
+    registry.BeginShapeDraw(&otherShape);
+    CHECK_FALSE(registry.IsRegisteredShapeDrawActive());
+    registry.BeginShapeDraw(&shape);
+    CHECK(registry.IsRegisteredShapeDrawActive());
+    registry.EndShapeDraw();
+    CHECK_FALSE(registry.IsRegisteredShapeDrawActive());
+}
+
+TEST_CASE("Windows distinguish offsets and are dropped on Register/Clear", "[TTSMarkerRegistry]")
+{
+    TTSMarkerRegistry registry;
+    int buffer = 0;
+    int shape = 0;
+    registry.Register(&shape, &buffer, 6);
+
+    auto window = Window(&buffer, 0);
+    window.vertexOffset = 280;
+    window.startIndex = 12;
+    CHECK(ReplayShapeDraw(registry, { &shape, window }));
+
+    auto shiftedStart = window;
+    shiftedStart.startIndex = 18;
+    CHECK_FALSE(registry.IsMarked(shiftedStart));
+    auto shiftedOffset = window;
+    shiftedOffset.vertexOffset = 308;
+    CHECK_FALSE(registry.IsMarked(shiftedOffset));
+    CHECK(registry.IsMarked(window));
+
+    const uint64_t generation = registry.GetGeneration();
+    registry.Register(&shape, &buffer, 6);
+    CHECK(registry.GetGeneration() > generation);
+    CHECK(registry.GetWindowCount() == 0);
+    CHECK_FALSE(registry.IsMarked(window));
+    CHECK(ReplayShapeDraw(registry, { &shape, window }));
+
+    registry.Clear();
+    CHECK(registry.IsEmpty());
+    CHECK_FALSE(registry.IsMarked(window));
+    CHECK_FALSE(ReplayShapeDraw(registry, { &shape, window }));
+}
@@ -0,0 +1,118 @@
+#include "TimingStatsStore.h"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ThroughScope::TimingStatsStore;
+using Clock = TimingStatsStore::Clock;
+
+namespace
+{
+    TimingStatsStore MakeStore(size_t window = 240)
+    {
+        return TimingStatsStore({ "Total", "DrawScopeContent", "MotionVectorMask" }, window);
+    }
+
+    std::vector<std::string> Lines(const std::string& text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream in(text);
+        for (std::string line; std::getline(in, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+}
+
+TEST_CASE("Summaries cover min, avg, p99 and max per phase and clock", "[TimingStatsStore]")
+{
+    auto store = MakeStore();
+    // 1..200 ms: p99 by nearest rank is the 198th sample
+    for (int i = 200; i >= 1; --i) {
+        store.Add(1, Clock::Gpu, static_cast<float>(i));
+    }
+    store.Add(1, Clock::Cpu, 0.25f);
+
+    const auto gpu = store.GetSummary(1, Clock::Gpu);
+    CHECK(gpu.samples == 200);
+    CHECK(gpu.minMs == 1.0f);
+    CHECK(gpu.maxMs == 200.0f);
+    CHECK(gpu.avgMs == Approx(100.5f));
+    CHECK(gpu.p99Ms == 198.0f);
+    CHECK(gpu.lastMs == 1.0f);
+
+    const auto cpu = store.GetSummary(1, Clock::Cpu);
+    CHECK(cpu.samples == 1);
+    CHECK(cpu.p99Ms == 0.25f);
+
+    // Other series stay empty
+    CHECK(store.GetSummary(0, Clock::Gpu).samples == 0);
+    CHECK(store.GetSummary(2, Clock::Cpu).samples == 0);
+}
+
+TEST_CASE("p99 of fewer than 100 samples is the maximum", "[TimingStatsStore]")
+{
+    std::vector<float> samples = { 3.0f, 1.0f, 9.0f, 2.0f };
+    CHECK(TimingStatsStore::Percentile(samples, 0.99f) == 9.0f);
+
+    std::vector<float> hundred;
+    for (int i = 1; i <= 100; ++i) {
+        hundred.push_back(static_cast<float>(i));
+    }
+    CHECK(TimingStatsStore::Percentile(hundred, 0.99f) == 99.0f);
+    CHECK(TimingStatsStore::Percentile(hundred, 0.5f) == 50.0f);
+    CHECK(TimingStatsStore::Percentile(hundred, 0.0f) == 1.0f);
+
+    std::vector<float> empty;
+    CHECK(TimingStatsStore::Percentile(empty, 0.99f) == 0.0f);
+}
+
+TEST_CASE("The window keeps only the most recent samples", "[TimingStatsStore]")
+{
+    auto store = MakeStore(4);
+    for (float ms : { 100.0f, 100.0f, 1.0f, 2.0f, 3.0f, 4.0f }) {
+        store.Add(0, Clock::Cpu, ms);
+    }
+    const auto summary = store.GetSummary(0, Clock::Cpu);
+    CHECK(summary.samples == 4);
+    CHECK(summary.maxMs == 4.0f);
+    CHECK(summary.avgMs == Approx(2.5f));
+    CHECK(summary.lastMs == 4.0f);
+}
+
+TEST_CASE("Invalid samples and phases are ignored", "[TimingStatsStore]")
+{
+    auto store = MakeStore();
+    store.Add(0, Clock::Gpu, std::nanf(""));
+    store.Add(0, Clock::Gpu, INFINITY);
+    store.Add(3, Clock::Gpu, 1.0f);
+    store.Add(0, Clock::Count, 1.0f);
+    CHECK(store.GetSummary(0, Clock::Gpu).samples == 0);
+    CHECK(store.GetSummary(3, Clock::Gpu).samples == 0);
+
+    store.Add(0, Clock::Gpu, 1.0f);
+    store.Clear();
+    CHECK(store.GetSummary(0, Clock::Gpu).samples == 0);
+    CHECK(store.GetSummary(0, Clock::Gpu).lastMs == 0.0f);
+}
+
+TEST_CASE("CSV has one row per measured series", "[TimingStatsStore]")
+{
+    auto store = MakeStore();
+    store.Add(0, Clock::Cpu, 1.5f);
+    store.Add(0, Clock::Gpu, 2.0f);
+    store.Add(2, Clock::Gpu, 0.125f);
+
+    std::ostringstream out;
+    store.WriteCsv(out);
+    const auto lines = Lines(out.str());
+    REQUIRE(lines.size() == 4);
+    CHECK(lines[0] == "phase,clock,samples,min_ms,avg_ms,p99_ms,max_ms,last_ms");
+    CHECK(lines[1] == "Total,cpu,1,1.5,1.5,1.5,1.5,1.5");
+    CHECK(lines[2] == "Total,gpu,1,2,2,2,2,2");
+    CHECK(lines[3] == "MotionVectorMask,gpu,1,0.125,0.125,0.125,0.125,0.125");
+}
@@ -0,0 +1,271 @@
+#include "TransientAliasPlanner.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+using ThroughScope::TransientAliasPlanner;
+using Lifetime = TransientAliasPlanner::Lifetime;
+
+namespace
+{
+    constexpr uint64_t kFullRes = 1;   // e.g. 2560x1440 R8G8B8A8
+    constexpr uint64_t kHalfRes = 2;   // e.g. 1280x720 R16G16B16A16
+    constexpr uint64_t kFullBytes = 2560ull * 1440 * 4;
+    constexpr uint64_t kHalfBytes = 1280ull * 720 * 8;
+
+    Lifetime Make(uint64_t key, uint32_t begin, uint32_t end)
+    {
+        Lifetime lifetime;
+        lifetime.key = key;
+        lifetime.bytes = key == kFullRes ? kFullBytes : kHalfBytes;
+        lifetime.begin = begin;
+        lifetime.end = end;
+        return lifetime;
+    }
+
+    bool Overlaps(const Lifetime& a, const Lifetime& b)
+    {
+        return a.begin < b.end && b.begin < a.end;
+    }
+
+    /// Peak number of same-key lifetimes alive at once: the fewest slots any plan can use
+    size_t PeakOverlap(const std::vector<Lifetime>& lifetimes, uint64_t key)
+    {
+        size_t peak = 0;
+        for (const auto& at : lifetimes) {
+            size_t alive = 0;
+            for (const auto& other : lifetimes) {
+                alive += other.key == key && other.begin <= at.begin && at.begin < other.end;
+            }
+            peak = std::max(peak, alive);
+        }
+        return peak;
+    }
+
+    /// Runs one frame the way RenderTargetMerger does: plan, then acquire/release in clock order
+    std::vector<TransientAliasPlanner::SlotId> RunFrame(TransientAliasPlanner& planner, const std::vector<Lifetime>& lifetimes, int& created)
+    {
+        planner.BeginFrame();
+        std::vector<TransientAliasPlanner::SlotId> planned;
+        planner.Plan(lifetimes, planned);
+
+        std::vector<TransientAliasPlanner::SlotId> slots(lifetimes.size(), TransientAliasPlanner::INVALID_SLOT);
+        uint32_t lastTime = 0;
+        for (const auto& lifetime : lifetimes) {
+            lastTime = std::max(lastTime, lifetime.end);
+        }
+        for (uint32_t time = 0; time <= lastTime; ++time) {
+            for (size_t i = 0; i < lifetimes.size(); ++i) {
+                if (lifetimes[i].end == time && slots[i] != TransientAliasPlanner::INVALID_SLOT) {
+                    planner.Release(slots[i]);
+                }
+            }
+            for (size_t i = 0; i < lifetimes.size(); ++i) {
+                if (lifetimes[i].begin == time) {
+                    bool isNew = false;
+                    slots[i] = planner.Acquire(lifetimes[i].key, lifetimes[i].bytes, time, isNew, planned[i]);
+                    created += isNew;
+                }
+            }
+        }
+        planner.EndFrame(true);
+        return slots;
+    }
+
+    void CheckNoLiveOverlap(const std::vector<Lifetime>& lifetimes, const std::vector<TransientAliasPlanner::SlotId>& slots)
+    {
+        for (size_t a = 0; a < lifetimes.size(); ++a) {
+            for (size_t b = a + 1; b < lifetimes.size(); ++b) {
+                if (slots[a] == slots[b]) {
+                    CHECK_FALSE(Overlaps(lifetimes[a], lifetimes[b]));
+                    CHECK(lifetimes[a].key == lifetimes[b].key);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Same-key lifetimes that don't overlap share a slot", "[TransientAliasPlanner]")
+{
+    TransientAliasPlanner planner;
+    const std::vector<Lifetime> lifetimes = {
+        Make(kFullRes, 0, 3),
+        Make(kFullRes, 3, 6),   // Starts as the first ends
+        Make(kFullRes, 2, 5),   // Overlaps both
+        Make(kHalfRes, 6, 8),   // Disjoint but incompatible
+    };
+    int created = 0;
+    auto slots = RunFrame(planner, lifetimes, created);
+
+    CHECK(slots[0] == slots[1]);
+    CHECK(slots[2] != slots[0]);
+    CHECK(slots[3] != slots[0]);
+    CHECK(slots[3] != slots[2]);
+    CHECK(created == 3);
+    CHECK(planner.GetReservedBytes() == 2 * kFullBytes + kHalfBytes);
+    CHECK(planner.GetRequestedBytes() == 3 * kFullBytes + kHalfBytes);
+    CheckNoLiveOverlap(lifetimes, slots);
+}
+
+TEST_CASE("Plans use the minimum number of slots per key", "[TransientAliasPlanner]")
+{
+    // Intervals listed out of begin order; the planner sorts them itself
+    const std::vector<Lifetime> lifetimes = {
+        Make(kFullRes, 9, 14), Make(kFullRes, 0, 4), Make(kFullRes, 1, 3), Make(kFullRes, 4, 9),
+        Make(kFullRes, 3, 7), Make(kFullRes, 7, 12), Make(kHalfRes, 0, 6), Make(kHalfRes, 6, 10),
+        Make(kHalfRes, 2, 12), Make(kFullRes, 12, 15), Make(kFullRes, 2, 3),
+    };
+
+    TransientAliasPlanner planner;
+    planner.BeginFrame();
+    std::vector<TransientAliasPlanner::SlotId> slots;
+    planner.Plan(lifetimes, slots);
+
+    std::set<TransientAliasPlanner::SlotId> full;
+    std::set<TransientAliasPlanner::SlotId> half;
+    for (size_t i = 0; i < lifetimes.size(); ++i) {
+        (lifetimes[i].key == kFullRes ? full : half).insert(slots[i]);
+    }
+    CHECK(full.size() == PeakOverlap(lifetimes, kFullRes));
+    CHECK(half.size() == PeakOverlap(lifetimes, kHalfRes));
+    CHECK(planner.GetSlotCount() == full.size() + half.size());
+    CheckNoLiveOverlap(lifetimes, slots);
+}
+
+TEST_CASE("Backups copied before any merge draw need a slot each", "[TransientAliasPlanner]")
+{
+    // RenderTargetMerger's schedule: 11 copies, then merge draws consume them in batches
+    std::vector<Lifetime> lifetimes;
+    for (uint32_t i = 0; i < 9; ++i) {
+        lifetimes.push_back(Make(kFullRes, i, i < 8 ? 12 : 13));
+    }
+    lifetimes.push_back(Make(kHalfRes, 9, 14));
+    lifetimes.push_back(Make(kHalfRes, 10, 14));
+
+    TransientAliasPlanner planner;
+    int created = 0;
+    auto slots = RunFrame(planner, lifetimes, created);
+    CHECK(std::set<TransientAliasPlanner::SlotId>(slots.begin(), slots.end()).size() == lifetimes.size());
+    CHECK(planner.GetReservedBytes() == planner.GetRequestedBytes());
+}
+
+TEST_CASE("A repeated schedule reuses last frame's slots", "[TransientAliasPlanner]")
+{
+    const std::vector<Lifetime> lifetimes = {
+        Make(kFullRes, 0, 2), Make(kFullRes, 1, 4), Make(kFullRes, 2, 5), Make(kHalfRes, 0, 5),
+    };
+
+    TransientAliasPlanner planner;
+    int created = 0;
+    auto first = RunFrame(planner, lifetimes, created);
+    CHECK(created == 3);
+    CHECK(first[0] == first[2]);
+
+    for (int frame = 0; frame < 10; ++frame) {
+        int recreated = 0;
+        CHECK(RunFrame(planner, lifetimes, recreated) == first);
+        CHECK(recreated == 0);
+    }
+}
+
+TEST_CASE("Acquires that run off the plan never share a live slot", "[TransientAliasPlanner]")
+{
+    TransientAliasPlanner planner;
+    int created = 0;
+    // Last frame: A [0,2) then B [2,4) on one slot
+    RunFrame(planner, { Make(kFullRes, 0, 2), Make(kFullRes, 2, 4) }, created);
+    REQUIRE(planner.GetSlotCount() == 1);
+
+    // This frame A runs longer than planned: B must not get A's texture while A is live
+    planner.BeginFrame();
+    std::vector<TransientAliasPlanner::SlotId> planned;
+    planner.Plan({ Make(kFullRes, 0, 2), Make(kFullRes, 2, 4) }, planned);
+    REQUIRE(planned[0] == planned[1]);
+
+    bool isNew = false;
+    auto a = planner.Acquire(kFullRes, kFullBytes, 0, isNew, planned[0]);
+    CHECK_FALSE(isNew);
+    auto b = planner.Acquire(kFullRes, kFullBytes, 2, isNew, planned[1]);
+    CHECK(isNew);
+    CHECK(a != b);
+
+    // An unplanned lifetime doesn't take a slot planned for a later lifetime
+    planner.Release(a);
+    auto c = planner.Acquire(kFullRes, kFullBytes, 1, isNew);
+    CHECK(c != b);
+    planner.EndFrame(true);
+}
+
+TEST_CASE("Idle slots are evicted to the budget and all released out of use", "[TransientAliasPlanner]")
+{
+    TransientAliasPlanner planner;
+    int created = 0;
+    RunFrame(planner, { Make(kFullRes, 0, 2), Make(kFullRes, 1, 3), Make(kHalfRes, 0, 3) }, created);
+    REQUIRE(planner.GetReservedBytes() == 2 * kFullBytes + kHalfBytes);
+
+    // Slots used this frame are kept even over budget
+    CHECK(planner.CollectEvictions(kFullBytes, 120).empty());
+
+    // Next frame only needs one full-res backup: the unused ones go, least recently used first
+    RunFrame(planner, { Make(kFullRes, 0, 2) }, created);
+    auto evicted = planner.CollectEvictions(kFullBytes, 120);
+    CHECK(evicted.size() == 2);
+    CHECK(planner.GetReservedBytes() == kFullBytes);
+
+    for (int frame = 0; frame < 3; ++frame) {
+        planner.BeginFrame();
+        planner.EndFrame(false);
+    }
+    CHECK(planner.CollectEvictions(kFullBytes, 3).size() == 1);
+    CHECK(planner.GetReservedBytes() == 0);
+    CHECK(planner.GetUsedBytes() == 0);
+}
+
+TEST_CASE("Texture descs that differ in samples or array size never share a slot", "[TransientAliasPlanner]")
+{
+    using ThroughScope::TransientKeyTable;
+    using ThroughScope::TransientTextureDesc;
+
+    TransientTextureDesc single;
+    single.width = 2560;
+    single.height = 1440;
+    single.format = 28;  // DXGI_FORMAT_R8G8B8A8_UNORM
+    TransientTextureDesc msaa = single;
+    msaa.sampleCount = 4;
+    TransientTextureDesc msaaQuality = msaa;
+    msaaQuality.sampleQuality = 0xFFFFFFFFu;  // D3D11_STANDARD_MULTISAMPLE_PATTERN
+    TransientTextureDesc array = single;
+    array.arraySize = 2;
+
+    TransientKeyTable keys;
+    const uint64_t singleKey = keys.GetKey(single);
+    const std::set<uint64_t> distinct = { singleKey, keys.GetKey(msaa), keys.GetKey(msaaQuality), keys.GetKey(array) };
+    CHECK(distinct.size() == 4);
+    CHECK(keys.GetKey(single) == singleKey);
+    TransientTextureDesc same = single;
+    CHECK(keys.GetKey(same) == singleKey);
+    CHECK(keys.GetKeyCount() == 4);
+
+    // A single-sample backup released before an MSAA one of the same size starts: equal
+    // width/height/format/mips, but the slot must not be handed over
+    TransientAliasPlanner planner;
+    planner.BeginFrame();
+    bool isNew = false;
+    auto a = planner.Acquire(singleKey, kFullBytes, 0, isNew);
+    planner.Release(a);
+    auto b = planner.Acquire(keys.GetKey(msaa), kFullBytes, 1, isNew);
+    CHECK(b != a);
+    CHECK(isNew);
+    planner.Release(b);
+    auto c = planner.Acquire(keys.GetKey(array), kFullBytes, 2, isNew);
+    CHECK(c != a);
+    CHECK(c != b);
+    planner.Release(c);
+    planner.EndFrame(true);
+
+    keys.Reset();
+    CHECK(keys.GetKeyCount() == 0);
+}
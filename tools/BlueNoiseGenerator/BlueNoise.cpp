@@ -0,0 +1,426 @@
+#include "BlueNoise.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+
+namespace BlueNoise
+{
+    namespace
+    {
+        constexpr double kPi = 3.14159265358979323846;
+
+        /// Energy of a binary pattern: sum of Gaussians centred on its set texels, on a torus
+        class EnergyField
+        {
+        public:
+            EnergyField(size_t size, double sigma) :
+                m_size(size),
+                m_kernel(size * size),
+                m_energy(size * size, 0.0),
+                m_pattern(size * size, 0)
+            {
+                const double scale = -1.0 / (2.0 * sigma * sigma);
+                for (size_t dy = 0; dy < size; ++dy) {
+                    for (size_t dx = 0; dx < size; ++dx) {
+                        const double x = double(std::min(dx, size - dx));
+                        const double y = double(std::min(dy, size - dy));
+                        m_kernel[dy * size + dx] = std::exp((x * x + y * y) * scale);
+                    }
+                }
+            }
+
+            bool IsSet(size_t index) const { return m_pattern[index] != 0; }
+            size_t GetCount() const { return m_count; }
+
+            void Set(size_t index, bool value)
+            {
+                if (IsSet(index) == value) {
+                    return;
+                }
+                m_pattern[index] = value ? 1 : 0;
+                m_count = value ? m_count + 1 : m_count - 1;
+
+                const double sign = value ? 1.0 : -1.0;
+                const size_t px = index % m_size;
+                const size_t py = index / m_size;
+                for (size_t y = 0; y < m_size; ++y) {
+                    const size_t dy = (y + m_size - py) % m_size;
+                    const double* kernelRow = &m_kernel[dy * m_size];
+                    double* energyRow = &m_energy[y * m_size];
+                    for (size_t x = 0; x < m_size; ++x) {
+                        energyRow[x] += sign * kernelRow[(x + m_size - px) % m_size];
+                    }
+                }
+            }
+
+            /// Set texel with the highest energy
+            size_t FindTightestCluster() const
+            {
+                size_t best = 0;
+                double bestEnergy = -std::numeric_limits<double>::infinity();
+                for (size_t i = 0; i < m_energy.size(); ++i) {
+                    if (m_pattern[i] && m_energy[i] > bestEnergy) {
+                        bestEnergy = m_energy[i];
+                        best = i;
+                    }
+                }
+                return best;
+            }
+
+            /// Unset texel with the lowest energy
+            size_t FindLargestVoid() const
+            {
+                size_t best = 0;
+                double bestEnergy = std::numeric_limits<double>::infinity();
+                for (size_t i = 0; i < m_energy.size(); ++i) {
+                    if (!m_pattern[i] && m_energy[i] < bestEnergy) {
+                        bestEnergy = m_energy[i];
+                        best = i;
+                    }
+                }
+                return best;
+            }
+
+        private:
+            size_t m_size;
+            std::vector<double> m_kernel;  // Indexed by toroidal offset (dy * size + dx)
+            std::vector<double> m_energy;
+            std::vector<uint8_t> m_pattern;
+            size_t m_count = 0;
+        };
+
+        // std::mt19937 output is specified by the standard; the distributions are not, so
+        // reduce it ourselves to keep the output identical across standard libraries
+        size_t RandomIndex(std::mt19937& rng, size_t count)
+        {
+            return size_t(rng()) % count;
+        }
+
+        /// In-place 2D DFT of a size x size grid (row pass, then column pass)
+        void Transform2D(std::vector<std::complex<double>>& data, size_t size)
+        {
+            std::vector<std::complex<double>> twiddle(size);
+            for (size_t k = 0; k < size; ++k) {
+                const double angle = -2.0 * kPi * double(k) / double(size);
+                twiddle[k] = { std::cos(angle), std::sin(angle) };
+            }
+
+            std::vector<std::complex<double>> line(size);
+            for (int pass = 0; pass < 2; ++pass) {
+                for (size_t a = 0; a < size; ++a) {
+                    for (size_t k = 0; k < size; ++k) {
+                        std::complex<double> sum = 0.0;
+                        for (size_t n = 0; n < size; ++n) {
+                            const size_t index = pass == 0 ? a * size + n : n * size + a;
+                            sum += data[index] * twiddle[(k * n) % size];
+                        }
+                        line[k] = sum;
+                    }
+                    for (size_t k = 0; k < size; ++k) {
+                        data[pass == 0 ? a * size + k : k * size + a] = line[k];
+                    }
+                }
+            }
+        }
+
+        /// Power per frequency of values normalized to zero mean and unit variance
+        std::vector<double> PowerSpectrum(const std::vector<double>& values, size_t size)
+        {
+            const double count = double(values.size());
+            double mean = 0.0;
+            for (double v : values) {
+                mean += v;
+            }
+            mean /= count;
+            double variance = 0.0;
+            for (double v : values) {
+                variance += (v - mean) * (v - mean);
+            }
+            variance /= count;
+            const double invStd = variance > 0.0 ? 1.0 / std::sqrt(variance) : 0.0;
+
+            std::vector<std::complex<double>> data(values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                data[i] = (values[i] - mean) * invStd;
+            }
+            Transform2D(data, size);
+
+            std::vector<double> power(values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                power[i] = std::norm(data[i]) / count;
+            }
+            return power;
+        }
+
+        /// Frequency radius of DFT bin (x, y), with bins above size / 2 as negative frequencies
+        double FrequencyRadius(size_t x, size_t y, size_t size)
+        {
+            const double fx = double(x <= size / 2 ? x : size - x);
+            const double fy = double(y <= size / 2 ? y : size - y);
+            return std::sqrt(fx * fx + fy * fy);
+        }
+
+        double LowFrequencyPower(const std::vector<double>& power, size_t size, double* maxPower)
+        {
+            const double limit = double(size) / 8.0;
+            double sum = 0.0;
+            size_t bins = 0;
+            double maximum = 0.0;
+            for (size_t y = 0; y < size; ++y) {
+                for (size_t x = 0; x < size; ++x) {
+                    const double radius = FrequencyRadius(x, y, size);
+                    if (radius > 0.0 && radius <= limit) {
+                        sum += power[y * size + x];
+                        maximum = std::max(maximum, power[y * size + x]);
+                        ++bins;
+                    }
+                }
+            }
+            if (maxPower) {
+                *maxPower = maximum;
+            }
+            return bins ? sum / double(bins) : 0.0;
+        }
+
+        // DDS layout (see DDSTextureLoader11.cpp)
+        constexpr uint32_t kDDSMagic = 0x20534444;  // "DDS "
+        constexpr uint32_t kFourCCDX10 = 0x30315844;  // "DX10"
+        constexpr uint32_t kDDSFlagsTexture = 0x1 | 0x2 | 0x4 | 0x8 | 0x1000;  // CAPS | HEIGHT | WIDTH | PITCH | PIXELFORMAT
+        constexpr uint32_t kDDPFFourCC = 0x4;
+        constexpr uint32_t kDDSCapsTexture = 0x1000;
+        constexpr uint32_t kDXGIFormatR8Unorm = 61;
+        constexpr uint32_t kResourceDimensionTexture2D = 3;
+
+        struct DDSPixelFormat
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t fourCC;
+            uint32_t rgbBitCount;
+            uint32_t rBitMask;
+            uint32_t gBitMask;
+            uint32_t bBitMask;
+            uint32_t aBitMask;
+        };
+
+        struct DDSHeader
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t height;
+            uint32_t width;
+            uint32_t pitchOrLinearSize;
+            uint32_t depth;
+            uint32_t mipMapCount;
+            uint32_t reserved1[11];
+            DDSPixelFormat pixelFormat;
+            uint32_t caps;
+            uint32_t caps2;
+            uint32_t caps3;
+            uint32_t caps4;
+            uint32_t reserved2;
+        };
+
+        struct DDSHeaderDX10
+        {
+            uint32_t dxgiFormat;
+            uint32_t resourceDimension;
+            uint32_t miscFlag;
+            uint32_t arraySize;
+            uint32_t miscFlags2;
+        };
+
+        static_assert(sizeof(DDSHeader) == 124, "DDS header layout");
+        static_assert(sizeof(DDSHeaderDX10) == 20, "DDS DX10 header layout");
+    }
+
+    std::vector<uint32_t> GenerateRanks(const GeneratorSettings& settings)
+    {
+        const size_t size = settings.size;
+        const size_t count = size * size;
+        std::vector<uint32_t> ranks(count, 0);
+        if (count == 0) {
+            return ranks;
+        }
+
+        // Initial binary pattern: random texels, then swap the tightest cluster into the largest
+        // void until that no longer moves anything
+        EnergyField prototype(size, settings.sigma);
+        std::mt19937 rng(settings.seed);
+        const size_t initialCount = std::clamp<size_t>(size_t(double(count) * settings.initialDensity), 1, count / 2);
+        while (prototype.GetCount() < initialCount) {
+            prototype.Set(RandomIndex(rng, count), true);
+        }
+        for (size_t iteration = 0; iteration < count * 4; ++iteration) {
+            const size_t cluster = prototype.FindTightestCluster();
+            prototype.Set(cluster, false);
+            const size_t largestVoid = prototype.FindLargestVoid();
+            prototype.Set(largestVoid, true);
+            if (largestVoid == cluster) {
+                break;
+            }
+        }
+
+        // Phase 1: rank the initial texels by removing tightest clusters
+        EnergyField field = prototype;
+        while (field.GetCount() > 0) {
+            const size_t cluster = field.FindTightestCluster();
+            field.Set(cluster, false);
+            ranks[cluster] = uint32_t(field.GetCount());
+        }
+
+        // Phases 2 and 3: fill the largest voids. Past half the texels the classic algorithm
+        // switches to removing clusters of unset texels; since the Gaussians over all texels sum
+        // to a constant, the highest energy among unset texels is the lowest energy of the set
+        // ones, so the same search covers both phases
+        field = prototype;
+        while (field.GetCount() < count) {
+            const size_t largestVoid = field.FindLargestVoid();
+            ranks[largestVoid] = uint32_t(field.GetCount());
+            field.Set(largestVoid, true);
+        }
+
+        return ranks;
+    }
+
+    std::vector<uint8_t> RanksToUnorm8(const std::vector<uint32_t>& ranks)
+    {
+        std::vector<uint8_t> texels(ranks.size());
+        const double count = double(ranks.size());
+        for (size_t i = 0; i < ranks.size(); ++i) {
+            texels[i] = uint8_t(std::min(255.0, std::floor((double(ranks[i]) + 0.5) / count * 256.0)));
+        }
+        return texels;
+    }
+
+    std::vector<uint8_t> GenerateWhiteNoise(size_t size, uint32_t seed)
+    {
+        std::vector<uint32_t> ranks(size * size);
+        for (size_t i = 0; i < ranks.size(); ++i) {
+            ranks[i] = uint32_t(i);
+        }
+        std::mt19937 rng(seed);
+        for (size_t i = ranks.size(); i > 1; --i) {
+            std::swap(ranks[i - 1], ranks[RandomIndex(rng, i)]);
+        }
+        return RanksToUnorm8(ranks);
+    }
+
+    SpectrumReport AnalyzeSpectrum(const std::vector<uint8_t>& texels, size_t size)
+    {
+        SpectrumReport report;
+        if (size == 0 || texels.size() != size * size) {
+            return report;
+        }
+
+        size_t histogram[256] = {};
+        for (uint8_t value : texels) {
+            histogram[value]++;
+        }
+        report.uniformHistogram = texels.size() % 256 == 0 &&
+            std::all_of(std::begin(histogram), std::end(histogram), [&](size_t n) { return n == texels.size() / 256; });
+
+        const std::vector<double> power = PowerSpectrum(std::vector<double>(texels.begin(), texels.end()), size);
+
+        const size_t maxRadius = size_t(std::ceil(FrequencyRadius(size / 2, size / 2, size)));
+        std::vector<size_t> bins(maxRadius + 1, 0);
+        report.radialPower.assign(maxRadius + 1, 0.0);
+        double highSum = 0.0;
+        size_t highBins = 0;
+        for (size_t y = 0; y < size; ++y) {
+            for (size_t x = 0; x < size; ++x) {
+                const double radius = FrequencyRadius(x, y, size);
+                const size_t bin = size_t(std::lround(radius));
+                report.radialPower[bin] += power[y * size + x];
+                bins[bin]++;
+                if (radius >= double(size) / 4.0) {
+                    highSum += power[y * size + x];
+                    ++highBins;
+                }
+            }
+        }
+        for (size_t i = 0; i < bins.size(); ++i) {
+            if (bins[i]) {
+                report.radialPower[i] /= double(bins[i]);
+            }
+        }
+
+        report.lowFrequencyPower = LowFrequencyPower(power, size, &report.maxLowFrequencyPower);
+        report.highFrequencyPower = highBins ? highSum / double(highBins) : 0.0;
+        return report;
+    }
+
+    double ThresholdLowFrequencyPower(const std::vector<uint8_t>& texels, size_t size, uint8_t threshold)
+    {
+        std::vector<double> pattern(texels.size());
+        for (size_t i = 0; i < texels.size(); ++i) {
+            pattern[i] = texels[i] < threshold ? 1.0 : 0.0;
+        }
+        return LowFrequencyPower(PowerSpectrum(pattern, size), size, nullptr);
+    }
+
+    bool WriteDDS(const std::string& path, const std::vector<uint8_t>& texels, size_t size)
+    {
+        if (size == 0 || texels.size() != size * size) {
+            return false;
+        }
+
+        DDSHeader header{};
+        header.size = sizeof(DDSHeader);
+        header.flags = kDDSFlagsTexture;
+        header.height = uint32_t(size);
+        header.width = uint32_t(size);
+        header.pitchOrLinearSize = uint32_t(size);
+        header.mipMapCount = 1;
+        header.pixelFormat.size = sizeof(DDSPixelFormat);
+        header.pixelFormat.flags = kDDPFFourCC;
+        header.pixelFormat.fourCC = kFourCCDX10;
+        header.caps = kDDSCapsTexture;
+
+        DDSHeaderDX10 headerDX10{};
+        headerDX10.dxgiFormat = kDXGIFormatR8Unorm;
+        headerDX10.resourceDimension = kResourceDimensionTexture2D;
+        headerDX10.arraySize = 1;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&kDDSMagic), sizeof(kDDSMagic));
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&headerDX10), sizeof(headerDX10));
+        file.write(reinterpret_cast<const char*>(texels.data()), std::streamsize(texels.size()));
+        return file.good();
+    }
+
+    bool ReadDDS(const std::string& path, std::vector<uint8_t>& texels, size_t& size)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        uint32_t magic = 0;
+        DDSHeader header{};
+        DDSHeaderDX10 headerDX10{};
+        if (!file.read(reinterpret_cast<char*>(&magic), sizeof(magic)) ||
+            !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            !file.read(reinterpret_cast<char*>(&headerDX10), sizeof(headerDX10))) {
+            return false;
+        }
+        if (magic != kDDSMagic || header.size != sizeof(DDSHeader) || header.pixelFormat.fourCC != kFourCCDX10 ||
+            headerDX10.dxgiFormat != kDXGIFormatR8Unorm || headerDX10.resourceDimension != kResourceDimensionTexture2D ||
+            header.width == 0 || header.width != header.height) {
+            return false;
+        }
+
+        size = header.width;
+        texels.resize(size * size);
+        return bool(file.read(reinterpret_cast<char*>(texels.data()), std::streamsize(texels.size())));
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// Offline blue-noise generation for the night-vision grain (TrueScopeShader.hlsl, t3).
+// Standalone: C++17 standard library only, builds on Linux and Windows.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BlueNoise
+{
+    struct GeneratorSettings
+    {
+        size_t size = 64;
+        double sigma = 1.5;
+        double initialDensity = 0.1;  // Fraction of texels set in the initial binary pattern
+        uint32_t seed = 1;
+    };
+
+    /**
+     * @brief Void-and-cluster dither array (Ulichney 1993) on a size x size torus
+     *
+     * Energy is a Gaussian of the toroidal distance, so the pattern tiles seamlessly.
+     * @return Rank (0 .. size*size-1) of every texel, row-major
+     */
+    std::vector<uint32_t> GenerateRanks(const GeneratorSettings& settings);
+
+    /// Ranks -> 8-bit values, (rank + 0.5) / count; every level is used equally often
+    std::vector<uint8_t> RanksToUnorm8(const std::vector<uint32_t>& ranks);
+
+    /// Uniform white noise with the same histogram, as a reference for the spectral checks
+    std::vector<uint8_t> GenerateWhiteNoise(size_t size, uint32_t seed);
+
+    /**
+     * @brief Spectral properties of a tileable size x size texture
+     *
+     * Power is |DFT(x)|^2 / count with x the values normalized to zero mean and unit variance,
+     * so white noise averages 1 at every frequency.
+     */
+    struct SpectrumReport
+    {
+        std::vector<double> radialPower;  // Mean power per rounded frequency radius (index 0 = DC)
+        double lowFrequencyPower = 0.0;   // Mean power for 0 < |f| <= size / 8
+        double maxLowFrequencyPower = 0.0;
+        double highFrequencyPower = 0.0;  // Mean power for |f| >= size / 4
+        bool uniformHistogram = false;    // Every 8-bit level appears equally often
+    };
+
+    SpectrumReport AnalyzeSpectrum(const std::vector<uint8_t>& texels, size_t size);
+
+    /// Mean power for 0 < |f| <= size / 8 of the binary pattern (value < threshold)
+    double ThresholdLowFrequencyPower(const std::vector<uint8_t>& texels, size_t size, uint8_t threshold);
+
+    /// Single-mip 2D DDS with a DX10 header, DXGI_FORMAT_R8_UNORM (loaded by DDSTextureLoader11)
+    bool WriteDDS(const std::string& path, const std::vector<uint8_t>& texels, size_t size);
+    bool ReadDDS(const std::string& path, std::vector<uint8_t>& texels, size_t& size);
+}
@@ -0,0 +1,122 @@
+// BlueNoiseGenerator: writes the tileable blue-noise texture used for the night-vision grain
+// (Data/Textures/TTS/BlueNoise64.dds) and checks its spectral properties.
+//
+//   BlueNoiseGenerator [--size 64] [--sigma 1.5] [--seed 1] [--output BlueNoise64.dds]
+//   BlueNoiseGenerator --verify BlueNoise64.dds
+//
+// Every run ends with the checks below; the exit code is non-zero when one fails.
+
+#include "BlueNoise.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    // Blue noise has almost no energy at low frequencies (white noise averages 1 everywhere)
+    constexpr double kMaxLowFrequencyPower = 0.1;
+    constexpr double kMaxLowFrequencyPeak = 0.5;
+    constexpr double kMinHighFrequencyPower = 1.1;
+    // Thresholding at any level must still give an evenly spread pattern
+    constexpr double kMaxThresholdLowFrequencyPower = 0.2;
+    constexpr uint8_t kThresholds[] = { 26, 64, 128, 192, 230 };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "usage: BlueNoiseGenerator [--size N] [--sigma S] [--seed N] [--output file.dds]\n"
+            "       BlueNoiseGenerator --verify file.dds\n");
+    }
+
+    bool Check(bool condition, const char* description, double value, double limit)
+    {
+        std::printf("  %-44s %8.4f (limit %.4f)  %s\n", description, value, limit, condition ? "ok" : "FAILED");
+        return condition;
+    }
+
+    bool Verify(const std::vector<uint8_t>& texels, size_t size)
+    {
+        const BlueNoise::SpectrumReport report = BlueNoise::AnalyzeSpectrum(texels, size);
+        const BlueNoise::SpectrumReport white = BlueNoise::AnalyzeSpectrum(BlueNoise::GenerateWhiteNoise(size, 1), size);
+
+        std::printf("radially averaged power (white noise reference in brackets):\n");
+        for (size_t radius = 1; radius < report.radialPower.size(); ++radius) {
+            std::printf("  |f| = %2zu  %7.4f  [%7.4f]\n", radius, report.radialPower[radius], white.radialPower[radius]);
+        }
+
+        std::printf("checks:\n");
+        bool passed = true;
+        std::printf("  %-44s %s\n", "uniform 8-bit histogram", report.uniformHistogram ? "ok" : "FAILED");
+        passed &= report.uniformHistogram;
+        passed &= Check(report.lowFrequencyPower <= kMaxLowFrequencyPower, "mean power, 0 < |f| <= size/8",
+            report.lowFrequencyPower, kMaxLowFrequencyPower);
+        passed &= Check(report.maxLowFrequencyPower <= kMaxLowFrequencyPeak, "peak power, 0 < |f| <= size/8",
+            report.maxLowFrequencyPower, kMaxLowFrequencyPeak);
+        passed &= Check(report.highFrequencyPower >= kMinHighFrequencyPower, "mean power, |f| >= size/4 (minimum)",
+            report.highFrequencyPower, kMinHighFrequencyPower);
+        for (uint8_t threshold : kThresholds) {
+            char description[64];
+            std::snprintf(description, sizeof(description), "thresholded at %3u/256, mean power 0 < |f| <= size/8",
+                unsigned(threshold));
+            const double power = BlueNoise::ThresholdLowFrequencyPower(texels, size, threshold);
+            passed &= Check(power <= kMaxThresholdLowFrequencyPower, description, power, kMaxThresholdLowFrequencyPower);
+        }
+        std::printf("%s\n", passed ? "all checks passed" : "checks FAILED");
+        return passed;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BlueNoise::GeneratorSettings settings;
+    std::string output = "BlueNoise64.dds";
+    std::string verifyPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            settings.size = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--sigma") == 0 && hasValue) {
+            settings.sigma = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            settings.seed = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--output") == 0 && hasValue) {
+            output = argv[++i];
+        } else if (std::strcmp(arg, "--verify") == 0 && hasValue) {
+            verifyPath = argv[++i];
+        } else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (!verifyPath.empty()) {
+        std::vector<uint8_t> texels;
+        size_t size = 0;
+        if (!BlueNoise::ReadDDS(verifyPath, texels, size)) {
+            std::fprintf(stderr, "failed to read %s (expected a square R8_UNORM DDS)\n", verifyPath.c_str());
+            return 1;
+        }
+        std::printf("%s: %zux%zu\n", verifyPath.c_str(), size, size);
+        return Verify(texels, size) ? 0 : 1;
+    }
+
+    // The 8-bit histogram check needs a multiple of 256 texels
+    if (settings.size < 16 || settings.size > 1024 || (settings.size * settings.size) % 256 != 0 || !(settings.sigma > 0.0)) {
+        std::fprintf(stderr, "size must be 16..1024 with size*size a multiple of 256, sigma > 0\n");
+        return 2;
+    }
+
+    std::printf("generating %zux%zu blue noise (sigma %.2f, seed %u)\n", settings.size, settings.size, settings.sigma,
+        settings.seed);
+    const std::vector<uint8_t> texels = BlueNoise::RanksToUnorm8(BlueNoise::GenerateRanks(settings));
+    if (!BlueNoise::WriteDDS(output, texels, settings.size)) {
+        std::fprintf(stderr, "failed to write %s\n", output.c_str());
+        return 1;
+    }
+    std::printf("wrote %s\n", output.c_str());
+    return Verify(texels, settings.size) ? 0 : 1;
+}